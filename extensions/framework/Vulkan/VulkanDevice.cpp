@@ -2436,6 +2436,9 @@ namespace {
 			#ifdef VK_KHR_push_descriptor
 				VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
 			#endif
+			#ifdef VK_EXT_pipeline_creation_feedback
+				VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME,
+			#endif
 			#ifdef VK_KHR_shader_atomic_int64
 				VK_KHR_SHADER_ATOMIC_INT64_EXTENSION_NAME,
 			#endif
@@ -2542,6 +2545,9 @@ namespace {
 			#ifdef VK_KHR_push_descriptor
 				VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
 			#endif
+			#ifdef VK_EXT_pipeline_creation_feedback
+				VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME,
+			#endif
 			#ifdef VK_EXT_blend_operation_advanced
 				VK_EXT_BLEND_OPERATION_ADVANCED_EXTENSION_NAME,
 			#endif
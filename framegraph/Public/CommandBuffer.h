@@ -34,15 +34,25 @@ namespace FG
 	
 	struct CommandBufferDesc
 	{
-		EQueueType		queueType	= EQueueType::Graphics;
-		EDebugFlags		debugFlags	= Default;
+		EQueueType		queueType			= EQueueType::Graphics;
+		EDebugFlags		debugFlags			= Default;
 		StringView		name;
+		bool			parallelRecording	= false;	// record render pass commands on multiple threads into secondary command buffers
+		bool			singlePassDrawTasks	= false;	// collect barriers and record draw commands in single pass, draw commands are recorded into secondary command buffer
+		bool			splitBarriers		= false;	// use events instead of pipeline barriers if there are independent tasks between producer and consumer
+		bool			barrierPlanning		= false;	// consecutive transfer tasks share a single pipeline barrier, ignored if split barriers are enabled
+		bool			transientDescriptorSets	= false;	// descriptor sets for not cached resources are allocated from command batch pool without locks, ignored if parallel recording is enabled
 		
 				 CommandBufferDesc () {}
 		explicit CommandBufferDesc (EQueueType type) : queueType{type} {}
 
-		CommandBufferDesc&  SetDebugFlags (EDebugFlags value)	{ debugFlags = value;  return *this; }
-		CommandBufferDesc&  SetDebugName (StringView value)		{ name = value;  return *this; }
+		CommandBufferDesc&  SetDebugFlags (EDebugFlags value)		{ debugFlags = value;  return *this; }
+		CommandBufferDesc&  SetDebugName (StringView value)			{ name = value;  return *this; }
+		CommandBufferDesc&  SetParallelRecording (bool value = true)	{ parallelRecording = value;  return *this; }
+		CommandBufferDesc&  SetSinglePassDrawTasks (bool value = true)	{ singlePassDrawTasks = value;  return *this; }
+		CommandBufferDesc&  SetSplitBarriers (bool value = true)		{ splitBarriers = value;  return *this; }
+		CommandBufferDesc&  SetBarrierPlanning (bool value = true)		{ barrierPlanning = value;  return *this; }
+		CommandBufferDesc&  SetTransientDescriptorSets (bool value = true)	{ transientDescriptorSets = value;  return *this; }
 	};
 
 
@@ -87,6 +97,11 @@ namespace FG
 		// Buffer may be in immutable or mutable state, immutable state disables barrier placement that increases performance on CPU.
 		virtual void		AcquireBuffer (RawBufferID id, bool makeMutable) = 0;
 
+		// Create image that can be used only in current command buffer, image will be released when command buffer complete execution.
+		// Memory is allocated in 'FrameGraph::Execute()', images that are not used at the same time share the same memory.
+		// Content of the image is undefined before first use.
+		ND_ virtual RawImageID	CreateTransientImage (const ImageDesc &desc, StringView dbgName = Default) = 0;
+
 	// tasks //
 		virtual Task		AddTask (const SubmitRenderPass &) = 0;
 		virtual Task		AddTask (const DispatchCompute &) = 0;
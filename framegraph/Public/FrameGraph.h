@@ -7,6 +7,7 @@
 
 #include "framegraph/Public/CommandBuffer.h"
 #include "framegraph/Public/PipelineCompiler.h"
+#include "framegraph/Public/TaskScheduler.h"
 #include "framegraph/Public/VulkanTypes.h"
 #include "framegraph/Public/Pipeline.h"
 #include "framegraph/Public/BufferDesc.h"
@@ -38,6 +39,8 @@ namespace FG
 		using OnExternalImageReleased_t		= std::function< void (const ExternalImage_t &) >;
 		using OnExternalBufferReleased_t	= std::function< void (const ExternalBuffer_t &) >;
 		using ShaderDebugCallback_t			= std::function< void (StringView taskName, StringView shaderName, EShaderStages, ArrayView<String> output) >;
+		using OnExecuted_t					= std::function< void (bool result) >;
+		using OnPipelineReady_t				= std::function< void (RawGPipelineID) >;
 
 	//-----------------------------------------------------
 	// statistics
@@ -46,7 +49,12 @@ namespace FG
 		{
 			uint		descriptorBinds				= 0;
 			uint		pushConstants				= 0;
-			uint		pipelineBarriers			= 0;
+			uint		pushDescriptors				= 0;	// number of 'vkCmdPushDescriptorSetKHR' calls
+			uint		pipelineBarriers			= 0;	// number of 'vkCmdPipelineBarrier' calls
+			uint		emittedBarriers				= 0;	// buffer and image barriers that are passed to 'vkCmdPipelineBarrier'
+			uint		mergedBarriers				= 0;	// barriers that are merged with barriers for adjacent ranges
+			uint		skippedBarriers				= 0;	// read -> read barriers without layout transition
+			uint		splitBarriers				= 0;	// buffer and image barriers that are passed to 'vkCmdWaitEvents'
 			uint		transferOps					= 0;
 
 			uint		indexBufferBindings			= 0;
@@ -57,6 +65,8 @@ namespace FG
 			uint64_t	primitiveCount				= 0;	// sum of primitives
 			uint		graphicsPipelineBindings	= 0;
 			uint		dynamicStateChanges			= 0;
+			uint		fallbackDrawCalls			= 0;	// draw tasks that used fallback pipeline while main pipeline is compiling
+			uint		skippedDrawCalls			= 0;	// draw tasks that was skipped while pipeline is compiling
 
 			uint		dispatchCalls				= 0;
 			uint		computePipelineBindings		= 0;
@@ -78,6 +88,17 @@ namespace FG
 			uint		newGraphicsPipelineCount	= 0;
 			uint		newComputePipelineCount		= 0;
 			uint		newRayTracingPipelineCount	= 0;
+			uint		asyncGraphicsPipelineCount	= 0;	// number of pipelines that was enqueued for asynchronous compilation
+			uint		transientDescriptorSets		= 0;	// number of descriptor sets that was allocated from command batch pools
+			uint		retainedMemoryHits			= 0;	// number of images and buffers that reused memory of destroyed resources
+			uint		retainedMemoryMisses		= 0;	// number of images and buffers that allocated new memory
+			BytesU		retainedMemorySize;					// size of memory that is kept for reuse
+			uint		transientImages				= 0;	// number of images that was created by 'ICommandBuffer::CreateTransientImage()'
+			BytesU		transientImageMemory;				// sum of transient image sizes
+			BytesU		transientHeapMemory;				// size of memory that was allocated for transient images, less than 'transientImageMemory' if memory is aliased
+			uint		lazyAllocRequestedImages	= 0;	// number of transient images that are used only inside render passes, so lazily allocated memory was requested
+			uint		lazilyAllocatedImages		= 0;	// number of transient images that was bound to lazily allocated (tile) memory, see 'DeviceProperties::lazilyAllocatedMemory'
+			uint		pipelineCacheHits			= 0;	// number of new pipelines that was found in driver pipeline cache, see 'DeviceProperties::pipelineCreationFeedback'
 		};
 
 		struct Statistics
@@ -111,6 +132,10 @@ namespace FG
 			bool	rayTracingNV					: 1;	// CreatePipeline(RayTracingPipelineDesc), CreateRayTracingGeometry(), CreateRayTracingScene(), CreateRayTracingShaderTable(),
 															// BuildRayTracingGeometry, BuildRayTracingScene, UpdateRayTracingShaderTable, TraceRays can be used.
 			bool	shadingRateImageNV				: 1;	// RenderPassDesc::SetShadingRateImage(), EImageUsage::ShadingRate can be used.
+			bool	bindlessResources				: 1;	// EnableBindlessResources() can be used.
+			bool	pushDescriptors					: 1;	// small descriptor sets without dynamic offsets are pushed into command buffer instead of allocating descriptor set.
+			bool	pipelineCreationFeedback		: 1;	// ResourceStatistics::pipelineCacheHits is counted.
+			bool	lazilyAllocatedMemory			: 1;	// for EMemoryType::LazilyAllocated, otherwise device local memory is used for transient attachments.
 		
 			BytesU	minStorageBufferOffsetAlignment;		// alignment of 'offset' argument in PipelineResources::BindBuffer().
 			BytesU	minUniformBufferOffsetAlignment;		// alignment of 'offset' argument in PipelineResources::BindBuffer().
@@ -119,6 +144,23 @@ namespace FG
 			uint	maxDrawIndexedIndexValue;				// max value of 'DrawCmd::indexCount' in draw commands.
 		};
 
+
+	//-----------------------------------------------------
+	// bindless resources
+		
+		// Global descriptor set with bindings:
+		//	0 - sampled images	(texture2D[] and other types)
+		//	1 - storage images	(image2D[] and other types)
+		//	2 - samplers		(sampler[])
+		//	3 - storage buffers
+		struct BindlessDesc
+		{
+			DescriptorSetID		descriptorSet	{"Bindless"};	// descriptor set in pipelines that will be replaced by global descriptor set.
+			uint				maxImages		= 4096;
+			uint				maxSamplers		= 256;
+			uint				maxBuffers		= 4096;
+		};
+
 		static constexpr auto	MaxTimeout = Nanoseconds{60'000'000'000};
 
 
@@ -128,7 +170,8 @@ namespace FG
 		// initialization //
 
 			// Creates the framegraph.
-		ND_ static FrameGraph		CreateFrameGraph (const DeviceInfo_t &);
+			// If 'scheduler' is not null then it will be used instead of internal thread pool.
+		ND_ static FrameGraph		CreateFrameGraph (const DeviceInfo_t &, const TaskScheduler &scheduler = null);
 
 			// Returns name and version number.
 		ND_ static const char*		GetVersion ();
@@ -149,6 +192,43 @@ namespace FG
 			// calling 'Task::EnableDebugTrace' and shader compiled with 'EShaderLangFormat::EnableDebugTrace' flag.
 			virtual bool			SetShaderDebugCallback (ShaderDebugCallback_t &&) = 0;
 
+			// Load driver pipeline cache from file, it will be shared between all command buffers.
+			// File is ignored if it was created on another device or driver version.
+			// Cache is saved in 'Deinitialize' and in background during 'Flush' when at least 'saveThreshold' pipelines have been created,
+			// zero threshold disables background saving.
+			// Must be called before pipelines are used in command buffers.
+			virtual bool			SetPipelineCacheFile (StringView filename, uint saveThreshold = 64) = 0;
+
+			// Save driver pipeline cache to the file that was specified in 'SetPipelineCacheFile'.
+			virtual bool			SavePipelineCache () = 0;
+
+			// Enable or disable asynchronous compilation of graphics pipelines.
+			// When pipeline instance for draw task is not created yet it will be compiled in background,
+			// until compilation is complete the draw call uses pipeline from 'SetFallbackPipeline' or will be skipped.
+			// 'onReady' is called on compilation thread when new pipeline instance is ready.
+			// Doesn't affect draw tasks with shader debugging, mesh and compute pipelines.
+			virtual bool			SetAsyncPipelineCompilation (bool enable, OnPipelineReady_t &&onReady = {}) = 0;
+
+			// Start recording of graphics pipeline instances to the manifest file, empty name stops recording.
+			// Previously recorded instances are loaded from the file, new instances are appended.
+			// Only pipelines with debug name and render passes with single subpass are recorded.
+			virtual bool			SetPipelineManifestFile (StringView filename) = 0;
+
+			// Save pipeline manifest to the file that was specified in 'SetPipelineManifestFile'.
+			virtual bool			SavePipelineManifest () = 0;
+
+			// Create all pipeline instances that are recorded in the manifest for specified pipelines,
+			// pipelines are matched by hash of description, not by name. Instances are compiled in parallel.
+			virtual bool			PrewarmPipelines (ArrayView<RawGPipelineID> pipelines) = 0;
+
+			// Create global update-after-bind descriptor set for all images, samplers and storage buffers.
+			// Must be called before pipelines are created, descriptors for already created resources are written too.
+			// Descriptor set with 'BindlessDesc::descriptorSet' name in pipelines will use global descriptor set and must not be passed in tasks.
+			// Bindless access is not tracked by framegraph, images are used in their default layout: sampled image binding is written
+			// only if default layout is read-only or general, storage image binding - only if default layout is general.
+			// Released resource and its index stay valid until all command buffers that were begun before release are complete.
+			virtual bool			EnableBindlessResources (const BindlessDesc &desc) = 0;
+
 			// Returns device info with which framegraph has been crated.
 		ND_ virtual DeviceInfo_t	GetDeviceInfo () const = 0;
 
@@ -213,6 +293,12 @@ namespace FG
 		//ND_ virtual SamplerDesc const&	GetDescription (RawSamplerID &id) const = 0;
 		ND_ virtual ExternalBufferDesc_t GetApiSpecificDescription (RawBufferID id) const = 0;
 		ND_ virtual ExternalImageDesc_t  GetApiSpecificDescription (RawImageID id) const = 0;
+
+			// Returns index of resource in bindless descriptor set, index is stable while resource is alive.
+			// Returns 'UMax' if bindless resources are not enabled or resource can not be used in bindless descriptor set.
+		ND_ virtual uint			GetBindlessIndex (RawImageID id) const = 0;
+		ND_ virtual uint			GetBindlessIndex (RawBufferID id) const = 0;
+		ND_ virtual uint			GetBindlessIndex (RawSamplerID id) const = 0;
 		
 			// Returns 'true' if resource is not deleted.
 		ND_	virtual bool			IsResourceAlive (RawGPipelineID id) const = 0;
@@ -255,6 +341,11 @@ namespace FG
 			// Compile framegraph for current command buffer and append it to the pending command buffer queue (that are waiting for submitting to GPU).
 			virtual bool			Execute (INOUT CommandBuffer &) = 0;
 
+			// Compile framegraph for current command buffer as a job in the task scheduler, 'onExecuted' will be called when command buffer is added to the pending queue.
+			// 'cmd' is reset immediately, you must wait for 'onExecuted' before calling 'Flush' or 'Wait'.
+			// Without task scheduler command buffer is executed synchronously.
+			virtual bool			Execute (INOUT CommandBuffer &cmd, OnExecuted_t &&onExecuted) = 0;
+
 			// Wait until all commands complete execution on the GPU or until time runs out.
 			virtual bool			Wait (ArrayView<CommandBuffer> commands, Nanoseconds timeout = MaxTimeout) = 0;
 
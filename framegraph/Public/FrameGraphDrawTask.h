@@ -186,6 +186,7 @@ namespace _fg_hidden_
 
 	// variables
 		RawGPipelineID			pipeline;
+		RawGPipelineID			fallbackPipeline;	// used while 'pipeline' is compiled asynchronously, must have same pipeline layout, see 'IFrameGraph::SetAsyncPipelineCompilation'
 		
 		VertexInputState		vertexInput;
 		Buffers_t				vertexBuffers;
@@ -200,6 +201,7 @@ namespace _fg_hidden_
 
 		TaskType&  SetTopology (EPrimitive value)					{ topology = value;  return static_cast<TaskType &>( *this ); }
 		TaskType&  SetPipeline (RawGPipelineID ppln)				{ ASSERT( ppln );  pipeline = ppln;  return static_cast<TaskType &>( *this ); }
+		TaskType&  SetFallbackPipeline (RawGPipelineID ppln)		{ ASSERT( ppln );  fallbackPipeline = ppln;  return static_cast<TaskType &>( *this ); }
 
 		TaskType&  SetVertexInput (const VertexInputState &value)	{ vertexInput = value;  return static_cast<TaskType &>( *this ); }
 		TaskType&  SetPrimitiveRestartEnabled (bool value)			{ primitiveRestart = value;  return static_cast<TaskType &>( *this ); }
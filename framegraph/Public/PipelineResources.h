@@ -148,6 +148,7 @@ namespace FG
 			UniformID		id;
 			EDescriptorType	resType		= Default;
 			uint16_t		offset		= 0;
+			HashVal			hash;					// hash of uniform id and resources, updated when resources are changed
 
 			// for sorting and searching
 			ND_ bool  operator == (const UniformID &rhs) const	{ return id == rhs; }
@@ -162,6 +163,7 @@ namespace FG
 			uint						dynamicOffsetsCount	= 0;
 			uint						dynamicOffsetsOffset= 0;
 			BytesU						memSize;
+			HashVal						hash;			// combination of all uniform hashes
 
 			DynamicData () {}
 
@@ -169,8 +171,11 @@ namespace FG
 			ND_ Uniform	const*	Uniforms ()			const	{ return Cast<Uniform>(this + BytesU{uniformsOffset}); }
 			ND_ uint*			DynamicOffsets ()			{ return Cast<uint>(this + BytesU{dynamicOffsetsOffset}); }
 
+			ND_ HashVal			GetHash ()			const	{ return hash; }
 			ND_ HashVal			CalcHash () const;
 			ND_ bool			operator == (const DynamicData &) const;
+
+				void			UpdateHash (INOUT Uniform &);
 				
 			template <typename T, typename Fn>	static void  _ForEachUniform (T&&, Fn &&);
 			template <typename Fn>				void ForEachUniform (Fn&& fn)				{ _ForEachUniform( *this, fn ); }
@@ -265,7 +270,9 @@ namespace FG
 
 		ND_ uint &					_GetDynamicOffset (uint i)		{ ASSERT( _dataPtr and i < _dataPtr->dynamicOffsetsCount );  return _dataPtr->DynamicOffsets()[i]; }
 
-		template <typename T> T *	_GetResource (const UniformID &id);
+		template <typename T> T *	_GetResource (const UniformID &id, OUT Uniform* &un);
+
+		void  _OnChanged (Uniform &un)								{ _ResetCachedID();  _dataPtr->UpdateHash( INOUT un ); }
 		template <typename T> bool	_HasResource (const UniformID &id) const;
 	};
 
@@ -52,6 +52,8 @@ namespace FG
 		Dedicated		= 1 << 2,		// force to use dedicated allocation
 		//AllowAliasing	= 1 << 3,		// 
 		//Sparse		= 1 << 4,
+		LazilyAllocated	= 1 << 5,		// tile memory that is allocated on demand, only for images with 'EImageUsage::TransientAttachment',
+										// device local memory is used if lazily allocated memory is not supported
 		_Last,
 	};
 	FG_BIT_OPERATORS( EMemoryType );
@@ -0,0 +1,42 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	ITaskScheduler allows to integrate FrameGraph into the engine's job system.
+	Pass it to IFrameGraph::CreateFrameGraph() then FrameGraph will use it instead of internal thread pool.
+*/
+
+#pragma once
+
+#include "framegraph/Public/Types.h"
+
+namespace FG
+{
+
+	//
+	// Task Scheduler interface
+	//
+
+	class ITaskScheduler
+	{
+	// types
+	public:
+		using Job_t			= std::function< void () >;
+		using ParallelJob_t	= std::function< void (uint jobIndex, uint workerIndex) >;
+
+
+	// interface
+	public:
+		virtual ~ITaskScheduler () {}
+
+			// Returns max number of jobs that can be executed at the same time.
+		ND_ virtual uint  WorkerCount () = 0;
+
+			// Run job asynchronously.
+			virtual void  Enqueue (Job_t &&job) = 0;
+
+			// Run 'job' for each index in range [0, count) and wait until all jobs are complete.
+			// Jobs that are executed at the same time must have different 'workerIndex' that is less than 'WorkerCount()'.
+			// Calling thread should take part in execution instead of blocking.
+			virtual void  ParallelFor (uint count, const ParallelJob_t &job) = 0;
+	};
+
+}	// FG
@@ -31,6 +31,7 @@ namespace FG
 
 	using PipelineCompiler	= SharedPtr< class IPipelineCompiler >;
 	using FrameGraph		= SharedPtr< class IFrameGraph >;
+	using TaskScheduler		= SharedPtr< class ITaskScheduler >;
 
 	using Task				= Ptr< class IFrameGraphTask >;
 	
@@ -62,6 +62,10 @@ namespace FG
 
 		BytesU				maxStagingBufferMemory	= ~0_b;	// you can limit max size of host visible memory that may be used by FrameGraph, by default used max available size.
 		BytesU				stagingBufferSize		= 0_b;	// max size of single staging buffer (needed for tests), 0 - auto
+
+		BytesU				maxRetainedMemory		= 256_Mb;	// memory of destroyed images and buffers is kept for reuse to avoid frequent memory page reallocation, 0 - disabled.
+																// enabled by default, retained memory is still allocated on the device, so decrease it if device memory is low.
+		uint				retainedMemoryLifetime	= 8;		// retained memory is released after this number of submissions.
 	};
 
 
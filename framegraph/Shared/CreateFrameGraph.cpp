@@ -14,17 +14,17 @@ namespace FG
 	CreateFrameGraph
 =================================================
 */
-	FrameGraph  IFrameGraph::CreateFrameGraph (const DeviceInfo_t &ci)
+	FrameGraph  IFrameGraph::CreateFrameGraph (const DeviceInfo_t &ci, const TaskScheduler &scheduler)
 	{
 		FrameGraph	result = Visit( ci,
 
 			#ifdef FG_ENABLE_VULKAN
-				[] (const VulkanDeviceInfo &vdi) -> FrameGraph
+				[&scheduler] (const VulkanDeviceInfo &vdi) -> FrameGraph
 				{
 					CHECK_ERR( vdi.instance and vdi.physicalDevice and vdi.device and not vdi.queues.empty() );
 					CHECK_ERR( VulkanLoader::Initialize() );
 
-					auto  fg = MakeShared<VFrameGraph>( vdi );
+					auto  fg = MakeShared<VFrameGraph>( vdi, scheduler );
 					CHECK_ERR( fg->Initialize() );
 
 					return fg;
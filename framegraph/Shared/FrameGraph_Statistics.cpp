@@ -14,7 +14,12 @@ namespace FG
 	{
 		dst.descriptorBinds				+= src.descriptorBinds;
 		dst.pushConstants				+= src.pushConstants;
+		dst.pushDescriptors				+= src.pushDescriptors;
 		dst.pipelineBarriers			+= src.pipelineBarriers;
+		dst.emittedBarriers				+= src.emittedBarriers;
+		dst.mergedBarriers				+= src.mergedBarriers;
+		dst.skippedBarriers				+= src.skippedBarriers;
+		dst.splitBarriers				+= src.splitBarriers;
 		dst.transferOps					+= src.transferOps;
 
 		dst.indexBufferBindings			+= src.indexBufferBindings;
@@ -25,6 +30,8 @@ namespace FG
 		dst.primitiveCount				+= src.primitiveCount;
 		dst.graphicsPipelineBindings	+= src.graphicsPipelineBindings;
 		dst.dynamicStateChanges			+= src.dynamicStateChanges;
+		dst.fallbackDrawCalls			+= src.fallbackDrawCalls;
+		dst.skippedDrawCalls			+= src.skippedDrawCalls;
 		
 		dst.dispatchCalls				+= src.dispatchCalls;
 		dst.computePipelineBindings		+= src.computePipelineBindings;
@@ -47,6 +54,17 @@ namespace FG
 		dst.newComputePipelineCount		+= src.newComputePipelineCount;
 		dst.newGraphicsPipelineCount	+= src.newGraphicsPipelineCount;
 		dst.newRayTracingPipelineCount	+= src.newRayTracingPipelineCount;
+		dst.asyncGraphicsPipelineCount	+= src.asyncGraphicsPipelineCount;
+		dst.transientDescriptorSets		+= src.transientDescriptorSets;
+		dst.retainedMemoryHits			+= src.retainedMemoryHits;
+		dst.retainedMemoryMisses		+= src.retainedMemoryMisses;
+		dst.retainedMemorySize			 = Max( dst.retainedMemorySize, src.retainedMemorySize );
+		dst.transientImages				+= src.transientImages;
+		dst.transientImageMemory		+= src.transientImageMemory;
+		dst.transientHeapMemory			+= src.transientHeapMemory;
+		dst.lazyAllocRequestedImages	+= src.lazyAllocRequestedImages;
+		dst.lazilyAllocatedImages		+= src.lazilyAllocatedImages;
+		dst.pipelineCacheHits			+= src.pipelineCacheHits;
 	}
 
 /*
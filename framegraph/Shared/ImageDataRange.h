@@ -5,6 +5,7 @@
 #include "framegraph/Shared/ResourceDataRange.h"
 #include "framegraph/Public/ImageLayer.h"
 #include "framegraph/Public/MipmapLevel.h"
+#include "stl/Math/Rectangle.h"
 
 namespace FG
 {
@@ -24,11 +25,14 @@ namespace FG
 	private:
 		using RangeU		= ResourceDataRange< uint >;
 
+		static constexpr RectU	WholeRegion	{ 0, 0, UMax, UMax };
+
 
 	// variables
 	private:
 		RangeU		_layers;
 		RangeU		_mipmaps;
+		RectU		_region		= WholeRegion;		// 2D region in each layer and mipmap level
 
 
 	// methods
@@ -45,29 +49,40 @@ namespace FG
 			_mipmaps = RangeU{ 0, levelCount } + baseLevel.Get();
 		}
 
+		ImageDataRange (ImageLayer baseLayer, uint layerCount, MipmapLevel baseLevel, uint levelCount, const RectU &region) :
+			ImageDataRange{ baseLayer, layerCount, baseLevel, levelCount }
+		{
+			_region = region;
+		}
+
 		ND_ RangeU const&	Layers ()						const	{ return _layers; }
 		ND_ RangeU const&	Mipmaps ()						const	{ return _mipmaps; }
+		ND_ RectU const&	Region ()						const	{ return _region; }
 		
 		ND_ bool		IsWholeLayers ()					const	{ return _layers.IsWhole(); }
 		ND_ bool		IsWholeMipmaps ()					const	{ return _mipmaps.IsWhole(); }
+		ND_ bool		IsWholeRegion ()					const	{ return All( _region == WholeRegion ); }
 		
-		ND_ bool		IsEmpty ()							const	{ return _layers.IsEmpty() or _mipmaps.IsEmpty(); }
+		ND_ bool		IsEmpty ()							const	{ return _layers.IsEmpty() or _mipmaps.IsEmpty() or _region.IsEmpty(); }
 		
-		ND_ bool		operator == (const Self &rhs)		const	{ return _layers == rhs._layers and _mipmaps == rhs._mipmaps; }
+		ND_ bool		operator == (const Self &rhs)		const	{ return _layers == rhs._layers and _mipmaps == rhs._mipmaps and All( _region == rhs._region ); }
 		ND_ bool		operator != (const Self &rhs)		const	{ return not (*this == rhs); }
 
 
 		ND_ Self		Intersect (const Self &other)		const
 		{
 			RangeU	layers = _layers.Intersect( other._layers );
-			return Self{ layers, layers.IsEmpty() ? RangeU() : _mipmaps.Intersect( other._mipmaps ) };
+			Self	result { layers, layers.IsEmpty() ? RangeU() : _mipmaps.Intersect( other._mipmaps )};
+			result._region = _region.Intersection( other._region );
+			return result;
 		}
 
 
 		ND_ bool		IsIntersects (const Self &other)	const
 		{
 			return	_layers.IsIntersects( other._layers ) and
-					_mipmaps.IsIntersects( other._mipmaps );
+					_mipmaps.IsIntersects( other._mipmaps ) and
+					_region.Intersects( other._region );
 		}
 	};
 
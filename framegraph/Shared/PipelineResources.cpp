@@ -166,10 +166,12 @@ namespace FG
 =================================================
 */
 	template <typename T>
-	ND_ inline T*  PipelineResources::_GetResource (const UniformID &id)
+	ND_ inline T*  PipelineResources::_GetResource (const UniformID &id, OUT Uniform* &un)
 	{
 		SHAREDLOCK( _drCheck );
 		
+		un = null;
+
 		if ( _dataPtr )
 		{
 			auto*	uniforms = _dataPtr->Uniforms();
@@ -177,10 +179,10 @@ namespace FG
 		
 			if ( index < _dataPtr->uniformCount )
 			{
-				auto&	un = uniforms[ index ];
-				ASSERT( un.resType == T::TypeId );
+				un = &uniforms[ index ];
+				ASSERT( un->resType == T::TypeId );
 
-				return Cast<T>( _dataPtr.get() + BytesU{un.offset} );
+				return Cast<T>( _dataPtr.get() + BytesU{un->offset} );
 			}
 		}
 		return null;
@@ -225,17 +227,20 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasImage( id ));
 
-		if ( auto* res = _GetResource<Image>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Image>( id, OUT un ))
 		{
 			auto&	img = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
 
-			if ( img.imageId != image or img.hasDesc or res->elementCount <= index )
-				_ResetCachedID();
+			const bool	changed = (img.imageId != image or img.hasDesc or res->elementCount <= index);
 		
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			img.imageId			= image;
 			img.hasDesc			= false;
+
+			if ( changed )
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -245,18 +250,21 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasImage( id ));
 
-		if ( auto* res = _GetResource<Image>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Image>( id, OUT un ))
 		{
 			auto&	img = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
 
-			if ( img.imageId != image or not img.hasDesc or not (img.desc == desc) or res->elementCount <= index )
-				_ResetCachedID();
+			const bool	changed = (img.imageId != image or not img.hasDesc or not (img.desc == desc) or res->elementCount <= index);
 		
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			img.imageId			= image;
 			img.desc			= desc;
 			img.hasDesc			= true;
+
+			if ( changed )
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -271,7 +279,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasImage( id ));
 
-		if ( auto* res = _GetResource<Image>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Image>( id, OUT un ))
 		{
 			bool	changed	= res->elementCount != images.size();
 		
@@ -289,7 +298,7 @@ namespace FG
 			}
 
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -310,18 +319,21 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexture( id ));
 
-		if ( auto* res = _GetResource<Texture>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Texture>( id, OUT un ))
 		{
 			auto&	tex = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
 
-			if ( tex.imageId != image or tex.samplerId != sampler or tex.hasDesc or res->elementCount <= index )
-				_ResetCachedID();
+			const bool	changed = (tex.imageId != image or tex.samplerId != sampler or tex.hasDesc or res->elementCount <= index);
 		
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			tex.imageId			= image;
 			tex.samplerId		= sampler;
 			tex.hasDesc			= false;
+
+			if ( changed )
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -331,19 +343,22 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexture( id ));
 
-		if ( auto* res = _GetResource<Texture>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Texture>( id, OUT un ))
 		{
 			auto&	tex = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
 
-			if ( tex.imageId != image or tex.samplerId != sampler or not tex.hasDesc or not (tex.desc == desc) or res->elementCount <= index )
-				_ResetCachedID();
+			const bool	changed = (tex.imageId != image or tex.samplerId != sampler or not tex.hasDesc or not (tex.desc == desc) or res->elementCount <= index);
 		
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			tex.imageId			= image;
 			tex.samplerId		= sampler;
 			tex.desc			= desc;
 			tex.hasDesc			= true;
+
+			if ( changed )
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -364,7 +379,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexture( id ));
 
-		if ( auto* res = _GetResource<Texture>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Texture>( id, OUT un ))
 		{
 			bool	changed = res->elementCount != images.size();
 
@@ -383,7 +399,7 @@ namespace FG
 			}
 
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -398,16 +414,19 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasSampler( id ));
 
-		if ( auto* res = _GetResource<Sampler>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Sampler>( id, OUT un ))
 		{
 			auto&	samp = res->elements[ index ];
 			ASSERT( index < res->elementCapacity );
 
-			if ( samp.samplerId != sampler or res->elementCount <= index )
-				_ResetCachedID();
+			const bool	changed = (samp.samplerId != sampler or res->elementCount <= index);
 		
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			samp.samplerId		= sampler;
+
+			if ( changed )
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -428,7 +447,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasSampler( id ));
 
-		if ( auto* res = _GetResource<Sampler>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Sampler>( id, OUT un ))
 		{
 			bool	changed = res->elementCount != samplers.size();
 		
@@ -445,7 +465,7 @@ namespace FG
 			}
 
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -465,7 +485,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasBuffer( id ));
 
-		if ( auto* res = _GetResource<Buffer>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Buffer>( id, OUT un ))
 		{
 			auto&	buf	= res->elements[ index ];
 
@@ -485,12 +506,12 @@ namespace FG
 				_GetDynamicOffset( res->dynamicOffsetIndex + index ) = uint(offset - buf.offset);
 			}
 		
-			if ( changed )
-				_ResetCachedID();
-		
 			res->elementCount	= Max( uint16_t(index+1), res->elementCount );
 			buf.bufferId		= buffer;
 			buf.size			= size;
+		
+			if ( changed )
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -510,8 +531,9 @@ namespace FG
 	{
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasBuffer( id ));
-		
-		if ( auto* res = _GetResource<Buffer>( id ))
+
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Buffer>( id, OUT un ))
 		{
 			bool	changed = res->elementCount != buffers.size();
 			BytesU	offset	= 0_b;
@@ -542,7 +564,7 @@ namespace FG
 			}
 		
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -557,7 +579,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasBuffer( id ));
 
-		if ( auto* res = _GetResource<Buffer>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<Buffer>( id, OUT un ))
 		{
 			auto&	buf		= res->elements[ index ];
 			bool	changed	= res->elementCount <= index;
@@ -573,7 +596,7 @@ namespace FG
 			}
 		
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -588,7 +611,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasTexelBuffer( name ));
 
-		if ( auto* res = _GetResource<TexelBuffer>( name ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<TexelBuffer>( name, OUT un ))
 		{
 			auto&	texbuf  = res->elements[ index ];
 			bool	changed	= res->elementCount <= index;
@@ -602,7 +626,7 @@ namespace FG
 			texbuf.desc		= desc;
 			
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -617,7 +641,8 @@ namespace FG
 		EXLOCK( _drCheck );
 		UNIFORM_EXISTS( HasRayTracingScene( id ));
 
-		if ( auto* res = _GetResource<RayTracingScene>( id ))
+		Uniform*	un = null;
+		if ( auto* res = _GetResource<RayTracingScene>( id, OUT un ))
 		{
 			auto&	rts		= res->elements[ index ];
 			bool	changed	= (res->elementCount <= index) or (rts.sceneId != scene);
@@ -628,7 +653,7 @@ namespace FG
 			rts.sceneId			= scene;
 
 			if ( changed )
-				_ResetCachedID();
+				_OnChanged( *un );
 		}
 		return *this;
 	}
@@ -665,7 +690,7 @@ namespace FG
 		}
 		END_ENUM_CHECKS();
 		
-		_ResetCachedID();
+		_OnChanged( un );
 	}
 	
 /*
@@ -679,6 +704,10 @@ namespace FG
 		CHECK_ERRV( _dataPtr );
 
 		_dataPtr->ForEachUniform( [](auto&, auto& data) { data.elementCount = 0; });
+
+		for (uint i = 0; i < _dataPtr->uniformCount; ++i) {
+			_dataPtr->UpdateHash( INOUT _dataPtr->Uniforms()[i] );
+		}
 		_ResetCachedID();
 	}
 //-----------------------------------------------------------------------------
@@ -833,17 +862,68 @@ namespace {
 		Allocator::Deallocate( ptr, ptr->memSize );
 	}
 
+/*
+=================================================
+	CalcUniformHash
+=================================================
+*/
+namespace {
+	ND_ HashVal  CalcUniformHash (const PipelineResources::DynamicData &data, const PipelineResources::Uniform &un)
+	{
+		using EDescriptorType = PipelineResources::EDescriptorType;
+
+		void const*	ptr		= (&data + BytesU{un.offset});
+		HashVal		result	= HashOf( un.id );
+
+		BEGIN_ENUM_CHECKS();
+		switch ( un.resType )
+		{
+			case EDescriptorType::Unknown :			break;
+			case EDescriptorType::Buffer :			result << HashOf( *Cast<PipelineResources::Buffer>(ptr) );			break;
+			case EDescriptorType::TexelBuffer :		result << HashOf( *Cast<PipelineResources::TexelBuffer>(ptr) );		break;
+			case EDescriptorType::SubpassInput :
+			case EDescriptorType::Image :			result << HashOf( *Cast<PipelineResources::Image>(ptr) );			break;
+			case EDescriptorType::Texture :			result << HashOf( *Cast<PipelineResources::Texture>(ptr) );			break;
+			case EDescriptorType::Sampler :			result << HashOf( *Cast<PipelineResources::Sampler>(ptr) );			break;
+			case EDescriptorType::RayTracingScene :	result << HashOf( *Cast<PipelineResources::RayTracingScene>(ptr) );	break;
+		}
+		END_ENUM_CHECKS();
+
+		return result;
+	}
+}	// namespace
+
 /*
 =================================================
 	CalcHash
+----
+	recalculate hash of all uniforms, result must be same as 'hash'.
 =================================================
 */
 	HashVal  PipelineResources::DynamicData::CalcHash () const
 	{
 		HashVal	result;
-		ForEachUniform( [&result] (const UniformID &id, auto& res) { result << HashOf(id) << HashOf(res); });
+		for (uint i = 0; i < uniformCount; ++i) {
+			result << CalcUniformHash( *this, Uniforms()[i] );
+		}
 		return result;
 	}
+	
+/*
+=================================================
+	UpdateHash
+----
+	'hash' is a XOR of uniform hashes (see 'HashVal::operator <<'),
+	so previous uniform hash is removed by combining it again.
+=================================================
+*/
+	void  PipelineResources::DynamicData::UpdateHash (INOUT Uniform &un)
+	{
+		const HashVal	new_hash = CalcUniformHash( *this, un );
+
+		hash << un.hash << new_hash;
+		un.hash = new_hash;
+	}
 
 /*
 =================================================
@@ -854,7 +934,8 @@ namespace {
 	{
 		auto&	lhs = *this;
 
-		if ( lhs.layoutId		!= rhs.layoutId		and
+		if ( lhs.hash			!= rhs.hash			or
+			 lhs.layoutId		!= rhs.layoutId		or
 			 lhs.uniformCount	!= rhs.uniformCount	)
 			return false;
 
@@ -866,7 +947,8 @@ namespace {
 			void const*	rhs_ptr = (&rhs + BytesU{rhs_un.offset});
 			bool		equals	= true;
 
-			if ( lhs_un.id		!= rhs_un.id	or
+			if ( lhs_un.hash	!= rhs_un.hash	or
+				 lhs_un.id		!= rhs_un.id	or
 				 lhs_un.resType != rhs_un.resType )
 				return false;
 
@@ -1065,6 +1147,10 @@ namespace {
 		std::sort( uniforms_ptr, uniforms_ptr + data->uniformCount,
 				   [] (auto& lhs, auto& rhs) { return lhs.id < rhs.id; });
 
+		for (uint i = 0; i < data->uniformCount; ++i) {
+			data->UpdateHash( INOUT uniforms_ptr[i] );
+		}
+
 		ASSERT( dbo_count == bufferDynamicOffsetCount );
 		return DynamicDataPtr{ data };
 	}
@@ -25,6 +25,12 @@ namespace FG
 		ND_ static DynamicDataPtr  CloneDynamicData (const PipelineResources &);
 		ND_ static DynamicDataPtr  RemoveDynamicData (INOUT PipelineResources &);
 
+		ND_ static DynamicData const*  GetDynamicData (const PipelineResources &res)
+		{
+			SHAREDLOCK( res._drCheck );
+			return res._dataPtr.get();
+		}
+
 		static bool Initialize (OUT PipelineResources &, RawDescriptorSetLayoutID layoutId, const DynamicDataPtr &);
 
 		ND_ static RawPipelineResourcesID  GetCached (const PipelineResources &res)
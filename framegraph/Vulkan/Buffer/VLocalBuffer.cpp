@@ -24,7 +24,7 @@ namespace FG
 	Create
 =================================================
 */
-	bool VLocalBuffer::Create (const VBuffer *bufferData)
+	bool VLocalBuffer::Create (const VBuffer *bufferData, Allocator_t &allocator)
 	{
 		CHECK_ERR( _bufferData == null );
 		CHECK_ERR( bufferData );
@@ -32,6 +32,9 @@ namespace FG
 		_bufferData		= bufferData;
 		_isImmutable	= _bufferData->IsReadOnly();
 
+		_accessForWrite.emplace( RecordAllocator_t{ allocator });
+		_accessForRead.emplace( RecordAllocator_t{ allocator });
+
 		return true;
 	}
 	
@@ -46,12 +49,14 @@ namespace FG
 
 		// check for uncommited barriers
 		ASSERT( _pendingAccesses.empty() );
-		ASSERT( _accessForWrite.empty() );
-		ASSERT( _accessForRead.empty() );
+		ASSERT( not _accessForWrite or _accessForWrite->empty() );
+		ASSERT( not _accessForRead or _accessForRead->empty() );
 
 		_pendingAccesses.clear();
-		_accessForWrite.clear();
-		_accessForRead.clear();
+
+		// memory of access records will be discarded by the command buffer, so destroy them now
+		_accessForWrite.reset();
+		_accessForRead.reset();
 	}
 
 /*
@@ -59,8 +64,8 @@ namespace FG
 	_FindFirstAccess
 =================================================
 */
-	inline VLocalBuffer::AccessIter_t
-		VLocalBuffer::_FindFirstAccess (AccessRecords_t &arr, const BufferRange &otherRange)
+	inline VLocalBuffer::PendingIter_t
+		VLocalBuffer::_FindFirstAccess (PendingAccesses_t &arr, const BufferRange &otherRange)
 	{
 		size_t	left	= 0;
 		size_t	right	= arr.size();
@@ -81,134 +86,88 @@ namespace FG
 		return arr.end();
 	}
 	
+	inline VLocalBuffer::AccessIter_t
+		VLocalBuffer::_FindFirstAccess (AccessRecords_t &arr, const BufferRange &otherRange)
+	{
+		// records don't overlap, so 'range.end' is sorted too
+		auto	iter = arr.upper_bound( otherRange.begin );
+
+		if ( iter != arr.begin() )
+		{
+			auto	prev = std::prev( iter );
+
+			if ( prev->second.range.end >= otherRange.begin )
+				return prev;
+		}
+		return iter;
+	}
+	
 /*
 =================================================
 	_ReplaceAccessRecords
 =================================================
 */
-	inline void VLocalBuffer::_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferAccess &barrier)
+	inline void VLocalBuffer::_ReplaceAccessRecords (INOUT AccessRecords_t &arr, const BufferAccess &barrier)
 	{
-		ASSERT( iter >= arr.begin() and iter <= arr.end() );
-
-		bool replaced = false;
-
-		for (; iter != arr.end();)
-		{
-			if ( iter->range.begin <  barrier.range.begin and
-				 iter->range.end   <= barrier.range.end )
-			{
-				//	|1111111|22222|
-				//     |bbbbb|			+
-				//  |11|....			=
-				iter->range.end = barrier.range.begin;
-				++iter;
-				continue;
-			}
-
-			if ( iter->range.begin < barrier.range.begin and
-				 iter->range.end   > barrier.range.end )
-			{
-				//  |111111111111111|
-				//      |bbbbb|			+
-				//  |111|bbbbb|11111|	=
-
-				const auto	src = *iter;
-
-				iter->range.end = barrier.range.begin;
-
-				iter = arr.insert( iter+1, barrier );
-				replaced = true;
-
-				iter = arr.insert( iter+1, src );
+		auto	iter = _EraseAccessRecords( arr, barrier.range );
 
-				iter->range.begin = barrier.range.end;
-				break;
-			}
-
-			if ( iter->range.begin >= barrier.range.begin and
-				 iter->range.begin <  barrier.range.end )
-			{
-				if ( iter->range.end > barrier.range.end )
-				{
-					//  ...|22222222222|
-					//   |bbbbbbb|			+
-					//  ...bbbbbb|22222|	=
-					iter->range.begin = barrier.range.end;
-
-					if ( not replaced )
-					{
-						arr.insert( iter, barrier );
-						replaced = true;
-					}
-					break;
-				}
-
-				if ( replaced )
-				{
-					//  ...|22222|33333|
-					//   |bbbbbbbbbbb|		+
-					//  ...|bbbbbbbbb|...	=
-					iter = arr.erase( iter );
-				}
-				else
-				{
-					*iter = barrier;
-					++iter;
-					replaced = true;
-				}
-				continue;
-			}
-
-			break;
-		}
-			
-		if ( not replaced )
-		{
-			arr.insert( iter, barrier );
-		}
+		arr.emplace_hint( iter, barrier.range.begin, barrier );
 	}
 	
 /*
 =================================================
 	_EraseAccessRecords
+----
+	returns position where the range was
 =================================================
 */
 	inline VLocalBuffer::AccessIter_t
-		VLocalBuffer::_EraseAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferRange &range)
+		VLocalBuffer::_EraseAccessRecords (INOUT AccessRecords_t &arr, const BufferRange &range)
 	{
-		if ( arr.empty() )
-			return iter;
+		auto	iter = _FindFirstAccess( arr, range );
 
-		ASSERT( iter >= arr.begin() and iter <= arr.end() );
-
-		for (; iter != arr.end();)
+		for (; iter != arr.end() and iter->second.range.begin < range.end;)
 		{
-			if ( iter->range.begin < range.begin and
-				 iter->range.end   > range.end )
+			auto&	rec = iter->second;
+
+			if ( rec.range.begin < range.begin and
+				 rec.range.end   > range.end )
 			{
-				const auto	src = *iter;
-				iter->range.end = range.begin;
+				//  |111111111111111|
+				//      |rrrrr|			-
+				//  |111|     |11111|	=
+				BufferAccess	src = rec;
+				rec.range.end	 = range.begin;
+				src.range.begin	 = range.end;
 
-				iter = arr.insert( iter+1, src );
-				iter->range.begin = range.end;
-				break;
+				return arr.emplace_hint( std::next(iter), src.range.begin, src );
 			}
 
-			if ( iter->range.begin < range.begin )
+			if ( rec.range.begin < range.begin )
 			{
-				ASSERT( iter->range.end >= range.begin );
+				//	|1111111|22222|
+				//     |rrrrr|			-
+				//  |11|  ...			=
+				ASSERT( rec.range.end >= range.begin );
 
-				iter->range.end = range.begin;
+				rec.range.end = range.begin;
 				++iter;
 				continue;
 			}
 
-			if ( iter->range.end > range.end )
+			if ( rec.range.end > range.end )
 			{
-				ASSERT( iter->range.begin <= range.end );
+				//  ...|22222222222|
+				//   |rrrrrrr|			-
+				//  ...      |22222|	=
+				ASSERT( rec.range.begin <= range.end );
 
-				iter->range.begin = range.end;
-				break;
+				// key is changed without reallocation
+				auto	node = arr.extract( iter++ );
+				node.key()					= range.end;
+				node.mapped().range.begin	= range.end;
+
+				return arr.insert( iter, std::move(node) );
 			}
 
 			iter = arr.erase( iter );
@@ -226,8 +185,8 @@ namespace FG
 	{
 		// buffer must be in initial state
 		ASSERT( _pendingAccesses.empty() );
-		ASSERT( _accessForWrite.empty() );
-		ASSERT( _accessForRead.empty() );
+		ASSERT( _accessForWrite->empty() );
+		ASSERT( _accessForRead->empty() );
 
 		_isImmutable = immutable;
 	}
@@ -316,8 +275,8 @@ namespace FG
 		CommitBarrier( barrierMngr, debugger );
 
 		// flush
-		_accessForWrite.clear();
-		_accessForRead.clear();
+		_accessForWrite->clear();
+		_accessForRead->clear();
 	}
 
 /*
@@ -345,61 +304,66 @@ namespace FG
 				barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 				barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
 
-				barrierMngr.AddBufferBarrier( src.stages, dst.stages, barrier );
+				auto*	split = barrierMngr.FindEvent( src.index, dst.index, src.stages );
+
+				barrierMngr.AddBufferBarrier( src.stages, dst.stages, barrier, split );
 
 				if ( debugger ) {
-					debugger->AddBufferBarrier( _bufferData.get(), src.index, dst.index, src.stages, dst.stages, 0, barrier );
+					debugger->AddBufferBarrier( _bufferData.get(), src.index, dst.index, src.stages, dst.stages, 0, barrier, split != null );
 				}
 			}
 		};
 
+		auto&	write_records	= *_accessForWrite;
+		auto&	read_records	= *_accessForRead;
+
 		for (const auto& pending : _pendingAccesses)
 		{
-			const auto	w_iter	= _FindFirstAccess( _accessForWrite, pending.range );
-			const auto	r_iter	= _FindFirstAccess( _accessForRead, pending.range );
+			const auto	w_iter	= _FindFirstAccess( write_records, pending.range );
+			const auto	r_iter	= _FindFirstAccess( read_records, pending.range );
 
 			if ( pending.isWritable )
 			{
 				// write -> write, read -> write barriers
 				bool	ww_barrier	= true;
 
-				if ( w_iter != _accessForWrite.end() and r_iter != _accessForRead.end() )
+				if ( w_iter != write_records.end() and r_iter != read_records.end() )
 				{
-					ww_barrier = (w_iter->index >= r_iter->index);
+					ww_barrier = (w_iter->second.index >= r_iter->second.index);
 				}
 
-				if ( ww_barrier and w_iter != _accessForWrite.end() )
+				if ( ww_barrier and w_iter != write_records.end() )
 				{
 					// write -> write barrier
-					for (auto iter = w_iter; iter != _accessForWrite.end() and iter->range.begin < pending.range.end; ++iter)
+					for (auto iter = w_iter; iter != write_records.end() and iter->second.range.begin < pending.range.end; ++iter)
 					{
-						AddBarrier( iter->range.Intersect( pending.range ), *iter, pending );
+						AddBarrier( iter->second.range.Intersect( pending.range ), iter->second, pending );
 					}
 				}
 				else
-				if ( r_iter != _accessForRead.end() )
+				if ( r_iter != read_records.end() )
 				{
 					// read -> write barrier
-					for (auto iter = r_iter; iter != _accessForRead.end() and iter->range.begin < pending.range.end; ++iter)
+					for (auto iter = r_iter; iter != read_records.end() and iter->second.range.begin < pending.range.end; ++iter)
 					{
-						AddBarrier( iter->range.Intersect( pending.range ), *iter, pending );
+						AddBarrier( iter->second.range.Intersect( pending.range ), iter->second, pending );
 					}
 				}
 				
 				// store to '_accessForWrite'
-				_ReplaceAccessRecords( _accessForWrite, w_iter, pending );
-				_EraseAccessRecords( _accessForRead, r_iter, pending.range );
+				_ReplaceAccessRecords( write_records, pending );
+				_EraseAccessRecords( read_records, pending.range );
 			}
 			else
 			{
 				// write -> read barrier only
-				for (auto iter = w_iter; iter != _accessForWrite.end() and iter->range.begin < pending.range.end; ++iter)
+				for (auto iter = w_iter; iter != write_records.end() and iter->second.range.begin < pending.range.end; ++iter)
 				{
-					AddBarrier( iter->range.Intersect( pending.range ), *iter, pending );
+					AddBarrier( iter->second.range.Intersect( pending.range ), iter->second, pending );
 				}
 
 				// store to '_accessForRead'
-				_ReplaceAccessRecords( _accessForRead, r_iter, pending );
+				_ReplaceAccessRecords( read_records, pending );
 			}
 		}
 
@@ -5,6 +5,9 @@
 #include "framegraph/Public/EResourceState.h"
 #include "framegraph/Shared/ResourceDataRange.h"
 #include "VBuffer.h"
+#include "stl/Memory/LinearAllocator.h"
+#include "stl/Containers/Optional.h"
+#include <map>
 
 namespace FG
 {
@@ -19,7 +22,8 @@ namespace FG
 
 	// types
 	public:
-		using BufferRange = ResourceDataRange< VkDeviceSize >;
+		using BufferRange	= ResourceDataRange< VkDeviceSize >;
+		using Allocator_t	= LinearAllocator<>;
 		
 		struct BufferState
 		{
@@ -50,18 +54,23 @@ namespace FG
 			BufferAccess () : isReadable{false}, isWritable{false} {}
 		};
 
-		using AccessRecords_t	= Array< BufferAccess >;	// TODO: fixed size array or custom allocator
+		using PendingAccesses_t	= Array< BufferAccess >;
+		using PendingIter_t		= PendingAccesses_t::iterator;
+
+		// non-overlapping ranges sorted by 'range.begin', memory is allocated by command buffer
+		using RecordAllocator_t	= StdLinearAllocator< Pair< const VkDeviceSize, BufferAccess >>;
+		using AccessRecords_t	= std::map< VkDeviceSize, BufferAccess, std::less<VkDeviceSize>, RecordAllocator_t >;
 		using AccessIter_t		= AccessRecords_t::iterator;
 
 
 	// variables
 	private:
-		Ptr<VBuffer const>			_bufferData;	// readonly access is thread safe
+		Ptr<VBuffer const>					_bufferData;	// readonly access is thread safe
 
-		mutable AccessRecords_t		_pendingAccesses;
-		mutable AccessRecords_t		_accessForWrite;
-		mutable AccessRecords_t		_accessForRead;
-		mutable bool				_isImmutable	= false;
+		mutable PendingAccesses_t			_pendingAccesses;
+		mutable Optional<AccessRecords_t>	_accessForWrite;
+		mutable Optional<AccessRecords_t>	_accessForRead;
+		mutable bool						_isImmutable	= false;
 
 
 	// methods
@@ -71,7 +80,7 @@ namespace FG
 		VLocalBuffer (const VLocalBuffer &) = delete;
 		~VLocalBuffer ();
 
-		bool Create (const VBuffer *);
+		bool Create (const VBuffer *, Allocator_t &);
 		void Destroy ();
 		
 		void SetInitialState (bool immutable) const;
@@ -90,9 +99,10 @@ namespace FG
 
 
 	private:
-		ND_ static AccessIter_t	_FindFirstAccess (AccessRecords_t &arr, const BufferRange &range);
-			static void			_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferAccess &barrier);
-			static AccessIter_t	_EraseAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const BufferRange &range);
+		ND_ static PendingIter_t	_FindFirstAccess (PendingAccesses_t &arr, const BufferRange &range);
+		ND_ static AccessIter_t		_FindFirstAccess (AccessRecords_t &arr, const BufferRange &range);
+			static void				_ReplaceAccessRecords (INOUT AccessRecords_t &arr, const BufferAccess &barrier);
+			static AccessIter_t		_EraseAccessRecords (INOUT AccessRecords_t &arr, const BufferRange &range);
 	};
 
 
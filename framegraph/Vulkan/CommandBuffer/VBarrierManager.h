@@ -1,8 +1,18 @@
 // Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Barriers are stored in linear memory that is owned by the command buffer and reused every frame.
+	Barriers with the same access masks for adjacent or overlapping ranges of the same resource are merged,
+	read -> read barriers without layout transition are skipped.
+
+	In split barriers mode 'vkCmdSetEvent' is recorded after each task and if there are another tasks
+	between producer and consumer then barrier is recorded as 'vkCmdWaitEvents' instead of 'vkCmdPipelineBarrier',
+	so the GPU doesn't need to wait for the unrelated commands.
+*/
 
 #pragma once
 
 #include "VDevice.h"
+#include "stl/Memory/LinearAllocator.h"
 
 namespace FG
 {
@@ -14,10 +24,40 @@ namespace FG
 	class VBarrierManager final
 	{
 	// types
+	public:
+		using Allocator_t	= LinearAllocator<>;
+
+		struct Statistic
+		{
+			uint	pipelineBarriers	= 0;	// number of 'vkCmdPipelineBarrier' calls
+			uint	emittedBarriers		= 0;	// number of buffer and image barriers that was passed to 'vkCmdPipelineBarrier'
+			uint	mergedBarriers		= 0;	// number of barriers that was merged with another barriers
+			uint	skippedBarriers		= 0;	// number of read -> read barriers
+			uint	splitBarriers		= 0;	// number of buffer and image barriers that was passed to 'vkCmdWaitEvents'
+		};
+
+		struct TaskEvent
+		{
+			ExeOrderIndex			index	= Default;	// producer task
+			VkEvent					event	= VK_NULL_HANDLE;
+			VkPipelineStageFlags	stages	= 0;
+		};
+
 	private:
-		// TODO: custom allocator
-		using ImageMemoryBarriers_t		= Array< VkImageMemoryBarrier >;
-		using BufferMemoryBarriers_t	= Array< VkBufferMemoryBarrier >;
+		template <typename T>
+		struct BarrierArray
+		{
+			T *		data		= null;
+			uint	count		= 0;
+			uint	capacity	= 0;
+		};
+
+		using ImageMemoryBarriers_t		= BarrierArray< VkImageMemoryBarrier >;
+		using BufferMemoryBarriers_t	= BarrierArray< VkBufferMemoryBarrier >;
+		using TaskEvents_t				= BarrierArray< TaskEvent >;
+		using WaitEvents_t				= BarrierArray< VkEvent >;
+
+		static constexpr uint	InitialCapacity	= 64;
 
 
 	// variables
@@ -30,16 +70,79 @@ namespace FG
 		VkPipelineStageFlags		_dstStageMask		= 0;
 		VkDependencyFlags			_dependencyFlags	= 0;
 
+		// split barriers
+		struct {
+			ImageMemoryBarriers_t		imageBarriers;
+			BufferMemoryBarriers_t		bufferBarriers;
+			WaitEvents_t				events;
+			VkPipelineStageFlags		srcStageMask	= 0;
+			VkPipelineStageFlags		dstStageMask	= 0;
+		}							_split;
+		TaskEvents_t				_taskEvents;		// sorted by index
+		bool						_splitBarriers		= false;
+
+		Allocator_t					_allocator;		// only for barrier arrays
+		Statistic					_stat;
+
 
 	// methods
 	public:
 		explicit VBarrierManager ()
 		{
-			_imageBarriers.reserve( 32 );
-			_bufferBarriers.reserve( 64 );
-
 			_memoryBarrier = {};
 			_memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+
+			_allocator.SetBlockSize( 16_Kb );
+		}
+
+
+		void SetSplitBarriers (bool enabled)
+		{
+			_splitBarriers		= enabled;
+			_taskEvents.count	= 0;
+		}
+
+		ND_ bool  IsSplitBarriers () const	{ return _splitBarriers; }
+
+		ND_ bool  HasPendingBarriers () const
+		{
+			return (_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask) or _bufferBarriers.count or _imageBarriers.count or _split.events.count;
+		}
+
+
+		void AddTaskEvent (ExeOrderIndex index, VkEvent event, VkPipelineStageFlags stages)
+		{
+			ASSERT( _splitBarriers );
+			ASSERT( _taskEvents.count == 0 or _taskEvents.data[_taskEvents.count-1].index < index );
+
+			_PushBack( INOUT _taskEvents, TaskEvent{ index, event, stages });
+		}
+
+
+		// returns non-null if barrier should be split
+		ND_ TaskEvent const*  FindEvent (ExeOrderIndex srcIndex, ExeOrderIndex dstIndex, VkPipelineStageFlags srcStages) const
+		{
+			// only if there are another tasks between producer and consumer
+			if ( not _splitBarriers or srcIndex == ExeOrderIndex::Initial or dstIndex >= ExeOrderIndex::Final or
+				 uint(srcIndex) + 1 >= uint(dstIndex) )
+				return null;
+
+			const auto*	begin	= _taskEvents.data;
+			const auto*	end		= _taskEvents.data + _taskEvents.count;
+			const auto*	iter	= std::lower_bound( begin, end, srcIndex, [] (const TaskEvent &lhs, ExeOrderIndex rhs) { return lhs.index < rhs; });
+
+			if ( iter == end or iter->index != srcIndex or AnyBits( srcStages, ~iter->stages ))
+				return null;
+
+			return iter;
+		}
+
+
+		ND_ Statistic  ReadStatistic ()
+		{
+			Statistic	result = _stat;
+			_stat = {};
+			return result;
 		}
 
 
@@ -47,16 +150,15 @@ namespace FG
 		{
 			const uint	mem_count = !!(_memoryBarrier.srcAccessMask | _memoryBarrier.dstAccessMask);
 
-			if ( mem_count or _bufferBarriers.size() or _imageBarriers.size() )
+			if ( _split.events.count )
+				_WaitEvents( dev, cmd );
+
+			if ( mem_count or _bufferBarriers.count or _imageBarriers.count )
 			{
-				dev.vkCmdPipelineBarrier( cmd, _srcStageMask, _dstStageMask, _dependencyFlags,
-										  mem_count, &_memoryBarrier,
-										  uint(_bufferBarriers.size()), _bufferBarriers.data(),
-										  uint(_imageBarriers.size()), _imageBarriers.data() );
-				ClearBarriers();
+				_PipelineBarrier( dev, cmd, mem_count );
 			}
 		}
-		
+
 
 		void ForceCommit (const VDevice &dev, VkCommandBuffer cmd, VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage)
 		{
@@ -65,50 +167,81 @@ namespace FG
 			_srcStageMask |= srcStage;
 			_dstStageMask |= dstStage;
 
+			if ( _split.events.count )
+				_WaitEvents( dev, cmd );
+
 			if ( _srcStageMask and _dstStageMask )
 			{
-				dev.vkCmdPipelineBarrier( cmd, _srcStageMask, _dstStageMask, _dependencyFlags,
-										  mem_count, &_memoryBarrier,
-										  uint(_bufferBarriers.size()), _bufferBarriers.data(),
-										  uint(_imageBarriers.size()), _imageBarriers.data() );
-				ClearBarriers();
+				_PipelineBarrier( dev, cmd, mem_count );
 			}
 		}
 
 
 		void ClearBarriers ()
 		{
-			_imageBarriers.clear();
-			_bufferBarriers.clear();
+			_imageBarriers.count	= 0;
+			_bufferBarriers.count	= 0;
 
 			_memoryBarrier.srcAccessMask = _memoryBarrier.dstAccessMask = 0;
 
 			_srcStageMask = _dstStageMask = 0;
 			_dependencyFlags = 0;
+
+			_split.imageBarriers.count	= 0;
+			_split.bufferBarriers.count	= 0;
+			_split.events.count			= 0;
+			_split.srcStageMask = _split.dstStageMask = 0;
 		}
 
 
 		void AddBufferBarrier (VkPipelineStageFlags			srcStageMask,
 							   VkPipelineStageFlags			dstStageMask,
-							   const VkBufferMemoryBarrier	&barrier)
+							   const VkBufferMemoryBarrier	&barrier,
+							   TaskEvent const*				split = null)
 		{
+			if ( _IsReadToRead( barrier ))
+			{
+				++_stat.skippedBarriers;
+				return;
+			}
+
+			if ( split )
+			{
+				_AddWaitEvent( *split, dstStageMask );
+				return _AddBufferBarrier( INOUT _split.bufferBarriers, barrier );
+			}
+
 			_srcStageMask |= srcStageMask;
 			_dstStageMask |= dstStageMask;
 
-			_bufferBarriers.push_back( barrier );
+			_AddBufferBarrier( INOUT _bufferBarriers, barrier );
 		}
-		
+
 
 		void AddImageBarrier (VkPipelineStageFlags			srcStageMask,
 							  VkPipelineStageFlags			dstStageMask,
 							  VkDependencyFlags				dependencyFlags,
-							  const VkImageMemoryBarrier	&barrier)
+							  const VkImageMemoryBarrier	&barrier,
+							  TaskEvent const*				split = null)
 		{
+			if ( barrier.oldLayout == barrier.newLayout and _IsReadToRead( barrier ))
+			{
+				++_stat.skippedBarriers;
+				return;
+			}
+
+			// dependency flags are not supported by 'vkCmdWaitEvents'
+			if ( split and dependencyFlags == 0 )
+			{
+				_AddWaitEvent( *split, dstStageMask );
+				return _AddImageBarrier( INOUT _split.imageBarriers, barrier );
+			}
+
 			_srcStageMask		|= srcStageMask;
 			_dstStageMask		|= dstStageMask;
 			_dependencyFlags	|= dependencyFlags;
 
-			_imageBarriers.push_back( barrier );
+			_AddImageBarrier( INOUT _imageBarriers, barrier );
 		}
 
 
@@ -122,6 +255,210 @@ namespace FG
 			_memoryBarrier.srcAccessMask |= barrier.srcAccessMask;
 			_memoryBarrier.dstAccessMask |= barrier.dstAccessMask;
 		}
+
+
+	private:
+		void _AddBufferBarrier (INOUT BufferMemoryBarriers_t &arr, const VkBufferMemoryBarrier &barrier)
+		{
+			// barriers for the same buffer are added sequentially, so search only in the tail
+			for (uint i = arr.count; i > 0; --i)
+			{
+				auto&	prev = arr.data[i-1];
+
+				if ( prev.buffer != barrier.buffer )
+					break;
+
+				if ( _MergeBufferBarriers( INOUT prev, barrier ))
+				{
+					++_stat.mergedBarriers;
+					return;
+				}
+			}
+
+			_PushBack( INOUT arr, barrier );
+		}
+
+
+		void _AddImageBarrier (INOUT ImageMemoryBarriers_t &arr, const VkImageMemoryBarrier &barrier)
+		{
+			for (uint i = arr.count; i > 0; --i)
+			{
+				auto&	prev = arr.data[i-1];
+
+				if ( prev.image != barrier.image )
+					break;
+
+				if ( _MergeImageBarriers( INOUT prev, barrier ))
+				{
+					++_stat.mergedBarriers;
+					return;
+				}
+			}
+
+			_PushBack( INOUT arr, barrier );
+		}
+
+
+		void _AddWaitEvent (const TaskEvent &split, VkPipelineStageFlags dstStageMask)
+		{
+			// 'srcStageMask' must be the bitwise OR of the 'stageMask' used to signal events
+			_split.dstStageMask |= dstStageMask;
+
+			for (uint i = 0; i < _split.events.count; ++i)
+			{
+				if ( _split.events.data[i] == split.event )
+					return;
+			}
+
+			_split.srcStageMask |= split.stages;
+			_PushBack( INOUT _split.events, split.event );
+		}
+
+
+		void _WaitEvents (const VDevice &dev, VkCommandBuffer cmd)
+		{
+			const uint	count = _split.bufferBarriers.count + _split.imageBarriers.count;
+
+			if ( count )
+			{
+				dev.vkCmdWaitEvents( cmd, _split.events.count, _split.events.data,
+									 _split.srcStageMask, (_split.dstStageMask ? _split.dstStageMask : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT),
+									 0, null,
+									 _split.bufferBarriers.count, _split.bufferBarriers.data,
+									 _split.imageBarriers.count, _split.imageBarriers.data );
+
+				_stat.splitBarriers += count;
+			}
+
+			_split.imageBarriers.count	= 0;
+			_split.bufferBarriers.count	= 0;
+			_split.events.count			= 0;
+			_split.srcStageMask = _split.dstStageMask = 0;
+		}
+
+
+		void _PipelineBarrier (const VDevice &dev, VkCommandBuffer cmd, uint memCount)
+		{
+			dev.vkCmdPipelineBarrier( cmd, _srcStageMask, _dstStageMask, _dependencyFlags,
+									  memCount, &_memoryBarrier,
+									  _bufferBarriers.count, _bufferBarriers.data,
+									  _imageBarriers.count, _imageBarriers.data );
+
+			++_stat.pipelineBarriers;
+			_stat.emittedBarriers += (_bufferBarriers.count + _imageBarriers.count);
+
+			ClearBarriers();
+		}
+
+
+		template <typename T>
+		void _PushBack (INOUT BarrierArray<T> &arr, const T &value)
+		{
+			if_unlikely( arr.count == arr.capacity )
+			{
+				// capacity is never reduced, so allocations stop when the max number of barriers is reached
+				const uint	new_cap	= Max( InitialCapacity, arr.capacity * 2 );
+				T *			new_ptr	= _allocator.Alloc<T>( new_cap );
+
+				if ( arr.count )
+					std::memcpy( new_ptr, arr.data, sizeof(T) * arr.count );
+
+				arr.data		= new_ptr;
+				arr.capacity	= new_cap;
+			}
+
+			arr.data[ arr.count++ ] = value;
+		}
+
+
+		template <typename T>
+		ND_ static bool  _IsReadToRead (const T &barrier)
+		{
+			constexpr VkAccessFlags	write_mask =
+					VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+					VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_MEMORY_WRITE_BIT
+				#ifdef VK_NV_ray_tracing
+					| VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_NV
+				#endif
+				#ifdef VK_EXT_transform_feedback
+					| VK_ACCESS_TRANSFORM_FEEDBACK_WRITE_BIT_EXT | VK_ACCESS_TRANSFORM_FEEDBACK_COUNTER_WRITE_BIT_EXT
+				#endif
+					;
+
+			// queue family ownership transfer must not be skipped
+			return	not ((barrier.srcAccessMask | barrier.dstAccessMask) & write_mask)	and
+					barrier.srcQueueFamilyIndex == barrier.dstQueueFamilyIndex;
+		}
+
+
+		ND_ static bool  _MergeBufferBarriers (INOUT VkBufferMemoryBarrier &dst, const VkBufferMemoryBarrier &src)
+		{
+			if ( dst.srcAccessMask			!= src.srcAccessMask		or
+				 dst.dstAccessMask			!= src.dstAccessMask		or
+				 dst.srcQueueFamilyIndex	!= src.srcQueueFamilyIndex	or
+				 dst.dstQueueFamilyIndex	!= src.dstQueueFamilyIndex	or
+				 dst.pNext					!= null						or
+				 src.pNext					!= null )
+				return false;
+
+			const VkDeviceSize	dst_end	= (dst.size == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : dst.offset + dst.size);
+			const VkDeviceSize	src_end	= (src.size == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : src.offset + src.size);
+
+			// ranges must be adjacent or overlapped
+			if ( src.offset > dst_end or dst.offset > src_end )
+				return false;
+
+			const VkDeviceSize	end	= Max( dst_end, src_end );
+
+			dst.offset	= Min( dst.offset, src.offset );
+			dst.size	= (end == VK_WHOLE_SIZE ? VK_WHOLE_SIZE : end - dst.offset);
+			return true;
+		}
+
+
+		ND_ static bool  _MergeRange (INOUT uint &dstBase, INOUT uint &dstCount, uint srcBase, uint srcCount)
+		{
+			const uint	dst_end	= dstBase + dstCount;
+			const uint	src_end	= srcBase + srcCount;
+
+			if ( srcBase > dst_end or dstBase > src_end )
+				return false;
+
+			dstBase		= Min( dstBase, srcBase );
+			dstCount	= Max( dst_end, src_end ) - dstBase;
+			return true;
+		}
+
+
+		ND_ static bool  _MergeImageBarriers (INOUT VkImageMemoryBarrier &dst, const VkImageMemoryBarrier &src)
+		{
+			auto&		dst_range	= dst.subresourceRange;
+			auto&		src_range	= src.subresourceRange;
+
+			if ( dst.srcAccessMask			!= src.srcAccessMask		or
+				 dst.dstAccessMask			!= src.dstAccessMask		or
+				 dst.oldLayout				!= src.oldLayout			or
+				 dst.newLayout				!= src.newLayout			or
+				 dst.srcQueueFamilyIndex	!= src.srcQueueFamilyIndex	or
+				 dst.dstQueueFamilyIndex	!= src.dstQueueFamilyIndex	or
+				 dst.pNext					!= null						or
+				 src.pNext					!= null						or
+				 dst_range.aspectMask		!= src_range.aspectMask		or
+				 dst_range.levelCount		== VK_REMAINING_MIP_LEVELS	or
+				 src_range.levelCount		== VK_REMAINING_MIP_LEVELS	or
+				 dst_range.layerCount		== VK_REMAINING_ARRAY_LAYERS or
+				 src_range.layerCount		== VK_REMAINING_ARRAY_LAYERS )
+				return false;
+
+			// merged range must be a rectangle in (mipmap, layer) space
+			if ( dst_range.baseMipLevel == src_range.baseMipLevel and dst_range.levelCount == src_range.levelCount )
+				return _MergeRange( INOUT dst_range.baseArrayLayer, INOUT dst_range.layerCount, src_range.baseArrayLayer, src_range.layerCount );
+
+			if ( dst_range.baseArrayLayer == src_range.baseArrayLayer and dst_range.layerCount == src_range.layerCount )
+				return _MergeRange( INOUT dst_range.baseMipLevel, INOUT dst_range.levelCount, src_range.baseMipLevel, src_range.levelCount );
+
+			return false;
+		}
 	};
 
 }	// FG
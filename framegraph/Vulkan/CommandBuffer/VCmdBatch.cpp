@@ -34,6 +34,19 @@ namespace FG
 	{
 		EXLOCK( _drCheck );
 		CHECK( _counter.load( memory_order_relaxed ) == 0 );
+		ASSERT( _events.used.empty() );
+
+		VDevice const&	dev = _frameGraph.GetDevice();
+
+		for (auto& ev : _events.available) {
+			dev.vkDestroyEvent( dev.GetVkDevice(), ev, null );
+		}
+		_events.available.clear();
+
+		for (auto& pool : _descriptors.pools) {
+			dev.vkDestroyDescriptorPool( dev.GetVkDevice(), pool, null );
+		}
+		_descriptors.pools.clear();
 	}
 	
 /*
@@ -48,6 +61,9 @@ namespace FG
 
 		ASSERT( _dependencies.empty() );
 		ASSERT( _batch.commands.empty() );
+		ASSERT( _batch.secondaries.empty() );
+		ASSERT( _events.used.empty() );
+		ASSERT( _descriptors.current == 0 and _descriptors.allocated == 0 );
 		ASSERT( _batch.signalSemaphores.empty() );
 		ASSERT( _batch.waitSemaphores.empty() );
 		ASSERT( _staging.hostToDevice.empty() );
@@ -55,13 +71,15 @@ namespace FG
 		ASSERT( _staging.onBufferLoadedEvents.empty() );
 		ASSERT( _staging.onImageLoadedEvents.empty() );
 		ASSERT( _resourcesToRelease.empty() );
+		ASSERT( _transientHeaps.empty() );
 		ASSERT( _swapchains.empty() );
 		ASSERT( _shaderDebugger.buffers.empty() );
 		ASSERT( _shaderDebugger.modes.empty() );
 		ASSERT( _submitted == null );
 		ASSERT( _counter.load( memory_order_relaxed ) == 0 );
 
-		_queueType = type;
+		_queueType	= type;
+		_batchIndex	= _frameGraph.GetResourceManager().OnBatchBegin();
 
 		if ( auto queue = _frameGraph.FindQueue( type ))
 		{
@@ -144,6 +162,19 @@ namespace FG
 		_batch.commands.push_back( cmd, pool );
 	}
 	
+/*
+=================================================
+	AddSecondaryCommandBuffer
+=================================================
+*/
+	void  VCmdBatch::AddSecondaryCommandBuffer (VkCommandBuffer cmd, const VCommandPool *pool)
+	{
+		EXLOCK( _drCheck );
+		ASSERT( GetState() < EState::Submitted );
+
+		_batch.secondaries.emplace_back( cmd, pool );
+	}
+	
 /*
 =================================================
 	AddDependency
@@ -177,6 +208,82 @@ namespace FG
 
 		_readyToDelete.push_back({ type, handle });
 	}
+	
+/*
+=================================================
+	AcquireEvent
+----
+	events are reused when batch complete execution on the GPU
+=================================================
+*/
+	VkEvent  VCmdBatch::AcquireEvent ()
+	{
+		EXLOCK( _drCheck );
+		ASSERT( GetState() == EState::Recording );
+
+		VkEvent		ev = VK_NULL_HANDLE;
+
+		if ( _events.available.size() )
+		{
+			ev = _events.available.back();
+			_events.available.pop_back();
+		}
+		else
+		{
+			VDevice const&		dev		= _frameGraph.GetDevice();
+			VkEventCreateInfo	info	= {};
+			info.sType	= VK_STRUCTURE_TYPE_EVENT_CREATE_INFO;
+
+			VK_CALL( dev.vkCreateEvent( dev.GetVkDevice(), &info, null, OUT &ev ));
+			CHECK_ERR( ev != VK_NULL_HANDLE );
+		}
+
+		_events.used.push_back( ev );
+		return ev;
+	}
+	
+/*
+=================================================
+	AllocTransientDescriptorSet
+----
+	descriptor sets are allocated linearly from batch local pools
+	and are released all at once when batch complete execution on the GPU.
+=================================================
+*/
+	bool  VCmdBatch::AllocTransientDescriptorSet (VkDescriptorSetLayout layout, OUT VkDescriptorSet &ds)
+	{
+		EXLOCK( _drCheck );
+		ASSERT( GetState() == EState::Recording );
+
+		VDevice const&				dev		= _frameGraph.GetDevice();
+		VkDescriptorSetAllocateInfo	info	= {};
+		info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		info.descriptorSetCount	= 1;
+		info.pSetLayouts		= &layout;
+
+		for (; _descriptors.current < _descriptors.pools.size(); ++_descriptors.current)
+		{
+			info.descriptorPool = _descriptors.pools[ _descriptors.current ];
+
+			if ( dev.vkAllocateDescriptorSets( dev.GetVkDevice(), &info, OUT &ds ) == VK_SUCCESS )
+			{
+				++_descriptors.allocated;
+				++_statistic.resources.transientDescriptorSets;
+				return true;
+			}
+		}
+
+		VkDescriptorPool	pool;
+		CHECK_ERR( _frameGraph.GetResourceManager().GetDescriptorManager().CreateTransientPool( OUT pool ));
+		_descriptors.pools.push_back( pool );
+
+		info.descriptorPool = pool;
+		VK_CHECK( dev.vkAllocateDescriptorSets( dev.GetVkDevice(), &info, OUT &ds ));
+		
+		++_descriptors.allocated;
+		++_statistic.resources.transientDescriptorSets;
+		return true;
+	}
 
 /*
 =================================================
@@ -367,6 +474,9 @@ namespace FG
 		_FinalizeStagingBuffers( _frameGraph.GetDevice() );
 		_ReleaseResources();
 		_ReleaseVkObjects();
+		
+		_frameGraph.GetResourceManager().OnBatchComplete( _batchIndex );
+		_batchIndex = UMax;
 
 		debugger.AddBatchDump( _debugName, std::move(_debugDump) );
 		debugger.AddBatchGraph( std::move(_debugGraph) );
@@ -406,7 +516,40 @@ namespace FG
 				pool->RecyclePrimary( _batch.commands.get<0>()[i] );
 		}
 
+		for (auto& [cmd, pool] : _batch.secondaries)
+		{
+			if ( pool )
+				pool->RecycleSecondary( cmd );
+		}
+
+		// events must be unsignaled before reusing
+		if ( _events.used.size() )
+		{
+			VDevice const&	dev = _frameGraph.GetDevice();
+
+			for (auto& ev : _events.used)
+			{
+				VK_CALL( dev.vkResetEvent( dev.GetVkDevice(), ev ));
+				_events.available.push_back( ev );
+			}
+			_events.used.clear();
+		}
+
+		// descriptor sets are not used anymore, pools can be reused
+		if ( _descriptors.allocated )
+		{
+			VDevice const&	dev = _frameGraph.GetDevice();
+
+			for (uint i = 0, cnt = Min( _descriptors.current + 1, uint(_descriptors.pools.size()) ); i < cnt; ++i)
+			{
+				VK_CALL( dev.vkResetDescriptorPool( dev.GetVkDevice(), _descriptors.pools[i], 0 ));
+			}
+			_descriptors.current	= 0;
+			_descriptors.allocated	= 0;
+		}
+
 		_batch.commands.clear();
+		_batch.secondaries.clear();
 		_batch.signalSemaphores.clear();
 		_batch.waitSemaphores.clear();
 	}
@@ -650,6 +793,12 @@ namespace FG
 			}
 		}
 		_resourcesToRelease.clear();
+
+		// transient images are released, so memory can be reused
+		for (auto& heap : _transientHeaps) {
+			rm.GetMemoryManager().Deallocate( INOUT heap );
+		}
+		_transientHeaps.clear();
 	}
 	
 /*
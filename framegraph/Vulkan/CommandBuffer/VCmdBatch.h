@@ -7,6 +7,7 @@
 #include "VDescriptorSetLayout.h"
 #include "VLocalDebugger.h"
 #include "VCommandPool.h"
+#include "VMemoryObj.h"
 #include "stl/Containers/FixedTupleArray.h"
 
 namespace FG
@@ -239,10 +240,14 @@ namespace FG
 
 		static constexpr uint		MaxBatchItems = 8;
 		using CmdBuffers_t			= FixedTupleArray< MaxBatchItems, VkCommandBuffer, VCommandPool const* >;
+		using SecondaryCmdBuffers_t	= Array< Pair< VkCommandBuffer, VCommandPool const* >>;
 		using SignalSemaphores_t	= FixedArray< VkSemaphore, MaxBatchItems >;
 		using WaitSemaphores_t		= FixedTupleArray< MaxBatchItems, VkSemaphore, VkPipelineStageFlags >;
 		
 		using VkResourceArray_t		= Array<Pair< VkObjectType, uint64_t >>;
+		using Events_t				= Array< VkEvent >;
+		using DescriptorPools_t		= Array< VkDescriptorPool >;
+		using MemoryHeaps_t			= Array< VMemoryObj::Storage_t >;
 
 		using Statistic_t			= IFrameGraph::Statistics;
 
@@ -266,6 +271,7 @@ namespace FG
 
 		const uint							_indexInPool;		// index in VFrameGraph::_cmdBatchPool
 		EQueueType							_queueType			= Default;
+		uint64_t							_batchIndex			= UMax;		// unique index from VResourceManager::OnBatchBegin
 
 		Dependencies_t						_dependencies;
 		bool								_submitImmediately	= false;
@@ -275,10 +281,24 @@ namespace FG
 		// command batch data
 		struct {
 			CmdBuffers_t						commands;
+			SecondaryCmdBuffers_t				secondaries;		// executed by primary command buffers
 			SignalSemaphores_t					signalSemaphores;
 			WaitSemaphores_t					waitSemaphores;
 		}									_batch;
 
+		// events for split barriers
+		struct {
+			Events_t							used;
+			Events_t							available;		// in unsignaled state
+		}									_events;
+
+		// linear descriptor pools for transient descriptor sets
+		struct {
+			DescriptorPools_t					pools;
+			uint								current		= 0;	// pools before this index are full
+			uint								allocated	= 0;	// number of sets allocated since last reset
+		}									_descriptors;
+
 		// staging buffers
 		struct {
 			FixedArray< StagingBuffer, 8 >		hostToDevice;	// CPU write, GPU read
@@ -291,6 +311,7 @@ namespace FG
 		ResourceMap_t						_resourcesToRelease;
 		Swapchains_t						_swapchains;
 		VkResourceArray_t					_readyToDelete;
+		MemoryHeaps_t						_transientHeaps;	// memory for transient images, see 'VCommandBuffer::_BindTransientImages'
 
 		// shader debugger
 		struct {
@@ -334,8 +355,11 @@ namespace FG
 		void  WaitSemaphore (VkSemaphore sem, VkPipelineStageFlags stage);
 		void  PushFrontCommandBuffer (VkCommandBuffer, const VCommandPool *);
 		void  PushBackCommandBuffer (VkCommandBuffer, const VCommandPool *);
+		void  AddSecondaryCommandBuffer (VkCommandBuffer, const VCommandPool *);
 		void  AddDependency (VCmdBatch *);
 		void  DestroyPostponed (VkObjectType type, uint64_t handle);
+		ND_ VkEvent  AcquireEvent ();
+		ND_ bool  AllocTransientDescriptorSet (VkDescriptorSetLayout layout, OUT VkDescriptorSet &ds);
 	
 
 		// shader debugger //
@@ -364,6 +388,7 @@ namespace FG
 		ND_ ArrayView<VCmdBatchPtr>	GetDependencies ()				const	{ SHAREDLOCK( _drCheck );  return _dependencies; }
 		ND_ VSubmitted *			GetSubmitted ()					const	{ SHAREDLOCK( _drCheck );  return _submitted; }		// TODO: rename
 		ND_ uint					GetIndexInPool ()				const	{ return _indexInPool; }
+		ND_ uint64_t				GetBatchIndex ()				const	{ SHAREDLOCK( _drCheck );  return _batchIndex; }
 		ND_ bool					IsQueueSyncRequired ()			const	{ SHAREDLOCK( _drCheck );  return _dbgQueueSync; }
 
 
@@ -2,6 +2,8 @@
 
 #include "VCommandBuffer.h"
 #include "VTaskGraph.hpp"
+#include "Shared/PipelineResourcesHelper.h"
+#include "stl/Algorithms/StringUtils.h"
 
 namespace FG
 {
@@ -44,6 +46,14 @@ namespace {
 			q.Destroy( GetDevice() );
 		}
 		_perQueue.clear();
+
+		for (auto& worker : _parallel.workers)
+		{
+			for (auto& q : worker->cmdPools) {
+				q.Destroy( GetDevice() );
+			}
+		}
+		_parallel.workers.clear();
 	}
 
 /*
@@ -60,6 +70,7 @@ namespace {
 		_batch			= batch;
 		_dbgFullBarriers= AllBits( desc.debugFlags, EDebugFlags::FullBarrier );
 		_dbgQueueSync	= AllBits( desc.debugFlags, EDebugFlags::QueueSync );
+		_singlePassDrawTasks = desc.singlePassDrawTasks;
 		_state			= EState::Recording;
 		_queueIndex		= queue->familyIndex;
 		
@@ -76,8 +87,24 @@ namespace {
 				CHECK_ERR( pool.Create( GetDevice(), queue ));
 			}
 		}
+
+		// parallel recording requires at least one worker thread
+		_parallel.enabled = desc.parallelRecording and _instance.GetWorkerCount() > 1;
+
+		if ( _parallel.enabled )
+			CHECK_ERR( _InitRecordingWorkers( queue ));
+
+		// events can not be used because render passes are recorded after other commands
+		_barrierMngr.SetSplitBarriers( desc.splitBarriers and not _parallel.enabled );
+
+		// planning is not compatible with split barriers and full barriers debug mode
+		_barrierPlanning = desc.barrierPlanning and not _barrierMngr.IsSplitBarriers() and not _dbgFullBarriers;
+
+		// render passes may be recorded on worker threads, but batch descriptor pools are not thread safe
+		_transientDescriptors = desc.transientDescriptorSets and not _parallel.enabled;
 		
 		_batch->OnBegin( desc );
+		_pipelineCache.ResetInstanceCache();
 		
 		// setup local debugger
 		const EDebugFlags	debugger_flags = desc.debugFlags & ~CmdDebugFlags;
@@ -112,6 +139,7 @@ namespace {
 
 		_state = EState::Compiling;
 
+		CHECK_ERR( _BindTransientImages() );
 		CHECK_ERR( _BuildCommandBuffers() );
 		
 		if_unlikely( _debugger )
@@ -123,6 +151,18 @@ namespace {
 		_AfterCompilation();
 		_mainAllocator.Discard();
 		
+		// barrier statistic
+		{
+			auto&	stat		= EditStatistic().renderer;
+			auto	barriers	= _barrierMngr.ReadStatistic();
+
+			stat.pipelineBarriers	+= barriers.pipelineBarriers;
+			stat.emittedBarriers	+= barriers.emittedBarriers;
+			stat.mergedBarriers		+= barriers.mergedBarriers;
+			stat.skippedBarriers	+= barriers.skippedBarriers;
+			stat.splitBarriers		+= barriers.splitBarriers;
+		}
+
 		EditStatistic().renderer.cpuTime += TimePoint_t::clock::now() - start_time;
 		_batch = null;
 
@@ -155,6 +195,77 @@ namespace {
 			}
 		}
 		_rm.logicalRenderPassCount = 0;
+
+		// destroy transient pipeline resources, descriptor sets will be released by command batch
+		for (auto* res : _rm.transientResources)
+		{
+			res->Destroy( GetResourceManager() );
+			res->~VPipelineResources();
+		}
+		_rm.transientResources.clear();
+
+		// transient images are released by command batch
+		_transient.images.clear();
+		_transient.imageIndices.Reset();
+		_transient.uses.clear();
+		_transient.submits.clear();
+		_transient.descriptorSets.clear();
+		_transient.aliasing.clear();
+		_transient.pass			= null;
+		_transient.firstTaskUse	= 0;
+	}
+	
+/*
+=================================================
+	CreateDescriptorSet
+----
+	explicitly cached resources are shared between command buffers,
+	other resources may be allocated from command batch pool to avoid global lock and hash map lookup.
+	Push descriptors doesn't require descriptor set at all, only descriptor writes are stored.
+=================================================
+*/
+	VPipelineResources const*  VCommandBuffer::CreateDescriptorSet (const PipelineResources &desc, bool pushDescriptors)
+	{
+		const bool	push_only		= pushDescriptors and not _parallel.enabled;
+		const bool	has_transient	= _transient.images.size() and _UsesTransientImages( desc );
+
+		if ( not (_transientDescriptors or push_only or has_transient) or (PipelineResourcesHelper::GetCached( desc ) and not has_transient) )
+		{
+			auto*	res = GetResourceManager().CreateDescriptorSet( desc, INOUT _rm.resourceMap );
+
+			// cached descriptor set is pushed into command buffer if pipeline layout uses push descriptors for this set,
+			// descriptor writes are created with descriptor set
+			if ( res and pushDescriptors )
+				ASSERT( res->GetPushDescriptors().size() );
+
+			return res;
+		}
+		
+		CHECK_ERR( desc.IsInitialized() );
+
+		auto*	res		= PlacementNew<VPipelineResources>( _mainAllocator.Alloc<VPipelineResources>(), desc );
+
+		// image views can be created only when memory is bound to the transient images
+		if ( has_transient )
+		{
+			_rm.transientResources.push_back( res );
+			_transient.descriptorSets.emplace_back( res, push_only );
+			return res;
+		}
+
+		bool	created	= push_only ?
+							res->CreatePushDescriptors( GetResourceManager() ) :
+							res->Create( GetResourceManager(), *_batch );
+
+		if ( not created )
+		{
+			res->Destroy( GetResourceManager() );
+			res->~VPipelineResources();
+			RETURN_ERR( "failed when creating transient descriptor set" );
+		}
+
+		_rm.transientResources.push_back( res );
+		return res;
 	}
 
 /*
@@ -225,6 +336,13 @@ namespace {
 
 		CHECK( _ProcessTasks( cmd ));
 
+		if ( _parallel.enabled )
+		{
+			_EndSecondaryCommands();
+			CHECK_ERR( _RecordDeferredRenderPasses() );
+			_ExecuteSecondaryCommands( cmd );
+		}
+
 		// transit image layout to default state
 		// add memory dependency to flush caches
 		{
@@ -253,6 +371,14 @@ namespace {
 */
 	forceinline void  VTaskProcessor::Run (VTask node)
 	{
+		if ( _barrierPlanning )
+		{
+			if ( node->IsTransfer() )
+				return _PlanTask( node );
+
+			RecordPlannedTasks();
+		}
+
 		// reset states
 		_currTask = node;
 		
@@ -260,6 +386,9 @@ namespace {
 			_fgThread.GetDebugger()->AddTask( _currTask );
 
 		node->Process( this );
+
+		if ( _currTaskStages )
+			_SetTaskEvent();
 	}
 
 /*
@@ -269,56 +398,360 @@ namespace {
 */
 	bool  VCommandBuffer::_ProcessTasks (VkCommandBuffer cmd)
 	{
-		VTaskProcessor	processor{ *this, cmd };
-		uint			visitor_id		= 1;
+		const uint		visitor_id		= 1;
 		ExeOrderIndex	exe_order_index	= ExeOrderIndex::First;
+		size_t			processed		= 0;
+		size_t			aliasing_index	= 0;
+		{
+			VTaskProcessor	processor{ *this, (_parallel.enabled ? BeginCommandSegment() : cmd), _parallel.enabled };
+
+			processed = _taskGraph.Visit( GetAllocator(), visitor_id,
+							[this, &processor, &exe_order_index, &aliasing_index] (VTask node)
+							{
+								node->SetExecutionOrder( ++exe_order_index );
+
+								if ( aliasing_index < _transient.aliasing.size() and _transient.aliasing[aliasing_index] == exe_order_index )
+								{
+									processor.RecordPlannedTasks();
+									_AddAliasingBarrier();
+									++aliasing_index;
+								}
+								processor.Run( node );
+							});
+
+			processor.RecordPlannedTasks();
+		}
+
+		if_unlikely( processed != _taskGraph.Count() )
+		{
+			String	str = "some tasks are not processed because of dependency cycle or dependency on a task from another command buffer: ";
 
-		TempTaskArray_t		pending{ GetAllocator() };
-		pending.reserve( 128 );
-		pending.assign( _taskGraph.Entries().begin(), _taskGraph.Entries().end() );
+			for (auto node : _taskGraph.Nodes())
+			{
+				if ( node->VisitorID() != visitor_id )
+					str << "'" << node->Name() << "', ";
+			}
+			str.pop_back();
+			str.pop_back();
 
-		for (uint k = 0; k < 10 and not pending.empty(); ++k)
+			RETURN_ERR( str );
+		}
+		return true;
+	}
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	_InitRecordingWorkers
+=================================================
+*/
+	bool  VCommandBuffer::_InitRecordingWorkers (VDeviceQueueInfoPtr queue)
+	{
+		const uint	index = uint(_queueIndex);
+
+		_parallel.workers.resize( Max( _parallel.workers.size(), _instance.GetWorkerCount() ));
+
+		for (auto& worker : _parallel.workers)
 		{
-			for (size_t i = 0; i < pending.size();)
+			if ( not worker )
 			{
-				auto	node = pending[i];
-				
-				if ( node->VisitorID() == visitor_id ) {
-					++i;
-					continue;
-				}
+				worker.reset( new RecordingWorker{} );
+				worker->allocator.SetBlockSize( 1_Mb );
+			}
 
-				// wait for input
-				bool	input_processed = true;
+			worker->cmdPools.resize( Max( worker->cmdPools.size(), index+1 ));
 
-				for (auto in_node : node->Inputs())
-				{
-					if ( in_node->VisitorID() != visitor_id ) {
-						input_processed = false;
-						break;
-					}
-				}
+			auto&	pool = worker->cmdPools[index];
 
-				if ( not input_processed ) {
-					++i;
-					continue;
-				}
+			if ( not pool.IsCreated() )
+			{
+				CHECK_ERR( pool.Create( GetDevice(), queue ));
+			}
+		}
+		return true;
+	}
 
-				node->SetVisitorID( visitor_id );
-				node->SetExecutionOrder( ++exe_order_index );
-				
-				processor.Run( node );
+/*
+=================================================
+	_BeginSecondary
+=================================================
+*/
+	void  VCommandBuffer::_BeginSecondary (VkCommandBuffer cmd, const VkRenderPassBeginInfo *passInfo) const
+	{
+		VkCommandBufferInheritanceInfo	inheritance = {};
+		inheritance.sType		= VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritance.renderPass	= (passInfo ? passInfo->renderPass : VK_NULL_HANDLE);
+		inheritance.subpass		= 0;
+		inheritance.framebuffer	= (passInfo ? passInfo->framebuffer : VK_NULL_HANDLE);
 
-				for (auto out_node : node->Outputs())
-				{
-					pending.push_back( out_node );
-				}
+		VkCommandBufferBeginInfo	info = {};
+		info.sType				= VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		info.flags				= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | (passInfo ? VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT : 0);
+		info.pInheritanceInfo	= &inheritance;
 
-				pending.erase( pending.begin()+i );
+		VK_CALL( GetDevice().vkBeginCommandBuffer( cmd, &info ));
+	}
+
+/*
+=================================================
+	BeginRenderPassSecondary
+----
+	returns secondary command buffer for draw commands in render pass,
+	command buffer must be ended by the caller.
+=================================================
+*/
+	VkCommandBuffer  VCommandBuffer::BeginRenderPassSecondary (const VkRenderPassBeginInfo &passInfo)
+	{
+		auto&			pool	= _perQueue[ uint(_queueIndex) ];
+		VkCommandBuffer	cmd		= pool.AllocSecondary( GetDevice() );
+		CHECK_ERR( cmd, VK_NULL_HANDLE );
+
+		_batch->AddSecondaryCommandBuffer( cmd, &pool );
+		_BeginSecondary( cmd, &passInfo );
+		return cmd;
+	}
+
+/*
+=================================================
+	_EndSecondaryCommands
+=================================================
+*/
+	void  VCommandBuffer::_EndSecondaryCommands ()
+	{
+		if ( _parallel.current )
+		{
+			VK_CALL( GetDevice().vkEndCommandBuffer( _parallel.current ));
+			_parallel.current = VK_NULL_HANDLE;
+		}
+	}
+	
+/*
+=================================================
+	BeginCommandSegment
+----
+	begins secondary command buffer for commands outside of render pass
+=================================================
+*/
+	VkCommandBuffer  VCommandBuffer::BeginCommandSegment ()
+	{
+		ASSERT( _parallel.enabled );
+		_EndSecondaryCommands();
+
+		auto&	pool = _perQueue[ uint(_queueIndex) ];
+		auto&	cmds = _parallel.commands.emplace_back();
+
+		cmds.cmdBuffer	= pool.AllocSecondary( GetDevice() );
+		cmds.cmdPool	= &pool;
+		CHECK_ERR( cmds.cmdBuffer, VK_NULL_HANDLE );
+
+		_BeginSecondary( cmds.cmdBuffer, null );
+
+		_parallel.current = cmds.cmdBuffer;
+		return _parallel.current;
+	}
+	
+/*
+=================================================
+	BeginRenderPassCommands
+----
+	returns null if render pass commands will be recorded later on worker thread
+=================================================
+*/
+	VkCommandBuffer  VCommandBuffer::BeginRenderPassCommands (const VFgTask<SubmitRenderPass> &task, const VkRenderPassBeginInfo &passInfo,
+															  VkImageView shadingRateImage, bool deferred)
+	{
+		ASSERT( _parallel.enabled );
+		_EndSecondaryCommands();
+
+		auto	draw_tasks = task.GetLogicalPass()->GetDrawTasks();
+
+		// split draw tasks between worker threads, each chunk is recorded into separate secondary command buffer
+		if ( deferred )
+		{
+			const size_t	max_chunks	= Max( 1u, Min( _instance.GetWorkerCount(), uint(draw_tasks.size() / MinDrawTasksPerThread) ));
+			const size_t	chunk_size	= (draw_tasks.size() + max_chunks - 1) / max_chunks;
+
+			for (size_t i = 0; i < draw_tasks.size(); i += chunk_size)
+			{
+				auto&	cmds = _parallel.commands.emplace_back();
+
+				cmds.renderPass			= &task;
+				cmds.drawTasks			= draw_tasks.section( i, chunk_size );
+				cmds.passInfo			= passInfo;
+				cmds.shadingRateImage	= shadingRateImage;
+
+				_parallel.deferred.push_back( uint(_parallel.commands.size() - 1) );
 			}
+			return VK_NULL_HANDLE;
+		}
+
+		auto&	pool = _perQueue[ uint(_queueIndex) ];
+		auto&	cmds = _parallel.commands.emplace_back();
+
+		cmds.renderPass			= &task;
+		cmds.drawTasks			= draw_tasks;
+		cmds.passInfo			= passInfo;
+		cmds.shadingRateImage	= shadingRateImage;
+
+		cmds.cmdBuffer	= pool.AllocSecondary( GetDevice() );
+		cmds.cmdPool	= &pool;
+		CHECK_ERR( cmds.cmdBuffer, VK_NULL_HANDLE );
+
+		_BeginSecondary( cmds.cmdBuffer, &cmds.passInfo );
+
+		_parallel.current = cmds.cmdBuffer;
+		return _parallel.current;
+	}
+	
+/*
+=================================================
+	_RecordDeferredRenderPasses
+----
+	render passes that failed to record on worker thread
+	are recorded again on current thread
+=================================================
+*/
+	bool  VCommandBuffer::_RecordDeferredRenderPasses ()
+	{
+		if ( _parallel.deferred.empty() )
+			return true;
+
+		const uint	queue_index = uint(_queueIndex);
+
+		// only data that was prepared by the main thread and worker's own data can be used here
+		_instance.ParallelFor( uint(_parallel.deferred.size()),
+			[this, queue_index] (uint jobIndex, uint workerIndex)
+			{
+				auto&	worker	= *_parallel.workers[ workerIndex ];
+				auto&	cmds	= _parallel.commands[ _parallel.deferred[ jobIndex ]];
+
+				// on failure 'cmdBuffer' stays null and render pass will be recorded again
+				Unused( _RecordRenderPassCommands( INOUT cmds, worker.cmdPools[ queue_index ], worker.allocator, worker.statistic.renderer ));
+			});
+
+		for (uint idx : _parallel.deferred)
+		{
+			auto&	cmds = _parallel.commands[ idx ];
+
+			if_likely( cmds.cmdBuffer )
+				continue;
+
+			FG_LOGI( "failed to record render pass '"s << cmds.renderPass->Name() << "' on worker thread, recording on current thread" );
+			CHECK_ERR( _RecordRenderPassCommands( INOUT cmds, _perQueue[ queue_index ], GetAllocator(), EditStatistic().renderer ));
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_RecordRenderPassCommands
+----
+	records draw tasks into new secondary command buffer,
+	on failure command buffer is returned to the pool
+=================================================
+*/
+	bool  VCommandBuffer::_RecordRenderPassCommands (INOUT SecondaryCommands &cmds, VCommandPool &pool, LinearAllocator<> &allocator, IFrameGraph::RenderingStatistics &stat)
+	{
+		VkCommandBuffer	cmd = pool.AllocSecondary( GetDevice() );
+		CHECK_ERR( cmd );
+
+		_BeginSecondary( cmd, &cmds.passInfo );
+		{
+			VTaskProcessor	processor{ *this, cmd, allocator, stat };
+			processor.RecordRenderPass( *cmds.renderPass, cmds.shadingRateImage, cmds.drawTasks );
+		}
+
+		if_unlikely( GetDevice().vkEndCommandBuffer( cmd ) != VK_SUCCESS )
+		{
+			pool.RecycleSecondary( cmd );
+			RETURN_ERR( "failed to record render pass commands" );
 		}
+
+		cmds.cmdBuffer	= cmd;
+		cmds.cmdPool	= &pool;
 		return true;
 	}
+	
+/*
+=================================================
+	_ExecuteSecondaryCommands
+=================================================
+*/
+	void  VCommandBuffer::_ExecuteSecondaryCommands (VkCommandBuffer primary)
+	{
+		VDevice const&	dev			= GetDevice();
+		const bool		debug_utils	= dev.GetFeatures().debugUtils;
+
+		const auto	push_debug_group = [&dev, debug_utils, primary] (StringView text, RGBA8u color)
+		{
+			if ( text.size() and debug_utils )
+			{
+				VkDebugUtilsLabelEXT	info = {};
+				info.sType		= VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+				info.pLabelName	= text.data();
+				MemCopy( info.color, RGBA32f{color} );
+
+				dev.vkCmdBeginDebugUtilsLabelEXT( primary, &info );
+			}
+		};
+		const auto	pop_debug_group = [&dev, debug_utils, primary] (StringView text)
+		{
+			if ( text.size() and debug_utils )
+				dev.vkCmdEndDebugUtilsLabelEXT( primary );
+		};
+
+		const String	name = "CommandBuffer: "s << (GetName().size() ? GetName() : ToString<16>( size_t(primary) ));
+		push_debug_group( name, RGBA8u{255} );
+
+		Array< VkCommandBuffer >	pass_cmdbufs;
+
+		for (size_t i = 0; i < _parallel.commands.size(); ++i)
+		{
+			auto&	cmds = _parallel.commands[i];
+
+			if ( cmds.cmdBuffer )
+				_batch->AddSecondaryCommandBuffer( cmds.cmdBuffer, cmds.cmdPool );
+
+			if ( not cmds.renderPass )
+			{
+				if ( cmds.cmdBuffer )
+					dev.vkCmdExecuteCommands( primary, 1, &cmds.cmdBuffer );
+				continue;
+			}
+
+			// render pass may be splitted into multiple secondary command buffers
+			if ( cmds.cmdBuffer )
+				pass_cmdbufs.push_back( cmds.cmdBuffer );
+
+			const bool	is_last = (i+1 == _parallel.commands.size() or _parallel.commands[i+1].renderPass != cmds.renderPass);
+
+			if ( is_last )
+			{
+				push_debug_group( cmds.renderPass->Name(), cmds.renderPass->DebugColor() );
+				dev.vkCmdBeginRenderPass( primary, &cmds.passInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
+
+				if ( pass_cmdbufs.size() )
+					dev.vkCmdExecuteCommands( primary, uint(pass_cmdbufs.size()), pass_cmdbufs.data() );
+
+				dev.vkCmdEndRenderPass( primary );
+				pop_debug_group( cmds.renderPass->Name() );
+				pass_cmdbufs.clear();
+			}
+		}
+
+		pop_debug_group( name );
+
+		_parallel.commands.clear();
+		_parallel.deferred.clear();
+
+		for (auto& worker : _parallel.workers)
+		{
+			EditStatistic().Merge( worker->statistic );
+			worker->statistic = Default;
+			worker->allocator.Discard();
+		}
+	}
 //-----------------------------------------------------------------------------
 
 	
@@ -448,6 +881,50 @@ namespace {
 		}
 	}
 
+/*
+=================================================
+	CreateTransientImage
+----
+	image memory is bound in 'Execute' when lifetimes of all transient images are known
+=================================================
+*/
+	RawImageID  VCommandBuffer::CreateTransientImage (const ImageDesc &desc, StringView dbgName)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( _IsRecording() );
+
+		// image that can be used only as attachment may be placed in lazily allocated memory
+		ImageDesc	img_desc	= desc;
+		const bool	lazy_alloc	= not AnyBits( desc.usage, ~VImage::TransientAttachmentUsage );
+
+		if ( lazy_alloc )
+			img_desc.usage |= EImageUsage::TransientAttachment;
+
+		auto&		dev		= GetDevice();
+		RawImageID	id		= GetResourceManager().CreateImage( img_desc, MemoryDesc{ EMemoryType(EMemoryTypeExt::Virtual) }, Default,
+																	EResourceState::Unknown, dbgName );
+		CHECK_ERR( id );
+
+		// image will be destroyed when command batch complete execution
+		ReleaseResource( id );
+
+		// content of the image is undefined
+		AcquireImage( id, true, true );
+
+		auto*	image = ToLocal( id );
+		CHECK_ERR( image );
+
+		TransientImage	info;
+		info.id			= id;
+		info.handle		= image->Handle();
+		info.lazyAlloc	= lazy_alloc;
+		dev.vkGetImageMemoryRequirements( dev.GetVkDevice(), info.handle, OUT &info.memReq );
+
+		_transient.imageIndices.Insert( id.Index(), _mainAllocator ) = Index_t(_transient.images.size());
+		_transient.images.push_back( info );
+		return id;
+	}
+
 /*
 =================================================
 	AddTask (SubmitRenderPass)
@@ -1728,6 +2205,8 @@ namespace {
 		auto&		data = _rm.logicalRenderPasses[ index ];
 		Replace( data );
 
+		_transient.pass = &data.Data();
+
 		if ( not data.Create( *this, desc ))
 		{
 			_rm.logicalRenderPasses.Unassign( index );
@@ -1926,16 +2405,16 @@ namespace {
 	_ToLocal
 =================================================
 */
-	template <typename ID, typename Res, typename MainPool, size_t MC>
-	inline Res const*  VCommandBuffer::_ToLocal (ID id, INOUT LocalResPool<Res,MainPool,MC> &localRes, StringView msg)
+	template <typename ID, typename Res, typename MainPool, size_t CS, size_t MC, typename ...Args>
+	inline Res const*  VCommandBuffer::_ToLocal (ID id, INOUT LocalResPool<Res,MainPool,CS,MC> &localRes, StringView msg, Args&& ...args)
 	{
 		EXLOCK( _drCheck );
 		CHECK_ERR( _state == EState::Recording or _state == EState::Compiling );
 
-		if ( id.Index() >= localRes.toLocal.size() )
+		if ( id.Index() >= MainPool::capacity() )
 			return null;
 
-		Index_t&	local = localRes.toLocal[ id.Index() ];
+		Index_t&	local = localRes.toLocal.Insert( id.Index(), _mainAllocator );
 
 		if ( local != UMax )
 		{
@@ -1953,14 +2432,13 @@ namespace {
 		auto&	data = localRes.pool[ local ];
 		Replace( data );
 		
-		if ( not data.Create( res ))
+		if ( not data.Create( res, std::forward<Args>(args)... ))
 		{
 			localRes.pool.Unassign( local );
 			RETURN_ERR( msg );
 		}
 
-		localRes.maxLocalIndex  = Max( uint(local)+1, localRes.maxLocalIndex );
-		localRes.maxGlobalIndex = Max( uint(id.Index())+1, localRes.maxGlobalIndex );
+		localRes.maxLocalIndex = Max( uint(local)+1, localRes.maxLocalIndex );
 
 		return &(data.Data());
 	}
@@ -1972,12 +2450,17 @@ namespace {
 */
 	VLocalBuffer const*  VCommandBuffer::ToLocal (RawBufferID id)
 	{
-		return _ToLocal( id, _rm.buffers, "failed when creating local buffer" );
+		return _ToLocal( id, _rm.buffers, "failed when creating local buffer", _mainAllocator );
 	}
 
 	VLocalImage const*  VCommandBuffer::ToLocal (RawImageID id)
 	{
-		return _ToLocal( id, _rm.images, "failed when creating local image" );
+		auto*	result = _ToLocal( id, _rm.images, "failed when creating local image" );
+
+		if ( _transient.images.size() and result and result->ToGlobal()->IsTransient() and _IsRecording() )
+			_AddTransientUse( id );
+
+		return result;
 	}
 	
 #ifdef VK_NV_ray_tracing
@@ -2000,6 +2483,10 @@ namespace {
 		auto&	data = _rm.logicalRenderPasses[ id.Index() ];
 		ASSERT( data.IsCreated() );
 
+		// transient images in draw tasks are used when render pass is submitted
+		if ( _transient.images.size() and _IsRecording() )
+			_transient.pass = &data.Data();
+
 		return &data.Data();
 	}
 
@@ -2010,18 +2497,418 @@ namespace {
 */
 	void  VCommandBuffer::_ResetLocalRemaping ()
 	{
-		std::memset( _rm.images.toLocal.data(), ~0u, sizeof(Index_t)*_rm.images.maxGlobalIndex );
-		std::memset( _rm.buffers.toLocal.data(), ~0u, sizeof(Index_t)*_rm.buffers.maxGlobalIndex );
-		_rm.images.maxGlobalIndex	= 0;
-		_rm.buffers.maxGlobalIndex	= 0;
+		_rm.images.toLocal.Reset();
+		_rm.buffers.toLocal.Reset();
 		
 		#ifdef VK_NV_ray_tracing
-		std::memset( _rm.rtScenes.toLocal.data(), ~0u, sizeof(Index_t)*_rm.rtScenes.maxGlobalIndex );
-		std::memset( _rm.rtGeometries.toLocal.data(), ~0u, sizeof(Index_t)*_rm.rtGeometries.maxGlobalIndex );
-		_rm.rtScenes.maxGlobalIndex		= 0;
-		_rm.rtGeometries.maxGlobalIndex	= 0;
+		_rm.rtScenes.toLocal.Reset();
+		_rm.rtGeometries.toLocal.Reset();
 		#endif
 	}
+	
+/*
+=================================================
+	LocalIndexMap::Insert
+----
+	returns reference to local index, 'UMax' for new item.
+=================================================
+*/
+	VCommandBuffer::Index_t&  VCommandBuffer::LocalIndexMap::Insert (Index_t globalIdx, Allocator_t &alloc)
+	{
+		ASSERT( globalIdx != Index_t(UMax) );
+
+		// keep load factor less than 3/4
+		if_unlikely( (count + 1) * 4 > capacity * 3 )
+		{
+			const uint		new_capacity	= Max( capacity * 2, 64u );
+			Item*			new_items		= alloc.Alloc<Item>( new_capacity );
+			const Item*		old_items		= items;
+			const uint		old_capacity	= capacity;
+			
+			std::memset( new_items, ~0u, sizeof(Item) * new_capacity );
+
+			items		= new_items;
+			capacity	= new_capacity;
+			count		= 0;
+
+			// old memory will be discarded with allocator
+			for (uint i = 0; i < old_capacity; ++i)
+			{
+				if ( old_items[i].global != Index_t(UMax) )
+					Insert( old_items[i].global, alloc ) = old_items[i].local;
+			}
+		}
+
+		const uint	mask = capacity - 1;
+
+		for (uint i = (uint(globalIdx) * 0x9E3779B1u) & mask;; i = (i + 1) & mask)
+		{
+			auto&	item = items[i];
+
+			if ( item.global == globalIdx )
+				return item.local;
+
+			if ( item.global == Index_t(UMax) )
+			{
+				item.global = globalIdx;
+				++count;
+				return item.local;
+			}
+		}
+	}
+	
+/*
+=================================================
+	LocalIndexMap::Find
+----
+	returns local index, 'UMax' if not found.
+=================================================
+*/
+	VCommandBuffer::Index_t  VCommandBuffer::LocalIndexMap::Find (Index_t globalIdx) const
+	{
+		if ( capacity == 0 )
+			return Index_t(UMax);
+
+		const uint	mask = capacity - 1;
+
+		for (uint i = (uint(globalIdx) * 0x9E3779B1u) & mask;; i = (i + 1) & mask)
+		{
+			auto&	item = items[i];
+
+			if ( item.global == globalIdx )
+				return item.local;
+
+			if ( item.global == Index_t(UMax) )
+				return Index_t(UMax);
+		}
+	}
+	
+/*
+=================================================
+	LocalIndexMap::Reset
+=================================================
+*/
+	void  VCommandBuffer::LocalIndexMap::Reset ()
+	{
+		items		= null;
+		capacity	= 0;
+		count		= 0;
+	}
+//-----------------------------------------------------------------------------
+
+	
+/*
+=================================================
+	_AddTransientUse
+----
+	returns 'true' if image is transient
+=================================================
+*/
+	bool  VCommandBuffer::_AddTransientUse (RawImageID id)
+	{
+		const Index_t	idx = _transient.imageIndices.Find( id.Index() );
+
+		if ( idx == Index_t(UMax) or _transient.images[idx].id != id )
+			return false;
+
+		const uint	i = uint(idx);
+
+		// skip duplicates in current task or render pass
+		if ( _transient.uses.size() > _transient.firstTaskUse )
+		{
+			auto&	last = _transient.uses.back();
+			if ( last.image == i and last.pass == _transient.pass )
+				return true;
+		}
+
+		_transient.uses.push_back({ i, null, _transient.pass });
+		return true;
+	}
+	
+/*
+=================================================
+	_UsesTransientImages
+=================================================
+*/
+	bool  VCommandBuffer::_UsesTransientImages (const PipelineResources &desc)
+	{
+		auto const*	data = PipelineResourcesHelper::GetDynamicData( desc );
+		CHECK_ERR( data );
+
+		struct Visitor
+		{
+			VCommandBuffer &	cmd;
+			bool				found	= false;
+
+			Visitor (VCommandBuffer &cmd) : cmd{cmd}
+			{}
+
+			void operator () (const UniformID &, const PipelineResources::Image &img)
+			{
+				for (uint i = 0; i < img.elementCount; ++i)
+				{
+					auto&	elem = img.elements[i];
+					if ( elem.imageId )
+						found |= cmd._AddTransientUse( elem.imageId );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Texture &tex)
+			{
+				for (uint i = 0; i < tex.elementCount; ++i)
+				{
+					auto&	elem = tex.elements[i];
+					if ( elem.imageId )
+						found |= cmd._AddTransientUse( elem.imageId );
+				}
+			}
+
+			void operator () (const UniformID &, const PipelineResources::Buffer &) {}
+			void operator () (const UniformID &, const PipelineResources::TexelBuffer &) {}
+			void operator () (const UniformID &, const PipelineResources::Sampler &) {}
+			void operator () (const UniformID &, const PipelineResources::RayTracingScene &) {}
+		};
+
+		Visitor	vis{ *this };
+		data->ForEachUniform( vis );
+
+		return vis.found;
+	}
+	
+/*
+=================================================
+	_CalcTransientLifetimes
+----
+	tasks are visited in the same order as in '_ProcessTasks',
+	so execution order indices are equal to indices that will be used for barriers.
+	Image may be placed in lazily allocated memory only if it is never loaded or stored by render passes.
+=================================================
+*/
+	void  VCommandBuffer::_CalcTransientLifetimes ()
+	{
+		const auto	IsTileOnly = [] (const VLogicalRenderPass &pass, RawImageID id)
+		{
+			const auto	IsNotStored = [] (const VLogicalRenderPass::ColorTarget &rt) {
+				return rt.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD and rt.storeOp != VK_ATTACHMENT_STORE_OP_STORE;
+			};
+
+			for (auto& rt : pass.GetColorTargets()) {
+				if ( rt.imageId == id )
+					return IsNotStored( rt );
+			}
+
+			auto&	ds = pass.GetDepthStencilTarget();
+			if ( ds.IsDefined() and ds.imageId == id )
+				return IsNotStored( ds );
+
+			return false;
+		};
+
+		const uint		visitor_id		= 2;
+		ExeOrderIndex	exe_order_index	= ExeOrderIndex::First;
+
+		Unused( _taskGraph.Visit( GetAllocator(), visitor_id,
+								  [&exe_order_index] (VTask node) { node->SetExecutionOrder( ++exe_order_index ); }));
+
+		for (auto& node : _taskGraph.Nodes()) {
+			node->ResetInputs();
+		}
+
+		for (auto& use : _transient.uses)
+		{
+			VTask	task = use.task;
+
+			if ( use.pass )
+			{
+				for (auto& sub : _transient.submits)
+				{
+					if ( sub.first == use.pass ) {
+						task = sub.second;
+						break;
+					}
+				}
+			}
+
+			// image is used outside of task or render pass is not submitted
+			if ( not task or task->ExecutionOrder() == ExeOrderIndex::Initial )
+				continue;
+
+			auto&		image	= _transient.images[ use.image ];
+			const auto	index	= task->ExecutionOrder();
+
+			image.lazyAlloc &= (use.pass and IsTileOnly( *use.pass, image.id ));
+
+			if ( index < image.firstUse )	image.firstUse = index;
+			if ( index > image.lastUse )	image.lastUse  = index;
+		}
+	}
+	
+/*
+=================================================
+	_BindTransientImages
+----
+	images with non-overlapping lifetimes are placed at the same memory,
+	large images are placed first to minimize heap size.
+	Images that are used only inside render passes are placed in separate heaps with lazily allocated memory.
+=================================================
+*/
+	bool  VCommandBuffer::_BindTransientImages ()
+	{
+		if ( _transient.images.empty() )
+			return true;
+
+		_CalcTransientLifetimes();
+
+		struct MemoryHeap
+		{
+			uint				memTypeBits	= 0;
+			bool				lazyAlloc	= false;
+			VkDeviceSize		size		= 0;
+			VkDeviceSize		align		= 1;
+			VkDeviceMemory		memory		= VK_NULL_HANDLE;
+			VkDeviceSize		offset		= 0;
+			bool				isLazy		= false;	// 'true' if lazily allocated memory is supported
+		};
+
+		auto&				dev			= GetDevice();
+		auto&				images		= _transient.images;
+		auto&				stat		= EditStatistic().resources;
+		Array<MemoryHeap>	heaps;
+		Array<uint>			sorted;
+		Array<Pair<VkDeviceSize, VkDeviceSize>>	used_ranges;
+
+		const auto	IsAlive = [] (const TransientImage &lhs, const TransientImage &rhs) {
+			return lhs.firstUse <= rhs.lastUse and rhs.firstUse <= lhs.lastUse;
+		};
+		const auto	IsIntersects = [] (const TransientImage &lhs, const TransientImage &rhs) {
+			return lhs.offset < rhs.offset + rhs.memReq.size and rhs.offset < lhs.offset + lhs.memReq.size;
+		};
+
+		for (uint i = 0, cnt = uint(images.size()); i < cnt; ++i) {
+			sorted.push_back( i );
+		}
+		std::sort( sorted.begin(), sorted.end(), [&images] (uint lhs, uint rhs) { return images[lhs].memReq.size > images[rhs].memReq.size; });
+
+		// place images
+		for (uint idx : sorted)
+		{
+			auto&	image	= images[idx];
+			uint	heap_idx = 0;
+
+			for (; heap_idx < heaps.size(); ++heap_idx)
+			{
+				if ( heaps[heap_idx].memTypeBits == image.memReq.memoryTypeBits and heaps[heap_idx].lazyAlloc == image.lazyAlloc )
+					break;
+			}
+			if ( heap_idx == heaps.size() )
+				heaps.push_back( MemoryHeap{ image.memReq.memoryTypeBits, image.lazyAlloc });
+
+			// find memory ranges that are used at the same time
+			used_ranges.clear();
+			for (auto& other : images)
+			{
+				if ( other.heapIndex == heap_idx and IsAlive( image, other ))
+					used_ranges.emplace_back( other.offset, other.offset + other.memReq.size );
+			}
+			std::sort( used_ranges.begin(), used_ranges.end() );
+
+			VkDeviceSize	offset = 0;
+			for (auto& range : used_ranges)
+			{
+				if ( offset + image.memReq.size <= range.first )
+					break;
+
+				offset = Max( offset, AlignToLarger( range.second, image.memReq.alignment ));
+			}
+
+			auto&	heap	= heaps[heap_idx];
+			image.heapIndex	= heap_idx;
+			image.offset	= offset;
+			heap.size		= Max( heap.size, offset + image.memReq.size );
+			heap.align		= Max( heap.align, image.memReq.alignment );
+		}
+
+		// memory barrier is required when image reuses memory of previous image
+		for (auto& lhs : images)
+		for (auto& rhs : images)
+		{
+			if ( lhs.heapIndex == rhs.heapIndex				and
+				 lhs.lastUse != ExeOrderIndex::Initial		and
+				 rhs.firstUse != ExeOrderIndex::Unknown		and
+				 lhs.lastUse < rhs.firstUse					and
+				 IsIntersects( lhs, rhs ))
+			{
+				_transient.aliasing.push_back( rhs.firstUse );
+			}
+		}
+		std::sort( _transient.aliasing.begin(), _transient.aliasing.end() );
+		_transient.aliasing.erase( std::unique( _transient.aliasing.begin(), _transient.aliasing.end() ), _transient.aliasing.end() );
+
+		// allocate memory
+		auto&	mem_mngr = GetResourceManager().GetMemoryManager();
+
+		for (auto& heap : heaps)
+		{
+			VkMemoryRequirements	mem_req = {};
+			mem_req.size			= heap.size;
+			mem_req.alignment		= heap.align;
+			mem_req.memoryTypeBits	= heap.memTypeBits;
+
+			// device local memory is used if lazily allocated memory is not supported
+			VMemoryObj::Storage_t	storage;
+			CHECK_ERR( mem_mngr.AllocateMemory( mem_req, MemoryDesc{ heap.lazyAlloc ? EMemoryType::LazilyAllocated : EMemoryType::Default }, OUT storage ));
+			_batch->_transientHeaps.push_back( storage );
+
+			VMemoryObj::MemoryInfo	info;
+			CHECK_ERR( mem_mngr.GetMemoryInfo( storage, OUT info ));
+
+			heap.memory	= info.mem;
+			heap.offset	= VkDeviceSize(info.offset);
+			heap.isLazy	= AllBits( info.flags, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT );
+
+			stat.transientHeapMemory += BytesU{heap.size};
+		}
+
+		for (auto& image : images)
+		{
+			auto&	heap = heaps[ image.heapIndex ];
+			VK_CHECK( dev.vkBindImageMemory( dev.GetVkDevice(), image.handle, heap.memory, heap.offset + image.offset ));
+
+			stat.transientImageMemory		+= BytesU{image.memReq.size};
+			stat.lazyAllocRequestedImages	+= uint(heap.lazyAlloc);
+			stat.lazilyAllocatedImages		+= uint(heap.isLazy);
+		}
+		stat.transientImages += uint(images.size());
+
+		// create descriptor sets that were deferred until memory is bound
+		for (auto& [res, push_only] : _transient.descriptorSets)
+		{
+			const bool	created = push_only ? res->CreatePushDescriptors( GetResourceManager() ) :
+											  res->Create( GetResourceManager(), *_batch );
+			CHECK_ERR( created );
+		}
+		return true;
+	}
+	
+/*
+=================================================
+	_AddAliasingBarrier
+----
+	writes to the previous image must complete before layout transition of the image
+	that reuses the same memory.
+=================================================
+*/
+	void  VCommandBuffer::_AddAliasingBarrier ()
+	{
+		auto&	dev = GetDevice();
+
+		VkMemoryBarrier	barrier = {};
+		barrier.sType			= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		barrier.srcAccessMask	= VK_ACCESS_MEMORY_WRITE_BIT;
+		barrier.dstAccessMask	= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+		_barrierMngr.AddMemoryBarrier( dev.GetAllWritableStages(), dev.GetAllReadableStages() | dev.GetAllWritableStages(), barrier );
+	}
 //-----------------------------------------------------------------------------
 
 	
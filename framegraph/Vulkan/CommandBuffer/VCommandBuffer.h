@@ -20,6 +20,8 @@ namespace FG
 
 	class VCommandBuffer final : public ICommandBuffer
 	{
+		friend class VCommandBufferUnitTest;
+
 	// types
 	private:
 		enum class EState
@@ -29,7 +31,6 @@ namespace FG
 			Compiling,
 		};
 
-		using TempTaskArray_t	= std::vector< VTask, StdLinearAllocator<VTask> >;
 		using TaskGraph_t		= VTaskGraph< VTaskProcessor >;
 		using Allocator_t		= LinearAllocator<>;
 		using Statistic_t		= IFrameGraph::Statistics;
@@ -42,6 +43,7 @@ namespace FG
 		static constexpr auto	MaxBufferParts	= VCmdBatch::MaxBufferParts;
 		static constexpr auto	MaxImageParts	= VCmdBatch::MaxImageParts;
 		static constexpr auto	MinBufferPart	= 4_Kb;
+		static constexpr uint	MinDrawTasksPerThread	= 128;	// render pass is splitted into chunks for parallel recording
 
 		using PerQueueArray_t	= FixedArray< VCommandPool, 4 >;
 		
@@ -50,20 +52,79 @@ namespace FG
 		template <typename T, size_t CS, size_t MC>
 		using PoolTmpl			= ChunkedIndexedPool< ResourceBase<T>, Index_t, CS, MC >;
 		
-		template <typename Res, typename MainPool, size_t MC>
+		// open addressing hash table that maps global resource index to local index,
+		// memory is allocated in '_mainAllocator' which is discarded after compilation,
+		// so reset is just a pointer reset and memory depends only on count of used resources.
+		struct LocalIndexMap {
+			struct Item {
+				Index_t		global;
+				Index_t		local;
+			};
+
+			Item*		items		= null;
+			uint		capacity	= 0;		// power of 2
+			uint		count		= 0;
+
+			ND_ Index_t&  Insert (Index_t globalIdx, Allocator_t &alloc);
+			ND_ Index_t	  Find (Index_t globalIdx) const;
+				void	  Reset ();
+		};
+
+		template <typename Res, typename MainPool, size_t CS, size_t MC>
 		struct LocalResPool {
-			PoolTmpl< Res, MainPool::capacity()/MC, MC >		pool;
-			StaticArray< Index_t, MainPool::capacity() >		toLocal;
-			uint												maxLocalIndex	= 0;
-			uint												maxGlobalIndex	= uint(MainPool::capacity());
+			STATIC_ASSERT( CS * MC >= MainPool::capacity() );
+
+			PoolTmpl< Res, CS, MC >		pool;
+			LocalIndexMap				toLocal;
+			uint						maxLocalIndex	= 0;
 		};
 
-		using LocalImages_t			= LocalResPool< VLocalImage,		VResourceManager::ImagePool_t,		16 >;
-		using LocalBuffers_t		= LocalResPool< VLocalBuffer,		VResourceManager::BufferPool_t,		16 >;
-		using LocalRTScenes_t		= LocalResPool< VLocalRTScene,		VResourceManager::RTScenePool_t,	16 >;
-		using LocalRTGeometries_t	= LocalResPool< VLocalRTGeometry,	VResourceManager::RTGeometryPool_t,	16 >;
+		using LocalImages_t			= LocalResPool< VLocalImage,		VResourceManager::ImagePool_t,		1u<<10,	63 >;
+		using LocalBuffers_t		= LocalResPool< VLocalBuffer,		VResourceManager::BufferPool_t,		1u<<10,	63 >;
+		using LocalRTScenes_t		= LocalResPool< VLocalRTScene,		VResourceManager::RTScenePool_t,	1u<<9,	16 >;
+		using LocalRTGeometries_t	= LocalResPool< VLocalRTGeometry,	VResourceManager::RTGeometryPool_t,	1u<<9,	16 >;
 		using LogicalRenderPasses_t	= PoolTmpl< VLogicalRenderPass,		1u<<10,								16 >;
 		
+		// commands that are recorded into secondary command buffer and executed in primary command buffer
+		struct SecondaryCommands
+		{
+			VkCommandBuffer						cmdBuffer		= VK_NULL_HANDLE;
+			VCommandPool const*					cmdPool			= null;
+			VFgTask<SubmitRenderPass> const*	renderPass		= null;		// null for commands outside of render pass
+			ArrayView< IDrawTask *>				drawTasks;					// draw tasks of render pass that are recorded into this command buffer
+			VkRenderPassBeginInfo				passInfo		= {};
+			VkImageView							shadingRateImage = VK_NULL_HANDLE;
+		};
+
+		// image that is created in command buffer and shares memory with another transient images
+		struct TransientImage
+		{
+			RawImageID				id;
+			VkImage					handle		= VK_NULL_HANDLE;
+			VkMemoryRequirements	memReq		= {};
+			ExeOrderIndex			firstUse	= ExeOrderIndex::Unknown;
+			ExeOrderIndex			lastUse		= ExeOrderIndex::Initial;
+			uint					heapIndex	= UMax;
+			VkDeviceSize			offset		= 0;
+			bool					lazyAlloc	= false;	// image is used only inside render passes and may be placed in tile memory
+		};
+
+		// task or render pass that uses transient image
+		struct TransientUse
+		{
+			uint						image;
+			VTask						task;		// null if image is used in render pass
+			VLogicalRenderPass const*	pass;
+		};
+
+		// per thread data for parallel recording
+		struct RecordingWorker
+		{
+			PerQueueArray_t			cmdPools;
+			Allocator_t				allocator;
+			Statistic_t				statistic;
+		};
+		
 
 
 	// variables
@@ -97,11 +158,36 @@ namespace FG
 			
 			LogicalRenderPasses_t	logicalRenderPasses;
 			uint					logicalRenderPassCount	= 0;
+
+			Array< VPipelineResources *>	transientResources;		// allocated in '_mainAllocator'
 		}						_rm;
+
+		struct {
+			Array< TransientImage >			images;
+			Array< TransientUse >			uses;
+			LocalIndexMap					imageIndices;	// global image index to index in 'images'
+			Array< Pair< VLogicalRenderPass const*, VTask >>	submits;		// tasks that submit render passes
+			Array< Pair< VPipelineResources *, bool >>			descriptorSets;	// created when memory is bound, 'true' for push descriptors
+			Array< ExeOrderIndex >			aliasing;		// tasks that use memory of previous transient images
+			VLogicalRenderPass const*		pass			= null;	// draw tasks and attachments are used in render pass
+			size_t							firstTaskUse	= 0;
+		}						_transient;
 		
 		PerQueueArray_t			_perQueue;		// TODO: use global command pool manager to minimize memory usage
+
+		struct {
+			Array< SecondaryCommands >				commands;
+			Array< uint >							deferred;		// indices in 'commands' that will be recorded on worker threads
+			Array< UniquePtr< RecordingWorker >>	workers;
+			VkCommandBuffer							current			= VK_NULL_HANDLE;
+			bool									enabled			= false;
+		}						_parallel;
+
 		bool					_dbgFullBarriers	= false;
 		bool					_dbgQueueSync		= false;
+		bool					_singlePassDrawTasks	= false;
+		bool					_barrierPlanning	= false;
+		bool					_transientDescriptors	= false;
 
 		DataRaceCheck			_drCheck;
 
@@ -126,6 +212,8 @@ namespace FG
 
 		void		AcquireImage (RawImageID id, bool makeMutable, bool invalidate) override;
 		void		AcquireBuffer (RawBufferID id, bool makeMutable) override;
+		
+		RawImageID	CreateTransientImage (const ImageDesc &desc, StringView dbgName) override;
 
 
 		// tasks //
@@ -184,7 +272,18 @@ namespace FG
 		ND_ VLocalImage  const*		ToLocal (RawImageID id);
 		ND_ VLocalRTGeometry const*	ToLocal (RawRTGeometryID id);
 		ND_ VLocalRTScene const*	ToLocal (RawRTSceneID id);
-		ND_ VPipelineResources const* CreateDescriptorSet (const PipelineResources &desc);
+		ND_ VPipelineResources const* CreateDescriptorSet (const PipelineResources &desc, bool pushDescriptors = false);
+
+		// transient images //
+			void					BeginTransientUses ();
+			void					EndTransientUses (VTask task);
+
+
+		// parallel recording //
+		ND_ VkCommandBuffer			BeginRenderPassSecondary (const VkRenderPassBeginInfo &passInfo);
+		ND_ VkCommandBuffer			BeginCommandSegment ();
+		ND_ VkCommandBuffer			BeginRenderPassCommands (const VFgTask<SubmitRenderPass> &task, const VkRenderPassBeginInfo &passInfo,
+															 VkImageView shadingRateImage, bool deferred);
 
 		
 		ND_ StringView				GetName ()					const	{ EXLOCK( _drCheck );  return _batch->GetName(); }
@@ -203,6 +302,8 @@ namespace FG
 		ND_ EQueueFamily			GetQueueFamily ()			const	{ EXLOCK( _drCheck );  return _queueIndex; }
 		ND_ bool					IsDebugFullBarriers ()		const	{ EXLOCK( _drCheck );  return _dbgFullBarriers; }
 		ND_ bool					IsDebugQueueSync ()			const	{ EXLOCK( _drCheck );  return _dbgQueueSync; }
+		ND_ bool					IsSinglePassDrawTasks ()	const	{ EXLOCK( _drCheck );  return _singlePassDrawTasks; }
+		ND_ bool					IsBarrierPlanning ()		const	{ EXLOCK( _drCheck );  return _barrierPlanning; }
 
 
 	private:
@@ -224,14 +325,29 @@ namespace FG
 		bool  _BuildCommandBuffers ();
 		bool  _ProcessTasks (VkCommandBuffer cmd);
 		void  _AfterCompilation ();
+
+	// parallel recording //
+		bool  _InitRecordingWorkers (VDeviceQueueInfoPtr queue);
+		void  _EndSecondaryCommands ();
+		bool  _RecordDeferredRenderPasses ();
+		bool  _RecordRenderPassCommands (INOUT SecondaryCommands &, VCommandPool &, LinearAllocator<> &, IFrameGraph::RenderingStatistics &);
+		void  _ExecuteSecondaryCommands (VkCommandBuffer primary);
+		void  _BeginSecondary (VkCommandBuffer cmd, const VkRenderPassBeginInfo *passInfo) const;
 		
 
 	// resource manager //
-		template <typename ID, typename Res, typename MainPool, size_t MC>
-		ND_ Res const*  _ToLocal (ID id, INOUT LocalResPool<Res,MainPool,MC> &, StringView msg);
+		template <typename ID, typename Res, typename MainPool, size_t CS, size_t MC, typename ...Args>
+		ND_ Res const*  _ToLocal (ID id, INOUT LocalResPool<Res,MainPool,CS,MC> &, StringView msg, Args&& ...args);
 
 		void  _FlushLocalResourceStates (ExeOrderIndex, VBarrierManager &, Ptr<VLocalDebugger>);
 		void  _ResetLocalRemaping ();
+		
+	// transient images //
+		bool  _AddTransientUse (RawImageID id);
+		bool  _UsesTransientImages (const PipelineResources &desc);
+		bool  _BindTransientImages ();
+		void  _CalcTransientLifetimes ();
+		void  _AddAliasingBarrier ();
 
 
 	// queue //
@@ -240,6 +356,48 @@ namespace FG
 	};
 
 	
+/*
+=================================================
+	BeginTransientUses
+----
+	images that are used in task constructor belong to this task
+=================================================
+*/
+	inline void  VCommandBuffer::BeginTransientUses ()
+	{
+		if ( _transient.images.empty() )
+			return;
+
+		_transient.pass			= null;
+		_transient.firstTaskUse	= _transient.uses.size();
+	}
+	
+/*
+=================================================
+	EndTransientUses
+=================================================
+*/
+	inline void  VCommandBuffer::EndTransientUses (VTask task)
+	{
+		if ( _transient.images.empty() )
+			return;
+
+		for (size_t i = _transient.firstTaskUse; i < _transient.uses.size(); ++i)
+		{
+			auto&	use = _transient.uses[i];
+			if ( not use.pass )
+				use.task = task;
+		}
+		_transient.firstTaskUse = _transient.uses.size();
+
+		// only 'SubmitRenderPass' task uses render pass
+		if ( _transient.pass )
+		{
+			_transient.submits.emplace_back( _transient.pass, task );
+			_transient.pass = null;
+		}
+	}
+
 /*
 =================================================
 	AcquireTemporary
@@ -264,15 +422,5 @@ namespace FG
 		_rm.resourceMap.insert({ Resource_t{ id }, 0 }).first->second++;
 	}
 	
-/*
-=================================================
-	CreateDescriptorSet
-=================================================
-*/
-	inline VPipelineResources const*  VCommandBuffer::CreateDescriptorSet (const PipelineResources &desc)
-	{
-		return GetResourceManager().CreateDescriptorSet( desc, INOUT _rm.resourceMap );
-	}
-
 
 }	// FG
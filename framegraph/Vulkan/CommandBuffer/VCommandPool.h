@@ -15,7 +15,7 @@ namespace FG
 	{
 	// types
 	private:
-		using CmdBufPool_t	= FixedArray< VkCommandBuffer, 32 >;
+		using CmdBufPool_t	= Array< VkCommandBuffer >;
 
 
 	// variables
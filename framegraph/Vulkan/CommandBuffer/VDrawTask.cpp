@@ -0,0 +1,133 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VDrawTask.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	CalcDrawStateHash
+----
+	vertex locations are not defined before 'ApplyAttribs',
+	so hash and compare functions of 'VertexInputState' can't be used here.
+=================================================
+*/
+	HashVal  VBaseDrawVerticesTask::CalcDrawStateHash (const VertexInputState &vertexInput, const _fg_hidden_::ColorBuffers_t &colorBuffers,
+													   const _fg_hidden_::DynamicStates &ds, EPrimitive topology, bool primitiveRestart)
+	{
+		HashVal	result = HashOf( topology ) + HashOf( primitiveRestart );
+
+		for (size_t i = 0; i < colorBuffers.size(); ++i)
+		{
+			auto&	cb = colorBuffers[i];
+			result << HashOf( cb.first ) << HashOf( cb.second );
+		}
+
+		for (size_t i = 0; i < vertexInput.Vertices().size(); ++i)
+		{
+			auto&	vert = vertexInput.Vertices()[i];
+			result << HashOf( vert.first ) << HashOf( vert.second.type ) << HashOf( vert.second.offset ) << HashOf( vert.second.bufferBinding );
+		}
+
+		for (size_t i = 0; i < vertexInput.BufferBindings().size(); ++i)
+		{
+			auto&	bind = vertexInput.BufferBindings()[i];
+			result << HashOf( bind.first ) << HashOf( bind.second.index ) << HashOf( bind.second.stride ) << HashOf( bind.second.rate );
+		}
+
+		if ( ds.hasStencilTest )		result << HashOf( ds.stencilTest );
+		if ( ds.hasStencilFailOp )		result << HashOf( ds.stencilFailOp );
+		if ( ds.hasStencilDepthFailOp )	result << HashOf( ds.stencilDepthFailOp );
+		if ( ds.hasStencilPassOp )		result << HashOf( ds.stencilPassOp );
+
+		// only dynamic state flags affect the pipeline, values are set in command buffer
+		result << HashOf( ds.hasStencilReference ) << HashOf( ds.hasStencilWriteMask ) << HashOf( ds.hasStencilCompareMask );
+
+		if ( ds.hasDepthCompareOp )		result << HashOf( ds.depthCompareOp );
+		if ( ds.hasDepthTest )			result << HashOf( ds.depthTest );
+		if ( ds.hasDepthWrite )			result << HashOf( ds.depthWrite );
+		if ( ds.hasCullMode )			result << HashOf( ds.cullMode );
+		if ( ds.hasRasterizedDiscard )	result << HashOf( ds.rasterizerDiscard );
+		if ( ds.hasFrontFaceCCW )		result << HashOf( ds.frontFaceCCW );
+
+		return result;
+	}
+
+/*
+=================================================
+	IsSameVertexInput
+=================================================
+*/
+	bool  VBaseDrawVerticesTask::IsSameVertexInput (const VertexInputState &lhs, const VertexInputState &rhs)
+	{
+		if ( lhs.Vertices().size()		 != rhs.Vertices().size()		or
+			 lhs.BufferBindings().size() != rhs.BufferBindings().size() )
+			return false;
+
+		for (size_t i = 0; i < lhs.Vertices().size(); ++i)
+		{
+			auto&	lv = lhs.Vertices()[i];
+			auto&	rv = rhs.Vertices()[i];
+
+			if ( not (lv.first					== rv.first					and
+					  lv.second.type			== rv.second.type			and
+					  lv.second.offset			== rv.second.offset			and
+					  lv.second.bufferBinding	== rv.second.bufferBinding) )
+				return false;
+		}
+
+		for (size_t i = 0; i < lhs.BufferBindings().size(); ++i)
+		{
+			auto&	lb = lhs.BufferBindings()[i];
+			auto&	rb = rhs.BufferBindings()[i];
+
+			if ( not (lb.first == rb.first and lb.second == rb.second) )
+				return false;
+		}
+		return true;
+	}
+
+/*
+=================================================
+	IsSameDynamicStates
+=================================================
+*/
+	bool  VBaseDrawVerticesTask::IsSameDynamicStates (const _fg_hidden_::DynamicStates &lhs, const _fg_hidden_::DynamicStates &rhs)
+	{
+		#define CMP( _flag_, _value_ ) \
+			(lhs._flag_ == rhs._flag_ and (not lhs._flag_ or lhs._value_ == rhs._value_))
+
+		return	CMP( hasStencilTest,		stencilTest )			and
+				CMP( hasStencilFailOp,		stencilFailOp )			and
+				CMP( hasStencilDepthFailOp,	stencilDepthFailOp )	and
+				CMP( hasStencilPassOp,		stencilPassOp )			and
+				lhs.hasStencilReference		== rhs.hasStencilReference		and
+				lhs.hasStencilWriteMask		== rhs.hasStencilWriteMask		and
+				lhs.hasStencilCompareMask	== rhs.hasStencilCompareMask	and
+				CMP( hasDepthCompareOp,		depthCompareOp )		and
+				CMP( hasDepthTest,			depthTest )				and
+				CMP( hasDepthWrite,			depthWrite )			and
+				CMP( hasCullMode,			cullMode )				and
+				CMP( hasRasterizedDiscard,	rasterizerDiscard )		and
+				CMP( hasFrontFaceCCW,		frontFaceCCW );
+
+		#undef CMP
+	}
+
+/*
+=================================================
+	IsSameDrawState
+----
+	returns 'true' if both tasks will use same pipeline instance in same render pass.
+=================================================
+*/
+	bool  VBaseDrawVerticesTask::IsSameDrawState (const VBaseDrawVerticesTask &other) const
+	{
+		return	pipeline			== other.pipeline			and
+				debugModeIndex		== other.debugModeIndex		and
+				IsSameStates( *this, other );
+	}
+
+
+}	// FG
@@ -75,6 +75,8 @@ namespace FG
 
 	public:
 		VGraphicsPipeline const* const			pipeline;
+		VGraphicsPipeline const* const			fallbackPipeline;	// may be null
+		const RawGPipelineID					pipelineId;
 		const _fg_hidden_::PushConstants_t		pushConstants;
 
 		const VertexInputState					vertexInput;
@@ -85,7 +87,11 @@ namespace FG
 		const EPrimitive						topology;
 		const bool								primitiveRestart;
 
-		mutable VkDescriptorSets_t				descriptorSets;
+		const HashVal							drawStateHash;		// hash of states that are used to create pipeline instance
+
+		mutable VBoundDescriptorSets			descriptorSets;
+		mutable VkPipeline						pipelineInstance	= VK_NULL_HANDLE;	// created before draw commands recording, null if pipeline is compiling
+		mutable VPipelineLayout const*			pipelineLayout		= null;
 		
 
 	// methods
@@ -100,6 +106,27 @@ namespace FG
 		ND_ ArrayView< VLocalBuffer const*>	GetVertexBuffers ()		const	{ return ArrayView{ _vertexBuffers.data(), _vbCount }; }
 		ND_ ArrayView< VkDeviceSize >		GetVBOffsets ()			const	{ return ArrayView{ _vbOffsets.data(), _vbCount }; }
 		ND_ ArrayView< Bytes<uint> >		GetVBStrides ()			const	{ return ArrayView{ _vbStrides.data(), _vbCount }; }
+
+		ND_ bool  IsSameDrawState (const VBaseDrawVerticesTask &other) const;
+
+		ND_ static HashVal  CalcDrawStateHash (const VertexInputState &vertexInput, const _fg_hidden_::ColorBuffers_t &colorBuffers,
+											   const _fg_hidden_::DynamicStates &dynamicStates, EPrimitive topology, bool primitiveRestart);
+
+		ND_ static bool  IsSameVertexInput (const VertexInputState &lhs, const VertexInputState &rhs);
+		ND_ static bool  IsSameDynamicStates (const _fg_hidden_::DynamicStates &lhs, const _fg_hidden_::DynamicStates &rhs);
+
+		// compares states that are used to create pipeline instance,
+		// accepts any type with the same fields as the draw task.
+		template <typename L, typename R>
+		ND_ static bool  IsSameStates (const L &lhs, const R &rhs)
+		{
+			return	lhs.drawStateHash		== rhs.drawStateHash		and
+					lhs.topology			== rhs.topology				and
+					lhs.primitiveRestart	== rhs.primitiveRestart		and
+					IsSameDynamicStates( lhs.dynamicStates, rhs.dynamicStates ) and
+					lhs.colorBuffers		== rhs.colorBuffers			and
+					IsSameVertexInput( lhs.vertexInput, rhs.vertexInput );
+		}
 	};
 
 
@@ -236,7 +263,9 @@ namespace FG
 		const _fg_hidden_::ColorBuffers_t		colorBuffers;
 		const _fg_hidden_::DynamicStates		dynamicStates;
 
-		mutable VkDescriptorSets_t				descriptorSets;
+		mutable VBoundDescriptorSets			descriptorSets;
+		mutable VkPipeline						pipelineInstance	= VK_NULL_HANDLE;	// created before draw commands recording
+		mutable VPipelineLayout const*			pipelineLayout		= null;
 
 
 	// methods
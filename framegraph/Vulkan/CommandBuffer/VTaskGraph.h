@@ -4,6 +4,7 @@
 
 #include "framegraph/Public/FrameGraph.h"
 #include "framegraph/Shared/EnumUtils.h"
+#include "stl/CompileTime/TypeList.h"
 #include "VCommon.h"
 
 namespace FG
@@ -12,6 +13,10 @@ namespace FG
 	template <typename TaskType>
 	class VFgTask;
 
+	// these tasks are recorded outside of render pass and have no side effects before barriers are committed
+	using TransferTasks_t = TypeList< CopyBuffer, CopyImage, CopyBufferToImage, CopyImageToBuffer, BlitImage, ResolveImage,
+									  GenerateMipmaps, FillBuffer, ClearColorImage, ClearDepthStencilImage, UpdateBuffer >;
+
 
 
 	//
@@ -35,7 +40,9 @@ namespace FG
 		Name_t				_taskName;
 		RGBA8u				_debugColor;
 		uint				_visitorID		= 0;
+		uint				_inDegree		= 0;	// number of input tasks that are not processed yet
 		ExeOrderIndex		_exeOrderIdx	= ExeOrderIndex::Initial;
+		bool				_isTransfer		= false;	// see 'TransferTasks_t'
 
 
 	// methods
@@ -47,7 +54,9 @@ namespace FG
 		explicit VFrameGraphTask (const _fg_hidden_::BaseTask<T> &task, ProcessFunc_t process) :
 			_processFunc{ process },
 			_taskName{ task.taskName },
-			_debugColor{ task.debugColor }
+			_debugColor{ task.debugColor },
+			_inDegree{ uint(task.depends.size()) },
+			_isTransfer{ TransferTasks_t::HasType<T> }
 		{
 			_inputs.resize( task.depends.size() );
 
@@ -69,6 +78,8 @@ namespace FG
 		ND_ RGBA8u				DebugColor ()		const	{ return _debugColor; }
 		ND_ uint				VisitorID ()		const	{ return _visitorID; }
 		ND_ ExeOrderIndex		ExecutionOrder ()	const	{ return _exeOrderIdx; }
+		ND_ bool				IsReady ()			const	{ return _inDegree == 0; }
+		ND_ bool				IsTransfer ()		const	{ return _isTransfer; }
 
 		ND_ ArrayView< VTask >	Inputs ()			const	{ return _inputs; }
 		ND_ ArrayView< VTask >	Outputs ()			const	{ return _outputs; }
@@ -76,6 +87,8 @@ namespace FG
 			void Attach (VTask output)						{ _outputs.push_back( output ); }
 			void SetVisitorID (uint id)						{ _visitorID = id; }
 			void SetExecutionOrder (ExeOrderIndex idx)		{ _exeOrderIdx = idx; }
+			void OnInputProcessed ()						{ ASSERT( _inDegree > 0 );  --_inDegree; }
+			void ResetInputs ()								{ _inDegree = uint(_inputs.size()); }
 
 			void Process (void *visitor)			const	{ ASSERT( _processFunc );  _processFunc( visitor, this ); }
 	};
@@ -728,6 +741,7 @@ namespace FG
 	private:
 		InPlace<SearchableNodes_t>	_nodes;
 		InPlace<Entries_t>			_entries;
+		size_t						_edgeCount	= 0;
 
 
 	// methods
@@ -741,9 +755,14 @@ namespace FG
 		void OnStart (Allocator_t &);
 		void OnDiscardMemory ();
 
-		ND_ ArrayView<VTask>	Entries ()		const	{ return *_entries; }
-		ND_ size_t				Count ()		const	{ return _nodes->size(); }
-		ND_ bool				Empty ()		const	{ return _nodes->empty(); }
+		template <typename FnT>
+		ND_ size_t  Visit (Allocator_t &alloc, uint visitorID, FnT &&fn) const;
+
+		ND_ ArrayView<VTask>			Entries ()		const	{ return *_entries; }
+		ND_ SearchableNodes_t const&	Nodes ()		const	{ return *_nodes; }
+		ND_ size_t						EdgeCount ()	const	{ return _edgeCount; }
+		ND_ size_t						Count ()		const	{ return _nodes->size(); }
+		ND_ bool						Empty ()		const	{ return _nodes->empty(); }
 
 
 	private:
@@ -755,6 +774,51 @@ namespace FG
 	};
 
 
+/*
+=================================================
+	VisitTasksInTopologicalOrder
+----
+	Kahn's algorithm: task is processed when all input tasks have been processed.
+	Queue has one slot per entry and per edge, so it is allocated only once,
+	task is processed in the first slot where it is ready.
+	Returns number of processed tasks, all other tasks are in cycle or depend on unknown task.
+=================================================
+*/
+	template <typename FnT>
+	inline size_t  VisitTasksInTopologicalOrder (ArrayView<VTask> entries, size_t edgeCount, uint visitorID, LinearAllocator<> &alloc, FnT &&fn)
+	{
+		const size_t	capacity	= entries.size() + edgeCount;
+		VTask *			queue		= alloc.Alloc< VTask >( capacity );
+		size_t			count		= 0;
+		size_t			processed	= 0;
+
+		for (auto node : entries) {
+			queue[count++] = node;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			VTask	node = queue[i];
+
+			if ( node->VisitorID() == visitorID or not node->IsReady() )
+				continue;
+
+			node->SetVisitorID( visitorID );
+			fn( node );
+			++processed;
+
+			for (auto out_node : node->Outputs())
+			{
+				out_node->OnInputProcessed();
+
+				ASSERT( count < capacity );
+				queue[count++] = out_node;
+			}
+		}
+		return processed;
+	}
+
+
 	/*
 	//
 	// Render Pass Graph
@@ -785,6 +849,7 @@ namespace FG
 		_nodes.Create( alloc );
 		_entries.Create( alloc );
 		_entries->reserve( 64 );
+		_edgeCount = 0;
 	}
 	
 /*
@@ -798,6 +863,18 @@ namespace FG
 		_nodes.Destroy();
 		_entries.Destroy();
 	}
+	
+/*
+=================================================
+	Visit
+=================================================
+*/
+	template <typename VisitorT>
+	template <typename FnT>
+	inline size_t  VTaskGraph<VisitorT>::Visit (Allocator_t &alloc, uint visitorID, FnT &&fn) const
+	{
+		return VisitTasksInTopologicalOrder( *_entries, _edgeCount, visitorID, alloc, std::forward<FnT>(fn) );
+	}
 
 
 }	// FG
@@ -19,7 +19,10 @@ namespace FG
 	{
 		auto*	ptr  = cb.GetAllocator().Alloc< VFgTask<T> >();
 
+		cb.BeginTransientUses();
 		PlacementNew< VFgTask<T> >( OUT ptr, cb, task, &_Visitor<T> );
+		cb.EndTransientUses( ptr );
+
 		CHECK_ERR( ptr->IsValid() );
 
 		_nodes->insert( ptr );
@@ -27,6 +30,8 @@ namespace FG
 		if ( ptr->Inputs().empty() )
 			_entries->push_back( ptr );
 
+		_edgeCount += ptr->Inputs().size();
+
 		for (auto in_node : ptr->Inputs())
 		{
 			ASSERT( !!_nodes->count( in_node ));
@@ -64,12 +69,28 @@ namespace FG
 //-----------------------------------------------------------------------------
 	
 	
+/*
+=================================================
+	GetPushDescriptorSet
+=================================================
+*/
+	template <typename PipelineType>
+	ND_ inline DescriptorSetID  GetPushDescriptorSet (VCommandBuffer &cb, const PipelineType *pipeline)
+	{
+		if ( not pipeline )
+			return Default;
+
+		auto const*	layout = cb.GetResourceManager().GetResource( pipeline->GetLayoutID(), false, true );
+		return layout ? layout->GetPushDescriptorSet() : Default;
+	}
+
 /*
 =================================================
 	CopyDescriptorSets
 =================================================
 */
-	inline void CopyDescriptorSets (VLogicalRenderPass *rp, VCommandBuffer &cb, const PipelineResourceSet &inResourceSet, OUT VPipelineResourceSet &outResourceSet)
+	inline void CopyDescriptorSets (VLogicalRenderPass *rp, VCommandBuffer &cb, const DescriptorSetID &pushDescSet,
+									const PipelineResourceSet &inResourceSet, OUT VPipelineResourceSet &outResourceSet)
 	{
 		uint	offset_count = 0;
 
@@ -77,7 +98,7 @@ namespace FG
 		{
 			auto	offsets = src.second->GetDynamicOffsets();
 
-			outResourceSet.resources.emplace_back( src.first, cb.CreateDescriptorSet( *src.second ),
+			outResourceSet.resources.emplace_back( src.first, cb.CreateDescriptorSet( *src.second, src.first == pushDescSet ),
 												   offset_count, CheckCast<uint>(offsets.size()) );
 			
 			for (size_t i = 0; i < offsets.size(); ++i, ++offset_count) {
@@ -155,13 +176,18 @@ namespace FG
 	VBaseDrawVerticesTask::VBaseDrawVerticesTask (VLogicalRenderPass &rp, VCommandBuffer &cb, const TaskType &task, ProcessFunc_t pass1, ProcessFunc_t pass2) :
 		IDrawTask{ task, pass1, pass2 },				_vbCount{ uint(task.vertexBuffers.size()) },
 		pipeline{ cb.AcquireTemporary( task.pipeline )},
-		pushConstants{ task.pushConstants },			vertexInput{ task.vertexInput },
+		fallbackPipeline{ task.fallbackPipeline ? cb.AcquireTemporary( task.fallbackPipeline ) : null },
+		pipelineId{ task.pipeline },					pushConstants{ task.pushConstants },
+		vertexInput{ task.vertexInput },
 		colorBuffers{ task.colorBuffers },				dynamicStates{ task.dynamicStates },
-		topology{ task.topology },						primitiveRestart{ task.primitiveRestart }
+		topology{ task.topology },						primitiveRestart{ task.primitiveRestart },
+		drawStateHash{ CalcDrawStateHash( task.vertexInput, task.colorBuffers, task.dynamicStates, task.topology, task.primitiveRestart )}
 	{
 		CopyScissors( cb, task.scissors, OUT _scissors );
-		CopyDescriptorSets( &rp, cb, task.resources, OUT _resources );
+		CopyDescriptorSets( &rp, cb, GetPushDescriptorSet( cb, pipeline ), task.resources, OUT _resources );
 		RemapVertexBuffers( cb, task.vertexBuffers, task.vertexInput, OUT _vertexBuffers, OUT _vbOffsets, OUT _vbStrides );
+		
+		rp._MergePipeline( dynamicStates, pipeline->IsEarlyFragmentTests() );
 
 		if ( task.debugMode.mode != Default )
 			debugModeIndex = cb.GetBatch().AppendShader( INOUT _scissors, task.taskName, task.debugMode );
@@ -259,8 +285,10 @@ namespace FG
 		dynamicStates{ task.dynamicStates }
 	{
 		CopyScissors( cb, task.scissors, OUT _scissors );
-		CopyDescriptorSets( &rp, cb, task.resources, OUT _resources );
+		CopyDescriptorSets( &rp, cb, GetPushDescriptorSet( cb, pipeline ), task.resources, OUT _resources );
 		
+		rp._MergePipeline( dynamicStates, pipeline->IsEarlyFragmentTests() );
+
 		if ( task.debugMode.mode != Default )
 			debugModeIndex = cb.GetBatch().AppendShader( INOUT _scissors, task.taskName, task.debugMode );
 	}
@@ -344,7 +372,7 @@ namespace FG
 		pushConstants{ task.pushConstants },	commands{ task.commands },
 		localGroupSize{ task.localGroupSize }
 	{
-		CopyDescriptorSets( null, cb, task.resources, OUT _resources );
+		CopyDescriptorSets( null, cb, GetPushDescriptorSet( cb, pipeline ), task.resources, OUT _resources );
 		
 		if ( task.debugMode.mode != Default )
 			debugModeIndex = cb.GetBatch().AppendShader( task.taskName, task.debugMode );
@@ -374,7 +402,7 @@ namespace FG
 	{
 		ASSERT( indirectBuffer and AllBits( indirectBuffer->Description().usage, EBufferUsage::Indirect ));
 
-		CopyDescriptorSets( null, cb, task.resources, OUT _resources );
+		CopyDescriptorSets( null, cb, GetPushDescriptorSet( cb, pipeline ), task.resources, OUT _resources );
 		
 		if ( task.debugMode.mode != Default )
 			debugModeIndex = cb.GetBatch().AppendShader( task.taskName, task.debugMode );
@@ -786,7 +814,8 @@ namespace FG
 		VFrameGraphTask{ task, process },		shaderTable{ cb.AcquireTemporary( task.shaderTable )},
 		pushConstants{ task.pushConstants },	groupCount{ Max( task.groupCount, 1u )}
 	{
-		CopyDescriptorSets( null, cb, task.resources, OUT _resources );
+		// pipeline layout is defined by shader table, so descriptor writes are pushed from created descriptor set
+		CopyDescriptorSets( null, cb, Default, task.resources, OUT _resources );
 
 		if ( task.debugMode.mode != Default )
 			debugModeIndex = cb.GetBatch().AppendShader( task.taskName, task.debugMode );
@@ -32,7 +32,7 @@ namespace FG
 
 	inline VTaskProcessor::Statistic_t&  VTaskProcessor::Stat () const
 	{
-		return _fgThread.EditStatistic().renderer;
+		return _stat;
 	}
 
 	inline uint64_t  CalcPrimitiveCount (uint vertCount, EPrimitive topology, uint patchSize)
@@ -92,26 +92,11 @@ namespace FG
 	//
 	class VTaskProcessor::DrawTaskBarriers final
 	{
-	// types
-	private:
-		using FragmentOutput	= GraphicsPipelineDesc::FragmentOutput;
-		using FragOutputs_t		= StaticArray< FragmentOutput, FG_MaxColorBuffers >;
-
-
 	// variables
 	private:
 		VTaskProcessor &			_tp;
 		VLogicalRenderPass const&	_logicalRP;
-
-		FragOutputs_t				_fragOutput;
-		uint						_maxFragCount;
-
-		bool						_earlyFragmentTests		: 1;
-		bool						_lateFragmentTests		: 1;
-		bool						_depthWrite				: 1;
-		bool						_stencilWrite			: 1;
-		bool						_rasterizerDiscard		: 1;
-		bool						_compatibleFragOutput	: 1;
+		bool						_parallel;		// draw commands may be recorded on another thread
 
 
 	// methods
@@ -129,20 +114,13 @@ namespace FG
 		void  Visit (const VFgDrawTask<FG::DrawMeshesIndirectCount> &task);
 		void  Visit (const VFgDrawTask<FG::CustomDraw> &task);
 
-		template <typename PipelineType>
-		void  _MergePipeline (const _fg_hidden_::DynamicStates &, const PipelineType *);
+		template <typename DrawTask>
+		void  _CreatePipeline (const DrawTask &task);
 		
 		template <typename DrawTask>
 		void  _ExtractDescriptorSets (RawPipelineLayoutID layoutId, const DrawTask &task);
 
-		ND_ bool						IsEarlyFragmentTests ()			const	{ return _earlyFragmentTests; }
-		ND_ bool						IsLateFragmentTests ()			const	{ return _lateFragmentTests; }
-		ND_ bool						IsFragmentOutputCompatible ()	const	{ return _compatibleFragOutput; }
-		ND_ bool						HasDepthWriteAccess ()			const	{ return _depthWrite; }
-		ND_ bool						HasStencilWriteAccess ()		const	{ return _stencilWrite; }
-		ND_ bool						IsRasterizerDiscard ()			const	{ return _rasterizerDiscard; }
-
-		ND_ ArrayView<FragmentOutput>	GetFragOutputs ()				const	{ return ArrayView<FragmentOutput>{ _fragOutput.data(), _maxFragCount }; }
+		ND_ bool	CanBeRecordedInParallel ()	const	{ return _parallel; }
 	};
 
 
@@ -409,29 +387,8 @@ namespace FG
 =================================================
 */
 	VTaskProcessor::DrawTaskBarriers::DrawTaskBarriers (VTaskProcessor &tp, const VLogicalRenderPass &logicalRP) :
-		_tp{ tp },						_logicalRP{ logicalRP },
-		_maxFragCount{ 0 },
-		_earlyFragmentTests{false},		_lateFragmentTests{false},
-		_depthWrite{ _logicalRP.GetDepthState().write },
-		_stencilWrite{ false },
-		_rasterizerDiscard{ _logicalRP.GetRasterizationState().rasterizerDiscard },
-		_compatibleFragOutput{true}
+		_tp{ tp },	_logicalRP{ logicalRP },	_parallel{ true }
 	{
-		// invalidate fragment output
-		for (auto& frag : _fragOutput)
-		{
-			frag.index	= UMax;
-			frag.type	= EFragOutput::Unknown;
-		}
-
-		auto&	stencil_st = _logicalRP.GetStencilState();
-		_stencilWrite |= not stencil_st.enabled ? 0 :
-						 (stencil_st.front.failOp		!= EStencilOp::Keep) |
-						 (stencil_st.front.depthFailOp	!= EStencilOp::Keep) |
-						 (stencil_st.front.passOp		!= EStencilOp::Keep) |
-						 (stencil_st.back.failOp		!= EStencilOp::Keep) |
-						 (stencil_st.back.depthFailOp	!= EStencilOp::Keep) |
-						 (stencil_st.back.passOp		!= EStencilOp::Keep);
 	}
 
 /*
@@ -459,7 +416,7 @@ namespace FG
 			}
 		}
 		
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	}
 
 /*
@@ -488,7 +445,7 @@ namespace FG
 			_tp._AddBuffer( task.indexBuffer, EResourceState::IndexBuffer, offset, size );
 		}
 		
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	}
 	
 /*
@@ -513,7 +470,7 @@ namespace FG
 			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	}
 	
 /*
@@ -541,7 +498,7 @@ namespace FG
 			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 		
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	}
 	
 /*
@@ -567,7 +524,7 @@ namespace FG
 			_tp._AddBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
 		}
 
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	}
 	
 /*
@@ -596,7 +553,7 @@ namespace FG
 			_tp._AddBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
 		}
 		
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	}
 	
 /*
@@ -610,7 +567,7 @@ namespace FG
 		// update descriptor sets and add pipeline barriers
 		_ExtractDescriptorSets( task.pipeline->GetLayoutID(), task );
 		
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	#else
 		Unused( task );
 	#endif
@@ -633,7 +590,7 @@ namespace FG
 			_tp._AddBuffer( task.indirectBuffer, EResourceState::IndirectBuffer, VkDeviceSize(cmd.indirectBufferOffset), VkDeviceSize(cmd.stride) * cmd.drawCount );
 		}
 
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	#else
 		Unused( task );
 	#endif
@@ -657,7 +614,7 @@ namespace FG
 			_tp._AddBuffer( task.countBuffer,    EResourceState::IndirectBuffer, VkDeviceSize(cmd.countBufferOffset),    sizeof(uint) );
 		}
 
-		_MergePipeline( task.dynamicStates, task.pipeline );
+		_CreatePipeline( task );
 	#else
 		Unused( task );
 	#endif
@@ -672,6 +629,9 @@ namespace FG
 	{
 		EResourceState	stages = _tp._fgThread.GetDevice().GetGraphicsShaderStages();
 
+		// custom draw uses command buffer services that are not thread safe
+		_parallel = false;
+
 		for (auto& item : task.GetImages())
 		{
 			ImageViewDesc	desc{ item.first->Description() };
@@ -697,28 +657,16 @@ namespace FG
 
 /*
 =================================================
-	_MergePipeline
+	_CreatePipeline
 =================================================
 */
-	template <typename PipelineType>
-	inline void  VTaskProcessor::DrawTaskBarriers::_MergePipeline (const _fg_hidden_::DynamicStates &ds,const PipelineType* pipeline)
+	template <typename DrawTask>
+	inline void  VTaskProcessor::DrawTaskBarriers::_CreatePipeline (const DrawTask &task)
 	{
-		STATIC_ASSERT(	(IsSameTypes<PipelineType, VGraphicsPipeline>) or
-						(IsSameTypes<PipelineType, VMeshPipeline>) );
-
-		if ( pipeline->IsEarlyFragmentTests() )
-			_earlyFragmentTests = true;
-		else
-			_lateFragmentTests = true;
-
-		_depthWrite |= (ds.hasDepthWrite & ds.depthWrite);
+		CHECK( _tp._CreatePipeline( _logicalRP, task ));
 
-		_stencilWrite |= not (ds.hasStencilTest | _logicalRP.GetStencilState().enabled) ? false :
-						 bool(ds.hasStencilFailOp      & (ds.stencilFailOp      != EStencilOp::Keep)) |
-						 bool(ds.hasStencilDepthFailOp & (ds.stencilDepthFailOp != EStencilOp::Keep)) |
-						 bool(ds.hasStencilPassOp      & (ds.stencilPassOp      != EStencilOp::Keep));
-
-		_rasterizerDiscard &= not _logicalRP.GetRasterizationState().rasterizerDiscard;
+		// shader debugger uses descriptor sets from command batch
+		_parallel &= (task.debugModeIndex == Default);
 	}
 //-----------------------------------------------------------------------------
 
@@ -751,6 +699,16 @@ namespace FG
 			buffers[i] = vertexBuffers[i]->Handle();
 		}
 
+		// skip if previous draw task used same vertex buffers
+		auto&	bound = _tp._vertexBuffers;
+
+		if ( ArrayView<VkBuffer>{ bound.buffers } == ArrayView<VkBuffer>{ buffers } and
+			 ArrayView<VkDeviceSize>{ bound.offsets } == vertexOffsets )
+			return;
+
+		bound.buffers = buffers;
+		bound.offsets = vertexOffsets;
+
 		_tp.vkCmdBindVertexBuffers( _cmdBuffer, 0, uint(buffers.size()), buffers.data(), vertexOffsets.data() );
 		_tp.Stat().vertexBufferBindings ++;
 	}
@@ -763,18 +721,7 @@ namespace FG
 	template <typename DrawTask>
 	void  VTaskProcessor::DrawTaskCommands::_BindPipelineResources (const VPipelineLayout &layout, const DrawTask &task) const
 	{
-		if ( task.descriptorSets.size() )
-		{
-			_tp.vkCmdBindDescriptorSets( _cmdBuffer,
-										  VK_PIPELINE_BIND_POINT_GRAPHICS,
-										  layout.Handle(),
-										  layout.GetFirstDescriptorSet(),
-										  uint(task.descriptorSets.size()),
-										  task.descriptorSets.data(),
-										  uint(task.GetResources().dynamicOffsets.size()),
-										  task.GetResources().dynamicOffsets.data() );
-			_tp.Stat().descriptorBinds ++;
-		}
+		_tp._BindGraphicsDescriptorSets( _cmdBuffer, layout, task.descriptorSets, task.GetResources().dynamicOffsets );
 		
 		if ( task.debugModeIndex != Default )
 		{
@@ -784,6 +731,9 @@ namespace FG
 			
 			_tp.vkCmdBindDescriptorSets( _cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout.Handle(), binding, 1, &desc_set, 1, &offset );
 			_tp.Stat().descriptorBinds ++;
+
+			// debug descriptor set replaces one of the cached sets
+			_tp._graphicsDescSets.layout = VK_NULL_HANDLE;
 		}
 	}
 
@@ -799,6 +749,9 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
+		if ( not task.pipelineInstance )
+			return;	// pipeline is compiling, see '_CreatePipeline'
+
 		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
 
 		_BindPipelineResources( *layout, task );
@@ -829,6 +782,9 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
+		if ( not task.pipelineInstance )
+			return;	// pipeline is compiling, see '_CreatePipeline'
+
 		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
 
 		_BindPipelineResources( *layout, task );
@@ -860,6 +816,9 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
+		if ( not task.pipelineInstance )
+			return;	// pipeline is compiling, see '_CreatePipeline'
+
 		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
 
 		_BindPipelineResources( *layout, task );
@@ -895,6 +854,9 @@ namespace FG
 		VPipelineLayout const*	layout	= null;
 		auto&					stat	= _tp.Stat();
 
+		if ( not task.pipelineInstance )
+			return;	// pipeline is compiling, see '_CreatePipeline'
+
 		CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
 
 		_BindPipelineResources( *layout, task );
@@ -933,6 +895,9 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
+			if ( not task.pipelineInstance )
+				return;	// pipeline is compiling, see '_CreatePipeline'
+
 			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
 
 			_BindPipelineResources( *layout, task );
@@ -972,6 +937,9 @@ namespace FG
 			VPipelineLayout const*	layout	= null;
 			auto&					stat	= _tp.Stat();
 
+			if ( not task.pipelineInstance )
+				return;	// pipeline is compiling, see '_CreatePipeline'
+
 			CHECK_ERRV( _tp._BindPipeline( *_currTask->GetLogicalPass(), task, OUT layout ));
 
 			_BindPipelineResources( *layout, task );
@@ -1129,6 +1097,9 @@ namespace FG
 		DrawContext	ctx{ _tp, *_currTask->GetLogicalPass() };
 
 		task.callback( task.callbackParam, ctx );
+
+		// bindings may be changed by custom draw
+		_tp._InvalidateBindings();
 	}
 //-----------------------------------------------------------------------------
 	
@@ -1292,14 +1263,26 @@ namespace FG
 		_BindPipeline( ALL_BITS );
 		CHECK_ERRV( _pplnLayout );
 
-		VPipelineResources const*	ppln_res = _tp._fgThread.CreateDescriptorSet( res );
-		VkDescriptorSet				ds		 = ppln_res->Handle();
-		ArrayView<uint>				dyn_offs = res.GetDynamicOffsets();
+		const bool					is_push	 = (id == _pplnLayout->GetPushDescriptorSet());
+		VPipelineResources const*	ppln_res = _tp._fgThread.CreateDescriptorSet( res, is_push );
+		CHECK_ERRV( ppln_res );
 
 		RawDescriptorSetLayoutID	ds_layout;
 		uint						binding;
 		_pplnLayout->GetDescriptorSetLayout( id, OUT ds_layout, OUT binding );
 
+		if ( is_push )
+		{
+			auto	writes = ppln_res->GetPushDescriptors();
+
+			_tp.vkCmdPushDescriptorSetKHR( _tp._cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pplnLayout->Handle(), binding, uint(writes.size()), writes.data() );
+			_tp.Stat().pushDescriptors ++;
+			return;
+		}
+
+		VkDescriptorSet		ds		 = ppln_res->Handle();
+		ArrayView<uint>		dyn_offs = res.GetDynamicOffsets();
+
 		_tp.vkCmdBindDescriptorSets( _tp._cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, _pplnLayout->Handle(), binding, 1, &ds, uint(dyn_offs.size()), dyn_offs.data() );
 		_tp.Stat().descriptorBinds ++;
 	}
@@ -1774,12 +1757,21 @@ namespace FG
 	constructor
 =================================================
 */
-	VTaskProcessor::VTaskProcessor (VCommandBuffer &fgThread, VkCommandBuffer cmd) :
+	VTaskProcessor::VTaskProcessor (VCommandBuffer &fgThread, VkCommandBuffer cmd, LinearAllocator<> &allocator, Statistic_t &stat) :
 		_fgThread{ fgThread },
 		_cmdBuffer{ cmd },
+		_stat{ stat },
 		_enableDebugUtils{ _fgThread.GetDevice().GetFeatures().debugUtils },
 		_isDefaultScissor{ false },	
 		_perPassStatesUpdated{ false },
+		_parallelRecording{ false },
+		_singlePassDrawTasks{ false },
+		_rootDebugGroup{ false },
+		_splitBarriers{ false },
+		_barrierPlanning{ false },
+		_planning{ false },
+		_recordOnly{ false },
+		_insideRenderPass{ false },
 		_dispatchBase{ _fgThread.GetDevice().GetFeatures().dispatchBase },
 		_drawIndirectCount{ _fgThread.GetDevice().GetFeatures().drawIndirectCount },
 		_meshShaderNV{ _fgThread.GetDevice().GetFeatures().meshShaderNV },
@@ -1788,13 +1780,31 @@ namespace FG
 		#ifdef VK_NV_mesh_shader
 		_maxMeshTaskCount{ _fgThread.GetDevice().GetProperties().meshShaderProperties.maxDrawMeshTasksCount },
 		#endif
-		_pendingResourceBarriers{ fgThread.GetAllocator() }
+		_pendingResourceBarriers{ allocator },
+		_plannedImages{ allocator },
+		_plannedBuffers{ allocator },
+		_plannedBarriers{ allocator },
+		_plannedTasks{ allocator }
 	{
 		ASSERT( _cmdBuffer );
 		
 		VulkanDeviceFn_Init( _fgThread.GetDevice() );
+	}
+	
+	VTaskProcessor::VTaskProcessor (VCommandBuffer &fgThread, VkCommandBuffer cmd, bool parallelRecording) :
+		VTaskProcessor{ fgThread, cmd, fgThread.GetAllocator(), fgThread.EditStatistic().renderer }
+	{
+		_parallelRecording		= parallelRecording;
+		_singlePassDrawTasks	= fgThread.IsSinglePassDrawTasks();
+		_splitBarriers			= fgThread.GetBarrierManager().IsSplitBarriers();
+		_barrierPlanning		= fgThread.IsBarrierPlanning();
 
-		_CmdPushDebugGroup( "CommandBuffer: "s << (fgThread.GetName().size() ? fgThread.GetName() : ToString<16>( size_t(_cmdBuffer) )), RGBA8u{255} );
+		// debug group can not be shared between secondary command buffers
+		if ( not _parallelRecording )
+		{
+			_rootDebugGroup = true;
+			_CmdPushDebugGroup( "CommandBuffer: "s << (fgThread.GetName().size() ? fgThread.GetName() : ToString<16>( size_t(_cmdBuffer) )), RGBA8u{255} );
+		}
 	}
 	
 /*
@@ -1804,7 +1814,10 @@ namespace FG
 */
 	VTaskProcessor::~VTaskProcessor ()
 	{
-		_CmdPopDebugGroup();
+		ASSERT( _plannedTasks.empty() );
+
+		if ( _rootDebugGroup )
+			_CmdPopDebugGroup();
 	}
 	
 /*
@@ -1965,7 +1978,7 @@ namespace FG
 	void  VTaskProcessor::_CmdDebugMarker (StringView text) const
 	{
 		Unused( text );
-		/*if ( text.size() and _enableDebugUtils )
+		/*if ( text.size() and _enableDebugUtils and not _planning )
 		{
 			VkDebugUtilsLabelEXT	info = {};
 			info.sType		= VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
@@ -1983,7 +1996,7 @@ namespace FG
 */
 	void  VTaskProcessor::_CmdPushDebugGroup (StringView text, RGBA8u color) const
 	{
-		if ( text.size() and _enableDebugUtils )
+		if ( text.size() and _enableDebugUtils and not _planning )
 		{
 			VkDebugUtilsLabelEXT	info = {};
 			info.sType		= VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
@@ -2001,7 +2014,7 @@ namespace FG
 */
 	void  VTaskProcessor::_CmdPopDebugGroup () const
 	{
-		if ( _enableDebugUtils )
+		if ( _enableDebugUtils and not _planning )
 		{
 			vkCmdEndDebugUtilsLabelEXT( _cmdBuffer );
 		}
@@ -2065,39 +2078,62 @@ namespace FG
 
 /*
 =================================================
-	_AddRenderTargetBarriers
+	GetDepthStencilTargetState
 =================================================
 */
-	void  VTaskProcessor::_AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const DrawTaskBarriers &info)
+	static EResourceState  GetDepthStencilTargetState (const VLogicalRenderPass::DepthStencilTarget &rt, const VLogicalRenderPass::FragmentOutput &info)
 	{
-		CHECK( info.IsFragmentOutputCompatible() );
+		const bool		clear	= (rt.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR);
+		EResourceState	state	= rt.state;
 
+		state |= (info.earlyFragmentTests ? EResourceState::EarlyFragmentTests : Default);
+		state |= (info.lateFragmentTests  ? EResourceState::LateFragmentTests : Default);
+		state &= ~((info.depthWrite | clear) ? EResourceState::Unknown : EResourceState::_Write);
+
+		return state;
+	}
+
+/*
+=================================================
+	_SetRenderTargetLayouts
+=================================================
+*/
+	void  VTaskProcessor::_SetRenderTargetLayouts (const VLogicalRenderPass &logicalRP, const FragmentOutput &info)
+	{
 		if ( logicalRP.GetDepthStencilTarget().IsDefined() )
 		{
-			auto &			rt		= logicalRP.GetDepthStencilTarget();
-			const bool		clear	= (rt.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR);
-			EResourceState	state	= rt.state;
+			auto &	rt	= logicalRP.GetDepthStencilTarget();
+			rt._layout	= EResourceState_ToImageLayout( GetDepthStencilTargetState( rt, info ), rt.imagePtr->AspectMask() );
+		}
 
-			state |= (info.IsEarlyFragmentTests() ? EResourceState::EarlyFragmentTests : Default);
-			state |= (info.IsLateFragmentTests()  ? EResourceState::LateFragmentTests : Default);
-			state &= ~((info.HasDepthWriteAccess() | clear) ? EResourceState::Unknown : EResourceState::_Write);
-			
-			VkImageLayout&	layout	= rt._layout;
-			layout = EResourceState_ToImageLayout( state, rt.imagePtr->AspectMask() );
+		if ( info.rasterizerDiscard )
+			return;
 
-			_AddImage( rt.imagePtr, state, layout, rt.desc );
+		for (auto& rt : logicalRP.GetColorTargets())
+		{
+			rt._layout = EResourceState_ToImageLayout( rt.state, rt.imagePtr->AspectMask() );
+		}
+	}
+
+/*
+=================================================
+	_AddRenderTargetBarriers
+=================================================
+*/
+	void  VTaskProcessor::_AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const FragmentOutput &info)
+	{
+		if ( logicalRP.GetDepthStencilTarget().IsDefined() )
+		{
+			auto &	rt	= logicalRP.GetDepthStencilTarget();
+			_AddImage( rt.imagePtr, GetDepthStencilTargetState( rt, info ), rt._layout, rt.desc );
 		}
 
-		if ( info.IsRasterizerDiscard() )
+		if ( info.rasterizerDiscard )
 			return;
 
 		for (auto& rt : logicalRP.GetColorTargets())
 		{
-			EResourceState	state	= rt.state;
-			VkImageLayout&	layout	= rt._layout;
-			layout = EResourceState_ToImageLayout( state, rt.imagePtr->AspectMask() );
-
-			_AddImage( rt.imagePtr, state, layout, rt.desc );
+			_AddImage( rt.imagePtr, rt.state, rt._layout, rt.desc );
 		}
 	}
 	
@@ -2202,76 +2238,165 @@ namespace FG
 
 /*
 =================================================
-	_BeginRenderPass
+	_InitRenderPass
+----
+	creates render pass and framebuffer,
+	attachment layouts depend only on pipelines that are used in draw tasks, so render pass is known before draw tasks processing
 =================================================
 */
-	void  VTaskProcessor::_BeginRenderPass (const VFgTask<SubmitRenderPass> &task)
+	bool  VTaskProcessor::_InitRenderPass (const VFgTask<SubmitRenderPass> &task, OUT FragmentOutput &fragOutput, OUT VkRenderPassBeginInfo &passInfo)
 	{
 		ASSERT( not task.IsSubpass() );
 
 		FixedArray< VLogicalRenderPass*, 32 >	logical_passes;
+		fragOutput = task.GetLogicalPass()->GetFragmentOutput();
 
 		for (auto* iter = &task; iter != null; iter = iter->GetNextSubpass())
 		{
-			logical_passes.push_back( iter->GetLogicalPass() );
+			auto*	pass	= iter->GetLogicalPass();
+			auto&	src		= pass->GetFragmentOutput();
+
+			logical_passes.push_back( pass );
+
+			fragOutput.earlyFragmentTests	|= src.earlyFragmentTests;
+			fragOutput.lateFragmentTests	|= src.lateFragmentTests;
+			fragOutput.depthWrite			|= src.depthWrite;
+			fragOutput.stencilWrite			|= src.stencilWrite;
+			fragOutput.rasterizerDiscard	&= src.rasterizerDiscard;
 		}
 
-		
-		// add barriers
-		DrawTaskBarriers	barrier_visitor{ *this, *logical_passes.front() };
-		EResourceState		stages = _fgThread.GetDevice().GetGraphicsShaderStages();
+		_SetRenderTargetLayouts( *task.GetLogicalPass(), fragOutput );
+		CHECK_ERR( _CreateRenderPass( logical_passes ));
+
+		VFramebuffer const*	framebuffer = _GetResource( task.GetLogicalPass()->GetFramebufferID() );
+		VRenderPass const*	render_pass = _GetResource( task.GetLogicalPass()->GetRenderPassID() );
+		RectI const&		area		= task.GetLogicalPass()->GetArea();
 
-		for (auto& pass : logical_passes)
+		passInfo = {};
+		passInfo.sType						= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		passInfo.renderPass					= render_pass->Handle();
+		passInfo.renderArea.offset.x		= area.left;
+		passInfo.renderArea.offset.y		= area.top;
+		passInfo.renderArea.extent.width	= CheckCast<uint>(area.Width());
+		passInfo.renderArea.extent.height	= CheckCast<uint>(area.Height());
+		passInfo.clearValueCount			= render_pass->GetCreateInfo().attachmentCount;
+		passInfo.pClearValues				= task.GetLogicalPass()->GetClearValues().data();
+		passInfo.framebuffer				= framebuffer->Handle();
+		return true;
+	}
+
+/*
+=================================================
+	_AddMutableResourceBarriers
+=================================================
+*/
+	void  VTaskProcessor::_AddMutableResourceBarriers (const VLogicalRenderPass &logicalRP)
+	{
+		EResourceState	stages = _fgThread.GetDevice().GetGraphicsShaderStages();
+
+		for (auto& item : logicalRP.GetMutableImages())
 		{
-			for (auto& draw : pass->GetDrawTasks())
-			{
-				draw->Process1( &barrier_visitor );
-			}
+			ImageViewDesc	desc{ item.first->Description() };
+			_AddImage( item.first, (item.second | stages), EResourceState_ToImageLayout( item.second, item.first->AspectMask() ), desc );
+		}
 
-			for (auto& item : pass->GetMutableImages())
-			{
-				ImageViewDesc	desc{ item.first->Description() };
-				_AddImage( item.first, (item.second | stages), EResourceState_ToImageLayout( item.second, item.first->AspectMask() ), desc );
-			}
+		for (auto& item : logicalRP.GetMutableBuffers())
+		{
+			_AddBuffer( item.first, item.second, 0, VK_WHOLE_SIZE );
+		}
+	}
+
+/*
+=================================================
+	_PrepareRenderPass
+=================================================
+*/
+	bool  VTaskProcessor::_PrepareRenderPass (const VFgTask<SubmitRenderPass> &task, OUT VkRenderPassBeginInfo &passInfo,
+											  OUT VkImageView &sriView, OUT bool &parallel)
+	{
+		FragmentOutput	frag_output;
+		CHECK_ERR( _InitRenderPass( task, OUT frag_output, OUT passInfo ));
 
-			for (auto& item : pass->GetMutableBuffers())
+		// add barriers and create pipelines
+		parallel = true;
+
+		for (auto* iter = &task; iter != null; iter = iter->GetNextSubpass())
+		{
+			auto&				pass = *iter->GetLogicalPass();
+			DrawTaskBarriers	barrier_visitor{ *this, pass };
+
+			for (auto& draw : pass.GetDrawTasks())
 			{
-				_AddBuffer( item.first, item.second, 0, VK_WHOLE_SIZE );
+				draw->Process1( &barrier_visitor );
 			}
+			parallel &= barrier_visitor.CanBeRecordedInParallel();
+
+			_AddMutableResourceBarriers( pass );
 		}
 		
-		VkImageView  sri_view = VK_NULL_HANDLE;
-		_SetShadingRateImage( *task.GetLogicalPass(), OUT sri_view );
+		sriView = VK_NULL_HANDLE;
+		_SetShadingRateImage( *task.GetLogicalPass(), OUT sriView );
 
-		_AddRenderTargetBarriers( *task.GetLogicalPass(), barrier_visitor );
+		_AddRenderTargetBarriers( *task.GetLogicalPass(), frag_output );
 		_CommitBarriers();
+		return true;
+	}
+	
+/*
+=================================================
+	_RecordSecondaryRenderPass
+----
+	barriers are collected and draw commands are recorded in single pass through all draw tasks,
+	draw commands are recorded into secondary command buffer, barriers are committed into
+	primary command buffer before render pass begins.
+=================================================
+*/
+	bool  VTaskProcessor::_RecordSecondaryRenderPass (const VFgTask<SubmitRenderPass> &task)
+	{
+		ASSERT( task.IsLastPass() );
 
+		VkRenderPassBeginInfo	pass_info;
+		FragmentOutput			frag_output;
+		VkImageView				sri_view = VK_NULL_HANDLE;
+		auto&					logical_rp	= *task.GetLogicalPass();
 
-		// create render pass and framebuffer
-		CHECK( _CreateRenderPass( logical_passes ));
-		
-
-		// begin render pass
-		VFramebuffer const*	framebuffer = _GetResource( task.GetLogicalPass()->GetFramebufferID() );
-		VRenderPass const*	render_pass = _GetResource( task.GetLogicalPass()->GetRenderPassID() );
-		RectI const&		area		= task.GetLogicalPass()->GetArea();
+		CHECK_ERR( _InitRenderPass( task, OUT frag_output, OUT pass_info ));
+		_SetShadingRateImage( logical_rp, OUT sri_view );
 
-		VkRenderPassBeginInfo	pass_info = {};
-		pass_info.sType						= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		pass_info.renderPass				= render_pass->Handle();
-		pass_info.renderArea.offset.x		= area.left;
-		pass_info.renderArea.offset.y		= area.top;
-		pass_info.renderArea.extent.width	= CheckCast<uint>(area.Width());
-		pass_info.renderArea.extent.height	= CheckCast<uint>(area.Height());
-		pass_info.clearValueCount			= render_pass->GetCreateInfo().attachmentCount;
-		pass_info.pClearValues				= task.GetLogicalPass()->GetClearValues().data();
-		pass_info.framebuffer				= framebuffer->Handle();
-		
-		vkCmdBeginRenderPass( _cmdBuffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE );
+		const VkCommandBuffer	primary		= _cmdBuffer;
+		const VkCommandBuffer	secondary	= _fgThread.BeginRenderPassSecondary( pass_info );
+		CHECK_ERR( secondary );
 
+		_cmdBuffer = secondary;
+		_InvalidateStates();
 		_BindShadingRateImage( sri_view );
+		{
+			DrawTaskBarriers	barrier_visitor{ *this, logical_rp };
+			DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
+
+			for (auto& draw : logical_rp.GetDrawTasks())
+			{
+				draw->Process1( &barrier_visitor );
+				draw->Process2( &command_builder );
+			}
+		}
+		VK_CALL( vkEndCommandBuffer( secondary ));
+
+		_cmdBuffer = primary;
+		_InvalidateStates();
+
+		_AddMutableResourceBarriers( logical_rp );
+		_AddRenderTargetBarriers( logical_rp, frag_output );
+		_CommitBarriers();
+		
+		_CmdPushDebugGroup( task.Name(), task.DebugColor() );
+		vkCmdBeginRenderPass( _cmdBuffer, &pass_info, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS );
+		vkCmdExecuteCommands( _cmdBuffer, 1, &secondary );
+		vkCmdEndRenderPass( _cmdBuffer );
+		_CmdPopDebugGroup();
+		return true;
 	}
-	
+
 /*
 =================================================
 	_BeginSubpass
@@ -2306,11 +2431,39 @@ namespace FG
 		// invalidate some states
 		_isDefaultScissor		= false;
 		_perPassStatesUpdated	= false;
+		_InvalidateBindings();
+
+		if ( _singlePassDrawTasks and not _parallelRecording and not task.IsSubpass() and task.IsLastPass() )
+		{
+			CHECK( _RecordSecondaryRenderPass( task ));
+			return;
+		}
 
 		if ( not task.IsSubpass() )
 		{
+			VkRenderPassBeginInfo	pass_info;
+			VkImageView				sri_view;
+			bool					parallel;
+			CHECK_ERRV( _PrepareRenderPass( task, OUT pass_info, OUT sri_view, OUT parallel ));
+
+			// draw commands are recorded into secondary command buffer, now or later on worker thread
+			if ( _parallelRecording )
+			{
+				if ( VkCommandBuffer cmd = _fgThread.BeginRenderPassCommands( task, pass_info, sri_view, parallel ))
+				{
+					_cmdBuffer = cmd;
+					_InvalidateStates();
+					RecordRenderPass( task, sri_view, task.GetLogicalPass()->GetDrawTasks() );
+				}
+				_cmdBuffer = _fgThread.BeginCommandSegment();
+				_InvalidateStates();
+				return;
+			}
+
 			_CmdPushDebugGroup( task.Name(), task.DebugColor() );
-			_BeginRenderPass( task );
+			vkCmdBeginRenderPass( _cmdBuffer, &pass_info, VK_SUBPASS_CONTENTS_INLINE );
+			_BindShadingRateImage( sri_view );
+			_insideRenderPass = true;
 		}
 		else
 		{
@@ -2319,36 +2472,110 @@ namespace FG
 			_BeginSubpass( task );
 		}
 
-
-		// draw
-		DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
-		
-		for (auto& draw : task.GetLogicalPass()->GetDrawTasks())
-		{
-			draw->Process2( &command_builder );
-		}
+		_RecordDrawTasks( task, task.GetLogicalPass()->GetDrawTasks() );
 
 		// end render pass
 		if ( task.IsLastPass() )
 		{
 			vkCmdEndRenderPass( _cmdBuffer );
 			_CmdPopDebugGroup();
+			_insideRenderPass = false;
 		}
 	}
 	
+/*
+=================================================
+	RecordRenderPass
+----
+	records draw commands into secondary command buffer,
+	render pass must be prepared on the main thread.
+=================================================
+*/
+	void  VTaskProcessor::RecordRenderPass (const VFgTask<SubmitRenderPass> &task, VkImageView shadingRateImage, ArrayView<IDrawTask*> drawTasks)
+	{
+		_BindShadingRateImage( shadingRateImage );
+		_RecordDrawTasks( task, drawTasks );
+	}
+
+/*
+=================================================
+	_RecordDrawTasks
+=================================================
+*/
+	void  VTaskProcessor::_RecordDrawTasks (const VFgTask<SubmitRenderPass> &task, ArrayView<IDrawTask*> drawTasks)
+	{
+		DrawTaskCommands	command_builder{ *this, &task, _cmdBuffer };
+		
+		for (auto& draw : drawTasks)
+		{
+			draw->Process2( &command_builder );
+		}
+	}
+
+/*
+=================================================
+	_InvalidateStates
+=================================================
+*/
+	void  VTaskProcessor::_InvalidateStates ()
+	{
+		_isDefaultScissor		= false;
+		_perPassStatesUpdated	= false;
+		_graphicsPipeline		= Default;
+		_computePipeline		= Default;
+		_rayTracingPipeline		= Default;
+		_indexBuffer			= VK_NULL_HANDLE;
+		_indexBufferOffset		= UMax;
+		_indexType				= VK_INDEX_TYPE_MAX_ENUM;
+		_shadingRateImage		= VK_NULL_HANDLE;
+		_InvalidateBindings();
+	}
+
+/*
+=================================================
+	_InvalidateBindings
+=================================================
+*/
+	void  VTaskProcessor::_InvalidateBindings ()
+	{
+		_graphicsDescSets.layout = VK_NULL_HANDLE;
+		_vertexBuffers.buffers.clear();
+		_vertexBuffers.offsets.clear();
+	}
+
 /*
 =================================================
 	_ExtractDescriptorSets
 =================================================
 */
 	void  VTaskProcessor::_ExtractDescriptorSets (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet,
-												  OUT VkDescriptorSets_t &descriptorSets)
+												  OUT VBoundDescriptorSets &result)
 	{
 		const FixedArray< uint, FG_MaxBufferDynamicOffsets >	old_offsets = resourceSet.dynamicOffsets;
 		StaticArray< Pair<uint, uint>, FG_MaxDescriptorSets >	new_offsets = {};
 		const uint												first_ds	= layout.GetFirstDescriptorSet();
+		auto&													descriptor_sets	= result.sets;
+
+		result = Default;
+		descriptor_sets.resize( resourceSet.resources.size() );
+
+		// bindless descriptor set is not passed in task resources
+		auto&	bindless = _fgThread.GetResourceManager().GetBindlessDescriptorSet();
+		if ( bindless.IsEnabled() )
+		{
+			RawDescriptorSetLayoutID	ds_layout;
+			uint						binding	= 0;
 
-		descriptorSets.resize( resourceSet.resources.size() );
+			if ( layout.GetDescriptorSetLayout( bindless.GetDescriptorSetID(), OUT ds_layout, OUT binding ))
+			{
+				ASSERT( ds_layout == bindless.GetLayoutID() );
+				ASSERT( binding >= first_ds );
+				binding -= first_ds;
+
+				descriptor_sets.resize( Max( descriptor_sets.size() + 1, size_t(binding) + 1 ));
+				descriptor_sets[binding] = bindless.Handle();
+			}
+		}
 
 		for (size_t i = 0; i < resourceSet.resources.size(); ++i)
 		{
@@ -2366,14 +2593,29 @@ namespace FG
 			ASSERT( binding >= first_ds );
 			binding -= first_ds;
 
-			descriptorSets[binding] = res.pplnRes->Handle();
+			// push descriptor set has no dynamic offsets
+			if ( res.descSetId == layout.GetPushDescriptorSet() )
+			{
+				ASSERT( res.pplnRes->GetPushDescriptors().size() );
+				result.pushDescriptors	= res.pplnRes;
+				result.pushIndex		= binding;
+				descriptor_sets[binding]	= VK_NULL_HANDLE;
+				continue;
+			}
+
+			descriptor_sets[binding] = res.pplnRes->Handle();
 			new_offsets[binding]    = { res.offsetIndex, res.offsetCount };
 		}
 
 		// sort dynamic offsets by binding index
 		uint	dst = 0;
-		for (auto& item : new_offsets)
+		for (uint binding = 0; binding < new_offsets.size(); ++binding)
 		{
+			auto&	item = new_offsets[binding];
+
+			if ( binding == result.pushIndex )
+				result.pushOffsetIndex = dst;
+
 			for (uint i = item.first; i < item.second; ++i, ++dst)
 			{
 				resourceSet.dynamicOffsets[dst] = old_offsets[i];
@@ -2381,6 +2623,88 @@ namespace FG
 		}
 	}
 	
+/*
+=================================================
+	_BindDescriptorSets
+----
+	push descriptor set splits descriptor sets into two ranges,
+	descriptors for this set are written directly into the command buffer.
+=================================================
+*/
+	void  VTaskProcessor::_BindDescriptorSets (VkCommandBuffer cmd, const VPipelineLayout &layout, VkPipelineBindPoint bindPoint,
+											   const VBoundDescriptorSets &descriptorSets, ArrayView<uint> dynamicOffsets)
+	{
+		const uint	first_ds	= layout.GetFirstDescriptorSet();
+		const uint	set_count	= uint(descriptorSets.sets.size());
+		const uint	push_index	= Min( descriptorSets.pushIndex, set_count );
+		const uint	offset_idx	= Min( descriptorSets.pushOffsetIndex, uint(dynamicOffsets.size()) );
+
+		if ( push_index > 0 )
+		{
+			vkCmdBindDescriptorSets( cmd, bindPoint, layout.Handle(), first_ds, push_index, descriptorSets.sets.data(),
+									 offset_idx, dynamicOffsets.data() );
+			Stat().descriptorBinds ++;
+		}
+
+		_PushDescriptorSet( cmd, layout, bindPoint, descriptorSets );
+
+		if ( push_index + 1 < set_count )
+		{
+			vkCmdBindDescriptorSets( cmd, bindPoint, layout.Handle(), first_ds + push_index + 1, set_count - push_index - 1,
+									 descriptorSets.sets.data() + push_index + 1,
+									 uint(dynamicOffsets.size()) - offset_idx, dynamicOffsets.data() + offset_idx );
+			Stat().descriptorBinds ++;
+		}
+	}
+
+/*
+=================================================
+	_PushDescriptorSet
+=================================================
+*/
+	void  VTaskProcessor::_PushDescriptorSet (VkCommandBuffer cmd, const VPipelineLayout &layout, VkPipelineBindPoint bindPoint,
+											  const VBoundDescriptorSets &descriptorSets)
+	{
+		if ( not descriptorSets.pushDescriptors )
+			return;
+
+		auto	writes = descriptorSets.pushDescriptors->GetPushDescriptors();
+
+		vkCmdPushDescriptorSetKHR( cmd, bindPoint, layout.Handle(), layout.GetFirstDescriptorSet() + descriptorSets.pushIndex,
+								   uint(writes.size()), writes.data() );
+		Stat().pushDescriptors ++;
+	}
+
+/*
+=================================================
+	_BindGraphicsDescriptorSets
+----
+	descriptor sets are not disturbed by binding pipeline with same layout,
+	so draw task that uses same sets and dynamic offsets as previous draw task only pushes descriptors.
+=================================================
+*/
+	void  VTaskProcessor::_BindGraphicsDescriptorSets (VkCommandBuffer cmd, const VPipelineLayout &layout, const VBoundDescriptorSets &descriptorSets,
+													   ArrayView<uint> dynamicOffsets)
+	{
+		auto&	bound = _graphicsDescSets;
+
+		if ( bound.layout		== layout.Handle()				and
+			 bound.pushIndex	== descriptorSets.pushIndex		and
+			 ArrayView<VkDescriptorSet>{ bound.sets } == ArrayView<VkDescriptorSet>{ descriptorSets.sets }	and
+			 ArrayView<uint>{ bound.dynamicOffsets } == dynamicOffsets )
+		{
+			_PushDescriptorSet( cmd, layout, VK_PIPELINE_BIND_POINT_GRAPHICS, descriptorSets );
+			return;
+		}
+
+		bound.layout	= layout.Handle();
+		bound.pushIndex	= descriptorSets.pushIndex;
+		bound.sets		= descriptorSets.sets;
+		bound.dynamicOffsets = dynamicOffsets;
+
+		_BindDescriptorSets( cmd, layout, VK_PIPELINE_BIND_POINT_GRAPHICS, descriptorSets, dynamicOffsets );
+	}
+
 /*
 =================================================
 	_BindPipelineResources
@@ -2390,21 +2714,9 @@ namespace FG
 												  VkPipelineBindPoint bindPoint, ShaderDbgIndex debugModeIndex)
 	{
 		// update descriptor sets and add pipeline barriers
-		VkDescriptorSets_t	descriptor_sets;
+		VBoundDescriptorSets	descriptor_sets;
 		_ExtractDescriptorSets( layout, resourceSet, OUT descriptor_sets );
-
-		if ( descriptor_sets.size() )
-		{
-			vkCmdBindDescriptorSets( _cmdBuffer,
-									  bindPoint,
-									  layout.Handle(),
-									  layout.GetFirstDescriptorSet(),
-									  uint(descriptor_sets.size()),
-									  descriptor_sets.data(),
-									  uint(resourceSet.dynamicOffsets.size()),
-									  resourceSet.dynamicOffsets.data() );
-			Stat().descriptorBinds ++;
-		}
+		_BindDescriptorSets( _cmdBuffer, layout, bindPoint, descriptor_sets, resourceSet.dynamicOffsets );
 
 		if ( debugModeIndex != Default )
 		{
@@ -2539,11 +2851,16 @@ namespace FG
 
 /*
 =================================================
-	_BindPipeline
+	_CreatePipeline
 =================================================
 */
-	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, VPipelineLayout const* &pplnLayout)
+	bool  VTaskProcessor::_CreatePipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task)
 	{
+		auto&	ppln_cache = _fgThread.GetPipelineCache();
+
+		if ( ppln_cache.FindDrawState( logicalRP, task, OUT task.pipelineInstance, OUT task.pipelineLayout ))
+			return true;
+
 		RenderState				render_state;
 		EPipelineDynamicState	dynamic_states = EPipelineDynamicState::Viewport | EPipelineDynamicState::Scissor;
 		
@@ -2561,8 +2878,47 @@ namespace FG
 									INOUT render_state.rasterization, INOUT dynamic_states, task.dynamicStates );
 		SetupExtensions( logicalRP, INOUT dynamic_states );
 
-		VkPipeline	ppln_id;
-		CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
+		if ( task.debugModeIndex == Default and _fgThread.GetResourceManager().GetPipelineCompileQueue().IsEnabled() )
+		{
+			CHECK_ERR( ppln_cache.CreatePipelineInstanceAsync(
+										_fgThread,
+										logicalRP,
+										task.pipelineId,
+										*task.pipeline,
+										task.vertexInput,
+										render_state,
+										dynamic_states,
+										OUT task.pipelineInstance, OUT task.pipelineLayout ));
+
+			if ( task.pipelineInstance )
+			{
+				ppln_cache.AddDrawState( logicalRP, task );
+				return true;
+			}
+
+			if ( not task.fallbackPipeline )
+			{
+				Stat().skippedDrawCalls ++;
+				return true;
+			}
+
+			// fallback pipeline is created synchronously and must use same resources
+			CHECK_ERR( task.fallbackPipeline->GetLayoutID() == task.pipeline->GetLayoutID() );
+			Stat().fallbackDrawCalls ++;
+
+			CHECK_ERR( ppln_cache.CreatePipelineInstance(
+										_fgThread,
+										logicalRP,
+										*task.fallbackPipeline,
+										task.vertexInput,
+										render_state,
+										dynamic_states,
+										Default,
+										OUT task.pipelineInstance, OUT task.pipelineLayout ));
+			return true;
+		}
+
+		CHECK_ERR( ppln_cache.CreatePipelineInstance(
 										_fgThread,
 										logicalRP,
 										*task.pipeline,
@@ -2570,18 +2926,18 @@ namespace FG
 										render_state,
 										dynamic_states,
 										task.debugModeIndex,
-										OUT ppln_id, OUT pplnLayout ));
-		
-		_BindPipeline2( logicalRP, ppln_id );
+										OUT task.pipelineInstance, OUT task.pipelineLayout ));
+
+		ppln_cache.AddDrawState( logicalRP, task );
 		return true;
 	}
 	
 /*
 =================================================
-	_BindPipeline
+	_CreatePipeline
 =================================================
 */
-	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, VPipelineLayout const* &pplnLayout)
+	bool  VTaskProcessor::_CreatePipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task)
 	{
 	#ifdef VK_NV_mesh_shader
 		RenderState				render_state;
@@ -2598,7 +2954,6 @@ namespace FG
 									INOUT render_state.rasterization, INOUT dynamic_states, task.dynamicStates );
 		SetupExtensions( logicalRP, INOUT dynamic_states );
 
-		VkPipeline	ppln_id;
 		CHECK_ERR( _fgThread.GetPipelineCache().CreatePipelineInstance(
 										_fgThread,
 										logicalRP,
@@ -2606,16 +2961,39 @@ namespace FG
 										render_state,
 										dynamic_states,
 										task.debugModeIndex,
-										OUT ppln_id, OUT pplnLayout ));
-		
-		_BindPipeline2( logicalRP, ppln_id );
+										OUT task.pipelineInstance, OUT task.pipelineLayout ));
 		return true;
 	#else
-		Unused( logicalRP, task, pplnLayout );
+		Unused( logicalRP, task );
 		return false;
 	#endif
 	}
 
+/*
+=================================================
+	_BindPipeline
+----
+	pipeline must be created in '_CreatePipeline'
+=================================================
+*/
+	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, OUT VPipelineLayout const* &pplnLayout)
+	{
+		CHECK_ERR( task.pipelineInstance and task.pipelineLayout );
+
+		pplnLayout = task.pipelineLayout;
+		_BindPipeline2( logicalRP, task.pipelineInstance );
+		return true;
+	}
+	
+	inline bool  VTaskProcessor::_BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, OUT VPipelineLayout const* &pplnLayout)
+	{
+		CHECK_ERR( task.pipelineInstance and task.pipelineLayout );
+
+		pplnLayout = task.pipelineLayout;
+		_BindPipeline2( logicalRP, task.pipelineInstance );
+		return true;
+	}
+
 /*
 =================================================
 	_BindPipeline
@@ -2745,7 +3123,8 @@ namespace FG
 			_AddBuffer( dst_buffer, EResourceState::TransferDst, dst.dstOffset, dst.size );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyBuffer( _cmdBuffer,
 						  src_buffer->Handle(),
@@ -2796,11 +3175,12 @@ namespace FG
 			//ASSERT(All( src.srcOffset + src.size <= Max(1u, src_image.Dimension().xyz() >> src.srcSubresource.mipLevel.Get()) ));
 			//ASSERT(All( src.dstOffset + src.size <= Max(1u, dst_image.Dimension().xyz() >> src.dstSubresource.mipLevel.Get()) ));
 
-			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource );
-			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource );
+			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource, dst.srcOffset, dst.extent );
+			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource, dst.dstOffset, dst.extent );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyImage( _cmdBuffer,
 						 src_image->Handle(),
@@ -2845,10 +3225,11 @@ namespace FG
 			dst.imageExtent						= VkExtent3D{ img_size.x, img_size.y, img_size.z };
 
 			_AddBuffer( src_buffer, EResourceState::TransferSrc, dst, dst_image );
-			_AddImage(  dst_image,  EResourceState::TransferDst, task.dstLayout, dst.imageSubresource );
+			_AddImage(  dst_image,  EResourceState::TransferDst, task.dstLayout, dst.imageSubresource, dst.imageOffset, dst.imageExtent );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyBufferToImage( _cmdBuffer,
 								 src_buffer->Handle(),
@@ -2890,11 +3271,12 @@ namespace FG
 			dst.imageOffset						= VkOffset3D{ src.imageOffset.x, src.imageOffset.y, src.imageOffset.z };
 			dst.imageExtent						= VkExtent3D{ image_size.x, image_size.y, image_size.z };
 
-			_AddImage(  src_image,  EResourceState::TransferSrc, task.srcLayout, dst.imageSubresource );
+			_AddImage(  src_image,  EResourceState::TransferSrc, task.srcLayout, dst.imageSubresource, dst.imageOffset, dst.imageExtent );
 			_AddBuffer( dst_buffer, EResourceState::TransferDst, dst, src_image );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdCopyImageToBuffer( _cmdBuffer,
 								 src_image->Handle(),
@@ -2942,7 +3324,8 @@ namespace FG
 			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdBlitImage( _cmdBuffer,
 						src_image->Handle(),
@@ -2989,11 +3372,12 @@ namespace FG
 			
 			dst.extent							= VkExtent3D{ image_size.x, image_size.y, image_size.z };
 
-			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource );
-			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource );
+			_AddImage( src_image, EResourceState::TransferSrc, task.srcLayout, dst.srcSubresource, dst.srcOffset, dst.extent );
+			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst.dstSubresource, dst.dstOffset, dst.extent );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdResolveImage(	_cmdBuffer,
 							src_image->Handle(),
@@ -3030,7 +3414,8 @@ namespace FG
 			return;
 
 		_AddImage( image, EResourceState::TransferSrc, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, subres );
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 	
 		VkImageMemoryBarrier	barrier = {};
 		barrier.sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -3091,7 +3476,8 @@ namespace FG
 
 		_AddBuffer( dst_buffer, EResourceState::TransferDst, task.dstOffset, task.size );
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdFillBuffer( _cmdBuffer,
 						  dst_buffer->Handle(),
@@ -3128,7 +3514,8 @@ namespace FG
 			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdClearColorImage( _cmdBuffer,
 							   dst_image->Handle(),
@@ -3166,7 +3553,8 @@ namespace FG
 			_AddImage( dst_image, EResourceState::TransferDst, task.dstLayout, dst );
 		}
 		
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		vkCmdClearDepthStencilImage( _cmdBuffer,
 									  dst_image->Handle(),
@@ -3192,7 +3580,8 @@ namespace FG
 		for (auto& reg : task.Regions()) {
 			_AddBuffer( dst_buffer, EResourceState::TransferDst, reg.bufferOffset, reg.dataSize );
 		}	
-		_CommitBarriers();
+		if ( not _CommitBarriers() )
+			return;
 		
 		for (auto& reg : task.Regions()) {
 			vkCmdUpdateBuffer( _cmdBuffer, dst_buffer->Handle(), reg.bufferOffset, reg.dataSize, reg.dataPtr );
@@ -3512,10 +3901,20 @@ namespace FG
 		ASSERT( img );
 		ASSERT( not state.range.IsEmpty() );
 
+		if ( _planning ) {
+			_plannedImages.emplace_back( img, state );
+			return;
+		}
+		if ( _recordOnly )
+			return;
+
 		_pendingResourceBarriers.insert({ img, &CommitResourceBarrier<VLocalImage> });
 
 		img->AddPendingState( state );
 
+		if ( _splitBarriers )
+			_currTaskStages |= EResourceState_ToPipelineStages( state.state );
+
 		if_unlikely( _fgThread.GetDebugger() )
 			_fgThread.GetDebugger()->AddImageUsage( img->ToGlobal(), state );
 	}
@@ -3555,6 +3954,29 @@ namespace FG
 						});
 	}
 	
+/*
+=================================================
+	_AddImage
+=================================================
+*/
+	inline void  VTaskProcessor::_AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceLayers &subres,
+											const VkOffset3D &offset, const VkExtent3D &extent)
+	{
+		const uint2		level_size	= Max( 1u, img->Dimension().xy() >> subres.mipLevel );
+		const RectU		region		{ uint(offset.x), uint(offset.y), uint(offset.x) + extent.width, uint(offset.y) + extent.height };
+
+		if ( region.left == 0 and region.top == 0 and region.right >= level_size.x and region.bottom >= level_size.y )
+			return _AddImage( img, state, layout, subres );
+
+		_AddImageState( img,
+						ImageState{
+							state, layout,
+							ImageRange{ ImageLayer(subres.baseArrayLayer), subres.layerCount, MipmapLevel(subres.mipLevel), 1, region },
+							VkImageAspectFlagBits(subres.aspectMask),
+							_currTask
+						});
+	}
+	
 /*
 =================================================
 	_AddImage
@@ -3579,9 +4001,20 @@ namespace FG
 	inline void  VTaskProcessor::_AddBufferState (const VLocalBuffer *buf, const BufferState &state)
 	{
 		ASSERT( buf );
+
+		if ( _planning ) {
+			_plannedBuffers.emplace_back( buf, state );
+			return;
+		}
+		if ( _recordOnly )
+			return;
+
 		_pendingResourceBarriers.insert({ buf, &CommitResourceBarrier<VLocalBuffer> });
 
 		buf->AddPendingState( state );
+
+		if ( _splitBarriers )
+			_currTaskStages |= EResourceState_ToPipelineStages( state.state );
 		
 		if_unlikely( _fgThread.GetDebugger() )
 			_fgThread.GetDebugger()->AddBufferUsage( buf->ToGlobal(), state );
@@ -3677,13 +4110,47 @@ namespace FG
 	}
 #endif
 
+/*
+=================================================
+	_SetTaskEvent
+----
+	event is signaled when all commands of the current task (and all previous commands) are complete,
+	later tasks may wait for this event instead of pipeline barrier.
+	'vkCmdSetEvent' is not allowed inside render pass, so event is not set for task that doesn't end the render pass
+	and consumers of this task will use pipeline barrier.
+=================================================
+*/
+	void  VTaskProcessor::_SetTaskEvent ()
+	{
+		// host stage is not allowed for events
+		const VkPipelineStageFlags	stages = _currTaskStages & ~VK_PIPELINE_STAGE_HOST_BIT;
+		_currTaskStages = 0;
+
+		if ( stages == 0 or _insideRenderPass )
+			return;
+
+		VkEvent		ev = _fgThread.GetBatch().AcquireEvent();
+		CHECK_ERRV( ev );
+
+		vkCmdSetEvent( _cmdBuffer, ev, stages );
+		_fgThread.GetBarrierManager().AddTaskEvent( _currTask->ExecutionOrder(), ev, stages );
+	}
+
 /*
 =================================================
 	_CommitBarriers
 =================================================
 */
-	inline void  VTaskProcessor::_CommitBarriers ()
+	inline bool  VTaskProcessor::_CommitBarriers ()
 	{
+		// commands will be recorded later, see '_PlanTask'
+		if ( _planning )
+			return false;
+
+		// barriers are already committed, see 'RecordPlannedTasks'
+		if ( _recordOnly )
+			return true;
+
 		auto&	barrier_mngr = _fgThread.GetBarrierManager();
 
 		for (auto& res : _pendingResourceBarriers)
@@ -3738,8 +4205,123 @@ namespace FG
 	#endif	// FG_DEBUG
 
 		barrier_mngr.Commit( _fgThread.GetDevice(), _cmdBuffer );
+		return true;
+	}
+	
+/*
+=================================================
+	_PlanTask
+----
+	transfer task is added to the current group if it has no common resources
+	with other tasks in the group, so all barriers of the group can be
+	committed by single 'vkCmdPipelineBarrier' call.
+=================================================
+*/
+	void  VTaskProcessor::_PlanTask (VTask node)
+	{
+		ASSERT( node->IsTransfer() );
+
+		// collect resource states
+		_plannedImages.clear();
+		_plannedBuffers.clear();
+
+		// nothing is recorded in this pass, labels and markers too,
+		// all commands are recorded in 'RecordPlannedTasks'
+		_currTask	= node;
+		_planning	= true;
+		node->Process( this );
+		_planning	= false;
+
+		// resource can be used only once in the group, otherwise it requires barrier between tasks
+		bool	conflict = false;
+
+		for (auto& img : _plannedImages) {
+			conflict |= (_pendingResourceBarriers.count( img.first ) > 0);
+		}
+		for (auto& buf : _plannedBuffers) {
+			conflict |= (_pendingResourceBarriers.count( buf.first ) > 0);
+		}
+
+		if ( conflict )
+			RecordPlannedTasks();
+		
+		_currTask = node;
+
+		if_unlikely( _fgThread.GetDebugger() )
+			_fgThread.GetDebugger()->AddTask( _currTask );
+
+		for (auto& img : _plannedImages)
+		{
+			if ( not _pendingResourceBarriers.count( img.first ))
+				_plannedBarriers.emplace_back( img.first, &CommitResourceBarrier<VLocalImage> );
+
+			_AddImageState( img.first, img.second );
+		}
+		for (auto& buf : _plannedBuffers)
+		{
+			if ( not _pendingResourceBarriers.count( buf.first ))
+				_plannedBarriers.emplace_back( buf.first, &CommitResourceBarrier<VLocalBuffer> );
+
+			_AddBufferState( buf.first, buf.second );
+		}
+
+		_plannedTasks.emplace_back( node, _plannedBarriers.size() );
 	}
 	
+/*
+=================================================
+	RecordPlannedTasks
+----
+	tasks that don't require barriers are recorded before pipeline barrier,
+	barriers for all other tasks in the group are merged into single call.
+=================================================
+*/
+	void  VTaskProcessor::RecordPlannedTasks ()
+	{
+		if ( _plannedTasks.empty() )
+			return;
+
+		auto&	barrier_mngr	= _fgThread.GetBarrierManager();
+		auto	debugger		= _fgThread.GetDebugger();
+		size_t	task_idx		= 0;
+		size_t	barrier_idx		= 0;
+
+		ASSERT( not barrier_mngr.HasPendingBarriers() );
+		_recordOnly = true;
+
+		for (; task_idx < _plannedTasks.size(); ++task_idx)
+		{
+			auto&	task = _plannedTasks[task_idx];
+
+			for (; barrier_idx < task.second; ++barrier_idx) {
+				_plannedBarriers[barrier_idx].second( _plannedBarriers[barrier_idx].first, barrier_mngr, debugger );
+			}
+
+			if ( barrier_mngr.HasPendingBarriers() )
+				break;
+
+			_currTask = task.first;
+			task.first->Process( this );
+		}
+		
+		for (; barrier_idx < _plannedBarriers.size(); ++barrier_idx) {
+			_plannedBarriers[barrier_idx].second( _plannedBarriers[barrier_idx].first, barrier_mngr, debugger );
+		}
+
+		barrier_mngr.Commit( _fgThread.GetDevice(), _cmdBuffer );
+
+		for (; task_idx < _plannedTasks.size(); ++task_idx)
+		{
+			_currTask = _plannedTasks[task_idx].first;
+			_currTask->Process( this );
+		}
+
+		_recordOnly = false;
+		_pendingResourceBarriers.clear();
+		_plannedBarriers.clear();
+		_plannedTasks.clear();
+	}
+
 /*
 =================================================
 	_BindIndexBuffer
@@ -8,6 +8,7 @@
 #include "VLocalRTGeometry.h"
 #include "VLocalRTScene.h"
 #include "VBarrierManager.h"
+#include "VLogicalRenderPass.h"
 
 namespace FG
 {
@@ -38,6 +39,10 @@ namespace FG
 		using CommitBarrierFn_t			= void (*) (const void *, VBarrierManager &, Ptr<VLocalDebugger>);
 		using PendingResourceBarriers_t	= std::unordered_map< void const*, CommitBarrierFn_t, std::hash<void const*>, std::equal_to<void const*>,
 															  StdLinearAllocator<Pair<void const* const, CommitBarrierFn_t>> >;	// TODO: use temp allocator
+		using PlannedImages_t			= std::vector< Pair<VLocalImage const*, ImageState>, StdLinearAllocator<Pair<VLocalImage const*, ImageState>> >;
+		using PlannedBuffers_t			= std::vector< Pair<VLocalBuffer const*, BufferState>, StdLinearAllocator<Pair<VLocalBuffer const*, BufferState>> >;
+		using PlannedBarriers_t			= std::vector< Pair<void const*, CommitBarrierFn_t>, StdLinearAllocator<Pair<void const*, CommitBarrierFn_t>> >;
+		using PlannedTasks_t			= std::vector< Pair<VTask, size_t>, StdLinearAllocator<Pair<VTask, size_t>> >;	// task and end index in '_plannedBarriers'
 		
 		using BufferCopyRegions_t		= FixedArray< VkBufferCopy, FG_MaxCopyRegions >;
 		using ImageCopyRegions_t		= FixedArray< VkImageCopy, FG_MaxCopyRegions >;
@@ -47,6 +52,7 @@ namespace FG
 		using ImageClearRanges_t		= FixedArray< VkImageSubresourceRange, FG_MaxClearRanges >;
 		
 		using Statistic_t				= IFrameGraph::RenderingStatistics;
+		using FragmentOutput			= VLogicalRenderPass::FragmentOutput;
 		using StencilValue_t			= decltype(_fg_hidden_::DynamicStates::stencilReference);
 
 		struct PipelineState
@@ -54,16 +60,41 @@ namespace FG
 			VkPipeline		pipeline	= VK_NULL_HANDLE;
 		};
 
+		// descriptor sets that are bound by draw tasks, push descriptor set is not cached
+		struct GraphicsDescriptorSets
+		{
+			VkPipelineLayout								layout		= VK_NULL_HANDLE;
+			VkDescriptorSets_t								sets;
+			FixedArray< uint, FG_MaxBufferDynamicOffsets >	dynamicOffsets;
+			uint											pushIndex	= UMax;
+		};
+
+		struct VertexBuffersState
+		{
+			FixedArray< VkBuffer, FG_MaxVertexBuffers >		buffers;
+			FixedArray< VkDeviceSize, FG_MaxVertexBuffers >	offsets;
+		};
+
 
 	// variables
 	private:
 		VCommandBuffer &			_fgThread;
-		const VkCommandBuffer		_cmdBuffer;
+		VkCommandBuffer				_cmdBuffer;
+		Statistic_t &				_stat;
 		
 		VTask						_currTask;
+		VkPipelineStageFlags		_currTaskStages		= 0;	// stages that are used by current task, only for split barriers
 		bool						_enableDebugUtils		: 1;
 		bool						_isDefaultScissor		: 1;
 		bool						_perPassStatesUpdated	: 1;
+		bool						_parallelRecording		: 1;	// render passes are recorded into secondary command buffers
+		bool						_singlePassDrawTasks	: 1;	// draw tasks are processed in single pass, see '_RecordSecondaryRenderPass'
+		bool						_rootDebugGroup			: 1;
+		bool						_splitBarriers			: 1;	// set event after each task, see 'VBarrierManager'
+		bool						_barrierPlanning		: 1;	// transfer tasks are grouped to share pipeline barrier, see '_PlanTask'
+		bool						_planning				: 1;	// resource states are collected, commands are not recorded
+		bool						_recordOnly				: 1;	// resource states are already committed, only commands are recorded
+		bool						_insideRenderPass		: 1;	// render pass is not ended after current task, events can't be set
 		const bool					_dispatchBase			: 1;
 		const bool					_drawIndirectCount		: 1;
 		const bool					_meshShaderNV			: 1;
@@ -75,6 +106,12 @@ namespace FG
 
 		PendingResourceBarriers_t	_pendingResourceBarriers;
 
+		// barrier planning
+		PlannedImages_t				_plannedImages;			// resource states of the current task
+		PlannedBuffers_t			_plannedBuffers;
+		PlannedBarriers_t			_plannedBarriers;		// resources of all tasks in the '_plannedTasks'
+		PlannedTasks_t				_plannedTasks;			// transfer tasks that have no common resources
+
 		PipelineState				_graphicsPipeline;
 		PipelineState				_computePipeline;
 		PipelineState				_rayTracingPipeline;
@@ -84,14 +121,21 @@ namespace FG
 		VkDeviceSize				_indexBufferOffset	= UMax;
 		VkIndexType					_indexType			= VK_INDEX_TYPE_MAX_ENUM;
 
+		// used to skip redundant bindings between draw tasks
+		GraphicsDescriptorSets		_graphicsDescSets;
+		VertexBuffersState			_vertexBuffers;
+
 		VkImageView					_shadingRateImage	= VK_NULL_HANDLE;
 
 
 	// methods
 	public:
-		explicit VTaskProcessor (VCommandBuffer &, VkCommandBuffer);
+		VTaskProcessor (VCommandBuffer &, VkCommandBuffer, bool parallelRecording);
+		VTaskProcessor (VCommandBuffer &, VkCommandBuffer, LinearAllocator<> &, Statistic_t &);		// for worker thread
 		~VTaskProcessor ();
 
+		void  RecordRenderPass (const VFgTask<SubmitRenderPass> &, VkImageView shadingRateImage, ArrayView<IDrawTask*> drawTasks);
+
 		void  Visit (const VFgTask<SubmitRenderPass> &);
 		void  Visit (const VFgTask<DispatchCompute> &);
 		void  Visit (const VFgTask<DispatchComputeIndirect> &);
@@ -135,6 +179,7 @@ namespace FG
 		static void  Visit2_CustomDraw (void *, void *);
 
 		void  Run (VTask);
+		void  RecordPlannedTasks ();
 
 
 	private:
@@ -145,16 +190,29 @@ namespace FG
 		template <typename ID>	ND_ auto const*  _ToLocal (ID id) const;
 		template <typename ID>	ND_ auto const*  _GetResource (ID id) const;
 		
-		void  _CommitBarriers ();
+		bool  _CommitBarriers ();
+		void  _SetTaskEvent ();
+		void  _PlanTask (VTask);
 		
-		void  _AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const DrawTaskBarriers &info);
+		void  _SetRenderTargetLayouts (const VLogicalRenderPass &logicalRP, const FragmentOutput &info);
+		void  _AddRenderTargetBarriers (const VLogicalRenderPass &logicalRP, const FragmentOutput &info);
 		void  _SetShadingRateImage (const VLogicalRenderPass &logicalRP, OUT VkImageView &view);
-		void  _BeginRenderPass (const VFgTask<SubmitRenderPass> &task);
+		bool  _InitRenderPass (const VFgTask<SubmitRenderPass> &task, OUT FragmentOutput &fragOutput, OUT VkRenderPassBeginInfo &passInfo);
+		void  _AddMutableResourceBarriers (const VLogicalRenderPass &logicalRP);
+		bool  _PrepareRenderPass (const VFgTask<SubmitRenderPass> &task, OUT VkRenderPassBeginInfo &passInfo, OUT VkImageView &sriView, OUT bool &parallel);
+		bool  _RecordSecondaryRenderPass (const VFgTask<SubmitRenderPass> &task);
 		void  _BeginSubpass (const VFgTask<SubmitRenderPass> &task);
 		bool  _CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses);
+		void  _RecordDrawTasks (const VFgTask<SubmitRenderPass> &task, ArrayView<IDrawTask*> drawTasks);
 
-		void  _ExtractDescriptorSets (const VPipelineLayout &, const VPipelineResourceSet &, OUT VkDescriptorSets_t &);
+		void  _ExtractDescriptorSets (const VPipelineLayout &, const VPipelineResourceSet &, OUT VBoundDescriptorSets &);
+		void  _BindDescriptorSets (VkCommandBuffer cmd, const VPipelineLayout &layout, VkPipelineBindPoint bindPoint,
+								   const VBoundDescriptorSets &descriptorSets, ArrayView<uint> dynamicOffsets);
+		void  _BindGraphicsDescriptorSets (VkCommandBuffer cmd, const VPipelineLayout &layout, const VBoundDescriptorSets &descriptorSets, ArrayView<uint> dynamicOffsets);
+		void  _PushDescriptorSet (VkCommandBuffer cmd, const VPipelineLayout &layout, VkPipelineBindPoint bindPoint, const VBoundDescriptorSets &descriptorSets);
 		void  _BindPipelineResources (const VPipelineLayout &layout, const VPipelineResourceSet &resourceSet, VkPipelineBindPoint bindPoint, ShaderDbgIndex debugModeIndex);
+		bool  _CreatePipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task);
+		bool  _CreatePipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task);
 		bool  _BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task, OUT VPipelineLayout const* &pplnLayout);
 		bool  _BindPipeline (const VLogicalRenderPass &logicalRP, const VBaseDrawMeshes &task, OUT VPipelineLayout const* &pplnLayout);
 		void  _BindPipeline2 (const VLogicalRenderPass &logicalRP, VkPipeline pipelineId);
@@ -165,9 +223,13 @@ namespace FG
 		void  _SetDynamicStates (const _fg_hidden_::DynamicStates &) const;
 		void  _BindShadingRateImage (VkImageView view);
 		void  _ResetDrawContext ();
+		void  _InvalidateStates ();
+		void  _InvalidateBindings ();
 
 		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const ImageViewDesc &desc);
 		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceLayers &subresLayers);
+		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceLayers &subresLayers,
+						 const VkOffset3D &offset, const VkExtent3D &extent);
 		void  _AddImage (const VLocalImage *img, EResourceState state, VkImageLayout layout, const VkImageSubresourceRange &subres);
 		void  _AddImageState (const VLocalImage *img, const ImageState &state);
 
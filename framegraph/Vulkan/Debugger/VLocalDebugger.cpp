@@ -110,14 +110,15 @@ namespace {
 										   VkPipelineStageFlags			srcStageMask,
 										   VkPipelineStageFlags			dstStageMask,
 										   VkDependencyFlags			dependencyFlags,
-										   const VkBufferMemoryBarrier	&barrier)
+										   const VkBufferMemoryBarrier	&barrier,
+										   bool							isSplit)
 	{
 		if ( not AllBits( _flags, EDebugFlags::LogBarriers ))
 			return;
 
 		auto&	barriers = _buffers.insert({ buffer, {} }).first->second.barriers;
 
-		barriers.push_back({ srcIndex, dstIndex, srcStageMask, dstStageMask, dependencyFlags, barrier });
+		barriers.push_back({ srcIndex, dstIndex, srcStageMask, dstStageMask, dependencyFlags, barrier, isSplit });
 	}
 	
 /*
@@ -131,14 +132,15 @@ namespace {
 										  VkPipelineStageFlags			srcStageMask,
 										  VkPipelineStageFlags			dstStageMask,
 										  VkDependencyFlags				dependencyFlags,
-										  const VkImageMemoryBarrier	&barrier)
+										  const VkImageMemoryBarrier	&barrier,
+										  bool							isSplit)
 	{
 		if ( not AllBits( _flags, EDebugFlags::LogBarriers ))
 			return;
 
 		auto&	barriers = _images.insert({ image, {} }).first->second.barriers;
 
-		barriers.push_back({ srcIndex, dstIndex, srcStageMask, dstStageMask, dependencyFlags, barrier });
+		barriers.push_back({ srcIndex, dstIndex, srcStageMask, dstStageMask, dependencyFlags, barrier, isSplit });
 	}
 	
 /*
@@ -383,8 +385,12 @@ namespace {
 					<< indent << "\t\t		baseMipLevel:    " << ToString( bar.info.subresourceRange.baseMipLevel ) << '\n'
 					<< indent << "\t\t		levelCount:      " << ToString( bar.info.subresourceRange.levelCount ) << '\n'
 					<< indent << "\t\t		baseArrayLayer:  " << ToString( bar.info.subresourceRange.baseArrayLayer ) << '\n'
-					<< indent << "\t\t		layerCount:      " << ToString( bar.info.subresourceRange.layerCount ) << '\n'
-					<< indent << "\t\t	}\n";
+					<< indent << "\t\t		layerCount:      " << ToString( bar.info.subresourceRange.layerCount ) << '\n';
+
+				if ( bar.isSplit )
+					str << indent << "\t\t		splitBarrier:    true\n";
+
+				str << indent << "\t\t	}\n";
 			}
 			str << indent << "	}\n";
 		}
@@ -447,8 +453,12 @@ namespace {
 					<< indent << "\t\t		srcAccessMask:   " << VkAccess_ToString( bar.info.srcAccessMask ) << '\n'
 					<< indent << "\t\t		dstAccessMask:   " << VkAccess_ToString( bar.info.dstAccessMask ) << '\n'
 					<< indent << "\t\t		offset:          " << ToString( BytesU(bar.info.offset) ) << '\n'
-					<< indent << "\t\t		size:            " << ToString( BytesU(bar.info.size) ) << '\n'
-					<< indent << "\t\t	}\n";
+					<< indent << "\t\t		size:            " << ToString( BytesU(bar.info.size) ) << '\n';
+
+				if ( bar.isSplit )
+					str << indent << "\t\t		splitBarrier:    true\n";
+
+				str << indent << "\t\t	}\n";
 			}
 			str << indent << "	}\n";
 		}
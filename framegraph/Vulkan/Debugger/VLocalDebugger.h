@@ -30,6 +30,7 @@ namespace FG
 			VkPipelineStageFlags		dstStageMask	= 0;
 			VkDependencyFlags			dependencyFlags	= 0;
 			BarrierType					info			= {};
+			bool						isSplit			= false;	// 'vkCmdWaitEvents' is used instead of 'vkCmdPipelineBarrier'
 		};
 		
 		template <typename BarrierType>
@@ -109,7 +110,8 @@ namespace FG
 							   VkPipelineStageFlags			srcStageMask,
 							   VkPipelineStageFlags			dstStageMask,
 							   VkDependencyFlags			dependencyFlags,
-							   const VkBufferMemoryBarrier	&barrier);
+							   const VkBufferMemoryBarrier	&barrier,
+							   bool							isSplit = false);
 
 		void AddImageBarrier (const VImage *				image,
 							  ExeOrderIndex					srcIndex,
@@ -117,7 +119,8 @@ namespace FG
 							  VkPipelineStageFlags			srcStageMask,
 							  VkPipelineStageFlags			dstStageMask,
 							  VkDependencyFlags				dependencyFlags,
-							  const VkImageMemoryBarrier	&barrier);
+							  const VkImageMemoryBarrier	&barrier,
+							  bool							isSplit = false);
 		
 		void AddRayTracingBarrier (const VRayTracingGeometry*	rtGeometry,
 								   ExeOrderIndex				srcIndex,
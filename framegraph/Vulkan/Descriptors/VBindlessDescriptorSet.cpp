@@ -0,0 +1,351 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VBindlessDescriptorSet.h"
+#include "VResourceManager.h"
+#include "VEnumCast.h"
+#include "VDevice.h"
+
+namespace FG
+{
+namespace
+{
+/*
+=================================================
+	IsSampledImageLayout
+=================================================
+*/
+	ND_ static bool  IsSampledImageLayout (VkImageLayout layout)
+	{
+		switch ( layout )
+		{
+			case VK_IMAGE_LAYOUT_GENERAL :
+			case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL :
+			case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL :
+			#ifdef VK_VERSION_1_1
+			case VK_IMAGE_LAYOUT_DEPTH_READ_ONLY_STENCIL_ATTACHMENT_OPTIMAL :
+			case VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_STENCIL_READ_ONLY_OPTIMAL :
+			#endif
+				return true;
+			default :
+				return false;
+		}
+	}
+
+/*
+=================================================
+	GetImageBindings
+----
+	access to bindless images is not tracked by framegraph,
+	so image is always in default layout when used in shader.
+	Binding is skipped if default layout is not allowed for it.
+=================================================
+*/
+	static void  GetImageBindings (const VImage &image, OUT bool &sampled, OUT bool &storage)
+	{
+		const EImageUsage	usage	= image.Description().usage;
+		const VkImageLayout	layout	= image.DefaultLayout();
+
+		sampled	= AllBits( usage, EImageUsage::Sampled ) and IsSampledImageLayout( layout );
+		storage	= AllBits( usage, EImageUsage::Storage ) and layout == VK_IMAGE_LAYOUT_GENERAL;
+	}
+}	// namespace
+//-----------------------------------------------------------------------------
+
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VBindlessDescriptorSet::VBindlessDescriptorSet (const VDevice &dev) :
+		_device{ dev }
+	{
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VBindlessDescriptorSet::~VBindlessDescriptorSet ()
+	{
+		CHECK( not _descPool );
+	}
+
+/*
+=================================================
+	GetBindings
+=================================================
+*/
+	bool  VBindlessDescriptorSet::GetBindings (const VDevice &dev, const BindlessDesc &desc, OUT DescriptorBinding_t &binding)
+	{
+		CHECK_ERR( dev.GetFeatures().descriptorIndexing );
+		CHECK_ERR( desc.descriptorSet.IsDefined() );
+		CHECK_ERR( desc.maxImages > 0 and desc.maxSamplers > 0 and desc.maxBuffers > 0 );
+
+	#ifdef VK_EXT_descriptor_indexing
+		auto&	feats	= dev.GetProperties().descriptorIndexingFeatures;
+		auto&	props	= dev.GetProperties().descriptorIndexingProperties;
+
+		CHECK_ERR( feats.runtimeDescriptorArray and feats.descriptorBindingPartiallyBound and feats.descriptorBindingUpdateUnusedWhilePending );
+		CHECK_ERR( feats.descriptorBindingSampledImageUpdateAfterBind and
+				   feats.descriptorBindingStorageImageUpdateAfterBind and
+				   feats.descriptorBindingStorageBufferUpdateAfterBind );
+
+		CHECK_ERR( desc.maxImages	<= props.maxPerStageDescriptorUpdateAfterBindSampledImages );
+		CHECK_ERR( desc.maxImages	<= props.maxPerStageDescriptorUpdateAfterBindStorageImages );
+		CHECK_ERR( desc.maxSamplers	<= props.maxPerStageDescriptorUpdateAfterBindSamplers );
+		CHECK_ERR( desc.maxBuffers	<= props.maxPerStageDescriptorUpdateAfterBindStorageBuffers );
+	#else
+		RETURN_ERR( "VK_EXT_descriptor_indexing is required for bindless resources" );
+	#endif
+
+		const auto	AddBinding = [&binding] (uint index, VkDescriptorType type, uint count)
+		{
+			VkDescriptorSetLayoutBinding	bind = {};
+			bind.binding			= index;
+			bind.descriptorType		= type;
+			bind.descriptorCount	= count;
+			bind.stageFlags			= VK_SHADER_STAGE_ALL;
+			binding.push_back( bind );
+		};
+
+		binding.clear();
+		AddBinding( SampledImageBinding,	VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,	desc.maxImages );
+		AddBinding( StorageImageBinding,	VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,	desc.maxImages );
+		AddBinding( SamplerBinding,			VK_DESCRIPTOR_TYPE_SAMPLER,			desc.maxSamplers );
+		AddBinding( StorageBufferBinding,	VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,	desc.maxBuffers );
+		return true;
+	}
+
+/*
+=================================================
+	Initialize
+=================================================
+*/
+	bool  VBindlessDescriptorSet::Initialize (RawDescriptorSetLayoutID layoutId, VkDescriptorSetLayout layout, const BindlessDesc &desc)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( not IsEnabled() );
+		CHECK_ERR( not _descPool );
+
+		const VkDescriptorPoolSize	pool_sizes[] = {
+			{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,		desc.maxImages },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,		desc.maxImages },
+			{ VK_DESCRIPTOR_TYPE_SAMPLER,			desc.maxSamplers },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,	desc.maxBuffers }
+		};
+
+		VkDescriptorPoolCreateInfo	pool_info = {};
+		pool_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		pool_info.flags			= VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+		pool_info.poolSizeCount	= uint(CountOf( pool_sizes ));
+		pool_info.pPoolSizes	= pool_sizes;
+		pool_info.maxSets		= 1;
+
+		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &pool_info, null, OUT &_descPool ));
+
+		VkDescriptorSetAllocateInfo		alloc_info = {};
+		alloc_info.sType				= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		alloc_info.descriptorPool		= _descPool;
+		alloc_info.descriptorSetCount	= 1;
+		alloc_info.pSetLayouts			= &layout;
+
+		if ( _device.vkAllocateDescriptorSets( _device.GetVkDevice(), &alloc_info, OUT &_descSet ) != VK_SUCCESS )
+		{
+			_device.vkDestroyDescriptorPool( _device.GetVkDevice(), _descPool, null );
+			_descPool = VK_NULL_HANDLE;
+			RETURN_ERR( "failed to allocate bindless descriptor set" );
+		}
+
+		_layoutId		= layoutId;
+		_descSetId		= desc.descriptorSet;
+		_maxImages		= desc.maxImages;
+		_maxSamplers	= desc.maxSamplers;
+		_maxBuffers		= desc.maxBuffers;
+
+		_enabled.store( true, memory_order_release );
+		return true;
+	}
+
+/*
+=================================================
+	Deinitialize
+=================================================
+*/
+	void  VBindlessDescriptorSet::Deinitialize (VResourceManager &resMngr)
+	{
+		EXLOCK( _guard );
+
+		_enabled.store( false, memory_order_release );
+
+		if ( _descPool )
+		{
+			_device.vkDestroyDescriptorPool( _device.GetVkDevice(), _descPool, null );
+			_descPool = VK_NULL_HANDLE;
+		}
+
+		if ( _layoutId )
+			resMngr.ReleaseResource( _layoutId );
+
+		_descSet		= VK_NULL_HANDLE;
+		_layoutId		= Default;
+		_descSetId		= Default;
+		_maxImages		= 0;
+		_maxSamplers	= 0;
+		_maxBuffers		= 0;
+	}
+
+/*
+=================================================
+	WriteImage
+=================================================
+*/
+	void  VBindlessDescriptorSet::WriteImage (RawImageID id, const VImage &image)
+	{
+		const uint	index = GetIndex( id, image );
+		if ( index == UMax )
+			return;
+
+		const auto&		desc		= image.Description();
+		ImageViewDesc	view_desc;
+
+		if ( EPixelFormat_HasDepth( desc.format ))
+			view_desc.aspectMask = EImageAspect::Depth;
+
+		VkImageView		view = image.GetView( _device, false, INOUT view_desc );
+		CHECK_ERRV( view );
+
+		bool	sampled, storage;
+		GetImageBindings( image, OUT sampled, OUT storage );
+
+		VkDescriptorImageInfo		infos [2]	= {};
+		VkWriteDescriptorSet		writes [2]	= {};
+		uint						count		= 0;
+
+		const auto	AddWrite = [&] (uint binding, VkDescriptorType type)
+		{
+			auto&	info = infos[count];
+			info.imageView		= view;
+			info.imageLayout	= image.DefaultLayout();
+
+			auto&	wr = writes[count++];
+			wr.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			wr.dstSet			= _descSet;
+			wr.dstBinding		= binding;
+			wr.dstArrayElement	= index;
+			wr.descriptorCount	= 1;
+			wr.descriptorType	= type;
+			wr.pImageInfo		= &info;
+		};
+
+		if ( sampled )
+			AddWrite( SampledImageBinding, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE );
+
+		if ( storage )
+			AddWrite( StorageImageBinding, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE );
+
+		EXLOCK( _guard );
+		_device.vkUpdateDescriptorSets( _device.GetVkDevice(), count, writes, 0, null );
+	}
+
+/*
+=================================================
+	WriteBuffer
+=================================================
+*/
+	void  VBindlessDescriptorSet::WriteBuffer (RawBufferID id, const VBuffer &buffer)
+	{
+		const uint	index = GetIndex( id, buffer );
+		if ( index == UMax )
+			return;
+
+		VkDescriptorBufferInfo	info = {};
+		info.buffer	= buffer.Handle();
+		info.offset	= 0;
+		info.range	= VK_WHOLE_SIZE;
+
+		VkWriteDescriptorSet	write = {};
+		write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet			= _descSet;
+		write.dstBinding		= StorageBufferBinding;
+		write.dstArrayElement	= index;
+		write.descriptorCount	= 1;
+		write.descriptorType	= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		write.pBufferInfo		= &info;
+
+		EXLOCK( _guard );
+		_device.vkUpdateDescriptorSets( _device.GetVkDevice(), 1, &write, 0, null );
+	}
+
+/*
+=================================================
+	WriteSampler
+=================================================
+*/
+	void  VBindlessDescriptorSet::WriteSampler (RawSamplerID id, const VSampler &sampler)
+	{
+		const uint	index = GetIndex( id );
+		if ( index == UMax )
+			return;
+
+		VkDescriptorImageInfo	info = {};
+		info.sampler	= sampler.Handle();
+
+		VkWriteDescriptorSet	write = {};
+		write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		write.dstSet			= _descSet;
+		write.dstBinding		= SamplerBinding;
+		write.dstArrayElement	= index;
+		write.descriptorCount	= 1;
+		write.descriptorType	= VK_DESCRIPTOR_TYPE_SAMPLER;
+		write.pImageInfo		= &info;
+
+		EXLOCK( _guard );
+		_device.vkUpdateDescriptorSets( _device.GetVkDevice(), 1, &write, 0, null );
+	}
+
+/*
+=================================================
+	GetIndex
+=================================================
+*/
+	uint  VBindlessDescriptorSet::GetIndex (RawImageID id, const VImage &image) const
+	{
+		if ( not IsEnabled() or id.Index() >= _maxImages )
+			return UMax;
+
+		bool	sampled, storage;
+		GetImageBindings( image, OUT sampled, OUT storage );
+
+		if ( not (sampled or storage) )
+			return UMax;
+
+		// transient image has no memory until command buffer is executed
+		if ( image.IsTransient() )
+			return UMax;
+
+		return id.Index();
+	}
+
+	uint  VBindlessDescriptorSet::GetIndex (RawBufferID id, const VBuffer &buffer) const
+	{
+		if ( not IsEnabled() or id.Index() >= _maxBuffers )
+			return UMax;
+
+		if ( not AllBits( buffer.Description().usage, EBufferUsage::Storage ))
+			return UMax;
+
+		return id.Index();
+	}
+
+	uint  VBindlessDescriptorSet::GetIndex (RawSamplerID id) const
+	{
+		if ( not IsEnabled() or id.Index() >= _maxSamplers )
+			return UMax;
+
+		return id.Index();
+	}
+
+
+}	// FG
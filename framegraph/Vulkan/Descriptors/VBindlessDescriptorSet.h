@@ -0,0 +1,80 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Global descriptor set for bindless resources.
+	Index of resource in descriptor set is the same as index of resource in the resource manager pool,
+	so it is stable while resource is alive and may be reused after resource is destroyed.
+	All bindings are partially bound and update-after-bind, descriptors for new resources
+	are written while descriptor set is used in command buffers that are pending execution.
+*/
+
+#pragma once
+
+#include "framegraph/Public/FrameGraph.h"
+#include "VDescriptorSetLayout.h"
+#include "VBuffer.h"
+#include "VImage.h"
+#include "VSampler.h"
+
+namespace FG
+{
+
+	//
+	// Vulkan Bindless Descriptor Set
+	//
+
+	class VBindlessDescriptorSet final
+	{
+	// types
+	public:
+		using BindlessDesc			= IFrameGraph::BindlessDesc;
+		using DescriptorBinding_t	= VDescriptorSetLayout::DescriptorBinding_t;
+
+		static constexpr uint	SampledImageBinding		= 0;
+		static constexpr uint	StorageImageBinding		= 1;
+		static constexpr uint	SamplerBinding			= 2;
+		static constexpr uint	StorageBufferBinding	= 3;
+
+
+	// variables
+	private:
+		VDevice const&				_device;
+
+		Mutex						_guard;			// descriptor set must be externally synchronized for update
+		Atomic<bool>				_enabled		{false};
+
+		VkDescriptorPool			_descPool		= VK_NULL_HANDLE;
+		VkDescriptorSet				_descSet		= VK_NULL_HANDLE;
+		RawDescriptorSetLayoutID	_layoutId;
+		DescriptorSetID				_descSetId;
+
+		uint						_maxImages		= 0;
+		uint						_maxSamplers	= 0;
+		uint						_maxBuffers		= 0;
+
+
+	// methods
+	public:
+		explicit VBindlessDescriptorSet (const VDevice &);
+		~VBindlessDescriptorSet ();
+
+		bool  Initialize (RawDescriptorSetLayoutID layoutId, VkDescriptorSetLayout layout, const BindlessDesc &desc);
+		void  Deinitialize (VResourceManager &);
+
+		void  WriteImage (RawImageID id, const VImage &image);
+		void  WriteBuffer (RawBufferID id, const VBuffer &buffer);
+		void  WriteSampler (RawSamplerID id, const VSampler &sampler);
+
+		ND_ uint  GetIndex (RawImageID id, const VImage &image) const;
+		ND_ uint  GetIndex (RawBufferID id, const VBuffer &buffer) const;
+		ND_ uint  GetIndex (RawSamplerID id) const;
+
+		ND_ bool						IsEnabled ()			const	{ return _enabled.load( memory_order_acquire ); }
+		ND_ VkDescriptorSet				Handle ()				const	{ return _descSet; }
+		ND_ RawDescriptorSetLayoutID	GetLayoutID ()			const	{ return _layoutId; }
+		ND_ DescriptorSetID const&		GetDescriptorSetID ()	const	{ return _descSetId; }
+
+		static bool  GetBindings (const VDevice &dev, const BindlessDesc &desc, OUT DescriptorBinding_t &binding);
+	};
+
+
+}	// FG
@@ -141,6 +141,19 @@ namespace FG
 		return true;
 	}
 
+/*
+=================================================
+	CreateTransientPool
+----
+	pool is owned by command batch and is reset when batch complete execution,
+	so individual sets can not be freed and global lock is not needed.
+=================================================
+*/
+	bool  VDescriptorManager::CreateTransientPool (OUT VkDescriptorPool &pool) const
+	{
+		return _CreatePool( TransientPoolSize, MaxTransientSets, 0, OUT pool );
+	}
+
 /*
 =================================================
 	_CreateDescriptorPool
@@ -150,21 +163,35 @@ namespace FG
 	{
 		CHECK_ERR( _descriptorPools.size() < _descriptorPools.capacity() );
 
+		VkDescriptorPool	ds_pool;
+		CHECK_ERR( _CreatePool( MaxDescriptorPoolSize, MaxDescriptorSets, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, OUT ds_pool ));
+
+		_descriptorPools.push_back({ ds_pool });
+		return true;
+	}
+	
+/*
+=================================================
+	_CreatePool
+=================================================
+*/
+	bool  VDescriptorManager::_CreatePool (uint poolSize, uint maxSets, VkDescriptorPoolCreateFlags flags, OUT VkDescriptorPool &pool) const
+	{
 		FixedArray< VkDescriptorPoolSize, 32 >	pool_sizes;
 
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_SAMPLER,						MaxDescriptorPoolSize });
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,		MaxDescriptorPoolSize * 4 });
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,				MaxDescriptorPoolSize });
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,				MaxDescriptorPoolSize });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_SAMPLER,						poolSize });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,		poolSize * 4 });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,				poolSize });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,				poolSize });
 
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,				MaxDescriptorPoolSize * 4 });
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,				MaxDescriptorPoolSize * 2 });
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,		MaxDescriptorPoolSize });
-		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,		MaxDescriptorPoolSize });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,				poolSize * 4 });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,				poolSize * 2 });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,		poolSize });
+		pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,		poolSize });
 		
 		#ifdef VK_NV_ray_tracing
 		if ( _device.GetFeatures().rayTracingNV ) {
-			pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV, MaxDescriptorPoolSize });
+			pool_sizes.push_back({ VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV, poolSize });
 		}
 		#endif
 
@@ -173,13 +200,10 @@ namespace FG
 		info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		info.poolSizeCount	= uint(pool_sizes.size());
 		info.pPoolSizes		= pool_sizes.data();
-		info.maxSets		= MaxDescriptorSets;
-		info.flags			= VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+		info.maxSets		= maxSets;
+		info.flags			= flags;
 
-		VkDescriptorPool	ds_pool;
-		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &info, null, OUT &ds_pool ));
-
-		_descriptorPools.push_back({ ds_pool });
+		VK_CHECK( _device.vkCreateDescriptorPool( _device.GetVkDevice(), &info, null, OUT &pool ));
 		return true;
 	}
 
@@ -17,6 +17,8 @@ namespace FG
 	private:
 		static constexpr uint	MaxDescriptorPoolSize	= 1u << 11;
 		static constexpr uint	MaxDescriptorSets		= 1u << 10;
+		static constexpr uint	TransientPoolSize		= 1u << 9;
+		static constexpr uint	MaxTransientSets		= 1u << 8;
 
 		struct DSPool
 		{
@@ -47,8 +49,11 @@ namespace FG
 		bool DeallocDescriptorSet (const DescriptorSet &ds);
 		bool DeallocDescriptorSets (ArrayView<DescriptorSet> ds);
 
+		bool CreateTransientPool (OUT VkDescriptorPool &pool) const;
+
 	private:
 		bool _CreateDescriptorPool ();
+		bool _CreatePool (uint poolSize, uint maxSets, VkDescriptorPoolCreateFlags flags, OUT VkDescriptorPool &pool) const;
 	};
 
 
@@ -52,9 +52,12 @@ namespace FG
 /*
 =================================================
 	Create
+----
+	'updateAfterBind' is used for bindless descriptor set,
+	all bindings can be updated while descriptor set is in use.
 =================================================
 */
-	bool VDescriptorSetLayout::Create (const VDevice &dev, const DescriptorBinding_t &binding)
+	bool VDescriptorSetLayout::Create (const VDevice &dev, const DescriptorBinding_t &binding, bool updateAfterBind)
 	{
 		EXLOCK( _drCheck );
 		CHECK_ERR( not _layout );
@@ -63,9 +66,38 @@ namespace FG
 		descriptor_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 		descriptor_info.pBindings		= binding.data();
 		descriptor_info.bindingCount	= uint(binding.size());
+		
+		Array<VkDescriptorBindingFlagsEXT>				binding_flags;
+		VkDescriptorSetLayoutBindingFlagsCreateInfoEXT	flags_info = {};
+
+		if ( updateAfterBind )
+		{
+			CHECK_ERR( dev.GetFeatures().descriptorIndexing );
+
+			binding_flags.resize( binding.size(), VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+												  VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT );
+
+			flags_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+			flags_info.bindingCount		= uint(binding_flags.size());
+			flags_info.pBindingFlags	= binding_flags.data();
+
+			descriptor_info.pNext		= &flags_info;
+			descriptor_info.flags		= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+
+			for (auto& bind : binding) {
+				_hash << HashOf( bind.binding ) << HashOf( bind.descriptorType ) << HashOf( bind.descriptorCount );
+			}
+		}
 
 		VK_CHECK( dev.vkCreateDescriptorSetLayout( dev.GetVkDevice(), &descriptor_info, null, OUT &_layout ));
 
+		// bindless descriptor set is updated per resource
+		if ( not updateAfterBind )
+		{
+			_CreateUpdateTemplate( dev, binding );
+			_CreatePushLayout( dev, binding );
+		}
+
 		_resourcesTemplate = PipelineResourcesHelper::CreateDynamicData( _uniforms, _maxIndex+1, _elementCount, _dynamicOffsetCount );
 		return true;
 	}
@@ -83,23 +115,172 @@ namespace FG
 			resMngr.GetDescriptorManager().DeallocDescriptorSets( _descSetCache );
 		}
 
+		if ( _updateTemplate ) {
+			auto&	dev = resMngr.GetDevice();
+			dev.vkDestroyDescriptorUpdateTemplateKHR( dev.GetVkDevice(), _updateTemplate, null );
+		}
+
 		if ( _layout ) {
 			auto&	dev = resMngr.GetDevice();
 			dev.vkDestroyDescriptorSetLayout( dev.GetVkDevice(), _layout, null );
 		}
 
+		if ( _pushLayout ) {
+			auto&	dev = resMngr.GetDevice();
+			dev.vkDestroyDescriptorSetLayout( dev.GetVkDevice(), _pushLayout, null );
+		}
+
 		_descSetCache.clear();
+		_templateEntries.clear();
 		_resourcesTemplate.reset();
 		_poolSize.clear();
 
 		_uniforms			= null;
 		_layout				= VK_NULL_HANDLE;
+		_updateTemplate		= VK_NULL_HANDLE;
+		_pushLayout			= VK_NULL_HANDLE;
+		_templateDataSize	= 0;
 		_hash				= Default;
 		_maxIndex			= 0;
 		_elementCount		= 0;
 		_dynamicOffsetCount	= 0;
 	}
 	
+/*
+=================================================
+	_CreateUpdateTemplate
+----
+	descriptor infos are packed into single memory block in binding order,
+	so descriptor set can be updated with a single call without 'VkWriteDescriptorSet' array.
+	Template is optional, 'vkUpdateDescriptorSets' is used if it is not created.
+=================================================
+*/
+	void VDescriptorSetLayout::_CreateUpdateTemplate (const VDevice &dev, const DescriptorBinding_t &binding)
+	{
+		if ( not dev.GetFeatures().descriptorUpdateTemplate or binding.empty() )
+			return;
+
+		UpdateTemplateEntries_t	entries;
+		if ( not _CalcTemplateEntries( binding, _maxIndex, OUT _templateEntries, OUT entries, OUT _templateDataSize ))
+		{
+			_templateDataSize = 0;
+			_templateEntries.clear();
+			return;
+		}
+
+		VkDescriptorUpdateTemplateCreateInfo	info = {};
+		info.sType						= VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+		info.descriptorUpdateEntryCount	= uint(entries.size());
+		info.pDescriptorUpdateEntries	= entries.data();
+		info.templateType				= VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+		info.descriptorSetLayout		= _layout;
+
+		if ( dev.vkCreateDescriptorUpdateTemplateKHR( dev.GetVkDevice(), &info, null, OUT &_updateTemplate ) != VK_SUCCESS )
+		{
+			_updateTemplate		= VK_NULL_HANDLE;
+			_templateDataSize	= 0;
+			_templateEntries.clear();
+		}
+	}
+
+/*
+=================================================
+	_CalcTemplateEntries
+----
+	returns 'false' if some bindings can't be written by template.
+=================================================
+*/
+	bool VDescriptorSetLayout::_CalcTemplateEntries (const DescriptorBinding_t &binding, uint maxIndex, OUT TemplateEntries_t &templateEntries,
+													 OUT UpdateTemplateEntries_t &updateEntries, OUT uint &dataSize)
+	{
+		updateEntries.clear();
+		updateEntries.reserve( binding.size() );
+
+		templateEntries.clear();
+		templateEntries.resize( maxIndex + 1 );
+		dataSize = 0;
+
+		for (auto& bind : binding)
+		{
+			size_t	stride = 0;
+
+			switch ( bind.descriptorType )
+			{
+				case VK_DESCRIPTOR_TYPE_SAMPLER :
+				case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER :
+				case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE :
+				case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE :
+				case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT :			stride = sizeof(VkDescriptorImageInfo);		break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :
+				case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC :
+				case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC :	stride = sizeof(VkDescriptorBufferInfo);	break;
+				case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER :
+				case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER :		stride = sizeof(VkBufferView);				break;
+				default :
+					// acceleration structures are written with 'vkUpdateDescriptorSets'
+					return false;
+			}
+
+			CHECK_ERR( bind.binding < templateEntries.size() );
+
+			auto&	dst = templateEntries[ bind.binding ];
+			dst.offset	= dataSize;
+			dst.count	= bind.descriptorCount;
+			dst.type	= bind.descriptorType;
+
+			VkDescriptorUpdateTemplateEntry	entry = {};
+			entry.dstBinding		= bind.binding;
+			entry.dstArrayElement	= 0;
+			entry.descriptorCount	= bind.descriptorCount;
+			entry.descriptorType	= bind.descriptorType;
+			entry.offset			= dst.offset;
+			entry.stride			= stride;
+			updateEntries.push_back( entry );
+
+			dataSize += uint(stride * bind.descriptorCount);
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_CreatePushLayout
+----
+	small descriptor set without dynamic offsets can be pushed directly into the command buffer,
+	so descriptor set is not allocated and cached for each combination of resources.
+	Push layout is optional, pipeline layout selects which descriptor set will use it.
+=================================================
+*/
+	void VDescriptorSetLayout::_CreatePushLayout (const VDevice &dev, const DescriptorBinding_t &binding)
+	{
+	#ifdef VK_KHR_push_descriptor
+		if ( not dev.GetFeatures().pushDescriptor or binding.empty() or _dynamicOffsetCount > 0 )
+			return;
+
+		const uint	max_descriptors	= Min( MaxPushDescriptors, dev.GetProperties().pushDescriptorProperties.maxPushDescriptors );
+		uint		count			= 0;
+
+		for (auto& bind : binding) {
+			count += bind.descriptorCount;
+		}
+
+		if ( count > max_descriptors )
+			return;
+
+		VkDescriptorSetLayoutCreateInfo	descriptor_info = {};
+		descriptor_info.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+		descriptor_info.flags			= VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+		descriptor_info.pBindings		= binding.data();
+		descriptor_info.bindingCount	= uint(binding.size());
+
+		if ( dev.vkCreateDescriptorSetLayout( dev.GetVkDevice(), &descriptor_info, null, OUT &_pushLayout ) != VK_SUCCESS )
+			_pushLayout = VK_NULL_HANDLE;
+	#else
+		Unused( dev, binding );
+	#endif
+	}
+
 /*
 =================================================
 	AllocDescriptorSet
@@ -15,16 +15,29 @@ namespace FG
 
 	class VDescriptorSetLayout final
 	{
+		friend class VDescriptorSetLayoutUnitTest;
+
 	// types
 	public:
 		using DescriptorBinding_t	= Array< VkDescriptorSetLayoutBinding >;
 		using DescriptorSet			= Pair< VkDescriptorSet, /*pool index*/uint8_t >;
 
+		struct TemplateEntry
+		{
+			uint				offset	= UMax;		// in bytes, 'UMax' if binding is not used
+			uint				count	= 0;
+			VkDescriptorType	type	= VK_DESCRIPTOR_TYPE_MAX_ENUM;
+		};
+		using TemplateEntries_t		= Array< TemplateEntry >;	// indexed by binding
+
+		static constexpr uint	MaxPushDescriptors	= 4;	// only small sets are pushed into command buffer
+
 	private:
 		using UniformMapPtr			= PipelineDescription::UniformMapPtr;
 		using PoolSizeArray_t		= FixedArray< VkDescriptorPoolSize, 10 >;
 		using DynamicDataPtr		= PipelineResources::DynamicDataPtr;
 		using DescSetCache_t		= FixedArray< DescriptorSet, 32 >;
+		using UpdateTemplateEntries_t	= Array< VkDescriptorUpdateTemplateEntry >;
 
 
 	// variables
@@ -42,7 +55,12 @@ namespace FG
 		mutable DescSetCache_t	_descSetCache;
 
 		DebugName_t				_debugName;
-		// TODO: desc set update template
+
+		VkDescriptorUpdateTemplate	_updateTemplate		= VK_NULL_HANDLE;
+		TemplateEntries_t			_templateEntries;
+		uint						_templateDataSize	= 0;
+
+		VkDescriptorSetLayout		_pushLayout			= VK_NULL_HANDLE;	// same bindings, but created for 'vkCmdPushDescriptorSetKHR'
 
 		RWDataRaceCheck			_drCheck;
 
@@ -55,7 +73,7 @@ namespace FG
 		VDescriptorSetLayout (const VDevice &dev, const UniformMapPtr &uniforms, OUT DescriptorBinding_t &binding);
 		~VDescriptorSetLayout ();
 
-		bool Create (const VDevice &dev, const DescriptorBinding_t &binding);
+		bool Create (const VDevice &dev, const DescriptorBinding_t &binding, bool updateAfterBind = false);
 		void Destroy (VResourceManager &);
 
 		bool AllocDescriptorSet (VResourceManager &, OUT DescriptorSet &) const;
@@ -70,8 +88,17 @@ namespace FG
 		ND_ uint					GetMaxIndex ()		const	{ SHAREDLOCK( _drCheck );  return _maxIndex; }
 		ND_ StringView				GetDebugName ()		const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 
+		ND_ VkDescriptorUpdateTemplate	GetUpdateTemplate ()	const	{ SHAREDLOCK( _drCheck );  return _updateTemplate; }
+		ND_ ArrayView<TemplateEntry>	GetTemplateEntries ()	const	{ SHAREDLOCK( _drCheck );  return _templateEntries; }
+		ND_ uint						GetTemplateDataSize ()	const	{ SHAREDLOCK( _drCheck );  return _templateDataSize; }
+		ND_ VkDescriptorSetLayout		GetPushLayout ()		const	{ SHAREDLOCK( _drCheck );  return _pushLayout; }
+
 
 	private:
+		void _CreateUpdateTemplate (const VDevice &dev, const DescriptorBinding_t &binding);
+		static bool _CalcTemplateEntries (const DescriptorBinding_t &binding, uint maxIndex, OUT TemplateEntries_t &templateEntries,
+										  OUT UpdateTemplateEntries_t &updateEntries, OUT uint &dataSize);
+		void _CreatePushLayout (const VDevice &dev, const DescriptorBinding_t &binding);
 		void _AddUniform (const PipelineDescription::Uniform &un, INOUT DescriptorBinding_t &binding);
 		void _AddImage (const PipelineDescription::Image &img, uint bindingIndex, uint arraySize, EShaderStages stageFlags, INOUT DescriptorBinding_t &binding);
 		void _AddTexture (const PipelineDescription::Texture &tex, uint bindingIndex, uint arraySize, EShaderStages stageFlags, INOUT DescriptorBinding_t &binding);
@@ -3,6 +3,7 @@
 #include "Shared/PipelineResourcesHelper.h"
 #include "VPipelineResources.h"
 #include "VResourceManager.h"
+#include "VCmdBatch.h"
 #include "VDevice.h"
 #include "VEnumCast.h"
 #include "stl/Algorithms/StringUtils.h"
@@ -23,7 +24,7 @@ namespace FG
 		
 		_dataPtr	= PipelineResourcesHelper::CloneDynamicData( desc );
 		_layoutId	= desc.GetLayout();
-		_hash		= HashOf( _layoutId ) + _dataPtr->CalcHash();
+		_hash		= HashOf( _layoutId ) + _dataPtr->GetHash();
 	}
 	
 /*
@@ -38,7 +39,7 @@ namespace FG
 		EXLOCK( _drCheck );
 		
 		_layoutId	= _dataPtr->layoutId;
-		_hash		= HashOf( _layoutId ) + _dataPtr->CalcHash();
+		_hash		= HashOf( _layoutId ) + _dataPtr->GetHash();
 	}
 
 /*
@@ -62,8 +63,73 @@ namespace FG
 		CHECK_ERR( not _descriptorSet.first );
 		CHECK_ERR( _dataPtr );
 
-		VDevice const&	dev			= resMngr.GetDevice();
 		auto const*		ds_layout	= resMngr.GetResource( _layoutId );
+		CHECK_ERR( ds_layout );
+		CHECK_ERR( ds_layout->AllocDescriptorSet( resMngr, OUT _descriptorSet ));
+
+		_WriteDescriptors( resMngr, *ds_layout );
+		return true;
+	}
+	
+/*
+=================================================
+	Create
+----
+	descriptor set is allocated from the command batch pool,
+	it is released when batch complete execution on the GPU.
+=================================================
+*/
+	bool  VPipelineResources::Create (VResourceManager &resMngr, VCmdBatch &batch)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( not _descriptorSet.first );
+		CHECK_ERR( _dataPtr );
+
+		auto const*		ds_layout	= resMngr.GetResource( _layoutId );
+		CHECK_ERR( ds_layout );
+		CHECK_ERR( batch.AllocTransientDescriptorSet( ds_layout->Handle(), OUT _descriptorSet.first ));
+
+		_isTransient = true;
+		_WriteDescriptors( resMngr, *ds_layout );
+		return true;
+	}
+	
+/*
+=================================================
+	CreatePushDescriptors
+----
+	descriptor set is not allocated, descriptors are pushed into the command buffer.
+	Object is owned by command buffer, so layout reference is not acquired.
+=================================================
+*/
+	bool  VPipelineResources::CreatePushDescriptors (VResourceManager &resMngr)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( not _descriptorSet.first );
+		CHECK_ERR( _dataPtr );
+
+		auto const*		ds_layout	= resMngr.GetResource( _layoutId );
+		CHECK_ERR( ds_layout );
+		CHECK_ERR( ds_layout->GetPushLayout() );
+
+		_isTransient = true;
+		_WriteDescriptors( resMngr, *ds_layout );
+		return true;
+	}
+
+/*
+=================================================
+	_WriteDescriptors
+----
+	descriptor writes are kept if descriptor set is not allocated or if it can be pushed,
+	otherwise they are discarded after descriptor set update.
+	Descriptor set may be shared between command buffers and may be bound or pushed,
+	so writes for push descriptors are created here and are immutable after creation.
+=================================================
+*/
+	void  VPipelineResources::_WriteDescriptors (VResourceManager &resMngr, const VDescriptorSetLayout &dsLayout)
+	{
+		VDevice const&	dev = resMngr.GetDevice();
 		
 		// Without the nullDescriptor feature enabled, when updating a VkDescriptorSet, all the resources backing it must be non-null,
 		// even if the descriptor is statically not used by the shader. This feature allows descriptors to be backed by null resources or views.
@@ -79,18 +145,75 @@ namespace FG
 		{
 			_allowEmptyResources = false;
 		}
-
-		CHECK_ERR( ds_layout );
-		CHECK_ERR( ds_layout->AllocDescriptorSet( resMngr, OUT _descriptorSet ));
 		
-		UpdateDescriptors	update;
-		update.descriptors		= update.allocator.Alloc< VkWriteDescriptorSet >( ds_layout->GetMaxIndex() + 1 );
+		const VkDescriptorSet	desc_set = _descriptorSet.first;
+
+		// only push descriptors
+		if ( not desc_set )
+		{
+			_pushDescriptors = MakeUnique<UpdateDescriptors>();
+			_AddResources( resMngr, dsLayout, VK_NULL_HANDLE, OUT *_pushDescriptors );
+			return;
+		}
+
+		// 'dstSet' is ignored when descriptors are pushed, so the same writes are used
+		if ( dsLayout.GetPushLayout() )
+			_pushDescriptors = MakeUnique<UpdateDescriptors>();
+
+		const VkDescriptorUpdateTemplate	update_tmpl	= dsLayout.GetUpdateTemplate();
+		UpdateDescriptors					local_update;
+		UpdateDescriptors&					update		= (_pushDescriptors ? *_pushDescriptors : local_update);
+
+		_AddResources( resMngr, dsLayout, update_tmpl, OUT update );
+
+		// template writes all bindings, so it can be used only if all descriptors are valid
+		if ( update.useTemplate and update.descriptorIndex == dsLayout.GetUniforms()->size() )
+			dev.vkUpdateDescriptorSetWithTemplateKHR( dev.GetVkDevice(), desc_set, update_tmpl, update.templateData );
+		else
+			dev.vkUpdateDescriptorSets( dev.GetVkDevice(), update.descriptorIndex, update.descriptors, 0, null );
+	}
+
+/*
+=================================================
+	_AddResources
+=================================================
+*/
+	void  VPipelineResources::_AddResources (VResourceManager &resMngr, const VDescriptorSetLayout &dsLayout, VkDescriptorUpdateTemplate updateTmpl,
+											 OUT UpdateDescriptors &update) const
+	{
+		update.descriptors		= update.allocator.Alloc< VkWriteDescriptorSet >( dsLayout.GetMaxIndex() + 1 );
 		update.descriptorIndex	= 0;
 
-		_dataPtr->ForEachUniform( [&](auto& un, auto& data) { _AddResource( resMngr, un, data, INOUT update ); });
-		
-		dev.vkUpdateDescriptorSets( dev.GetVkDevice(), update.descriptorIndex, update.descriptors, 0, null );
-		return true;
+		if ( updateTmpl )
+		{
+			update.templateEntries	= dsLayout.GetTemplateEntries();
+			update.templateData		= update.allocator.Alloc( BytesU{dsLayout.GetTemplateDataSize()}, 16_b );
+			update.useTemplate		= true;
+		}
+
+		_dataPtr->ForEachUniform( [&](auto& un, auto& data) { update.useTemplate &= _AddResource( resMngr, un, data, INOUT update ); });
+	}
+
+/*
+=================================================
+	AllocInfo
+----
+	returns pointer to the template data if layout of the resources matches with template entry.
+=================================================
+*/
+	template <typename T>
+	inline T*  VPipelineResources::UpdateDescriptors::AllocInfo (uint binding, uint count, VkDescriptorType type)
+	{
+		if ( useTemplate and binding < templateEntries.size() )
+		{
+			auto&	entry = templateEntries[binding];
+
+			if ( entry.count == count and entry.type == type )
+				return BitCast<T *>( static_cast<uint8_t *>(templateData) + entry.offset );
+		}
+
+		useTemplate = false;
+		return allocator.Alloc<T>( count );
 	}
 
 /*
@@ -102,23 +225,44 @@ namespace FG
 	{
 		EXLOCK( _drCheck );
 
-		auto*	ds_layout = resMngr.GetResource( _layoutId, false, true );
+		// transient descriptor set is owned by command batch and layout reference is not acquired
+		if ( not _isTransient )
+		{
+			auto*	ds_layout = resMngr.GetResource( _layoutId, false, true );
 
-		if ( ds_layout and _descriptorSet.first ) {
-			ds_layout->ReleaseDescriptorSet( resMngr, _descriptorSet );
-		}
+			if ( ds_layout and _descriptorSet.first ) {
+				ds_layout->ReleaseDescriptorSet( resMngr, _descriptorSet );
+			}
 
-		// release reference only if descriptor set was created
-		if ( _layoutId and _descriptorSet.first ) {
-			resMngr.ReleaseResource( _layoutId );
+			// release reference only if descriptor set was created
+			if ( _layoutId and _descriptorSet.first ) {
+				resMngr.ReleaseResource( _layoutId );
+			}
 		}
 
 		_dataPtr.reset();
+		_pushDescriptors.reset();
+		_isTransient	= false;
 		_descriptorSet	= { VK_NULL_HANDLE, UMax };
 		_layoutId		= Default;
 		_hash			= Default;
 	}
 	
+/*
+=================================================
+	GetPushDescriptors
+=================================================
+*/
+	ArrayView<VkWriteDescriptorSet>  VPipelineResources::GetPushDescriptors () const
+	{
+		SHAREDLOCK( _drCheck );
+
+		if ( not _pushDescriptors )
+			return Default;
+
+		return ArrayView<VkWriteDescriptorSet>{ _pushDescriptors->descriptors, _pushDescriptors->descriptorIndex };
+	}
+
 /*
 =================================================
 	IsAllResourcesAlive
@@ -239,9 +383,15 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Buffer &buf, INOUT UpdateDescriptors &list)
+	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Buffer &buf, INOUT UpdateDescriptors &list) const
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorBufferInfo >( buf.elementCount );
+		const bool				is_uniform	= ((buf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
+		const bool				is_dynamic	= AllBits( buf.state, EResourceState::_BufferDynamicOffset );
+		const VkDescriptorType	type		= (is_uniform ?
+												(is_dynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) :
+												(is_dynamic ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+
+		auto*	info = list.AllocInfo< VkDescriptorBufferInfo >( buf.index.VKBinding(), buf.elementCount, type );
 
 		for (uint i = 0; i < buf.elementCount; ++i)
 		{
@@ -261,15 +411,10 @@ namespace FG
 			_CheckBufferUsage( *buffer, buf.state );
 		}
 
-		const bool	is_uniform	= ((buf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
-		const bool	is_dynamic	= AllBits( buf.state, EResourceState::_BufferDynamicOffset );
-
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		wds.descriptorType	= (is_uniform ?
-								(is_dynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) :
-								(is_dynamic ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER));
+		wds.descriptorType	= type;
 		wds.descriptorCount	= buf.elementCount;
 		wds.dstBinding		= buf.index.VKBinding();
 		wds.dstSet			= _descriptorSet.first;
@@ -283,9 +428,12 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::TexelBuffer &texbuf, INOUT UpdateDescriptors &list)
+	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::TexelBuffer &texbuf, INOUT UpdateDescriptors &list) const
 	{
-		auto*	info = list.allocator.Alloc< VkBufferView >( texbuf.elementCount );
+		const bool				is_uniform	= ((texbuf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
+		const VkDescriptorType	type		= is_uniform ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+
+		auto*	info = list.AllocInfo< VkBufferView >( texbuf.index.VKBinding(), texbuf.elementCount, type );
 
 		for (uint i = 0; i < texbuf.elementCount; ++i)
 		{
@@ -309,12 +457,10 @@ namespace FG
 			_CheckTexelBufferUsage( *buffer, texbuf.state );
 		}
 		
-		const bool	is_uniform	= ((texbuf.state & EResourceState::_StateMask) == EResourceState::UniformRead);
-
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		wds.descriptorType		= is_uniform ? VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER;
+		wds.descriptorType		= type;
 		wds.descriptorCount		= texbuf.elementCount;
 		wds.dstBinding			= texbuf.index.VKBinding();
 		wds.dstSet				= _descriptorSet.first;
@@ -328,9 +474,12 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Image &img, INOUT UpdateDescriptors &list)
+	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Image &img, INOUT UpdateDescriptors &list) const
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( img.elementCount );
+		const VkDescriptorType	type = ((img.state & EResourceState::_StateMask) == EResourceState::InputAttachment) ?
+										VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+
+		auto*	info = list.AllocInfo< VkDescriptorImageInfo >( img.index.VKBinding(), img.elementCount, type );
 
 		for (uint i = 0; i < img.elementCount; ++i)
 		{
@@ -360,8 +509,7 @@ namespace FG
 		VkWriteDescriptorSet&	wds = list.descriptors[list.descriptorIndex++];
 		wds = {};
 		wds.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		wds.descriptorType	= ((img.state & EResourceState::_StateMask) == EResourceState::InputAttachment) ?
-								VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT : VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+		wds.descriptorType	= type;
 		wds.descriptorCount	= img.elementCount;
 		wds.dstBinding		= img.index.VKBinding();
 		wds.dstSet			= _descriptorSet.first;
@@ -375,9 +523,9 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Texture &tex, INOUT UpdateDescriptors &list)
+	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, INOUT PipelineResources::Texture &tex, INOUT UpdateDescriptors &list) const
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( tex.elementCount );
+		auto*	info = list.AllocInfo< VkDescriptorImageInfo >( tex.index.VKBinding(), tex.elementCount, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER );
 
 		for (uint i = 0; i < tex.elementCount; ++i)
 		{
@@ -422,9 +570,9 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, const PipelineResources::Sampler &samp, INOUT UpdateDescriptors &list)
+	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, const PipelineResources::Sampler &samp, INOUT UpdateDescriptors &list) const
 	{
-		auto*	info = list.allocator.Alloc< VkDescriptorImageInfo >( samp.elementCount );
+		auto*	info = list.AllocInfo< VkDescriptorImageInfo >( samp.index.VKBinding(), samp.elementCount, VK_DESCRIPTOR_TYPE_SAMPLER );
 
 		for (uint i = 0; i < samp.elementCount; ++i)
 		{
@@ -459,7 +607,7 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, const PipelineResources::RayTracingScene &rtScene, INOUT UpdateDescriptors &list)
+	bool  VPipelineResources::_AddResource (VResourceManager &resMngr, const UniformID &un, const PipelineResources::RayTracingScene &rtScene, INOUT UpdateDescriptors &list) const
 	{
 	#ifdef VK_NV_ray_tracing
 		auto*	tlas = list.allocator.Alloc<VkAccelerationStructureNV>( rtScene.elementCount );
@@ -507,7 +655,7 @@ namespace FG
 	_AddResource
 =================================================
 */
-	bool  VPipelineResources::_AddResource (VResourceManager &, const UniformID &un, const NullUnion &, INOUT UpdateDescriptors &)
+	bool  VPipelineResources::_AddResource (VResourceManager &, const UniformID &un, const NullUnion &, INOUT UpdateDescriptors &) const
 	{
 		#if FG_OPTIMIZE_IDS
 			Unused( un );
@@ -17,11 +17,19 @@ namespace FG
 	{
 	// types
 	private:
+		using TemplateEntry		= VDescriptorSetLayout::TemplateEntry;
+
 		struct UpdateDescriptors
 		{
 			LinearAllocator<>			allocator;
 			VkWriteDescriptorSet *		descriptors;
 			uint						descriptorIndex;
+			ArrayView<TemplateEntry>	templateEntries;
+			void *						templateData	= null;
+			bool						useTemplate		= false;
+
+			template <typename T>
+			ND_ T*  AllocInfo (uint binding, uint count, VkDescriptorType type);
 		};
 
 		//using Element_t			= Union< VkDescriptorBufferInfo, VkDescriptorImageInfo, VkAccelerationStructureNV >;
@@ -36,6 +44,9 @@ namespace FG
 		HashVal						_hash;
 		DynamicDataPtr				_dataPtr;
 		bool						_allowEmptyResources;
+		bool						_isTransient		= false;	// descriptor set is allocated from command batch pool or not allocated at all
+
+		UniquePtr<UpdateDescriptors>	_pushDescriptors;	// created only if resources can be pushed into command buffer
 		
 		DebugName_t					_debugName;
 		
@@ -52,6 +63,8 @@ namespace FG
 		~VPipelineResources ();
 
 			bool Create (VResourceManager &);
+			bool Create (VResourceManager &, VCmdBatch &);
+			bool CreatePushDescriptors (VResourceManager &);
 			void Destroy (VResourceManager &);
 
 		ND_ bool IsAllResourcesAlive (const VResourceManager &) const;
@@ -64,18 +77,22 @@ namespace FG
 		ND_ VkDescriptorSet				Handle ()		const	{ SHAREDLOCK( _drCheck );  return _descriptorSet.first; }
 		ND_ RawDescriptorSetLayoutID	GetLayoutID ()	const	{ SHAREDLOCK( _drCheck );  return _layoutId; }
 		ND_ HashVal						GetHash ()		const	{ SHAREDLOCK( _drCheck );  return _hash; }
+		ND_ ArrayView<VkWriteDescriptorSet>	GetPushDescriptors () const;
 
 		ND_ StringView					GetDebugName ()	const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 
 
 	private:
-		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::Buffer &, INOUT UpdateDescriptors &);
-		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::TexelBuffer &, INOUT UpdateDescriptors &);
-		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::Image &, INOUT UpdateDescriptors &);
-		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::Texture &, INOUT UpdateDescriptors &);
-		bool _AddResource (VResourceManager &, const UniformID &, const PipelineResources::Sampler &, INOUT UpdateDescriptors &);
-		bool _AddResource (VResourceManager &, const UniformID &, const PipelineResources::RayTracingScene &, INOUT UpdateDescriptors &);
-		bool _AddResource (VResourceManager &, const UniformID &, const NullUnion &, INOUT UpdateDescriptors &);
+		void _WriteDescriptors (VResourceManager &, const VDescriptorSetLayout &);
+		void _AddResources (VResourceManager &, const VDescriptorSetLayout &, VkDescriptorUpdateTemplate, OUT UpdateDescriptors &) const;
+
+		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::Buffer &, INOUT UpdateDescriptors &) const;
+		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::TexelBuffer &, INOUT UpdateDescriptors &) const;
+		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::Image &, INOUT UpdateDescriptors &) const;
+		bool _AddResource (VResourceManager &, const UniformID &, INOUT PipelineResources::Texture &, INOUT UpdateDescriptors &) const;
+		bool _AddResource (VResourceManager &, const UniformID &, const PipelineResources::Sampler &, INOUT UpdateDescriptors &) const;
+		bool _AddResource (VResourceManager &, const UniformID &, const PipelineResources::RayTracingScene &, INOUT UpdateDescriptors &) const;
+		bool _AddResource (VResourceManager &, const UniformID &, const NullUnion &, INOUT UpdateDescriptors &) const;
 
 		void _LogUniform (const UniformID &, uint idx) const;
 
@@ -186,6 +186,7 @@ namespace
 		VK_CHECK( dev.vkCreateImage( dev.GetVkDevice(), &info, null, OUT &_image ));
 
 		CHECK_ERR( memObj.AllocateForImage( resMngr.GetMemoryManager(), _image ));
+		_isTransient = AllBits( memObj.MemoryType(), EMemoryTypeExt::Virtual );
 		
 		if ( not dbgName.empty() )
 		{
@@ -286,6 +287,7 @@ namespace
 		_aspectMask			= Zero;
 		_defaultLayout		= Zero;
 		_queueFamilyMask	= Default;
+		_isTransient		= false;
 		_onRelease			= {};
 	}
 	
@@ -426,6 +428,13 @@ namespace
 		const bool		opt_tiling	= not AnyBits( memType, EMemoryType::HostRead | EMemoryType::HostWrite );
 		const VkFormat	format		= VEnumCast( desc.format );
 
+		// lazily allocated memory can be bound only to transient attachment
+		if ( AllBits( memType, EMemoryType::LazilyAllocated ) and not AllBits( desc.usage, EImageUsage::TransientAttachment ))
+			return false;
+
+		if ( AllBits( desc.usage, EImageUsage::TransientAttachment ) and AnyBits( desc.usage, ~TransientAttachmentUsage ))
+			return false;
+
 		// check available creation flags
 		{
 			VkImageCreateFlagBits	required	= VEnumCast( desc.flags );
@@ -460,7 +469,7 @@ namespace
 					case EImageUsage::ColorAttachment :			required |= VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT;					break;
 					case EImageUsage::ColorAttachmentBlend :	required |= VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT;			break;
 					case EImageUsage::DepthStencilAttachment :	required |= VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;			break;
-					case EImageUsage::TransientAttachment :		break;	// TODO
+					case EImageUsage::TransientAttachment :
 					case EImageUsage::InputAttachment :			break;
 					case EImageUsage::ShadingRate :				if ( not dev.GetFeatures().shadingRateImageNV ) return false;		break;
 					//case EImageUsage::FragmentDensityMap :	return false;	// not supported yet
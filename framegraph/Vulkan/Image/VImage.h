@@ -23,6 +23,10 @@ namespace FG
 		using ImageViewMap_t	= HashMap< HashedImageViewDesc, VkImageView, HashOfImageViewDesc >;
 		using OnRelease_t		= IFrameGraph::OnExternalImageReleased_t;
 
+		// image with 'EImageUsage::TransientAttachment' can be used only as attachment
+		static constexpr EImageUsage	TransientAttachmentUsage	= EImageUsage::ColorAttachment | EImageUsage::ColorAttachmentBlend | EImageUsage::DepthStencilAttachment |
+																	  EImageUsage::InputAttachment | EImageUsage::TransientAttachment;
+
 
 	// variables
 	private:
@@ -37,6 +41,7 @@ namespace FG
 		VkImageLayout				_defaultLayout		= Zero;
 		VkAccessFlagBits			_readAccessMask		= Zero;
 		EQueueFamilyMask			_queueFamilyMask	= Default;
+		bool						_isTransient		= false;	// memory is bound by command buffer
 
 		DebugName_t					_debugName;
 		OnRelease_t					_onRelease;
@@ -83,6 +88,7 @@ namespace FG
 		
 		ND_ VkAccessFlagBits	GetAllReadAccessMask ()	const	{ SHAREDLOCK( _drCheck );  return _readAccessMask; }
 
+		ND_ bool				IsTransient ()			const	{ SHAREDLOCK( _drCheck );  return _isTransient; }
 		ND_ bool				IsExclusiveSharing ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask == Default; }
 		ND_ EQueueFamilyMask	GetQueueFamilyMask ()	const	{ SHAREDLOCK( _drCheck );  return _queueFamilyMask; }
 		ND_ StringView			GetDebugName ()			const	{ SHAREDLOCK( _drCheck );  return _debugName; }
@@ -65,6 +65,7 @@ namespace FG
 
 		_pendingAccesses.clear();
 		_accessForReadWrite.clear();
+		_mergedAccesses.clear();
 	}
 
 /*
@@ -181,6 +182,44 @@ namespace FG
 		}
 	}
 	
+/*
+=================================================
+	_IsIntersects
+=================================================
+*/
+	inline bool  VLocalImage::_IsIntersects (const Regions_t &lhs, const Regions_t &rhs)
+	{
+		if ( lhs.empty() or rhs.empty() )
+			return true;
+
+		for (auto& l : lhs)
+		for (auto& r : rhs)
+		{
+			if ( l.Intersects( r ))
+				return true;
+		}
+		return false;
+	}
+	
+/*
+=================================================
+	_MergeRegions
+=================================================
+*/
+	inline void  VLocalImage::_MergeRegions (INOUT Regions_t &dst, const Regions_t &src)
+	{
+		if ( dst.empty() )
+			return;
+
+		if ( src.empty() )
+		{
+			dst.clear();
+			return;
+		}
+
+		dst.insert( dst.end(), src.begin(), src.end() );
+	}
+
 /*
 =================================================
 	SetInitialState
@@ -227,6 +266,13 @@ namespace FG
 		pending.layout			= is.layout;
 		pending.index			= is.task->ExecutionOrder();
 		
+		if ( not is.range.IsWholeRegion() )
+		{
+			// content outside of the region must be preserved
+			pending.invalidateBefore = false;
+			pending.regions.push_back( is.range.Region() );
+		}
+
 
 		// extract sub ranges
 		const uint		arr_layers	= ArrayLayers();
@@ -285,6 +331,7 @@ namespace FG
 				iter->isWritable		|= pending.isWritable;
 				iter->invalidateBefore	&= pending.invalidateBefore;
 				iter->invalidateAfter	&= pending.invalidateAfter;
+				_MergeRegions( INOUT iter->regions, pending.regions );
 			}
 
 			if ( not range.IsEmpty() )
@@ -304,6 +351,14 @@ namespace FG
 	{
 		ASSERT( _pendingAccesses.empty() and "you must commit all pending states before reseting" );
 		
+		// memory of transient image may be already used by another image,
+		// content is not needed after command buffer execution, so layout transition is skipped
+		if ( _imageData->IsTransient() )
+		{
+			_accessForReadWrite.clear();
+			return;
+		}
+
 		// add full range barrier
 		{
 			ImageAccess		pending;
@@ -333,11 +388,10 @@ namespace FG
 */
 	void VLocalImage::CommitBarrier (VBarrierManager &barrierMngr, Ptr<VLocalDebugger> debugger) const
 	{
-		VkPipelineStageFlags	dst_stages = 0;
-
 		for (const auto& pending : _pendingAccesses)
 		{
-			const auto	first = _FindFirstAccess( _accessForReadWrite, pending.range );
+			const auto	first	= _FindFirstAccess( _accessForReadWrite, pending.range );
+			bool		merged	= false;
 
 			for (auto iter = first; iter != _accessForReadWrite.end() and iter->range.begin < pending.range.end; ++iter)
 			{
@@ -348,7 +402,50 @@ namespace FG
 											  (iter->isReadable and pending.isWritable)	or		// read -> write
 											  iter->isWritable;									// write -> read/write
 
-				if ( not range.IsEmpty() and is_modified )
+				const bool		is_read_after_read = not is_modified and iter->isReadable and pending.isReadable;
+
+				if ( range.IsEmpty() )
+					continue;
+
+				// access to non-overlapping regions of the same subresource doesn't require barrier,
+				// but previous access must be kept to add barrier for the next overlapping access.
+				// read -> read doesn't require barrier too, but all reads must be kept for the next write.
+				if ( is_read_after_read or
+					 (is_modified						and
+					  iter->layout == pending.layout	and
+					  not iter->invalidateAfter			and
+					  not _IsIntersects( iter->regions, pending.regions )))
+				{
+					if ( not merged )
+					{
+						for (auto it = first; it != iter; ++it)
+						{
+							const SubRange	r = it->range.Intersect( pending.range );
+							if ( not r.IsEmpty() ) {
+								_mergedAccesses.push_back( pending );
+								_mergedAccesses.back().range = r;
+							}
+						}
+						merged = true;
+					}
+
+					ImageAccess&	acc = _mergedAccesses.emplace_back( pending );
+					acc.range		 = range;
+					acc.stages		|= iter->stages;
+					acc.access		|= iter->access;
+					acc.isReadable	|= iter->isReadable;
+					acc.isWritable	|= iter->isWritable;
+					_MergeRegions( INOUT acc.regions, iter->regions );
+					continue;
+				}
+
+				if ( merged )
+				{
+					_mergedAccesses.push_back( pending );
+					_mergedAccesses.back().range = range;
+				}
+
+				if ( is_modified )
 				{
 					VkImageMemoryBarrier	barrier = {};
 					barrier.sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -370,16 +467,25 @@ namespace FG
 					ASSERT( barrier.subresourceRange.levelCount > 0 );
 					ASSERT( barrier.subresourceRange.layerCount > 0 );
 
-					dst_stages |= pending.stages;
-					barrierMngr.AddImageBarrier( iter->stages, pending.stages, 0, barrier );
+					auto*	split = barrierMngr.FindEvent( iter->index, pending.index, iter->stages );
+
+					barrierMngr.AddImageBarrier( iter->stages, pending.stages, 0, barrier, split );
 
 					if ( debugger ) {
-						debugger->AddImageBarrier( _imageData.get(), iter->index, pending.index, iter->stages, pending.stages, 0, barrier );
+						debugger->AddImageBarrier( _imageData.get(), iter->index, pending.index, iter->stages, pending.stages, 0, barrier, split != null );
 					}
 				}
 			}
 
-			_ReplaceAccessRecords( _accessForReadWrite, first, pending );
+			if ( merged )
+			{
+				for (auto& acc : _mergedAccesses) {
+					_ReplaceAccessRecords( _accessForReadWrite, _FindFirstAccess( _accessForReadWrite, acc.range ), acc );
+				}
+				_mergedAccesses.clear();
+			}
+			else
+				_ReplaceAccessRecords( _accessForReadWrite, first, pending );
 		}
 
 		_pendingAccesses.clear();
@@ -39,11 +39,13 @@ namespace FG
 
 	private:
 		using SubRange	= ImageRange::SubRange_t;
+		using Regions_t	= Array< RectU >;		// empty array means whole subresource
 
 		struct ImageAccess
 		{
 		// variables
 			SubRange				range;
+			Regions_t				regions;		// non-overlapping 2D regions that are accessed in the same layout
 			VkImageLayout			layout			= Zero;
 			VkPipelineStageFlagBits	stages			= Zero;
 			VkAccessFlagBits		access			= Zero;
@@ -69,6 +71,7 @@ namespace FG
 
 		mutable AccessRecords_t		_pendingAccesses;
 		mutable AccessRecords_t		_accessForReadWrite;
+		mutable AccessRecords_t		_mergedAccesses;	// temporary array for 'CommitBarrier'
 		mutable bool				_isImmutable	= false;
 
 
@@ -113,6 +116,9 @@ namespace FG
 		ND_ static AccessIter_t	_FindFirstAccess (AccessRecords_t &arr, const SubRange &range);
 			static void			_ReplaceAccessRecords (INOUT AccessRecords_t &arr, AccessIter_t iter, const ImageAccess &barrier);
 
+		ND_ static bool			_IsIntersects (const Regions_t &lhs, const Regions_t &rhs);
+			static void			_MergeRegions (INOUT Regions_t &dst, const Regions_t &src);
+
 	};
 
 
@@ -157,6 +157,9 @@ namespace FG
 		_features.commandPoolTrim			= has_maintenance1;
 		_features.array2DCompatible			= has_maintenance1;
 		#endif
+		#ifdef VK_KHR_descriptor_update_template
+		_features.descriptorUpdateTemplate	= _vkVersion >= EShaderLangFormat::Vulkan_110 or HasDeviceExtension( VK_KHR_DESCRIPTOR_UPDATE_TEMPLATE_EXTENSION_NAME );
+		#endif
 		#ifdef VK_KHR_device_group
 		_features.dispatchBase				= _vkVersion >= EShaderLangFormat::Vulkan_110 or HasDeviceExtension( VK_KHR_DEVICE_GROUP_EXTENSION_NAME );
 		#endif
@@ -187,6 +190,12 @@ namespace FG
 		#ifdef VK_EXT_robustness2
 		_features.robustness2				= HasDeviceExtension( VK_EXT_ROBUSTNESS_2_EXTENSION_NAME );
 		#endif
+		#ifdef VK_KHR_push_descriptor
+		_features.pushDescriptor			= HasDeviceExtension( VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME );
+		#endif
+		#ifdef VK_EXT_pipeline_creation_feedback
+		_features.pipelineCreationFeedback	= HasDeviceExtension( VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME );
+		#endif
 
 		// load extensions
 		if ( _vkVersion >= EShaderLangFormat::Vulkan_110 or HasInstanceExtension( VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME ))
@@ -305,6 +314,14 @@ namespace FG
 				_properties.robustness2Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ROBUSTNESS_2_PROPERTIES_EXT;
 			}
 			#endif
+			#ifdef VK_KHR_push_descriptor
+			if ( _features.pushDescriptor )
+			{
+				*next_props	= &_properties.pushDescriptorProperties;
+				next_props	= &_properties.pushDescriptorProperties.pNext;
+				_properties.pushDescriptorProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+			}
+			#endif
 			Unused( next_props );
 
 			vkGetPhysicalDeviceProperties2KHR( GetVkPhysicalDevice(), OUT &props2 );
@@ -21,10 +21,11 @@ namespace FG
 	constructor
 =================================================
 */
-	VFrameGraph::VFrameGraph (const VulkanDeviceInfo &vdi) :
+	VFrameGraph::VFrameGraph (const VulkanDeviceInfo &vdi, const TaskScheduler &scheduler) :
 		_state{ EState::Initial },	_device{ vdi },
-		_queueUsage{ Default },		_resourceMngr{ _device, vdi.maxStagingBufferMemory, vdi.stagingBufferSize },
-		_queryPool{ VK_NULL_HANDLE }
+		_queueUsage{ Default },		_resourceMngr{ _device, vdi },
+		_queryPool{ VK_NULL_HANDLE },
+		_scheduler{ scheduler }
 	{
 	}
 	
@@ -93,6 +94,12 @@ namespace FG
 */
 	void  VFrameGraph::Deinitialize ()
 	{
+		// wait for asynchronous 'Execute' jobs
+		{
+			std::unique_lock	lock{ _executingGuard };
+			_executingIdle.wait( lock, [this] () { return _executingJobs == 0; });
+		}
+
 		CHECK_ERRV( _SetState( EState::Idle, EState::Destroyed ));
 		CHECK_ERRV( WaitIdle( MaxTimeout ));
 
@@ -130,7 +137,14 @@ namespace FG
 			_queryPool = VK_NULL_HANDLE;
 		}
 
+		// stop worker threads
+		{
+			EXLOCK( _workerPoolGuard );
+			_workerPool.reset();
+		}
+
 		_shaderDebugCallback = {};
+		_scheduler = null;
 		_resourceMngr.Deinitialize();
 	}
 	
@@ -160,6 +174,169 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	SetPipelineCacheFile
+=================================================
+*/
+	bool  VFrameGraph::SetPipelineCacheFile (StringView filename, uint saveThreshold)
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		return _resourceMngr.GetDiskPipelineCache().Initialize( filename, saveThreshold );
+	}
+	
+/*
+=================================================
+	SavePipelineCache
+=================================================
+*/
+	bool  VFrameGraph::SavePipelineCache ()
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		return _resourceMngr.GetDiskPipelineCache().Save();
+	}
+	
+/*
+=================================================
+	SetAsyncPipelineCompilation
+=================================================
+*/
+	bool  VFrameGraph::SetAsyncPipelineCompilation (bool enable, OnPipelineReady_t &&onReady)
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		auto&	queue = _resourceMngr.GetPipelineCompileQueue();
+
+		if ( not enable )
+		{
+			queue.Deinitialize();
+			return true;
+		}
+		return queue.Initialize( _scheduler, std::move(onReady) );
+	}
+	
+/*
+=================================================
+	SetPipelineManifestFile
+=================================================
+*/
+	bool  VFrameGraph::SetPipelineManifestFile (StringView filename)
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		auto&	manifest = _resourceMngr.GetPipelineManifest();
+
+		if ( filename.empty() )
+		{
+			manifest.Deinitialize();
+			return true;
+		}
+		return manifest.Initialize( filename );
+	}
+	
+/*
+=================================================
+	SavePipelineManifest
+=================================================
+*/
+	bool  VFrameGraph::SavePipelineManifest ()
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		return _resourceMngr.GetPipelineManifest().Save();
+	}
+	
+/*
+=================================================
+	PrewarmPipelines
+----
+	render passes are created on the calling thread,
+	pipeline instances are created in parallel and keep references to the render passes.
+=================================================
+*/
+	bool  VFrameGraph::PrewarmPipelines (ArrayView<RawGPipelineID> pipelines)
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		using InstanceEntry = VPipelineManifest::InstanceEntry;
+
+		VPipelineManifest::RenderPasses_t	rp_descs;
+		VPipelineManifest::Instances_t		instances;
+		_resourceMngr.GetPipelineManifest().GetEntries( OUT rp_descs, OUT instances );
+
+		HashMap< uint64_t, VGraphicsPipeline const* >	ppln_map;
+		for (auto& id : pipelines)
+		{
+			auto*	ppln = _resourceMngr.GetResource( id );
+			CHECK_ERR( ppln );
+
+			const uint64_t	hash = ppln->GetDescriptionHash();
+			if ( hash == 0 )
+			{
+				FG_LOGI( "pipeline '"s << ppln->GetDebugName() << "' is created from shader modules and can't be prewarmed" );
+				continue;
+			}
+
+			auto[iter, inserted] = ppln_map.insert({ hash, ppln });
+			if ( not inserted and iter->second != ppln )
+				FG_LOGI( "pipelines '"s << iter->second->GetDebugName() << "' and '" << ppln->GetDebugName() << "' have the same description, only the first one will be prewarmed" );
+		}
+
+		Array< RawRenderPassID >								render_passes;
+		Array< Pair< VGraphicsPipeline const*, InstanceEntry const* >>	jobs;
+		render_passes.resize( rp_descs.size() );
+
+		for (auto& inst : instances)
+		{
+			auto	iter = ppln_map.find( inst.pipelineHash );
+			if ( iter == ppln_map.end() )
+				continue;
+
+			auto&	rp = render_passes[ inst.renderPass ];
+			if ( not rp )
+			{
+				rp = _resourceMngr.CreateRenderPass( rp_descs[ inst.renderPass ], Default );
+				CHECK_ERR( rp );
+			}
+			jobs.push_back({ iter->second, &inst });
+		}
+
+		Array< VPipelineCache >		compilers( GetWorkerCount() );	// only temporary arrays are used
+		Atomic<uint>				skipped	{0};
+
+		ParallelFor( uint(jobs.size()), [&] (uint jobIndex, uint workerIndex)
+			{
+				auto&	job = jobs[ jobIndex ];
+
+				if ( not compilers[ workerIndex ].PrewarmPipelineInstance( _resourceMngr, *job.first, render_passes[ job.second->renderPass ], *job.second ))
+					skipped.fetch_add( 1, memory_order_relaxed );
+			});
+
+		for (auto& rp : render_passes) {
+			if ( rp )
+				_resourceMngr.ReleaseResource( rp );
+		}
+
+		if ( skipped.load( memory_order_relaxed ))
+			FG_LOGI( "pipeline prewarming skipped "s << ToString( skipped.load( memory_order_relaxed )) << " instances" );
+
+		return true;
+	}
+	
+/*
+=================================================
+	EnableBindlessResources
+=================================================
+*/
+	bool  VFrameGraph::EnableBindlessResources (const BindlessDesc &desc)
+	{
+		CHECK_ERR( _IsInitialized() );
+
+		return _resourceMngr.EnableBindless( desc );
+	}
+	
 /*
 =================================================
 	GetDeviceInfo
@@ -225,6 +402,19 @@ namespace FG
 		result.meshShaderNV						= feats.meshShaderNV;
 		result.rayTracingNV						= feats.rayTracingNV;
 		result.shadingRateImageNV				= feats.shadingRateImageNV;
+		result.bindlessResources				= false;
+		#ifdef VK_EXT_descriptor_indexing
+		auto&	desc_idx = props.descriptorIndexingFeatures;
+		result.bindlessResources				= feats.descriptorIndexing and desc_idx.runtimeDescriptorArray and desc_idx.descriptorBindingPartiallyBound and
+												  desc_idx.descriptorBindingUpdateUnusedWhilePending and desc_idx.descriptorBindingSampledImageUpdateAfterBind and
+												  desc_idx.descriptorBindingStorageImageUpdateAfterBind and desc_idx.descriptorBindingStorageBufferUpdateAfterBind;
+		#endif
+		result.pushDescriptors					= feats.pushDescriptor;
+		result.pipelineCreationFeedback			= feats.pipelineCreationFeedback;
+		result.lazilyAllocatedMemory			= false;
+		for (uint i = 0; i < props.memoryProperties.memoryTypeCount; ++i) {
+			result.lazilyAllocatedMemory |= AllBits( props.memoryProperties.memoryTypes[i].propertyFlags, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT );
+		}
 		result.minStorageBufferOffsetAlignment	= BytesU{props.properties.limits.minStorageBufferOffsetAlignment};
 		result.minUniformBufferOffsetAlignment	= BytesU{props.properties.limits.minUniformBufferOffsetAlignment};
 		result.maxDrawIndirectCount				= props.properties.limits.maxDrawIndirectCount;
@@ -649,6 +839,29 @@ namespace FG
 		auto*  res = _resourceMngr.GetResource( id );
 		return res ? res->GetApiSpecificDescription() : Default;
 	}
+	
+/*
+=================================================
+	GetBindlessIndex
+=================================================
+*/
+	uint  VFrameGraph::GetBindlessIndex (RawImageID id) const
+	{
+		ASSERT( _IsInitialized() );
+		return _resourceMngr.GetBindlessIndex( id );
+	}
+
+	uint  VFrameGraph::GetBindlessIndex (RawBufferID id) const
+	{
+		ASSERT( _IsInitialized() );
+		return _resourceMngr.GetBindlessIndex( id );
+	}
+
+	uint  VFrameGraph::GetBindlessIndex (RawSamplerID id) const
+	{
+		ASSERT( _IsInitialized() );
+		return _resourceMngr.GetBindlessIndex( id );
+	}
 
 /*
 =================================================
@@ -746,6 +959,7 @@ namespace FG
 
 		if ( not cmd->Begin( desc, batch, queue.ptr ))
 		{
+			_resourceMngr.OnBatchComplete( batch->GetBatchIndex() );
 			_cmdBufferPool.Unassign( cmd->GetIndexInPool() );
 			_cmdBatchPool.Unassign( batch->GetIndexInPool() );
 
@@ -769,11 +983,65 @@ namespace FG
 		VCmdBatchPtr	batch	= cmd->GetBatchPtr();
 		CHECK_ERR( batch.get() == cmdBufPtr.GetBatch() );
 
-		CHECK_ERR( cmd->Execute() );
-		_cmdBufferPool.Unassign( cmd->GetIndexInPool() );
+		CHECK_ERR( _ExecuteCommandBuffer( cmd, batch ));
+
+		cmdBufPtr = CommandBuffer{ (ICommandBuffer*)(null), cmdBufPtr.GetBatch() };
+		return true;
+	}
+	
+	bool  VFrameGraph::Execute (INOUT CommandBuffer &cmdBufPtr, OnExecuted_t &&onExecuted)
+	{
+		if ( not _scheduler )
+		{
+			const bool	result = Execute( INOUT cmdBufPtr );
+
+			if ( onExecuted )
+				onExecuted( result );
+
+			return result;
+		}
+
+		ASSERT( _IsInitialized() );
+		CHECK_ERR( cmdBufPtr.GetCommandBuffer() and cmdBufPtr.GetBatch() );
+
+		VCommandBuffer*	cmd		= Cast<VCommandBuffer>(cmdBufPtr.GetCommandBuffer());
+		VCmdBatchPtr	batch	= cmd->GetBatchPtr();
+		CHECK_ERR( batch.get() == cmdBufPtr.GetBatch() );
 
 		cmdBufPtr = CommandBuffer{ (ICommandBuffer*)(null), cmdBufPtr.GetBatch() };
 
+		// command buffer is compiled on the scheduler's thread, caller must not access it anymore
+		{
+			EXLOCK( _executingGuard );
+			++_executingJobs;
+		}
+
+		_scheduler->Enqueue( [this, cmd, batch = std::move(batch), fn = std::move(onExecuted)] ()
+			{
+				const bool	result = _ExecuteCommandBuffer( cmd, batch );
+
+				if ( fn )
+					fn( result );
+
+				// notify under lock, frame graph may be destroyed as soon as the lock is released
+				EXLOCK( _executingGuard );
+				ASSERT( _executingJobs > 0 );
+				if ( --_executingJobs == 0 )
+					_executingIdle.notify_all();
+			});
+		return true;
+	}
+	
+/*
+=================================================
+	_ExecuteCommandBuffer
+=================================================
+*/
+	bool  VFrameGraph::_ExecuteCommandBuffer (VCommandBuffer *cmd, const VCmdBatchPtr &batch)
+	{
+		CHECK_ERR( cmd->Execute() );
+		_cmdBufferPool.Unassign( cmd->GetIndexInPool() );
+
 		// add batch to the submission queue
 		{
 			uint	q_idx = uint(batch->GetQueueType());
@@ -822,6 +1090,13 @@ namespace FG
 		}
 
 		_resourceMngr.RunValidation( 100 );
+
+		// save driver pipeline cache in background when many new pipelines have been created
+		auto&	disk_cache = _resourceMngr.GetDiskPipelineCache();
+
+		if ( disk_cache.IsSaveRequired() )
+			disk_cache.SaveAsync( _scheduler );
+
 		return res;
 	}
 	
@@ -1247,6 +1522,8 @@ namespace FG
 		result = _lastStatistic;
 		result.renderer.submitingTime   = Nanoseconds{_submitingTime.exchange( 0, memory_order_relaxed )};
 		result.renderer.waitingTime	 = Nanoseconds{_waitingTime.exchange( 0, memory_order_relaxed )};
+
+		_resourceMngr.GetMemoryManager().ReadStatistic( INOUT result.resources );
 		
 		_lastStatistic = Default;
 		return true;
@@ -1516,6 +1793,36 @@ namespace FG
 		ASSERT( batch );
 		_cmdBatchPool.Unassign( batch->GetIndexInPool() );
 	}
+	
+/*
+=================================================
+	GetWorkerCount
+----
+	returns max number of threads that can be used by 'ParallelFor'
+=================================================
+*/
+	uint  VFrameGraph::GetWorkerCount ()
+	{
+		if ( _scheduler )
+			return Max( 1u, _scheduler->WorkerCount() );
+
+		return _GetWorkerPool().ThreadCount();
+	}
+
+/*
+=================================================
+	_GetWorkerPool
+=================================================
+*/
+	WorkerPool&  VFrameGraph::_GetWorkerPool ()
+	{
+		EXLOCK( _workerPoolGuard );
+
+		if ( not _workerPool )
+			_workerPool.reset( new WorkerPool{} );
+
+		return *_workerPool;
+	}
 
 
 }	// FG
@@ -8,6 +8,7 @@
 #include "VCmdBatch.h"
 #include "VDebugger.h"
 #include "stl/ThreadSafe/LfIndexedPool.h"
+#include "stl/ThreadSafe/WorkerPool.h"
 
 namespace FG
 {
@@ -80,10 +81,18 @@ namespace FG
 		mutable Atomic<uint64_t>   _submitingTime {0};
 		mutable Atomic<uint64_t>   _waitingTime   {0};
 
+		Mutex					_workerPoolGuard;
+		UniquePtr<WorkerPool>	_workerPool;		// created on first use, not used if '_scheduler' is set
+
+		TaskScheduler			_scheduler;
+		Mutex					_executingGuard;
+		std::condition_variable	_executingIdle;
+		uint					_executingJobs	= 0;	// number of 'Execute' jobs that are not complete yet
+
 
 	// methods
 	public:
-		explicit VFrameGraph (const VulkanDeviceInfo &);
+		VFrameGraph (const VulkanDeviceInfo &, const TaskScheduler &);
 		~VFrameGraph () override;
 
 		// initialization //
@@ -91,6 +100,13 @@ namespace FG
 		void			Deinitialize () override;
 		bool			AddPipelineCompiler (const PipelineCompiler &comp) override;
 		bool			SetShaderDebugCallback (ShaderDebugCallback_t &&) override;
+		bool			SetPipelineCacheFile (StringView filename, uint saveThreshold) override;
+		bool			SavePipelineCache () override;
+		bool			SetAsyncPipelineCompilation (bool enable, OnPipelineReady_t &&onReady) override;
+		bool			SetPipelineManifestFile (StringView filename) override;
+		bool			SavePipelineManifest () override;
+		bool			PrewarmPipelines (ArrayView<RawGPipelineID> pipelines) override;
+		bool			EnableBindlessResources (const BindlessDesc &desc) override;
 		DeviceInfo_t	GetDeviceInfo () const override;
 		EQueueUsage		GetAvilableQueues () const override;
 		DeviceProperties GetDeviceProperties () const override;
@@ -186,6 +202,9 @@ namespace FG
 		ImageDesc const&	GetDescription (RawImageID id) const override;
 		ExternalBufferDesc_t GetApiSpecificDescription (RawBufferID id) const override;
 		ExternalImageDesc_t  GetApiSpecificDescription (RawImageID id) const override;
+		uint			GetBindlessIndex (RawImageID id) const override;
+		uint			GetBindlessIndex (RawBufferID id) const override;
+		uint			GetBindlessIndex (RawSamplerID id) const override;
 		
 		bool			UpdateHostBuffer (RawBufferID id, BytesU offset, BytesU size, const void *data) override;
 		bool			MapBufferRange (RawBufferID id, BytesU offset, INOUT BytesU &size, OUT void* &data) override;
@@ -194,6 +213,7 @@ namespace FG
 		// frame execution //
 		CommandBuffer	Begin (const CommandBufferDesc &, ArrayView<CommandBuffer> dependsOn) override;
 		bool			Execute (INOUT CommandBuffer &) override;
+		bool			Execute (INOUT CommandBuffer &, OnExecuted_t &&) override;
 		bool			Wait (ArrayView<CommandBuffer> commands, Nanoseconds timeout) override;
 		bool			Flush (EQueueUsage queues) override;
 		bool			WaitIdle (Nanoseconds timeout) override;
@@ -207,6 +227,10 @@ namespace FG
 
 		// //
 		void			RecycleBatch (const VCmdBatch *);
+		ND_ uint		GetWorkerCount ();
+
+		template <typename Fn>
+		void			ParallelFor (uint count, Fn &&fn);
 
 		
 		ND_ VDeviceQueueInfoPtr	FindQueue (EQueueType type) const;
@@ -243,12 +267,35 @@ namespace FG
 			bool  _FlushQueue (EQueueType queue, uint maxIter);
 			bool  _WaitQueue (EQueueType queue, Nanoseconds timeout);
 
+			bool  _ExecuteCommandBuffer (VCommandBuffer *cmd, const VCmdBatchPtr &batch);
+
+
+		// threading //
+		ND_ WorkerPool&  _GetWorkerPool ();
+
 
 		// states //
 		ND_ bool	_IsInitialized () const;
 		ND_ EState	_GetState () const;
 		ND_ bool	_SetState (EState expected, EState newState);
 	};
+	
+
+/*
+=================================================
+	ParallelFor
+----
+	calls 'fn(jobIndex, workerIndex)' on the user-defined task scheduler or on the internal worker pool
+=================================================
+*/
+	template <typename Fn>
+	inline void  VFrameGraph::ParallelFor (uint count, Fn &&fn)
+	{
+		if ( _scheduler )
+			_scheduler->ParallelFor( count, ITaskScheduler::ParallelJob_t{ fn });
+		else
+			_GetWorkerPool().ParallelFor( count, std::forward<Fn>(fn) );
+	}
 
 
 }	// FG
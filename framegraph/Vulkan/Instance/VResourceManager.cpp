@@ -57,14 +57,16 @@ namespace FG
 	constructor
 =================================================
 */
-	VResourceManager::VResourceManager (const VDevice &dev, BytesU maxStagingBufferMemory, BytesU stagingBufferSize) :
+	VResourceManager::VResourceManager (const VDevice &dev, const VulkanDeviceInfo &info) :
 		_device{ dev },
-		_memoryMngr{ dev },
+		_memoryMngr{ dev, info.maxRetainedMemory, info.retainedMemoryLifetime },
 		_descMngr{ dev },
+		_diskPplnCache{ dev },
+		_bindless{ dev },
 		_submissionCounter{ 0 }
 	{
-		_staging.maxStagingBufferMemory = maxStagingBufferMemory < 1_Mb ? ~0_b : maxStagingBufferMemory;
-		_staging.writeBufPageSize		= stagingBufferSize < 1_Kb ? 0_b : stagingBufferSize;
+		_staging.maxStagingBufferMemory = info.maxStagingBufferMemory < 1_Mb ? ~0_b : info.maxStagingBufferMemory;
+		_staging.writeBufPageSize		= info.stagingBufferSize < 1_Kb ? 0_b : info.stagingBufferSize;
 		_staging.readBufPageSize		= _staging.writeBufPageSize;
 	}
 	
@@ -100,11 +102,30 @@ namespace FG
 */
 	void  VResourceManager::Deinitialize ()
 	{
+		// destroy bindless resources that are waiting for batches
+		{
+			Array<VCmdBatch::Resource>	resources;
+			{
+				EXLOCK( _bindlessRelease.guard );
+
+				for (auto& item : _bindlessRelease.released) {
+					resources.push_back( item.second );
+				}
+				_bindlessRelease.released.clear();
+				_bindlessRelease.activeBatches.clear();
+			}
+			_DestroyReleasedResources( resources );
+		}
+
+		_pplnCompileQueue.Deinitialize();
+		_pplnManifest.Deinitialize();
+		_diskPplnCache.Deinitialize();
 		_DestroyStagingBuffers();
 		_DestroyShaderDebuggerResources();
 
 		_DestroyResourceCache( INOUT _samplerCache );
 		_DestroyResourceCache( INOUT _pplnLayoutCache );
+		_bindless.Deinitialize( *this );
 		_DestroyResourceCache( INOUT _dsLayoutCache );
 		_DestroyResourceCache( INOUT _renderPassCache );
 		_DestroyResourceCache( INOUT _framebufferCache );
@@ -151,7 +172,58 @@ namespace FG
 */
 	void  VResourceManager::OnSubmit ()
 	{
-		_submissionCounter.fetch_add( 1, memory_order_relaxed );
+		const uint	index = _submissionCounter.fetch_add( 1, memory_order_relaxed ) + 1;
+
+		_memoryMngr.OnSubmit( index );
+	}
+	
+/*
+=================================================
+	OnBatchBegin
+----
+	returns unique index of batch, batch index must be passed to 'OnBatchComplete'.
+=================================================
+*/
+	uint64_t  VResourceManager::OnBatchBegin ()
+	{
+		EXLOCK( _bindlessRelease.guard );
+
+		const uint64_t	index = _bindlessRelease.batchCounter++;
+
+		_bindlessRelease.activeBatches.push_back( index );
+		return index;
+	}
+	
+/*
+=================================================
+	OnBatchComplete
+----
+	destroy released bindless resources that can not be used in active batches.
+=================================================
+*/
+	void  VResourceManager::OnBatchComplete (uint64_t batchIndex)
+	{
+		Array<VCmdBatch::Resource>	resources;
+		{
+			EXLOCK( _bindlessRelease.guard );
+
+			auto&	active	= _bindlessRelease.activeBatches;
+			auto	iter	= std::lower_bound( active.begin(), active.end(), batchIndex );
+			
+			CHECK_ERRV( iter != active.end() and *iter == batchIndex );
+			active.erase( iter );
+
+			// resource may be used only in batches that were begun before resource releasing
+			const uint64_t	first_active	= active.empty() ? _bindlessRelease.batchCounter : active.front();
+			auto&			released		= _bindlessRelease.released;
+			size_t			count			= 0;
+
+			for (; count < released.size() and released[count].first <= first_active; ++count) {
+				resources.push_back( released[count].second );
+			}
+			released.erase( released.begin(), released.begin() + count );
+		}
+		_DestroyReleasedResources( resources );
 	}
 	
 /*
@@ -215,6 +287,145 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	EnableBindless
+----
+	bindless descriptor set layout is not added to the cache,
+	it is used only for descriptor sets with 'BindlessDesc::descriptorSet' name.
+=================================================
+*/
+	bool  VResourceManager::EnableBindless (const IFrameGraph::BindlessDesc &desc)
+	{
+		CHECK_ERR( not _bindless.IsEnabled() );
+
+		VDescriptorSetLayout::DescriptorBinding_t	binding;
+		CHECK_ERR( VBindlessDescriptorSet::GetBindings( _device, desc, OUT binding ));
+
+		RawDescriptorSetLayoutID	id;
+		CHECK_ERR( _Assign( OUT id ));
+
+		auto&										res			= _GetResourcePool( id )[ id.Index() ];
+		const PipelineDescription::UniformMapPtr	uniforms	= MakeShared<PipelineDescription::UniformMap_t>();
+		VDescriptorSetLayout::DescriptorBinding_t	temp;
+
+		Replace( res, _device, uniforms, OUT temp );
+
+		if ( not res.Create( _device, binding, true ))
+		{
+			_Unassign( id );
+			RETURN_ERR( "failed when creating bindless descriptor set layout" );
+		}
+		res.AddRef();
+		id = RawDescriptorSetLayoutID{ id.Index(), res.GetInstanceID() };
+
+		if ( not _bindless.Initialize( id, res.Data().Handle(), desc ))
+		{
+			ReleaseResource( id );
+			return false;
+		}
+
+		// write descriptors for resources that were created before
+		for (size_t i = 0, count = _imagePool.size(); i < count; ++i)
+		{
+			auto&	image = _imagePool[ Index_t(i) ];
+			if ( image.IsCreated() )
+				_bindless.WriteImage( RawImageID{ Index_t(i), image.GetInstanceID() }, image.Data() );
+		}
+		for (size_t i = 0, count = _bufferPool.size(); i < count; ++i)
+		{
+			auto&	buffer = _bufferPool[ Index_t(i) ];
+			if ( buffer.IsCreated() )
+				_bindless.WriteBuffer( RawBufferID{ Index_t(i), buffer.GetInstanceID() }, buffer.Data() );
+		}
+		for (size_t i = 0, count = _samplerCache.size(); i < count; ++i)
+		{
+			auto&	sampler = _samplerCache[ Index_t(i) ];
+			if ( sampler.IsCreated() )
+				_bindless.WriteSampler( RawSamplerID{ Index_t(i), sampler.GetInstanceID() }, sampler.Data() );
+		}
+		return true;
+	}
+	
+/*
+=================================================
+	GetBindlessIndex
+=================================================
+*/
+	uint  VResourceManager::GetBindlessIndex (RawImageID id) const
+	{
+		auto*	image = GetResource( id, false, true );
+		return image ? _bindless.GetIndex( id, *image ) : UMax;
+	}
+
+	uint  VResourceManager::GetBindlessIndex (RawBufferID id) const
+	{
+		auto*	buffer = GetResource( id, false, true );
+		return buffer ? _bindless.GetIndex( id, *buffer ) : UMax;
+	}
+
+	uint  VResourceManager::GetBindlessIndex (RawSamplerID id) const
+	{
+		return IsResourceAlive( id ) ? _bindless.GetIndex( id ) : UMax;
+	}
+	
+/*
+=================================================
+	_DeferRelease
+----
+	resource that is visible in bindless descriptor set may be used in any batch,
+	so destruction and index reuse are delayed until batches are complete.
+=================================================
+*/
+	bool  VResourceManager::_DeferRelease (ResourceBase<VImage> &data, Index_t index)
+	{
+		const RawImageID	id{ index, data.GetInstanceID() };
+		return _bindless.GetIndex( id, data.Data() ) != UMax and _DeferRelease( VCmdBatch::Resource{ id });
+	}
+
+	bool  VResourceManager::_DeferRelease (ResourceBase<VBuffer> &data, Index_t index)
+	{
+		const RawBufferID	id{ index, data.GetInstanceID() };
+		return _bindless.GetIndex( id, data.Data() ) != UMax and _DeferRelease( VCmdBatch::Resource{ id });
+	}
+
+	bool  VResourceManager::_DeferRelease (ResourceBase<VSampler> &data, Index_t index)
+	{
+		const RawSamplerID	id{ index, data.GetInstanceID() };
+		return _bindless.GetIndex( id ) != UMax and _DeferRelease( VCmdBatch::Resource{ id });
+	}
+
+	bool  VResourceManager::_DeferRelease (const VCmdBatch::Resource &res)
+	{
+		EXLOCK( _bindlessRelease.guard );
+
+		// there are no batches that may use this resource
+		if ( _bindlessRelease.activeBatches.empty() )
+			return false;
+
+		_bindlessRelease.released.emplace_back( _bindlessRelease.batchCounter, res );
+		return true;
+	}
+	
+/*
+=================================================
+	_DestroyReleasedResources
+=================================================
+*/
+	void  VResourceManager::_DestroyReleasedResources (ArrayView<VCmdBatch::Resource> resources)
+	{
+		for (auto& res : resources)
+		{
+			switch ( res.GetUID() )
+			{
+				case RawImageID::GetUID() :		_DestroyReleased( RawImageID{ res.Index(), res.InstanceID() });		break;
+				case RawBufferID::GetUID() :	_DestroyReleased( RawBufferID{ res.Index(), res.InstanceID() });	break;
+				case RawSamplerID::GetUID() :	_DestroyReleased( RawSamplerID{ res.Index(), res.InstanceID() });	break;
+				default :						CHECK( !"not supported" );											break;
+			}
+		}
+	}
+	
 /*
 =================================================
 	GetDebugShaderStorageSize
@@ -367,7 +578,15 @@ namespace FG
 		{
 			RawDescriptorSetLayoutID			ds_id;
 			ResourceBase<VDescriptorSetLayout>*	ds_layout = null;
-			CHECK_ERR( _CreateDescriptorSetLayout( OUT ds_id, OUT ds_layout, ds.uniforms ));
+
+			if ( _bindless.IsEnabled() and ds.id == _bindless.GetDescriptorSetID() )
+			{
+				ds_id		= _bindless.GetLayoutID();
+				ds_layout	= &_GetResourcePool( ds_id )[ ds_id.Index() ];
+				ds_layout->AddRef();
+			}
+			else
+				CHECK_ERR( _CreateDescriptorSetLayout( OUT ds_id, OUT ds_layout, ds.uniforms ));
 
 			ds_layouts.push_back({ ds_id, ds_layout });
 		}
@@ -765,6 +984,8 @@ namespace FG
 */
 	RawGPipelineID  VResourceManager::CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName)
 	{
+		const uint64_t	desc_hash = VPipelineManifest::CalcPipelineHash( desc );
+
 		if ( not _CompileShaders( INOUT desc, _device ))
 		{
 			FG_LOGI( "Failed to compile shaders for graphics pipeline "s << (dbgName.size() ? "'"s << dbgName << "'" : ""));
@@ -781,7 +1002,7 @@ namespace FG
 		auto&	data = _GetResourcePool( id )[ id.Index() ];
 		Replace( data );
 		
-		if ( not data.Create( desc, layout_id, dbgName ))
+		if ( not data.Create( desc, layout_id, desc_hash, _pplnManifest.GetInstanceCount( desc_hash ), dbgName ))
 		{
 			_Unassign( id );
 			RETURN_ERR( "failed when creating graphics pipeline" );
@@ -919,6 +1140,8 @@ namespace FG
 		
 		mem_obj->AddRef();
 		data.AddRef();
+
+		_bindless.WriteImage( id, data.Data() );
 		return id;
 	}
 	
@@ -948,6 +1171,8 @@ namespace FG
 		
 		mem_obj->AddRef();
 		data.AddRef();
+
+		_bindless.WriteBuffer( id, data.Data() );
 		return id;
 	}
 	
@@ -971,6 +1196,8 @@ namespace FG
 		}
 		
 		data.AddRef();
+
+		_bindless.WriteImage( id, data.Data() );
 		return id;
 	}
 	
@@ -994,6 +1221,8 @@ namespace FG
 		}
 		
 		data.AddRef();
+
+		_bindless.WriteBuffer( id, data.Data() );
 		return id;
 	}
 
@@ -1054,9 +1283,14 @@ namespace FG
 */
 	RawSamplerID  VResourceManager::CreateSampler (const SamplerDesc &desc, StringView dbgName)
 	{
-		return _CreateCachedResource<RawSamplerID>( "failed when creating sampler",
+		RawSamplerID	id = _CreateCachedResource<RawSamplerID>( "failed when creating sampler",
 										[&] (auto& data) { Replace( data, _device, desc ); },
 										[&] (auto& data) { return data.Create( _device, dbgName ); });
+
+		if ( id and _bindless.IsEnabled() )
+			_bindless.WriteSampler( id, _GetResourcePool( id )[ id.Index() ].Data() );
+
+		return id;
 	}
 	
 	RawRenderPassID  VResourceManager::CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses, StringView dbgName)
@@ -1065,6 +1299,13 @@ namespace FG
 										[&] (auto& data) { Replace( data, logicalPasses ); },
 										[&] (auto& data) { return data.Create( _device, dbgName ); });
 	}
+
+	RawRenderPassID  VResourceManager::CreateRenderPass (const VRenderPass::Desc &desc, StringView dbgName)
+	{
+		return _CreateCachedResource<RawRenderPassID>( "failed when creating render pass",
+										[&] (auto& data) { Replace( data, desc ); },
+										[&] (auto& data) { return data.Create( _device, dbgName ); });
+	}
 	
 	RawFramebufferID  VResourceManager::CreateFramebuffer (ArrayView<Pair<RawImageID, ImageViewDesc>> attachments,
 														   RawRenderPassID rp, uint2 dim, uint layers, StringView dbgName)
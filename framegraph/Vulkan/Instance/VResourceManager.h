@@ -14,6 +14,9 @@
 #include "VSampler.h"
 #include "VMemoryObj.h"
 #include "VPipelineCache.h"
+#include "VDiskPipelineCache.h"
+#include "VPipelineCompileQueue.h"
+#include "VPipelineManifest.h"
 #include "VRenderPass.h"
 #include "VFramebuffer.h"
 #include "VPipelineResources.h"
@@ -23,6 +26,7 @@
 #include "VSwapchain.h"
 #include "VMemoryManager.h"
 #include "VDescriptorManager.h"
+#include "VBindlessDescriptorSet.h"
 #include "VCmdBatch.h"
 
 namespace FG
@@ -46,15 +50,18 @@ namespace FG
 		template <typename T, size_t ChunkSize, size_t MaxChunks>
 		using CachedPoolTmpl	= CachedIndexedPool< T, Index_t, ChunkSize, MaxChunks, UntypedAlignedAllocator, AssignOpGuard_t, CacheGuard_t, AtomicPtr >;
 
-		static constexpr uint	MaxImages		= 1u << 10;
-		static constexpr uint	MaxBuffers		= 1u << 10;
-		static constexpr uint	MaxMemoryObjs	= 1u << 10;
-		static constexpr uint	MaxCached		= 1u <<  9;
-		static constexpr uint	MaxRTObjects	= 1u <<  9;
-
-		using ImagePool_t			= PoolTmpl<			ResourceBase<VImage>,					MaxImages,		32 >;
-		using BufferPool_t			= PoolTmpl<			ResourceBase<VBuffer>,					MaxBuffers,		32 >;
-		using MemoryPool_t			= PoolTmpl<			ResourceBase<VMemoryObj>,				MaxMemoryObjs,	63 >;
+		// pools grow by chunks up to 'MaxChunks', index 'UMax' is reserved for invalid ID,
+		// so with 16 bit index a pool can hold up to 63 chunks of 1024 resources.
+		static constexpr uint	MaxImages		= 1u << 10;		// chunk size
+		static constexpr uint	MaxBuffers		= 1u << 10;		// chunk size
+		static constexpr uint	MaxMemoryObjs	= 1u << 10;		// chunk size
+		static constexpr uint	MaxCached		= 1u <<  9;		// chunk size
+		static constexpr uint	MaxRTObjects	= 1u <<  9;		// chunk size
+		static constexpr uint	MaxResChunks	= 63;
+
+		using ImagePool_t			= PoolTmpl<			ResourceBase<VImage>,					MaxImages,		MaxResChunks >;
+		using BufferPool_t			= PoolTmpl<			ResourceBase<VBuffer>,					MaxBuffers,		MaxResChunks >;
+		using MemoryPool_t			= PoolTmpl<			ResourceBase<VMemoryObj>,				MaxMemoryObjs,	MaxResChunks >;
 		using SamplerPool_t			= CachedPoolTmpl<	ResourceBase<VSampler>,					MaxCached,		 8 >;
 		using GPipelinePool_t		= PoolTmpl<			ResourceBase<VGraphicsPipeline>,		MaxCached,		 8 >;
 		using CPipelinePool_t		= PoolTmpl<			ResourceBase<VComputePipeline>,			MaxCached,		 8 >;
@@ -69,6 +76,9 @@ namespace FG
 		using RTScenePool_t			= PoolTmpl<			ResourceBase<VRayTracingScene>,			MaxRTObjects,	16 >;
 		using RTShaderTablePool_t	= PoolTmpl<			ResourceBase<VRayTracingShaderTable>,	MaxRTObjects,	16 >;
 		using SwapchainPool_t		= PoolTmpl<			ResourceBase<VSwapchain>,				8,				 4 >;
+
+		STATIC_ASSERT( ImagePool_t::capacity() < std::numeric_limits<Index_t>::max() );
+		STATIC_ASSERT( BufferPool_t::capacity() < std::numeric_limits<Index_t>::max() );
 		
 		using PipelineCompilers_t	= HashSet< PipelineCompiler >;
 		using VkShaderPtr			= PipelineDescription::VkShaderPtr;
@@ -85,6 +95,10 @@ namespace FG
 		VDevice const&				_device;
 		VMemoryManager				_memoryMngr;
 		VDescriptorManager			_descMngr;
+		VDiskPipelineCache			_diskPplnCache;
+		VPipelineCompileQueue		_pplnCompileQueue;
+		VPipelineManifest			_pplnManifest;
+		VBindlessDescriptorSet		_bindless;
 
 		BufferPool_t				_bufferPool;
 		ImagePool_t					_imagePool;
@@ -122,6 +136,15 @@ namespace FG
 
 		Atomic<uint>				_submissionCounter;
 
+		// bindless resources are not tracked by batches, so they are destroyed
+		// when all batches that were begun before resource releasing are complete.
+		struct {
+			Mutex						guard;
+			uint64_t					batchCounter	= 0;
+			Array<uint64_t>				activeBatches;		// in ascending order
+			Array<Pair<uint64_t, VCmdBatch::Resource>>	released;	// batch counter at release time and resource
+		}							_bindlessRelease;
+
 		struct {
 			DebugLayoutCache_t			dsLayoutsCache;
 			CPipelineID					pplnFindMaxValue1;
@@ -162,7 +185,7 @@ namespace FG
 
 	// methods
 	public:
-		VResourceManager (const VDevice &dev, BytesU maxStagingBufferMemory, BytesU stagingBufferSize);
+		VResourceManager (const VDevice &dev, const VulkanDeviceInfo &info);
 		~VResourceManager ();
 
 		bool  Initialize ();
@@ -171,6 +194,9 @@ namespace FG
 		void  AddCompiler (const PipelineCompiler &comp);
 		void  OnSubmit ();
 
+		ND_ uint64_t  OnBatchBegin ();
+			void	  OnBatchComplete (uint64_t batchIndex);
+
 		ND_ RawMPipelineID		CreatePipeline (INOUT MeshPipelineDesc &desc, StringView dbgName);
 		ND_ RawGPipelineID		CreatePipeline (INOUT GraphicsPipelineDesc &desc, StringView dbgName);
 		ND_ RawCPipelineID		CreatePipeline (INOUT ComputePipelineDesc &desc, StringView dbgName);
@@ -184,6 +210,7 @@ namespace FG
 		ND_ RawBufferID			CreateBuffer (const VulkanBufferDesc &desc, IFrameGraph::OnExternalBufferReleased_t &&onRelease, StringView dbgName);
 
 		ND_ RawRenderPassID		CreateRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses, StringView dbgName);
+		ND_ RawRenderPassID		CreateRenderPass (const VRenderPass::Desc &desc, StringView dbgName);
 		ND_ RawFramebufferID	CreateFramebuffer (ArrayView<Pair<RawImageID, ImageViewDesc>> attachments, RawRenderPassID rp, uint2 dim, uint layers, StringView dbgName);
 
 		ND_ VPipelineResources const*	CreateDescriptorSet (const PipelineResources &desc, VCmdBatch::ResourceMap_t &);
@@ -199,6 +226,11 @@ namespace FG
 		ND_ RawDescriptorSetLayoutID GetDescriptorSetLayout (EShaderDebugMode debugMode, EShaderStages debuggableShaders);
 
 		ND_ RawDescriptorSetLayoutID CreateDescriptorSetLayout (const PipelineDescription::UniformMapPtr &uniforms);
+
+			bool				EnableBindless (const IFrameGraph::BindlessDesc &desc);
+		ND_ uint				GetBindlessIndex (RawImageID id)	const;
+		ND_ uint				GetBindlessIndex (RawBufferID id)	const;
+		ND_ uint				GetBindlessIndex (RawSamplerID id)	const;
 		
 		ND_ RawSwapchainID		CreateSwapchain (const VulkanSwapchainCreateInfo &desc, RawSwapchainID oldSwapchain, VFrameGraph &, StringView dbgName);
 
@@ -221,6 +253,10 @@ namespace FG
 		ND_ VDevice const&		GetDevice ()				const	{ return _device; }
 		ND_ VMemoryManager&		GetMemoryManager ()					{ return _memoryMngr; }
 		ND_ VDescriptorManager&	GetDescriptorManager ()				{ return _descMngr; }
+		ND_ VDiskPipelineCache&	GetDiskPipelineCache ()				{ return _diskPplnCache; }
+		ND_ VPipelineCompileQueue&	GetPipelineCompileQueue ()		{ return _pplnCompileQueue; }
+		ND_ VPipelineManifest&		GetPipelineManifest ()			{ return _pplnManifest; }
+		ND_ VBindlessDescriptorSet const&	GetBindlessDescriptorSet ()	const	{ return _bindless; }
 		
 		ND_ uint				GetSubmitIndex ()			const	{ return _submissionCounter.load( memory_order_relaxed ); }
 		
@@ -271,6 +307,17 @@ namespace FG
 		template <typename DataT, size_t CS, size_t MC>
 		bool  _ReleaseResource (CachedPoolTmpl<DataT,CS,MC> &pool, DataT& data, Index_t index, uint refCount);
 
+		template <typename DataT>
+		bool  _DeferRelease (DataT &, Index_t)		{ return false; }
+		bool  _DeferRelease (ResourceBase<VImage> &data, Index_t index);
+		bool  _DeferRelease (ResourceBase<VBuffer> &data, Index_t index);
+		bool  _DeferRelease (ResourceBase<VSampler> &data, Index_t index);
+		bool  _DeferRelease (const VCmdBatch::Resource &res);
+
+		template <typename ID>
+		void  _DestroyReleased (ID id);
+		void  _DestroyReleasedResources (ArrayView<VCmdBatch::Resource> resources);
+
 		void  _DestroyStagingBuffers ();
 
 
@@ -439,6 +486,9 @@ namespace FG
 	{
 		if ( data.ReleaseRef( refCount ) and data.IsCreated() )
 		{
+			if ( _DeferRelease( data, index ))
+				return true;
+
 			data.Destroy( *this );
 			pool.Unassign( index );
 			return true;
@@ -452,6 +502,10 @@ namespace FG
 		if ( data.ReleaseRef( refCount ) and data.IsCreated() )
 		{
 			pool.RemoveFromCache( index );
+
+			if ( _DeferRelease( data, index ))
+				return true;
+
 			data.Destroy( *this );
 			pool.Unassign( index );
 			return true;
@@ -459,6 +513,24 @@ namespace FG
 		return false;
 	}
 
+/*
+=================================================
+	_DestroyReleased
+=================================================
+*/
+	template <typename ID>
+	inline void  VResourceManager::_DestroyReleased (ID id)
+	{
+		auto&	pool = _GetResourcePool( id );
+		auto&	data = pool[ id.Index() ];
+		
+		ASSERT( data.GetInstanceID() == id.InstanceID() );
+		ASSERT( data.GetRefCount() == 0 );
+
+		data.Destroy( *this );
+		pool.Unassign( id.Index() );
+	}
+
 /*
 =================================================
 	_Assign
@@ -10,8 +10,10 @@ namespace FG
 	constructor
 =================================================
 */
-	VMemoryManager::VMemoryManager (const VDevice &dev) :
-		_device{ dev }
+	VMemoryManager::VMemoryManager (const VDevice &dev, BytesU maxRetainedMemory, uint retainedMemoryLifetime) :
+		_device{ dev },
+		_maxRetainedMemory{ maxRetainedMemory },
+		_retainedMemoryLifetime{ retainedMemoryLifetime }
 	{
 	}
 	
@@ -35,6 +37,9 @@ namespace FG
 	{
 		EXLOCK( _drCheck );
 
+		// memory for transient images is bound by command buffer
+		_allocators.push_back( _CreateVirtual() );
+
 		// TODO: use custom mem allocator?
 #	ifdef FG_ENABLE_VULKAN_MEMORY_ALLOCATOR
 		_allocators.push_back( _CreateVMA() );
@@ -131,6 +136,34 @@ namespace FG
 	}
 #endif
 
+/*
+=================================================
+	AllocateMemory
+----
+	allocates memory without binding to resource,
+	used as heap for transient images.
+=================================================
+*/
+	bool VMemoryManager::AllocateMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data)
+	{
+		SHAREDLOCK( _drCheck );
+		ASSERT( not _allocators.empty() );
+
+		for (size_t i = 0; i < _allocators.size(); ++i)
+		{
+			auto&	alloc = _allocators[i];
+
+			if ( alloc->IsSupported( desc.type ))
+			{
+				CHECK_ERR( alloc->AllocMemory( memReq, desc, OUT data ));
+				
+				*data.Cast<uint>() = uint(i);
+				return true;
+			}
+		}
+		RETURN_ERR( "unsupported memory type" );
+	}
+
 /*
 =================================================
 	Deallocate
@@ -162,6 +195,36 @@ namespace FG
 		CHECK_ERR( _allocators[alloc_id]->GetMemoryInfo( data, OUT info ));
 		return true;
 	}
+	
+/*
+=================================================
+	OnSubmit
+----
+	releases retained memory that was not reused in last submissions
+=================================================
+*/
+	void VMemoryManager::OnSubmit (uint submitIndex)
+	{
+		SHAREDLOCK( _drCheck );
+
+		for (auto& alloc : _allocators) {
+			alloc->OnSubmit( submitIndex );
+		}
+	}
+	
+/*
+=================================================
+	ReadStatistic
+=================================================
+*/
+	void VMemoryManager::ReadStatistic (INOUT Statistic_t &stat)
+	{
+		SHAREDLOCK( _drCheck );
+
+		for (auto& alloc : _allocators) {
+			alloc->ReadStatistic( INOUT stat );
+		}
+	}
 
 
 }	// FG
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "framegraph/Public/FrameGraph.h"
 #include "VMemoryObj.h"
 
 namespace FG
@@ -17,6 +18,7 @@ namespace FG
 	protected:
 		using Storage_t		= VMemoryObj::Storage_t;
 		using MemoryInfo_t	= VMemoryObj::MemoryInfo;
+		using Statistic_t	= IFrameGraph::ResourceStatistics;
 
 		class DedicatedMemAllocator;
 		class HostMemAllocator;
@@ -40,9 +42,14 @@ namespace FG
 			virtual bool AllocForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data) = 0;
 			#endif
 
+			virtual bool AllocMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data) = 0;
+
 			virtual bool Dealloc (INOUT Storage_t &data) = 0;
 			
 			virtual bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const = 0;
+
+			virtual void OnSubmit (uint submitIndex) = 0;
+			virtual void ReadStatistic (INOUT Statistic_t &stat) = 0;
 		};
 
 		using AllocatorPtr	= UniquePtr< IMemoryAllocator >;
@@ -54,12 +61,15 @@ namespace FG
 		VDevice const &		_device;
 		Allocators_t		_allocators;
 
+		const BytesU		_maxRetainedMemory;
+		const uint			_retainedMemoryLifetime;
+
 		RWDataRaceCheck		_drCheck;
 
 
 	// methods
 	public:
-		explicit VMemoryManager (const VDevice &dev);
+		VMemoryManager (const VDevice &dev, BytesU maxRetainedMemory, uint retainedMemoryLifetime);
 		~VMemoryManager ();
 
 		virtual bool Initialize ();
@@ -71,14 +81,20 @@ namespace FG
 		#ifdef VK_NV_ray_tracing
 		virtual bool AllocateForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data);
 		#endif
+		
+		virtual bool AllocateMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data);
 
 		virtual bool Deallocate (INOUT Storage_t &data);
 
 		virtual bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const;
 
+		void  OnSubmit (uint submitIndex);
+		void  ReadStatistic (INOUT Statistic_t &stat);
+
 
 	private:
 		ND_ AllocatorPtr  _CreateVMA ();
+		ND_ AllocatorPtr  _CreateVirtual ();
 	};
 
 
@@ -68,8 +68,21 @@ namespace FG
 		struct Data
 		{
 			VmaAllocation	allocation;
+			EMemoryTypeExt	memType;		// memory type with 'ForBuffer' or 'ForImage' bit
 		};
 
+		struct RetainedMemory
+		{
+			VmaAllocation	allocation;
+			EMemoryTypeExt	memType;
+			uint			memTypeIndex;
+			uint			submitIndex;
+			VkDeviceSize	offset;
+			VkDeviceSize	size;
+		};
+		using RetainedList_t	= Array< RetainedMemory >;								// sorted by size
+		using RetainedMemory_t	= StaticArray< RetainedList_t, VK_MAX_MEMORY_TYPES >;	// index is memory type index
+
 
 	// variables
 	private:
@@ -77,10 +90,19 @@ namespace FG
 		VDevice const&			_device;
 		VmaAllocator			_allocator;
 
+		// memory of destroyed resources
+		RetainedMemory_t		_retained;
+		VkDeviceSize			_retainedSize		= 0;
+		const VkDeviceSize		_maxRetainedSize;
+		const uint				_retainedLifetime;
+		uint					_submitIndex		= 0;
+		uint					_retainedHits		= 0;
+		uint					_retainedMisses		= 0;
+
 
 	// methods
 	public:
-		VulkanMemoryAllocator (const VDevice &dev, EMemoryTypeExt memType);
+		VulkanMemoryAllocator (const VDevice &dev, EMemoryTypeExt memType, BytesU maxRetainedSize, uint retainedLifetime);
 		~VulkanMemoryAllocator () override;
 
 		bool IsSupported (EMemoryType memType) const override;
@@ -92,13 +114,23 @@ namespace FG
 		bool AllocForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data) override;
 		#endif
 
+		bool AllocMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data) override;
+
 		bool Dealloc (INOUT Storage_t &data) override;
 		
 		bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const override;
 
+		void OnSubmit (uint submitIndex) override;
+		void ReadStatistic (INOUT Statistic_t &stat) override;
+
 	private:
 		bool _CreateAllocator (OUT VmaAllocator &alloc) const;
 
+		ND_ VmaAllocation  _AllocRetained (const VkMemoryRequirements &memReq, EMemoryTypeExt memType);
+		ND_ bool  _Retain (VmaAllocation mem, EMemoryTypeExt memType);
+			void  _ReleaseRetained (uint lifetime);
+			void  _FallbackToDeviceLocal (const VkMemoryRequirements &memReq, INOUT VmaAllocationCreateInfo &info) const;
+
 		ND_ static Data *					_CastStorage (Storage_t &data);
 		ND_ static Data const*				_CastStorage (const Storage_t &data);
 		
@@ -115,7 +147,7 @@ namespace FG
 */
 	VMemoryManager::AllocatorPtr  VMemoryManager::_CreateVMA ()
 	{
-		return AllocatorPtr{ new VulkanMemoryAllocator{ _device, EMemoryTypeExt::All }};
+		return AllocatorPtr{ new VulkanMemoryAllocator{ _device, EMemoryTypeExt::All, _maxRetainedMemory, _retainedMemoryLifetime }};
 	}
 	
 /*
@@ -123,8 +155,10 @@ namespace FG
 	constructor
 =================================================
 */
-	VMemoryManager::VulkanMemoryAllocator::VulkanMemoryAllocator (const VDevice &dev, EMemoryTypeExt) :
-		_device{ dev },		_allocator{ null }
+	VMemoryManager::VulkanMemoryAllocator::VulkanMemoryAllocator (const VDevice &dev, EMemoryTypeExt, BytesU maxRetainedSize, uint retainedLifetime) :
+		_device{ dev },		_allocator{ null },
+		_maxRetainedSize{ VkDeviceSize(maxRetainedSize) },
+		_retainedLifetime{ retainedLifetime }
 	{
 		EXLOCK( _guard );
 		CHECK( _CreateAllocator( OUT _allocator ));
@@ -140,6 +174,7 @@ namespace FG
 		EXLOCK( _guard );
 
 		if ( _allocator ) {
+			_ReleaseRetained( 0 );
 			vmaDestroyAllocator( _allocator );
 		}
 	}
@@ -149,9 +184,9 @@ namespace FG
 	IsSupported
 =================================================
 */
-	bool VMemoryManager::VulkanMemoryAllocator::IsSupported (EMemoryType) const
+	bool VMemoryManager::VulkanMemoryAllocator::IsSupported (EMemoryType memType) const
 	{
-		return true;
+		return not AllBits( EMemoryTypeExt(memType), EMemoryTypeExt::Virtual );
 	}
 	
 /*
@@ -188,35 +223,39 @@ namespace FG
 		info.memoryTypeBits	= 0;
 		info.pool			= VK_NULL_HANDLE;
 		info.pUserData		= null;
-
-		VmaAllocation	mem = null;
 		
-		if ( auto* req = UnionGetIf<VulkanMemRequirements>( &desc.req ))
+		// because used private api
+		VMA_DEBUG_GLOBAL_MUTEX_LOCK
+		
+		const auto*				req			= UnionGetIf<VulkanMemRequirements>( &desc.req );
+		const EMemoryTypeExt	mem_type	= EMemoryTypeExt(desc.type) | EMemoryTypeExt::ForImage;
+		VkMemoryRequirements	vkMemReq	= {};
+		bool requires_dedicated_allocation	= false;
+		bool prefers_dedicated_allocation	= false;
+		_allocator->GetImageMemoryRequirements( image, OUT vkMemReq, OUT requires_dedicated_allocation, OUT prefers_dedicated_allocation );
+
+		if ( req )
 		{
-			// because used private api
-			VMA_DEBUG_GLOBAL_MUTEX_LOCK
-				
-			VkMemoryRequirements vkMemReq = {};
-			bool requires_dedicated_allocation	= false;
-			bool prefers_dedicated_allocation	= false;
-			_allocator->GetImageMemoryRequirements( image, OUT vkMemReq, OUT requires_dedicated_allocation, OUT prefers_dedicated_allocation );
-
 			vkMemReq.alignment		= Max( vkMemReq.alignment, req->alignment );
 			vkMemReq.memoryTypeBits	&= (req->memTypeBits ? req->memTypeBits : ~0u);
-			
-			CHECK_ERR( vkMemReq.memoryTypeBits != 0 );
-
-			VK_CHECK( _allocator->AllocateMemory( vkMemReq, requires_dedicated_allocation, prefers_dedicated_allocation,
-												  VK_NULL_HANDLE, image, info, VMA_SUBALLOCATION_TYPE_IMAGE_UNKNOWN, 1, OUT &mem ));
 		}
-		else
+		CHECK_ERR( vkMemReq.memoryTypeBits != 0 );
+
+		_FallbackToDeviceLocal( vkMemReq, INOUT info );
+
+		VmaAllocation	mem = _AllocRetained( vkMemReq, mem_type );
+
+		if ( not mem )
 		{
-			VK_CHECK( vmaAllocateMemoryForImage( _allocator, image, &info, OUT &mem, null ));
+			VK_CHECK( _allocator->AllocateMemory( vkMemReq, requires_dedicated_allocation, prefers_dedicated_allocation,
+												  VK_NULL_HANDLE, image, info, (req ? VMA_SUBALLOCATION_TYPE_IMAGE_UNKNOWN : VMA_SUBALLOCATION_TYPE_IMAGE_OPTIMAL),
+												  1, OUT &mem ));
 		}
 
 		VK_CHECK( vmaBindImageMemory( _allocator, mem, image ));
 		
-		_CastStorage( data )->allocation = mem;
+		_CastStorage( data )->allocation	= mem;
+		_CastStorage( data )->memType		= mem_type;
 		return true;
 	}
 	
@@ -238,34 +277,35 @@ namespace FG
 		info.pool			= VK_NULL_HANDLE;
 		info.pUserData		= null;
 		
-		VmaAllocation	mem = null;
-
-		if ( auto* req = UnionGetIf<VulkanMemRequirements>( &desc.req ))
-		{
-			// because used private api
-			VMA_DEBUG_GLOBAL_MUTEX_LOCK
+		// because used private api
+		VMA_DEBUG_GLOBAL_MUTEX_LOCK
 
-			VkMemoryRequirements vkMemReq = {};
-			bool requires_dedicated_allocation	= false;
-			bool prefers_dedicated_allocation	= false;
-			_allocator->GetBufferMemoryRequirements( buffer, OUT vkMemReq, OUT requires_dedicated_allocation, OUT prefers_dedicated_allocation );
+		const auto*				req			= UnionGetIf<VulkanMemRequirements>( &desc.req );
+		const EMemoryTypeExt	mem_type	= EMemoryTypeExt(desc.type) | EMemoryTypeExt::ForBuffer;
+		VkMemoryRequirements	vkMemReq	= {};
+		bool requires_dedicated_allocation	= false;
+		bool prefers_dedicated_allocation	= false;
+		_allocator->GetBufferMemoryRequirements( buffer, OUT vkMemReq, OUT requires_dedicated_allocation, OUT prefers_dedicated_allocation );
 
+		if ( req )
+		{
 			vkMemReq.alignment		= Max( vkMemReq.alignment, req->alignment );
 			vkMemReq.memoryTypeBits	&= (req->memTypeBits ? req->memTypeBits : ~0u);
-			
-			CHECK_ERR( vkMemReq.memoryTypeBits != 0 );
+		}
+		CHECK_ERR( vkMemReq.memoryTypeBits != 0 );
+
+		VmaAllocation	mem = _AllocRetained( vkMemReq, mem_type );
 
+		if ( not mem )
+		{
 			VK_CHECK( _allocator->AllocateMemory( vkMemReq, requires_dedicated_allocation, prefers_dedicated_allocation,
 												  buffer, VK_NULL_HANDLE, info, VMA_SUBALLOCATION_TYPE_BUFFER, 1, OUT &mem ));
 		}
-		else
-		{
-			VK_CHECK( vmaAllocateMemoryForBuffer( _allocator, buffer, &info, OUT &mem, null ));
-		}
 
 		VK_CHECK( vmaBindBufferMemory( _allocator, mem, buffer ));
 		
-		_CastStorage( data )->allocation = mem;
+		_CastStorage( data )->allocation	= mem;
+		_CastStorage( data )->memType		= mem_type;
 		return true;
 	}
 	
@@ -312,11 +352,53 @@ namespace FG
 		bind_info.memoryOffset			= alloc_info.offset;
 		VK_CHECK( _device.vkBindAccelerationStructureMemoryNV( _device.GetVkDevice(), 1, &bind_info ));
 
-		_CastStorage( data )->allocation = mem;
+		_CastStorage( data )->allocation	= mem;
+		_CastStorage( data )->memType		= EMemoryTypeExt(desc.type);		// acceleration structures are not retained
 		return true;
 	}
 #endif
 
+/*
+=================================================
+	AllocMemory
+----
+	memory is used only for images with optimal tiling,
+	so it may be retained and reused for another images.
+=================================================
+*/
+	bool VMemoryManager::VulkanMemoryAllocator::AllocMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( memReq.memoryTypeBits != 0 );
+
+		VmaAllocationCreateInfo		info = {};
+		info.flags			= _ConvertToMemoryFlags( desc.type );
+		info.usage			= _ConvertToMemoryUsage( desc.type );
+		info.requiredFlags	= _ConvertToMemoryProperties( desc.type );
+		info.preferredFlags	= 0;
+		info.memoryTypeBits	= 0;
+		info.pool			= VK_NULL_HANDLE;
+		info.pUserData		= null;
+		
+		_FallbackToDeviceLocal( memReq, INOUT info );
+
+		// because used private api
+		VMA_DEBUG_GLOBAL_MUTEX_LOCK
+
+		const EMemoryTypeExt	mem_type	= EMemoryTypeExt(desc.type) | EMemoryTypeExt::ForImage;
+		VmaAllocation			mem			= _AllocRetained( memReq, mem_type );
+
+		if ( not mem )
+		{
+			VK_CHECK( _allocator->AllocateMemory( memReq, false, false, VK_NULL_HANDLE, VK_NULL_HANDLE, info,
+												  VMA_SUBALLOCATION_TYPE_IMAGE_OPTIMAL, 1, OUT &mem ));
+		}
+
+		_CastStorage( data )->allocation	= mem;
+		_CastStorage( data )->memType		= mem_type;
+		return true;
+	}
+
 /*
 =================================================
 	Dealloc
@@ -328,7 +410,8 @@ namespace FG
 
 		VmaAllocation&	mem = _CastStorage( data )->allocation;
 
-		vmaFreeMemory( _allocator, mem );
+		if ( not _Retain( mem, _CastStorage( data )->memType ))
+			vmaFreeMemory( _allocator, mem );
 
 		mem = null;
 		return true;
@@ -358,6 +441,183 @@ namespace FG
 		return true;
 	}
 	
+/*
+=================================================
+	OnSubmit
+=================================================
+*/
+	void VMemoryManager::VulkanMemoryAllocator::OnSubmit (uint submitIndex)
+	{
+		EXLOCK( _guard );
+
+		_submitIndex = submitIndex;
+		_ReleaseRetained( _retainedLifetime );
+	}
+	
+/*
+=================================================
+	ReadStatistic
+=================================================
+*/
+	void VMemoryManager::VulkanMemoryAllocator::ReadStatistic (INOUT Statistic_t &stat)
+	{
+		EXLOCK( _guard );
+
+		stat.retainedMemoryHits		+= _retainedHits;
+		stat.retainedMemoryMisses	+= _retainedMisses;
+		stat.retainedMemorySize		+= BytesU{_retainedSize};
+
+		_retainedHits	= 0;
+		_retainedMisses	= 0;
+	}
+	
+/*
+=================================================
+	_AllocRetained
+----
+	search for the smallest memory of destroyed resource with the same memory type,
+	size must be not greater than 1.25x of required size.
+=================================================
+*/
+	VmaAllocation  VMemoryManager::VulkanMemoryAllocator::_AllocRetained (const VkMemoryRequirements &memReq, EMemoryTypeExt memType)
+	{
+		if ( _maxRetainedSize == 0 )
+			return null;
+
+		const VkDeviceSize	max_size	= memReq.size + memReq.size / 4;
+		RetainedList_t*		best_list	= null;
+		size_t				best_index	= 0;
+
+		for (uint t = 0; t < uint(_retained.size()); ++t)
+		{
+			if ( not (memReq.memoryTypeBits & (1u << t)) )
+				continue;
+
+			auto&	list = _retained[t];
+			auto	iter = std::lower_bound( list.begin(), list.end(), memReq.size,
+											 [] (const RetainedMemory &item, VkDeviceSize size) { return item.size < size; });
+
+			for (; iter != list.end() and iter->size <= max_size; ++iter)
+			{
+				if ( iter->memType != memType or (iter->offset % memReq.alignment) != 0 )
+					continue;
+
+				if ( not best_list or iter->size < (*best_list)[best_index].size )
+				{
+					best_list	= &list;
+					best_index	= size_t(iter - list.begin());
+				}
+				break;
+			}
+		}
+
+		if ( not best_list )
+		{
+			++_retainedMisses;
+			return null;
+		}
+
+		VmaAllocation	result = (*best_list)[best_index].allocation;
+		_retainedSize -= (*best_list)[best_index].size;
+
+		best_list->erase( best_list->begin() + best_index );
+
+		++_retainedHits;
+		return result;
+	}
+	
+/*
+=================================================
+	_Retain
+----
+	keep memory of destroyed image or buffer to avoid memory page reallocation.
+	resources are destroyed when all command batches that used it are complete,
+	so memory is not used by GPU.
+=================================================
+*/
+	bool VMemoryManager::VulkanMemoryAllocator::_Retain (VmaAllocation mem, EMemoryTypeExt memType)
+	{
+		if ( not AnyBits( memType, EMemoryTypeExt::ForBuffer | EMemoryTypeExt::ForImage ))
+			return false;
+
+		VmaAllocationInfo	alloc_info = {};
+		vmaGetAllocationInfo( _allocator, mem, OUT &alloc_info );
+
+		if ( _retainedSize + alloc_info.size > _maxRetainedSize or alloc_info.size == 0 )
+			return false;
+
+		CHECK_ERR( alloc_info.memoryType < _retained.size() );
+
+		RetainedMemory	item;
+		item.allocation		= mem;
+		item.memType		= memType;
+		item.memTypeIndex	= alloc_info.memoryType;
+		item.submitIndex	= _submitIndex;
+		item.offset			= alloc_info.offset;
+		item.size			= alloc_info.size;
+
+		auto&	list = _retained[ item.memTypeIndex ];
+		auto	iter = std::upper_bound( list.begin(), list.end(), item.size,
+										 [] (VkDeviceSize size, const RetainedMemory &rhs) { return size < rhs.size; });
+
+		list.insert( iter, item );
+		_retainedSize += item.size;
+		return true;
+	}
+	
+/*
+=================================================
+	_ReleaseRetained
+----
+	free memory that was retained more than 'lifetime' submissions
+=================================================
+*/
+	void VMemoryManager::VulkanMemoryAllocator::_ReleaseRetained (uint lifetime)
+	{
+		for (auto& list : _retained)
+		{
+			for (size_t i = 0; i < list.size();)
+			{
+				auto&	item = list[i];
+
+				if ( _submitIndex - item.submitIndex >= lifetime )
+				{
+					vmaFreeMemory( _allocator, item.allocation );
+					_retainedSize -= item.size;
+
+					// keep list sorted
+					list.erase( list.begin() + i );
+				}
+				else
+					++i;
+			}
+		}
+	}
+	
+/*
+=================================================
+	_FallbackToDeviceLocal
+----
+	lazily allocated memory is not supported on most desktop GPUs,
+	in this case any compatible memory type is used.
+=================================================
+*/
+	void  VMemoryManager::VulkanMemoryAllocator::_FallbackToDeviceLocal (const VkMemoryRequirements &memReq, INOUT VmaAllocationCreateInfo &info) const
+	{
+		if ( not AllBits( info.requiredFlags, VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT ))
+			return;
+
+		const auto&		mem_props = _device.GetProperties().memoryProperties;
+
+		for (uint i = 0; i < mem_props.memoryTypeCount; ++i)
+		{
+			if ( ((memReq.memoryTypeBits >> i) & 1) and AllBits( mem_props.memoryTypes[i].propertyFlags, info.requiredFlags ))
+				return;
+		}
+
+		info.requiredFlags &= ~VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+	}
+
 /*
 =================================================
 	_ConvertToMemoryFlags
@@ -417,6 +677,7 @@ namespace FG
 				case EMemoryTypeExt::LocalInGPU :		flags |= VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;	break;
 				case EMemoryTypeExt::HostCoherent :		flags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;	break;
 				case EMemoryTypeExt::HostCached :		flags |= VK_MEMORY_PROPERTY_HOST_CACHED_BIT;	break;
+				case EMemoryTypeExt::LazilyAllocated :	flags |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;	break;
 				case EMemoryTypeExt::Dedicated :
 				//case EMemoryTypeExt::AllowAliasing :
 				//case EMemoryTypeExt::Sparse :
@@ -0,0 +1,127 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VMemoryManager.h"
+
+namespace FG
+{
+
+	//
+	// Virtual Memory Allocator
+	//
+
+	class VMemoryManager::VirtualMemAllocator final : public IMemoryAllocator
+	{
+	// methods
+	public:
+		VirtualMemAllocator () {}
+		~VirtualMemAllocator () override {}
+
+		bool IsSupported (EMemoryType memType) const override;
+
+		bool AllocForImage (VkImage image, const MemoryDesc &mem, OUT Storage_t &data) override;
+		bool AllocForBuffer (VkBuffer buffer, const MemoryDesc &mem, OUT Storage_t &data) override;
+
+		#ifdef VK_NV_ray_tracing
+		bool AllocForAccelStruct (VkAccelerationStructureNV as, const MemoryDesc &desc, OUT Storage_t &data) override;
+		#endif
+
+		bool AllocMemory (const VkMemoryRequirements &memReq, const MemoryDesc &desc, OUT Storage_t &data) override;
+
+		bool Dealloc (INOUT Storage_t &data) override;
+
+		bool GetMemoryInfo (const Storage_t &data, OUT MemoryInfo_t &info) const override;
+
+		void OnSubmit (uint) override {}
+		void ReadStatistic (INOUT Statistic_t &) override {}
+	};
+
+
+/*
+=================================================
+	_CreateVirtual
+=================================================
+*/
+	VMemoryManager::AllocatorPtr  VMemoryManager::_CreateVirtual ()
+	{
+		return AllocatorPtr{ new VirtualMemAllocator{} };
+	}
+
+/*
+=================================================
+	IsSupported
+=================================================
+*/
+	bool VMemoryManager::VirtualMemAllocator::IsSupported (EMemoryType memType) const
+	{
+		return AllBits( EMemoryTypeExt(memType), EMemoryTypeExt::Virtual );
+	}
+
+/*
+=================================================
+	AllocForImage
+----
+	memory is not allocated here, command buffer binds image to the shared memory heap,
+	see 'VCommandBuffer::_BindTransientImages'.
+=================================================
+*/
+	bool VMemoryManager::VirtualMemAllocator::AllocForImage (VkImage, const MemoryDesc &, OUT Storage_t &)
+	{
+		return true;
+	}
+
+/*
+=================================================
+	AllocForBuffer
+=================================================
+*/
+	bool VMemoryManager::VirtualMemAllocator::AllocForBuffer (VkBuffer, const MemoryDesc &, OUT Storage_t &)
+	{
+		RETURN_ERR( "transient buffers are not supported" );
+	}
+
+/*
+=================================================
+	AllocForAccelStruct
+=================================================
+*/
+#ifdef VK_NV_ray_tracing
+	bool VMemoryManager::VirtualMemAllocator::AllocForAccelStruct (VkAccelerationStructureNV, const MemoryDesc &, OUT Storage_t &)
+	{
+		RETURN_ERR( "transient acceleration structures are not supported" );
+	}
+#endif
+
+/*
+=================================================
+	AllocMemory
+=================================================
+*/
+	bool VMemoryManager::VirtualMemAllocator::AllocMemory (const VkMemoryRequirements &, const MemoryDesc &, OUT Storage_t &)
+	{
+		RETURN_ERR( "virtual memory can not be allocated" );
+	}
+
+/*
+=================================================
+	Dealloc
+----
+	memory heap is owned by command batch
+=================================================
+*/
+	bool VMemoryManager::VirtualMemAllocator::Dealloc (INOUT Storage_t &)
+	{
+		return true;
+	}
+
+/*
+=================================================
+	GetMemoryInfo
+=================================================
+*/
+	bool VMemoryManager::VirtualMemAllocator::GetMemoryInfo (const Storage_t &, OUT MemoryInfo_t &) const
+	{
+		RETURN_ERR( "memory of transient image is not accessible" );
+	}
+
+
+}	// FG
@@ -0,0 +1,315 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VDiskPipelineCache.h"
+#include "VDevice.h"
+#include "stl/Stream/FileStream.h"
+#include "stl/Algorithms/StringUtils.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VDiskPipelineCache::VDiskPipelineCache (const VDevice &dev) :
+		_device{ dev }
+	{
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VDiskPipelineCache::~VDiskPipelineCache ()
+	{
+		CHECK( _cache == VK_NULL_HANDLE );
+	}
+
+/*
+=================================================
+	Initialize
+----
+	loads cache from file if it is exists and compatible with current device and driver,
+	otherwise creates empty cache.
+=================================================
+*/
+	bool  VDiskPipelineCache::Initialize (StringView filename, uint saveThreshold)
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( _cache == VK_NULL_HANDLE );
+		CHECK_ERR( filename.size() );
+
+		_filename		= String{filename};
+		_saveThreshold	= saveThreshold;
+		_newPipelines.store( 0, memory_order_relaxed );
+
+		Array<uint8_t>	data;
+		if ( not _Load( OUT data ))
+			data.clear();
+
+		VkPipelineCacheCreateInfo	info = {};
+		info.sType				= VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		info.initialDataSize	= data.size();
+		info.pInitialData		= data.data();
+
+		VK_CHECK( _device.vkCreatePipelineCache( _device.GetVkDevice(), &info, null, OUT &_cache ));
+		return true;
+	}
+
+/*
+=================================================
+	Deinitialize
+=================================================
+*/
+	void  VDiskPipelineCache::Deinitialize ()
+	{
+		if ( _cache == VK_NULL_HANDLE )
+			return;
+
+		_WaitSave();
+
+		if ( _newPipelines.load( memory_order_relaxed ) > 0 )
+			Save();
+
+		EXLOCK( _guard );
+
+		_device.vkDestroyPipelineCache( _device.GetVkDevice(), _cache, null );
+		_cache = VK_NULL_HANDLE;
+		_filename.clear();
+	}
+
+/*
+=================================================
+	IsSaveRequired
+=================================================
+*/
+	bool  VDiskPipelineCache::IsSaveRequired () const
+	{
+		return	_cache != VK_NULL_HANDLE and _saveThreshold > 0 and
+				not _saving.load( memory_order_relaxed ) and
+				_newPipelines.load( memory_order_relaxed ) >= _saveThreshold;
+	}
+
+/*
+=================================================
+	Save
+----
+	data is written into temporary file which then replaces the cache file,
+	so the cache file is never partially written.
+=================================================
+*/
+	bool  VDiskPipelineCache::Save ()
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( _cache );
+
+		const uint		new_pipelines = _newPipelines.exchange( 0, memory_order_relaxed );
+		size_t			size		= 0;
+		Array<uint8_t>	data;
+
+		VK_CHECK( _device.vkGetPipelineCacheData( _device.GetVkDevice(), _cache, OUT &size, null ));
+
+		data.resize( size );
+		VK_CHECK( _device.vkGetPipelineCacheData( _device.GetVkDevice(), _cache, INOUT &size, OUT data.data() ));
+		data.resize( size );
+
+		FileHeader	header;
+		_InitHeader( OUT header, data, _device.GetProperties().properties );
+
+		const String	temp_name = _filename + ".tmp";
+		{
+			FileWStream		file{ temp_name };
+
+			if ( not (file.IsOpen() and file.Write( header ) and file.Write( ArrayView<uint8_t>{data} )))
+			{
+				_newPipelines.fetch_add( new_pipelines, memory_order_relaxed );
+				RETURN_ERR( "can't write pipeline cache to file '" + temp_name + "'" );
+			}
+		}
+
+	#ifdef FS_HAS_FILESYSTEM
+		std::error_code	err;
+		FS::rename( FS::path{temp_name}, FS::path{_filename}, OUT err );
+
+		if ( err )
+	#else
+		std::remove( _filename.c_str() );
+
+		if ( std::rename( temp_name.c_str(), _filename.c_str() ) != 0 )
+	#endif
+		{
+			_newPipelines.fetch_add( new_pipelines, memory_order_relaxed );
+			RETURN_ERR( "can't replace pipeline cache file '" + _filename + "'" );
+		}
+
+		FG_LOGI( "pipeline cache saved to '"s << _filename << "', size: " << ToString( BytesU{data.size()} ));
+		return true;
+	}
+
+/*
+=================================================
+	SaveAsync
+=================================================
+*/
+	void  VDiskPipelineCache::SaveAsync (const TaskScheduler &scheduler)
+	{
+		bool	expected = false;
+		if ( not _saving.compare_exchange_strong( INOUT expected, true, memory_order_acquire ))
+			return;
+
+		if ( scheduler )
+		{
+			scheduler->Enqueue( [this] () { _SaveJob(); });
+			return;
+		}
+
+		if ( _saveThread.joinable() )
+			_saveThread.join();
+
+		_saveThread = std::thread{ [this] () { _SaveJob(); }};
+	}
+
+/*
+=================================================
+	_SaveJob
+=================================================
+*/
+	void  VDiskPipelineCache::_SaveJob ()
+	{
+		Save();
+
+		// notify under lock, cache may be destroyed as soon as the lock is released
+		EXLOCK( _saveGuard );
+		_saving.store( false, memory_order_release );
+		_saveIdle.notify_all();
+	}
+
+/*
+=================================================
+	_WaitSave
+=================================================
+*/
+	void  VDiskPipelineCache::_WaitSave ()
+	{
+		if ( _saveThread.joinable() )
+			_saveThread.join();
+
+		std::unique_lock	lock{ _saveGuard };
+		_saveIdle.wait( lock, [this] () { return not _saving.load( memory_order_acquire ); });
+	}
+
+/*
+=================================================
+	_Load
+=================================================
+*/
+	bool  VDiskPipelineCache::_Load (OUT Array<uint8_t> &data) const
+	{
+		FileRStream		file{ _filename };
+
+		if ( not file.IsOpen() )
+		{
+			FG_LOGI( "pipeline cache file '"s << _filename << "' is not exists, empty cache will be created" );
+			return false;
+		}
+
+		Array<uint8_t>	file_data;
+		CHECK_ERR( file.Read( size_t(file.RemainingSize()), OUT file_data ));
+
+		if ( not _Parse( file_data, _device.GetProperties().properties, OUT data ))
+		{
+			FG_LOGI( "pipeline cache file '"s << _filename << "' is damaged or not compatible with current device or driver, empty cache will be created" );
+			return false;
+		}
+		return true;
+	}
+
+/*
+=================================================
+	_Parse
+----
+	returns driver cache data if file is not truncated and
+	was written for the same device and driver.
+=================================================
+*/
+	bool  VDiskPipelineCache::_Parse (ArrayView<uint8_t> file, const VkPhysicalDeviceProperties &props, OUT Array<uint8_t> &data)
+	{
+		FileHeader	header;
+
+		if ( file.size() < sizeof(header) )
+			return false;
+
+		std::memcpy( OUT &header, file.data(), sizeof(header) );
+
+		if ( header.dataSize != uint64_t(file.size() - sizeof(header)) )
+			return false;
+
+		data.assign( file.begin() + sizeof(header), file.end() );
+
+		return _Validate( header, data, props );
+	}
+
+/*
+=================================================
+	_InitHeader
+=================================================
+*/
+	void  VDiskPipelineCache::_InitHeader (OUT FileHeader &header, ArrayView<uint8_t> data, const VkPhysicalDeviceProperties &props)
+	{
+		header.magic			= FileMagic;
+		header.version			= FileVersion;
+		header.vendorID			= props.vendorID;
+		header.deviceID			= props.deviceID;
+		header.driverVersion	= props.driverVersion;
+		header.dataSize			= uint64_t(data.size());
+		header.dataHash			= uint64_t(size_t(HashOf( data.data(), data.size() )));
+
+		std::memcpy( header.pipelineCacheUUID, props.pipelineCacheUUID, sizeof(header.pipelineCacheUUID) );
+	}
+
+/*
+=================================================
+	_Validate
+----
+	checks file header and header of the driver cache data,
+	see 'VkPipelineCacheHeaderVersionOne' in specs.
+=================================================
+*/
+	bool  VDiskPipelineCache::_Validate (const FileHeader &header, ArrayView<uint8_t> data, const VkPhysicalDeviceProperties &props)
+	{
+		FileHeader	expected;
+		_InitHeader( OUT expected, data, props );
+
+		if ( header.magic			!= expected.magic			or
+			 header.version			!= expected.version			or
+			 header.vendorID		!= expected.vendorID		or
+			 header.deviceID		!= expected.deviceID		or
+			 header.driverVersion	!= expected.driverVersion	or
+			 header.dataSize		!= expected.dataSize		or
+			 header.dataHash		!= expected.dataHash		or
+			 std::memcmp( header.pipelineCacheUUID, expected.pipelineCacheUUID, sizeof(header.pipelineCacheUUID) ) != 0 )
+			return false;
+
+		// validate driver header
+		const size_t	driver_header_size = sizeof(uint) * 4 + VK_UUID_SIZE;
+
+		if ( data.size() < driver_header_size )
+			return false;
+
+		uint	header_size, header_version, vendor_id, device_id;
+		std::memcpy( OUT &header_size,		data.data() + sizeof(uint)*0, sizeof(uint) );
+		std::memcpy( OUT &header_version,	data.data() + sizeof(uint)*1, sizeof(uint) );
+		std::memcpy( OUT &vendor_id,		data.data() + sizeof(uint)*2, sizeof(uint) );
+		std::memcpy( OUT &device_id,		data.data() + sizeof(uint)*3, sizeof(uint) );
+
+		return	header_size		>= driver_header_size					and
+				header_version	== VK_PIPELINE_CACHE_HEADER_VERSION_ONE	and
+				vendor_id		== expected.vendorID					and
+				device_id		== expected.deviceID					and
+				std::memcmp( data.data() + sizeof(uint)*4, expected.pipelineCacheUUID, VK_UUID_SIZE ) == 0;
+	}
+
+}	// FG
@@ -0,0 +1,130 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Driver pipeline cache that is shared between all command buffers
+	and stored on disk between application runs.
+*/
+
+#pragma once
+
+#include "framegraph/Public/TaskScheduler.h"
+#include "VCommon.h"
+#include <thread>
+#include <condition_variable>
+
+namespace FG
+{
+
+	//
+	// Vulkan Disk Pipeline Cache
+	//
+
+	class VDiskPipelineCache final
+	{
+		friend class VDiskPipelineCacheUnitTest;
+
+	// types
+	private:
+		struct FileHeader
+		{
+			uint		magic;
+			uint		version;
+			uint		vendorID;
+			uint		deviceID;
+			uint		driverVersion;
+			uint8_t		pipelineCacheUUID [VK_UUID_SIZE];
+			uint64_t	dataSize;
+			uint64_t	dataHash;
+		};
+
+		static constexpr uint	FileMagic	= 0x43504746;	// 'FGPC'
+		static constexpr uint	FileVersion	= 1;
+
+
+	// variables
+	private:
+		VDevice const&			_device;
+
+		Mutex					_guard;				// protects file access
+		VkPipelineCache			_cache				= VK_NULL_HANDLE;
+		String					_filename;
+		uint					_saveThreshold		= 0;
+
+		Atomic<uint>			_newPipelines		{0};		// number of pipelines that was created after last save
+		Atomic<bool>			_saving				{false};	// background save is in progress
+		std::thread				_saveThread;					// used if task scheduler is not set
+
+		Mutex					_saveGuard;
+		std::condition_variable	_saveIdle;						// notified when background save is complete
+
+
+	// methods
+	public:
+		explicit VDiskPipelineCache (const VDevice &);
+		~VDiskPipelineCache ();
+
+		bool  Initialize (StringView filename, uint saveThreshold);
+		void  Deinitialize ();
+
+		bool  Save ();
+		void  SaveAsync (const TaskScheduler &scheduler);
+
+		void  OnPipelineCreated ()				{ if ( _cache ) _newPipelines.fetch_add( 1, memory_order_relaxed ); }
+
+		ND_ bool			IsCreated ()	const	{ return _cache != VK_NULL_HANDLE; }
+		ND_ bool			IsSaveRequired () const;
+		ND_ VkPipelineCache	Handle ()		const	{ return _cache; }
+
+	private:
+		bool  _Load (OUT Array<uint8_t> &data) const;
+		void  _SaveJob ();
+		void  _WaitSave ();
+
+		static bool  _Parse (ArrayView<uint8_t> file, const VkPhysicalDeviceProperties &props, OUT Array<uint8_t> &data);
+		static bool  _Validate (const FileHeader &header, ArrayView<uint8_t> data, const VkPhysicalDeviceProperties &props);
+		static void  _InitHeader (OUT FileHeader &header, ArrayView<uint8_t> data, const VkPhysicalDeviceProperties &props);
+	};
+
+
+
+	//
+	// Pipeline Creation Feedback
+	//
+
+	struct VPipelineCreationFeedback
+	{
+	#ifdef VK_EXT_pipeline_creation_feedback
+		VkPipelineCreationFeedbackEXT				pipeline	= {};
+		VkPipelineCreationFeedbackEXT				stages [32]	= {};
+		VkPipelineCreationFeedbackCreateInfoEXT		info		= {};
+	#endif
+
+		// adds feedback into pipeline create info if extension is enabled
+		void  Attach (bool enabled, INOUT const void* &pNext, uint stageCount)
+		{
+		#ifdef VK_EXT_pipeline_creation_feedback
+			if ( not enabled or stageCount > CountOf(stages) )
+				return;
+
+			info.sType								= VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT;
+			info.pNext								= pNext;
+			info.pPipelineCreationFeedback			= &pipeline;
+			info.pipelineStageCreationFeedbackCount	= stageCount;
+			info.pPipelineStageCreationFeedbacks	= stages;
+			pNext									= &info;
+		#else
+			Unused( enabled, pNext, stageCount );
+		#endif
+		}
+
+		ND_ bool  IsCacheHit () const
+		{
+		#ifdef VK_EXT_pipeline_creation_feedback
+			return AllBits( pipeline.flags, VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT | VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT );
+		#else
+			return false;
+		#endif
+		}
+	};
+
+
+}	// FG
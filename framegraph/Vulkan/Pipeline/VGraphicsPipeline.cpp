@@ -66,16 +66,22 @@ namespace FG
 	VGraphicsPipeline::~VGraphicsPipeline ()
 	{
 		CHECK( _instances.empty() );
+		CHECK( _pendingInstances.empty() );
 	}
 	
 /*
 =================================================
 	Create
+----
+	'expectedInstances' is taken from pipeline manifest,
+	instance map is not used by other threads yet, so it can be resized.
 =================================================
 */
-	bool VGraphicsPipeline::Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, StringView dbgName)
+	bool VGraphicsPipeline::Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, uint64_t descHash, uint expectedInstances, StringView dbgName)
 	{
 		EXLOCK( _drCheck );
+
+		_instances.Reserve( expectedInstances );
 		
 		for (auto& stage : desc._shaders)
 		{
@@ -96,6 +102,7 @@ namespace FG
 		_vertexAttribs		= desc._vertexAttribs;
 		_patchControlPoints	= desc._patchControlPoints;
 		_earlyFragmentTests	= desc._earlyFragmentTests;
+		_descHash			= descHash;
 		_debugName			= dbgName;
 		
 		return true;
@@ -112,17 +119,17 @@ namespace FG
 
 		auto&	dev = resMngr.GetDevice();
 
-		for (auto& ppln : _instances) {
-			dev.vkDestroyPipeline( dev.GetVkDevice(), ppln.second, null );
-			resMngr.ReleaseResource( const_cast<PipelineInstance &>(ppln.first).layoutId );
-		}
+		_instances.Clear( [&] (PipelineInstance &inst, VkPipeline ppln) {
+				dev.vkDestroyPipeline( dev.GetVkDevice(), ppln, null );
+				resMngr.ReleaseResource( inst.layoutId );
+				resMngr.ReleaseResource( inst.renderPassId );
+			});
 		
 		if ( _baseLayoutId ) {
 			resMngr.ReleaseResource( _baseLayoutId.Release() );
 		}
 
 		_shaders.clear();
-		_instances.clear();
 		_vertexAttribs.clear();
 		_debugName.clear();
 
@@ -130,6 +137,7 @@ namespace FG
 		_supportedTopology	= Default;
 		_patchControlPoints	= 0;
 		_earlyFragmentTests	= false;
+		_descHash			= 0;
 	}
 
 
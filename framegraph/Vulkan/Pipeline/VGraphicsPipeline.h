@@ -3,6 +3,7 @@
 #pragma once
 
 #include "VPipelineLayout.h"
+#include "stl/ThreadSafe/LfInsertOnlyMap.h"
 
 namespace FG
 {
@@ -14,6 +15,7 @@ namespace FG
 	class VGraphicsPipeline final
 	{
 		friend class VPipelineCache;
+		friend class VPipelineManifest;
 		
 	// types
 	public:
@@ -31,7 +33,7 @@ namespace FG
 		// variables
 			HashVal						_hash;
 			RawPipelineLayoutID			layoutId;		// strong reference
-			RawRenderPassID				renderPassId;
+			RawRenderPassID				renderPassId;	// strong reference
 			RenderState					renderState;
 			VertexInputState			vertexInput;
 			EPipelineDynamicState		dynamicState	= Default;
@@ -52,7 +54,8 @@ namespace FG
 			ND_ size_t	operator () (const PipelineInstance &value) const	{ return size_t(value._hash); }
 		};
 
-		using Instances_t			= HashMap< PipelineInstance, VkPipeline, PipelineInstanceHash >;
+		using Instances_t			= LfInsertOnlyMap< PipelineInstance, VkPipeline, PipelineInstanceHash >;
+		using PendingInstances_t	= HashSet< PipelineInstance, PipelineInstanceHash >;
 		using ShaderModules_t		= FixedArray< ShaderModule, 8 >;
 		using TopologyBits_t		= GraphicsPipelineDesc::TopologyBits_t;
 		using VertexAttrib			= VertexInputState::VertexAttrib;
@@ -61,8 +64,9 @@ namespace FG
 
 	// variables
 	private:
-		mutable SharedMutex			_instanceGuard;
+		mutable SharedMutex			_instanceGuard;		// protects '_pendingInstances', search in '_instances' is lock-free
 		mutable Instances_t			_instances;
+		mutable PendingInstances_t	_pendingInstances;		// instances that are compiled asynchronously
 
 		PipelineLayoutID			_baseLayoutId;
 		ShaderModules_t				_shaders;
@@ -71,6 +75,7 @@ namespace FG
 		VertexAttribs_t				_vertexAttribs;
 		uint						_patchControlPoints		= 0;
 		bool						_earlyFragmentTests		= true;
+		uint64_t					_descHash				= 0;	// stable hash for pipeline manifest
 		
 		DebugName_t					_debugName;
 		
@@ -84,7 +89,7 @@ namespace FG
 		VGraphicsPipeline (const VGraphicsPipeline &) = delete;
 		~VGraphicsPipeline ();
 
-		bool Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, StringView dbgName);
+		bool Create (const GraphicsPipelineDesc &desc, RawPipelineLayoutID layoutId, uint64_t descHash, uint expectedInstances, StringView dbgName);
 		void Destroy (VResourceManager &);
 		
 		ND_ RawPipelineLayoutID		GetLayoutID ()			const	{ SHAREDLOCK( _drCheck );  return _baseLayoutId.Get(); }
@@ -92,6 +97,7 @@ namespace FG
 		ND_ uint					PatchControlPoints ()	const	{ SHAREDLOCK( _drCheck );  return _patchControlPoints; }
 
 		ND_ bool					IsEarlyFragmentTests ()	const	{ SHAREDLOCK( _drCheck );  return _earlyFragmentTests; }
+		ND_ uint64_t				GetDescriptionHash ()	const	{ SHAREDLOCK( _drCheck );  return _descHash; }
 		
 		ND_ StringView				GetDebugName ()			const	{ SHAREDLOCK( _drCheck );  return _debugName; }
 	};
@@ -2,10 +2,12 @@
 
 #include "Public/PipelineCompiler.h"
 #include "VPipelineCache.h"
+#include "VDiskPipelineCache.h"
 #include "VDevice.h"
 #include "VEnumCast.h"
 #include "VRenderPass.h"
 #include "VCommandBuffer.h"
+#include "VDrawTask.h"
 
 namespace FG
 {
@@ -76,6 +78,70 @@ namespace FG
 		// TODO
 		return false;
 	}
+
+/*
+=================================================
+	ResetInstanceCache
+----
+	pipelines may be destroyed after command buffer has been executed,
+	so cache must be cleared before recording.
+=================================================
+*/
+	void VPipelineCache::ResetInstanceCache ()
+	{
+		_instanceCache.fill( Default );
+		_drawStateCache.fill( Default );
+	}
+
+/*
+=================================================
+	_GetDrawStateItem
+=================================================
+*/
+	VPipelineCache::DrawStateCacheItem&  VPipelineCache::_GetDrawStateItem (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task)
+	{
+		const HashVal	hash = task.drawStateHash + HashOf( task.pipeline ) + HashOf( &logicalRP );
+
+		return _drawStateCache[ size_t(hash) & (_drawStateCache.size()-1) ];
+	}
+
+/*
+=================================================
+	FindDrawState
+----
+	draw tasks with same state use same pipeline instance,
+	so render state building, validation and hashing can be skipped.
+=================================================
+*/
+	bool  VPipelineCache::FindDrawState (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task,
+										 OUT VkPipeline &outPipeline, OUT VPipelineLayout const* &outLayout)
+	{
+		auto&	item = _GetDrawStateItem( logicalRP, task );
+
+		if ( item.renderPass != &logicalRP or not item.task or not item.task->IsSameDrawState( task ))
+			return false;
+
+		outPipeline	= item.handle;
+		outLayout	= item.layout;
+		return true;
+	}
+
+/*
+=================================================
+	AddDrawState
+=================================================
+*/
+	void  VPipelineCache::AddDrawState (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task)
+	{
+		ASSERT( task.pipelineInstance and task.pipelineLayout );
+
+		auto&	item = _GetDrawStateItem( logicalRP, task );
+
+		item.renderPass	= &logicalRP;
+		item.task		= &task;
+		item.handle		= task.pipelineInstance;
+		item.layout		= task.pipelineLayout;
+	}
 	
 /*
 =================================================
@@ -97,6 +163,46 @@ namespace FG
 		return true;
 	}
 
+/*
+=================================================
+	_GetPipelineCache
+----
+	disk cache is shared between all command buffers,
+	'vkCreate*Pipelines' doesn't require external synchronization for pipeline cache.
+=================================================
+*/
+	VkPipelineCache  VPipelineCache::_GetPipelineCache (VCommandBuffer &fgThread) const
+	{
+		auto&	disk_cache = fgThread.GetResourceManager().GetDiskPipelineCache();
+
+		return disk_cache.IsCreated() ? disk_cache.Handle() : _pipelinesCache;
+	}
+
+/*
+=================================================
+	_FindInstance
+----
+	search in local cache and then in the pipeline instances,
+	both are lock-free.
+=================================================
+*/
+	VkPipeline  VPipelineCache::_FindInstance (const VGraphicsPipeline &gppln, const GPipelineInstance &inst)
+	{
+		auto&	item = _instanceCache[ size_t(inst._hash) & (_instanceCache.size()-1) ];
+
+		if ( item.pipeline == &gppln and item.instance->_hash == inst._hash and *item.instance == inst )
+			return item.handle;
+
+		auto*	node = gppln._instances.Find( inst );
+		if ( not node )
+			return VK_NULL_HANDLE;
+
+		item.pipeline	= &gppln;
+		item.instance	= &node->key;
+		item.handle		= node->value;
+		return item.handle;
+	}
+
 /*
 =================================================
 	_ClearTemp
@@ -195,15 +301,249 @@ namespace FG
 			CHECK( _SetupShaderDebugging( fgThread, gppln, debugModeIndex, OUT dbg_mode, OUT dbg_stages, OUT layout_id ));
 		}
 
+		VGraphicsPipeline::PipelineInstance		inst;
+		CHECK_ERR( _InitPipelineInstance( dev, logicalRP, gppln, layout_id, GetDebugModeHash( dbg_mode, dbg_stages ),
+										  vertexInput, renderState, dynamicStates, OUT inst ));
+		
+		outLayout	= fgThread.AcquireTemporary( layout_id );
+		outPipeline	= _FindInstance( gppln, inst );
+
+		if ( outPipeline )
+			return true;
+
+		// create new instance
+		bool	cache_hit = false;
+		CHECK_ERR( _CreateGraphicsPipeline( dev, _GetPipelineCache( fgThread ), gppln, inst, *render_pass, *outLayout, dbg_mode, dbg_stages, OUT outPipeline, OUT cache_hit ));
+
+		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
+		fgThread.EditStatistic().resources.pipelineCacheHits += uint(cache_hit);
+		fgThread.GetResourceManager().GetDiskPipelineCache().OnPipelineCreated();
+		
+		// try to insert new instance
+		{
+			auto[node, inserted] = gppln._instances.Insert( inst, outPipeline );
+		
+			if ( not inserted )
+			{
+				dev.vkDestroyPipeline( dev.GetVkDevice(), outPipeline, null );
+
+				outPipeline = node->value;
+				return true;
+			}
+
+			if ( dbg_mode == Default )
+				fgThread.GetResourceManager().GetPipelineManifest().Record( gppln, *render_pass, inst );
+		}
+		
+		CHECK( fgThread.GetResourceManager().AcquireResource( layout_id ));
+		CHECK( fgThread.GetResourceManager().AcquireResource( inst.renderPassId ));
+		return true;
+	}
+	
+/*
+=================================================
+	CreatePipelineInstanceAsync
+----
+	returns existing pipeline instance or null if instance is compiling,
+	new instance is enqueued to the pipeline compile queue.
+=================================================
+*/
+	bool  VPipelineCache::CreatePipelineInstanceAsync (VCommandBuffer				&fgThread,
+													   const VLogicalRenderPass		&logicalRP,
+													   RawGPipelineID				 pipelineId,
+													   const VGraphicsPipeline		&gppln,
+													   const VertexInputState		&vertexInput,
+													   const RenderState			&renderState,
+													   const EPipelineDynamicState	 dynamicStates,
+													   OUT VkPipeline				&outPipeline,
+													   OUT VPipelineLayout const*	&outLayout)
+	{
+		CHECK_ERR( logicalRP.GetRenderPassID() and pipelineId );
+
+		VResourceManager&		res_mngr	= fgThread.GetResourceManager();
+		RawPipelineLayoutID		layout_id	= gppln.GetLayoutID();
+
+		VGraphicsPipeline::PipelineInstance		inst;
+		CHECK_ERR( _InitPipelineInstance( fgThread.GetDevice(), logicalRP, gppln, layout_id, GetDebugModeHash( Default, Default ),
+										  vertexInput, renderState, dynamicStates, OUT inst ));
+
+		outLayout	= fgThread.AcquireTemporary( layout_id );
+		outPipeline	= _FindInstance( gppln, inst );
+
+		if ( outPipeline )
+			return true;
+
+		// mark instance as pending
+		{
+			EXLOCK( gppln._instanceGuard );
+
+			// instance may be inserted after lock-free search
+			if ( auto* node = gppln._instances.Find( inst )) {
+				outPipeline = node->value;
+				return true;
+			}
+
+			if ( not gppln._pendingInstances.insert( inst ).second )
+				return true;	// already compiling
+		}
+
+		// pipeline, render pass and layout must be alive until compilation is complete
+		CHECK( res_mngr.AcquireResource( pipelineId ));
+		CHECK( res_mngr.AcquireResource( inst.renderPassId ));
+		CHECK( res_mngr.AcquireResource( layout_id ));
+
+		fgThread.EditStatistic().resources.asyncGraphicsPipelineCount++;
+
+		res_mngr.GetPipelineCompileQueue().Enqueue( [&res_mngr, &gppln, pipelineId, inst] ()
+			{
+				_CompilePipelineInstance( res_mngr, pipelineId, gppln, inst );
+			});
+		return true;
+	}
+	
+/*
+=================================================
+	_CompilePipelineInstance
+----
+	executed on the pipeline compile queue.
+=================================================
+*/
+	void  VPipelineCache::_CompilePipelineInstance (VResourceManager &resMngr, RawGPipelineID pipelineId, const VGraphicsPipeline &gppln,
+													const VGraphicsPipeline::PipelineInstance &inst)
+	{
+		VDevice const&			dev			= resMngr.GetDevice();
+		VRenderPass const*		render_pass	= resMngr.GetResource( inst.renderPassId );
+		VPipelineLayout const*	layout		= resMngr.GetResource( inst.layoutId );
+		auto&					disk_cache	= resMngr.GetDiskPipelineCache();
+		VkPipeline				ppln		= VK_NULL_HANDLE;
+		bool					inserted	= false;
+
+		if ( render_pass and layout )
+		{
+			VPipelineCache	compiler;	// only temporary arrays are used
+
+			bool			cache_hit;
+
+			if ( compiler._CreateGraphicsPipeline( dev, disk_cache.Handle(), gppln, inst, *render_pass, *layout, Default, Default, OUT ppln, OUT cache_hit ))
+				disk_cache.OnPipelineCreated();
+		}
+
+		{
+			EXLOCK( gppln._instanceGuard );
+
+			gppln._pendingInstances.erase( inst );
+
+			if ( ppln )
+				inserted = gppln._instances.Insert( inst, ppln ).second;
+
+			if ( inserted )
+				resMngr.GetPipelineManifest().Record( gppln, *render_pass, inst );
+		}
+
+		// same instance may be created synchronously
+		if ( ppln and not inserted )
+			dev.vkDestroyPipeline( dev.GetVkDevice(), ppln, null );
+
+		// layout and render pass references are moved to the pipeline instance
+		if ( not inserted )
+		{
+			resMngr.ReleaseResource( inst.layoutId );
+			resMngr.ReleaseResource( inst.renderPassId );
+		}
+
+		if ( ppln )
+			resMngr.GetPipelineCompileQueue().OnPipelineReady( pipelineId );
+
+		resMngr.ReleaseResource( pipelineId );
+	}
+
+/*
+=================================================
+	PrewarmPipelineInstance
+----
+	creates pipeline instance recorded in the pipeline manifest,
+	returns false if entry is not compatible with the pipeline.
+=================================================
+*/
+	bool  VPipelineCache::PrewarmPipelineInstance (VResourceManager							&resMngr,
+												   const VGraphicsPipeline					&gppln,
+												   RawRenderPassID							 renderPassId,
+												   const VPipelineManifest::InstanceEntry	&entry)
+	{
+		VDevice const&			dev			= resMngr.GetDevice();
+		RawPipelineLayoutID		layout_id	= gppln.GetLayoutID();
+		VRenderPass const*		render_pass	= resMngr.GetResource( renderPassId );
+		VPipelineLayout const*	layout		= resMngr.GetResource( layout_id );
+		CHECK_ERR( render_pass and layout );
+
+		// recorded render state is already validated
 		VGraphicsPipeline::PipelineInstance		inst;
 		inst.layoutId		= layout_id;
+		inst.dynamicState	= EPipelineDynamicState(entry.dynamicState);
+		inst.renderPassId	= renderPassId;
+		inst.subpassIndex	= uint8_t(entry.subpassIndex);
+		inst.viewportCount	= uint8_t(entry.viewportCount);
+		inst.debugMode		= GetDebugModeHash( Default, Default );
+		inst.renderState	= entry.renderState;
+
+		VPipelineManifest::Unpack( entry, OUT inst.vertexInput );
+
+		// pipeline may be changed since the manifest was recorded
+		if ( inst.vertexInput.Vertices().size() != gppln.GetVertexAttribs().size() or
+			 uint(inst.renderState.inputAssembly.topology) >= gppln._supportedTopology.size() or
+			 not gppln._supportedTopology[uint(inst.renderState.inputAssembly.topology)] )
+			return false;
+
+		inst.vertexInput.ApplyAttribs( gppln.GetVertexAttribs() );
+		inst.UpdateHash();
+
+		// find existing instance
+		if ( gppln._instances.Find( inst ))
+			return true;
+
+		// create new instance
+		auto&		disk_cache	= resMngr.GetDiskPipelineCache();
+		VkPipeline	ppln		= VK_NULL_HANDLE;
+		bool		cache_hit	= false;
+
+		CHECK_ERR( _CreateGraphicsPipeline( dev, disk_cache.Handle(), gppln, inst, *render_pass, *layout, Default, Default, OUT ppln, OUT cache_hit ));
+		disk_cache.OnPipelineCreated();
+
+		// try to insert new instance
+		if ( not gppln._instances.Insert( inst, ppln ).second )
+		{
+			dev.vkDestroyPipeline( dev.GetVkDevice(), ppln, null );
+			return true;
+		}
+
+		CHECK( resMngr.AcquireResource( layout_id ));
+		CHECK( resMngr.AcquireResource( renderPassId ));
+		return true;
+	}
+
+/*
+=================================================
+	_InitPipelineInstance
+=================================================
+*/
+	bool  VPipelineCache::_InitPipelineInstance (const VDevice							&dev,
+												 const VLogicalRenderPass				&logicalRP,
+												 const VGraphicsPipeline				&gppln,
+												 RawPipelineLayoutID					 layoutId,
+												 uint									 debugMode,
+												 const VertexInputState					&vertexInput,
+												 const RenderState						&renderState,
+												 const EPipelineDynamicState			 dynamicStates,
+												 OUT VGraphicsPipeline::PipelineInstance &inst) const
+	{
+		inst.layoutId		= layoutId;
 		inst.dynamicState	= dynamicStates;
 		inst.renderPassId	= logicalRP.GetRenderPassID();
 		inst.subpassIndex	= uint8_t(logicalRP.GetSubpassIndex());
 		inst.vertexInput	= vertexInput;
 		//inst.flags		= 0;	//pipelineFlags;	// TODO
 		inst.viewportCount	= uint8_t(logicalRP.GetViewports().size());
-		inst.debugMode		= GetDebugModeHash( dbg_mode, dbg_stages );
+		inst.debugMode		= debugMode;
 		inst.renderState	= renderState;
 
 		if ( gppln._patchControlPoints )
@@ -217,22 +557,25 @@ namespace FG
 					gppln._supportedTopology[uint(inst.renderState.inputAssembly.topology)] );
 
 		inst.UpdateHash();
-		
-		outLayout = fgThread.AcquireTemporary( layout_id );
-
-		// find existing instance
-		{
-			SHAREDLOCK( gppln._instanceGuard );
-
-			auto iter = gppln._instances.find( inst );
-			if ( iter != gppln._instances.end() ) {
-				outPipeline = iter->second;
-				return true;
-			}
-		}
-
+		return true;
+	}
 
-		// create new instance
+/*
+=================================================
+	_CreateGraphicsPipeline
+=================================================
+*/
+	bool  VPipelineCache::_CreateGraphicsPipeline (const VDevice								&dev,
+												   VkPipelineCache							 pipelineCache,
+												   const VGraphicsPipeline					&gppln,
+												   const VGraphicsPipeline::PipelineInstance	&inst,
+												   const VRenderPass						&renderPass,
+												   const VPipelineLayout					&layout,
+												   EShaderDebugMode							 dbgMode,
+												   EShaderStages							 dbgStages,
+												   OUT VkPipeline							&outPipeline,
+												   OUT bool									&cacheHit)
+	{
 		_ClearTemp();
 
 		VkGraphicsPipelineCreateInfo			pipeline_info		= {};
@@ -246,9 +589,9 @@ namespace FG
 		VkPipelineVertexInputStateCreateInfo	vertex_input_info	= {};
 		VkPipelineViewportStateCreateInfo		viewport_info		= {};
 
-		CHECK_ERR( _SetShaderStages( OUT _tempStages, INOUT _tempSpecialization, INOUT _tempSpecEntries, gppln._shaders, dbg_mode, dbg_stages ));
+		CHECK_ERR( _SetShaderStages( OUT _tempStages, INOUT _tempSpecialization, INOUT _tempSpecEntries, gppln._shaders, dbgMode, dbgStages ));
 		_SetDynamicState( OUT dynamic_state_info, OUT _tempDynamicStates, inst.dynamicState );
-		_SetColorBlendState( OUT blend_info, OUT _tempAttachments, inst.renderState.color, *render_pass, inst.subpassIndex );
+		_SetColorBlendState( OUT blend_info, OUT _tempAttachments, inst.renderState.color, renderPass, inst.subpassIndex );
 		_SetMultisampleState( OUT multisample_info, inst.renderState.multisample );
 		_SetTessellationState( OUT tessellation_info, gppln._patchControlPoints );
 		_SetDepthStencilState( OUT depth_stencil_info, inst.renderState.depth, inst.renderState.stencil );
@@ -271,10 +614,10 @@ namespace FG
 		pipeline_info.pDynamicState			= (_tempDynamicStates.empty() ? null : &dynamic_state_info);
 		pipeline_info.basePipelineIndex		= -1;
 		pipeline_info.basePipelineHandle	= VK_NULL_HANDLE;
-		pipeline_info.layout				= outLayout->Handle();
+		pipeline_info.layout				= layout.Handle();
 		pipeline_info.stageCount			= uint(_tempStages.size());
 		pipeline_info.pStages				= _tempStages.data();
-		pipeline_info.renderPass			= render_pass->Handle();
+		pipeline_info.renderPass			= renderPass.Handle();
 		pipeline_info.subpass				= inst.subpassIndex;
 		
 		if ( not rasterization_info.rasterizerDiscardEnable )
@@ -287,29 +630,16 @@ namespace FG
 			pipeline_info.pColorBlendState		= null;
 		}
 
-		outPipeline = {};
-		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
+		VPipelineCreationFeedback	feedback;
+		feedback.Attach( dev.GetFeatures().pipelineCreationFeedback, INOUT pipeline_info.pNext, pipeline_info.stageCount );
 
-		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
-		
-		// try to insert new instance
-		{
-			EXLOCK( gppln._instanceGuard );
-
-			auto[iter, inserted] = gppln._instances.insert({ std::move(inst), outPipeline });
-		
-			if ( not inserted )
-			{
-				dev.vkDestroyPipeline( dev.GetVkDevice(), outPipeline, null );
+		outPipeline = {};
+		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), pipelineCache, 1, &pipeline_info, null, OUT &outPipeline ));
 
-				outPipeline = iter->second;
-				return true;
-			}
-		}
-		
-		CHECK( fgThread.GetResourceManager().AcquireResource( layout_id ));
+		cacheHit = feedback.IsCacheHit();
 		return true;
 	}
+
 /*
 =================================================
 	CreatePipelineInstance
@@ -420,10 +750,15 @@ namespace FG
 			pipeline_info.pColorBlendState		= null;
 		}
 
+		VPipelineCreationFeedback	feedback;
+		feedback.Attach( dev.GetFeatures().pipelineCreationFeedback, INOUT pipeline_info.pNext, pipeline_info.stageCount );
+
 		outPipeline = {};
-		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
+		VK_CHECK( dev.vkCreateGraphicsPipelines( dev.GetVkDevice(), _GetPipelineCache( fgThread ), 1, &pipeline_info, null, OUT &outPipeline ));
 		
 		fgThread.EditStatistic().resources.newGraphicsPipelineCount++;
+		fgThread.EditStatistic().resources.pipelineCacheHits += uint(feedback.IsCacheHit());
+		fgThread.GetResourceManager().GetDiskPipelineCache().OnPipelineCreated();
 		
 		// try to insert new instance
 		{
@@ -542,10 +877,15 @@ namespace FG
 			pipeline_info.stage.pSpecializationInfo	= &spec;
 		}
 
+		VPipelineCreationFeedback	feedback;
+		feedback.Attach( dev.GetFeatures().pipelineCreationFeedback, INOUT pipeline_info.pNext, 1 );
+
 		outPipeline = {};
-		VK_CHECK( dev.vkCreateComputePipelines( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &outPipeline ));
+		VK_CHECK( dev.vkCreateComputePipelines( dev.GetVkDevice(), _GetPipelineCache( fgThread ), 1, &pipeline_info, null, OUT &outPipeline ));
 		
 		fgThread.EditStatistic().resources.newComputePipelineCount++;
+		fgThread.EditStatistic().resources.pipelineCacheHits += uint(feedback.IsCacheHit());
+		fgThread.GetResourceManager().GetDiskPipelineCache().OnPipelineCreated();
 		
 		// try to insert new instance
 		{
@@ -751,8 +1091,9 @@ namespace FG
 			pipeline_info.basePipelineIndex		= -1;
 			pipeline_info.basePipelineHandle	= VK_NULL_HANDLE;
 
-			VK_CHECK( dev.vkCreateRayTracingPipelinesNV( dev.GetVkDevice(), _pipelinesCache, 1, &pipeline_info, null, OUT &table.pipeline ));
+			VK_CHECK( dev.vkCreateRayTracingPipelinesNV( dev.GetVkDevice(), _GetPipelineCache( fgThread ), 1, &pipeline_info, null, OUT &table.pipeline ));
 			fgThread.EditStatistic().resources.newRayTracingPipelineCount++;
+			fgThread.GetResourceManager().GetDiskPipelineCache().OnPipelineCreated();
 			
 			CHECK( res_mngr.AcquireResource( layout_id ));
 			table.layoutId = PipelineLayoutID{layout_id};
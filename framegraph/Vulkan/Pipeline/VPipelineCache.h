@@ -9,6 +9,7 @@
 #include "VComputePipeline.h"
 #include "VMeshPipeline.h"
 #include "VRayTracingPipeline.h"
+#include "VPipelineManifest.h"
 
 namespace FG
 {
@@ -61,6 +62,26 @@ namespace FG
 		using RTShaderSpecializations_t	= FixedArray< RTShaderSpec, 32 >;
 		
 		using ShaderModule_t			= VGraphicsPipeline::ShaderModule;
+		using GPipelineInstance			= VGraphicsPipeline::PipelineInstance;
+
+		// last found graphics pipeline instances, it is valid only while command buffer is recording
+		struct InstanceCacheItem
+		{
+			VGraphicsPipeline const*	pipeline	= null;
+			GPipelineInstance const*	instance	= null;		// key in 'VGraphicsPipeline::_instances'
+			VkPipeline					handle		= VK_NULL_HANDLE;
+		};
+		using InstanceCache_t			= StaticArray< InstanceCacheItem, 64 >;
+
+		// last pipelines that are used for draw tasks, the key is draw task state, so render state is not needed
+		struct DrawStateCacheItem
+		{
+			VLogicalRenderPass const*		renderPass	= null;
+			VBaseDrawVerticesTask const*	task		= null;
+			VkPipeline						handle		= VK_NULL_HANDLE;
+			VPipelineLayout const*			layout		= null;
+		};
+		using DrawStateCache_t			= StaticArray< DrawStateCacheItem, 64 >;
 
 	public:
 		struct BufferCopyRegion
@@ -75,6 +96,8 @@ namespace FG
 	// variables
 	private:
 		VkPipelineCache				_pipelinesCache;
+		InstanceCache_t				_instanceCache;
+		DrawStateCache_t			_drawStateCache;
 
 		// temporary arrays
 		ShaderStages_t				_tempStages;			// TODO: use custom allocator?
@@ -104,6 +127,12 @@ namespace FG
 
 		bool MergeCache (VPipelineCache &);
 
+		void ResetInstanceCache ();
+
+		ND_ bool  FindDrawState (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task,
+								 OUT VkPipeline &outPipeline, OUT VPipelineLayout const* &outLayout);
+			void  AddDrawState (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task);
+
 		bool CreatePipelineInstance (VCommandBuffer					&fgThread,
 									 const VLogicalRenderPass		&logicalRP,
 									 const VGraphicsPipeline		&gpipeline,
@@ -114,6 +143,21 @@ namespace FG
 									 OUT VkPipeline					&outPipeline,
 									 OUT VPipelineLayout const*		&outLayout);
 		
+		bool CreatePipelineInstanceAsync (VCommandBuffer				&fgThread,
+										  const VLogicalRenderPass		&logicalRP,
+										  RawGPipelineID				 pipelineId,
+										  const VGraphicsPipeline		&gpipeline,
+										  const VertexInputState		&vertexInput,
+										  const RenderState				&renderState,
+										  const EPipelineDynamicState	 dynamicStates,
+										  OUT VkPipeline				&outPipeline,
+										  OUT VPipelineLayout const*	&outLayout);
+		
+		bool PrewarmPipelineInstance (VResourceManager							&resMngr,
+									  const VGraphicsPipeline					&gpipeline,
+									  RawRenderPassID							 renderPassId,
+									  const VPipelineManifest::InstanceEntry	&entry);
+
 		bool CreatePipelineInstance (VCommandBuffer					&fgThread,
 									 const VLogicalRenderPass		&logicalRP,
 									 const VMeshPipeline			&mpipeline,
@@ -143,6 +187,7 @@ namespace FG
 
 	private:
 		bool _CreatePipelineCache (const VDevice &dev);
+		ND_ VkPipelineCache  _GetPipelineCache (VCommandBuffer &fgThread) const;
 
 		template <typename Pipeline>
 		bool _SetupShaderDebugging (VCommandBuffer &fgThread, const Pipeline &ppln, ShaderDbgIndex debugModeIndex,
@@ -150,6 +195,33 @@ namespace FG
 
 		void _ClearTemp ();
 
+		ND_ VkPipeline  _FindInstance (const VGraphicsPipeline &gppln, const GPipelineInstance &inst);
+		ND_ DrawStateCacheItem&  _GetDrawStateItem (const VLogicalRenderPass &logicalRP, const VBaseDrawVerticesTask &task);
+
+		bool _InitPipelineInstance (const VDevice							&dev,
+									const VLogicalRenderPass				&logicalRP,
+									const VGraphicsPipeline					&gppln,
+									RawPipelineLayoutID						 layoutId,
+									uint									 debugMode,
+									const VertexInputState					&vertexInput,
+									const RenderState						&renderState,
+									const EPipelineDynamicState				 dynamicStates,
+									OUT VGraphicsPipeline::PipelineInstance	&inst) const;
+
+		bool _CreateGraphicsPipeline (const VDevice								&dev,
+									  VkPipelineCache							 pipelineCache,
+									  const VGraphicsPipeline					&gppln,
+									  const VGraphicsPipeline::PipelineInstance	&inst,
+									  const VRenderPass							&renderPass,
+									  const VPipelineLayout						&layout,
+									  EShaderDebugMode							 dbgMode,
+									  EShaderStages								 dbgStages,
+									  OUT VkPipeline							&outPipeline,
+									  OUT bool									&cacheHit);
+
+		static void _CompilePipelineInstance (VResourceManager &resMngr, RawGPipelineID pipelineId, const VGraphicsPipeline &gppln,
+											  const VGraphicsPipeline::PipelineInstance &inst);
+
 		void _SetColorBlendState (OUT VkPipelineColorBlendStateCreateInfo &outState,
 								  OUT ColorAttachments_t &attachments,
 								  const RenderState::ColorBuffersState &inState,
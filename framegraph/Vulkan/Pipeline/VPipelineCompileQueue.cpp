@@ -0,0 +1,165 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VPipelineCompileQueue.h"
+
+namespace FG
+{
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VPipelineCompileQueue::~VPipelineCompileQueue ()
+	{
+		CHECK( not _thread.joinable() );
+		CHECK( _pending == 0 );
+	}
+
+/*
+=================================================
+	Initialize
+=================================================
+*/
+	bool  VPipelineCompileQueue::Initialize (const TaskScheduler &scheduler, OnPipelineReady_t &&onReady)
+	{
+		Deinitialize();
+
+		EXLOCK( _guard );
+
+		_scheduler	= scheduler;
+		_onReady	= std::move(onReady);
+		_looping	= true;
+
+		if ( not _scheduler )
+			_thread = std::thread{ [this] () { _Loop(); }};
+
+		_enabled.store( true, memory_order_release );
+		return true;
+	}
+
+/*
+=================================================
+	Deinitialize
+----
+	waits until all jobs are complete
+=================================================
+*/
+	void  VPipelineCompileQueue::Deinitialize ()
+	{
+		_enabled.store( false, memory_order_release );
+
+		WaitIdle();
+
+		{
+			EXLOCK( _guard );
+			_looping = false;
+		}
+		_wakeup.notify_all();
+
+		if ( _thread.joinable() )
+			_thread.join();
+
+		EXLOCK( _guard );
+		_scheduler	= null;
+		_onReady	= {};
+	}
+
+/*
+=================================================
+	Enqueue
+=================================================
+*/
+	void  VPipelineCompileQueue::Enqueue (Job_t &&job)
+	{
+		std::unique_lock	lock{ _guard };
+
+		++_pending;
+
+		if ( _scheduler )
+		{
+			lock.unlock();
+
+			_scheduler->Enqueue( [this, fn = std::move(job)] ()
+				{
+					fn();
+					_Complete();
+				});
+			return;
+		}
+
+		_jobs.push_back( std::move(job) );
+		lock.unlock();
+
+		_wakeup.notify_one();
+	}
+
+/*
+=================================================
+	WaitIdle
+=================================================
+*/
+	void  VPipelineCompileQueue::WaitIdle ()
+	{
+		std::unique_lock	lock{ _guard };
+
+		_idle.wait( lock, [this] () { return _pending == 0; });
+	}
+
+/*
+=================================================
+	OnPipelineReady
+=================================================
+*/
+	void  VPipelineCompileQueue::OnPipelineReady (RawGPipelineID id) const
+	{
+		if ( _onReady )
+			_onReady( id );
+	}
+
+/*
+=================================================
+	_Loop
+=================================================
+*/
+	void  VPipelineCompileQueue::_Loop ()
+	{
+		for (;;)
+		{
+			Job_t	job;
+			{
+				std::unique_lock	lock{ _guard };
+
+				_wakeup.wait( lock, [this] () { return not _looping or not _jobs.empty(); });
+
+				if ( _jobs.empty() )
+					return;
+
+				job = std::move(_jobs.front());
+				_jobs.pop_front();
+			}
+
+			job();
+			_Complete();
+		}
+	}
+
+/*
+=================================================
+	_Complete
+=================================================
+*/
+	void  VPipelineCompileQueue::_Complete ()
+	{
+		{
+			EXLOCK( _guard );
+
+			ASSERT( _pending > 0 );
+			if ( --_pending > 0 )
+				return;
+		}
+		_idle.notify_all();
+	}
+
+
+}	// FG
@@ -0,0 +1,66 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Queue for asynchronous graphics pipeline compilation.
+	Jobs are executed on the task scheduler if it is set, otherwise on the single background thread.
+*/
+
+#pragma once
+
+#include "framegraph/Public/FrameGraph.h"
+#include "VCommon.h"
+#include <thread>
+#include <condition_variable>
+
+namespace FG
+{
+
+	//
+	// Vulkan Pipeline Compile Queue
+	//
+
+	class VPipelineCompileQueue final
+	{
+	// types
+	public:
+		using Job_t				= ITaskScheduler::Job_t;
+		using OnPipelineReady_t	= IFrameGraph::OnPipelineReady_t;
+
+
+	// variables
+	private:
+		Atomic<bool>				_enabled	{false};
+
+		Mutex						_guard;
+		std::condition_variable		_wakeup;
+		std::condition_variable		_idle;
+		Deque< Job_t >				_jobs;
+		uint						_pending	= 0;		// number of enqueued jobs that are not complete yet
+		bool						_looping	= false;
+		std::thread					_thread;				// used if task scheduler is not set
+
+		TaskScheduler				_scheduler;
+		OnPipelineReady_t			_onReady;
+
+
+	// methods
+	public:
+		VPipelineCompileQueue () {}
+		~VPipelineCompileQueue ();
+
+		bool  Initialize (const TaskScheduler &scheduler, OnPipelineReady_t &&onReady);
+		void  Deinitialize ();
+
+		void  Enqueue (Job_t &&job);
+		void  WaitIdle ();
+
+		void  OnPipelineReady (RawGPipelineID id) const;
+
+		ND_ bool  IsEnabled ()	const	{ return _enabled.load( memory_order_relaxed ); }
+
+	private:
+		void  _Loop ();
+		void  _Complete ();
+	};
+
+
+}	// FG
@@ -85,7 +85,7 @@ namespace FG
 			ASSERT( ds.bindingIndex < MaxDescSets );
 			ASSERT( res.Handle() );
 
-			setsInfo.insert({ ds.id, DescSetLayout{ sets[i].first, res.Handle(), ds.bindingIndex }});
+			setsInfo.insert({ ds.id, DescSetLayout{ sets[i].first, res.Handle(), res.GetPushLayout(), ds.bindingIndex }});
 			
 			// calculate hash
 			hash << HashOf( ds.id );
@@ -116,6 +116,9 @@ namespace FG
 /*
 =================================================
 	Create
+----
+	only one descriptor set in pipeline layout can use push descriptors,
+	the set with lowest index is selected to make choice independent of descriptor set names.
 =================================================
 */
 	bool VPipelineLayout::Create (const VDevice &dev, VkDescriptorSetLayout emptyLayout)
@@ -130,9 +133,12 @@ namespace FG
 			layout = emptyLayout;
 		}
 
-		uint	min_set = uint(vk_layouts.size());
-		uint	max_set = 0;
-		auto	ds_iter = _descriptorSets.begin();
+		uint	min_set		= uint(vk_layouts.size());
+		uint	max_set		= 0;
+		uint	push_set	= UMax;
+		auto	ds_iter		= _descriptorSets.begin();
+
+		VkDescriptorSetLayout	push_layout = VK_NULL_HANDLE;
 
 		for (size_t i = 0; ds_iter != _descriptorSets.end(); ++i, ++ds_iter)
 		{
@@ -143,8 +149,18 @@ namespace FG
 			vk_layouts[ ds.index ] = ds.layout;
 			min_set = Min( min_set, ds.index );
 			max_set = Max( max_set, ds.index );
+
+			if ( ds.pushLayout and ds.index < push_set )
+			{
+				push_set		= ds.index;
+				push_layout		= ds.pushLayout;
+				_pushDescSet	= ds_iter->first;
+			}
 		}
 
+		if ( push_set != UMax )
+			vk_layouts[ push_set ] = push_layout;
+
 		for (auto& pc : _pushConstants)
 		{
 			VkPushConstantRange	range = {};
@@ -192,6 +208,7 @@ namespace FG
 		_layout			= VK_NULL_HANDLE;
 		_hash			= Default;
 		_firstDescSet	= UMax;
+		_pushDescSet	= Default;
 	}
 	
 /*
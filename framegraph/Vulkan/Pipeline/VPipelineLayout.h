@@ -20,10 +20,12 @@ namespace FG
 		{
 			RawDescriptorSetLayoutID	layoutId;
 			VkDescriptorSetLayout		layout		= VK_NULL_HANDLE;	// TODO: remove?
+			VkDescriptorSetLayout		pushLayout	= VK_NULL_HANDLE;
 			uint						index		= 0;
 
 			DescSetLayout () {}
-			DescSetLayout (RawDescriptorSetLayoutID id, VkDescriptorSetLayout layout, uint index) : layoutId{id}, layout{layout}, index{index} {}
+			DescSetLayout (RawDescriptorSetLayoutID id, VkDescriptorSetLayout layout, VkDescriptorSetLayout pushLayout, uint index) :
+				layoutId{id}, layout{layout}, pushLayout{pushLayout}, index{index} {}
 		};
 
 		// the last index will be used for shader debugger
@@ -43,6 +45,7 @@ namespace FG
 		DescriptorSets_t		_descriptorSets;
 		PushConstants_t			_pushConstants;
 		uint					_firstDescSet	= UMax;
+		DescriptorSetID			_pushDescSet;			// descriptors are pushed into command buffer instead of binding descriptor set
 
 		DebugName_t				_debugName;
 		
@@ -74,6 +77,7 @@ namespace FG
 		ND_ uint					GetFirstDescriptorSet ()	const	{ SHAREDLOCK( _drCheck );  return _firstDescSet; }
 		ND_ DescriptorSets_t const&	GetDescriptorSets ()		const	{ SHAREDLOCK( _drCheck );  return _descriptorSets; }
 		ND_ PushConstants_t const&	GetPushConstants ()			const	{ SHAREDLOCK( _drCheck );  return _pushConstants; }
+		ND_ DescriptorSetID const&	GetPushDescriptorSet ()		const	{ SHAREDLOCK( _drCheck );  return _pushDescSet; }
 
 
 	private:
@@ -0,0 +1,434 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VPipelineManifest.h"
+#include "stl/Stream/FileStream.h"
+#include "stl/Algorithms/StringUtils.h"
+
+namespace FG
+{
+namespace
+{
+	//
+	// FNV-1a Hash
+	//
+	struct StableHash
+	{
+		uint64_t	value	= 0xcbf29ce484222325ull;
+
+		void  Add (const void *ptr, size_t size)
+		{
+			const uint8_t*	buf = static_cast<const uint8_t*>(ptr);
+			for (size_t i = 0; i < size; ++i) {
+				value = (value ^ buf[i]) * 0x100000001b3ull;
+			}
+		}
+
+		void  Add (uint64_t val)
+		{
+			uint8_t		bytes[8];
+			for (uint i = 0; i < 8; ++i) {
+				bytes[i] = uint8_t(val >> (i*8));	// independent of endianness
+			}
+			Add( bytes, sizeof(bytes) );
+		}
+
+		void  Add (StringView str)
+		{
+			Add( uint64_t(str.size()) );
+			Add( str.data(), str.size() );
+		}
+
+		void  Add (ArrayView<uint> spirv)
+		{
+			Add( uint64_t(spirv.size()) );
+			for (auto& word : spirv) {
+				Add( uint64_t(word) );
+			}
+		}
+	};
+}
+//-----------------------------------------------------------------------------
+
+
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	VPipelineManifest::~VPipelineManifest ()
+	{
+		CHECK( not IsRecording() );
+	}
+
+/*
+=================================================
+	Initialize
+----
+	loads previously recorded instances if file is exists,
+	new instances will be added to them.
+=================================================
+*/
+	bool  VPipelineManifest::Initialize (StringView filename)
+	{
+		Deinitialize();
+
+		EXLOCK( _guard );
+		CHECK_ERR( filename.size() );
+
+		_filename	= String{filename};
+		_changed	= false;
+
+		if ( not _Load() )
+		{
+			_renderPasses.clear();
+			_renderPassMap.clear();
+			_instances.clear();
+			_instanceSet.clear();
+			_instanceCount.clear();
+		}
+
+		_recording.store( true, memory_order_release );
+		return true;
+	}
+
+/*
+=================================================
+	Deinitialize
+=================================================
+*/
+	void  VPipelineManifest::Deinitialize ()
+	{
+		if ( not IsRecording() )
+			return;
+
+		if ( _changed )
+			Save();
+
+		EXLOCK( _guard );
+		_recording.store( false, memory_order_release );
+
+		_filename.clear();
+		_renderPasses.clear();
+		_renderPassMap.clear();
+		_instances.clear();
+		_instanceSet.clear();
+		_instanceCount.clear();
+	}
+
+/*
+=================================================
+	Save
+----
+	manifest is written into temporary file which then replaces the previous one.
+=================================================
+*/
+	bool  VPipelineManifest::Save ()
+	{
+		EXLOCK( _guard );
+		CHECK_ERR( _filename.size() );
+
+		FileHeader	header;
+		header.magic			= FileMagic;
+		header.version			= FileVersion;
+		header.renderPassSize	= uint(sizeof(VRenderPass::Desc));
+		header.instanceSize		= uint(sizeof(InstanceEntry));
+		header.renderPassCount	= uint(_renderPasses.size());
+		header.instanceCount	= uint(_instances.size());
+
+		const String	temp_name = _filename + ".tmp";
+		{
+			FileWStream		file{ temp_name };
+
+			if ( not (file.IsOpen() and
+					  file.Write( header ) and
+					  file.Write( _renderPasses.data(), SizeOf<VRenderPass::Desc> * _renderPasses.size() ) and
+					  file.Write( _instances.data(), SizeOf<InstanceEntry> * _instances.size() )))
+			{
+				RETURN_ERR( "can't write pipeline manifest to file '" + temp_name + "'" );
+			}
+		}
+
+	#ifdef FS_HAS_FILESYSTEM
+		std::error_code	err;
+		FS::rename( FS::path{temp_name}, FS::path{_filename}, OUT err );
+
+		if ( err )
+	#else
+		std::remove( _filename.c_str() );
+
+		if ( std::rename( temp_name.c_str(), _filename.c_str() ) != 0 )
+	#endif
+		{
+			RETURN_ERR( "can't replace pipeline manifest file '" + _filename + "'" );
+		}
+
+		_changed = false;
+
+		FG_LOGI( "pipeline manifest saved to '"s << _filename << "', instances: " << ToString( _instances.size() ));
+		return true;
+	}
+
+/*
+=================================================
+	_Load
+=================================================
+*/
+	bool  VPipelineManifest::_Load ()
+	{
+		FileRStream		file{ _filename };
+
+		if ( not file.IsOpen() )
+			return false;
+
+		FileHeader	header;
+		CHECK_ERR( file.Read( OUT header ));
+
+		if ( header.magic			!= FileMagic						or
+			 header.version			!= FileVersion						or
+			 header.renderPassSize	!= uint(sizeof(VRenderPass::Desc))	or
+			 header.instanceSize	!= uint(sizeof(InstanceEntry))		)
+		{
+			FG_LOGI( "pipeline manifest '"s << _filename << "' is not compatible, it will be replaced" );
+			return false;
+		}
+
+		CHECK_ERR( file.RemainingSize() == SizeOf<VRenderPass::Desc> * header.renderPassCount + SizeOf<InstanceEntry> * header.instanceCount );
+
+		_renderPasses.resize( header.renderPassCount );
+		CHECK_ERR( file.Read( OUT _renderPasses.data(), SizeOf<VRenderPass::Desc> * _renderPasses.size() ));
+
+		Instances_t		instances;
+		instances.resize( header.instanceCount );
+		CHECK_ERR( file.Read( OUT instances.data(), SizeOf<InstanceEntry> * instances.size() ));
+
+		for (size_t i = 0; i < _renderPasses.size(); ++i)
+		{
+			VRenderPass		rp{ _renderPasses[i] };
+			_renderPassMap.insert({ size_t(rp.GetHash()), uint(i) });
+		}
+
+		for (auto& inst : instances)
+		{
+			CHECK_ERR( inst.renderPass < _renderPasses.size() );
+			_AddInstance( inst );
+		}
+		return true;
+	}
+
+/*
+=================================================
+	Record
+=================================================
+*/
+	void  VPipelineManifest::Record (const VGraphicsPipeline &gppln, const VRenderPass &renderPass, const VGraphicsPipeline::PipelineInstance &inst)
+	{
+		if ( not IsRecording() )
+			return;
+
+		const uint64_t	ppln_hash = gppln.GetDescriptionHash();
+		if ( ppln_hash == 0 )
+			return;
+
+		VRenderPass::Desc	rp_desc;
+		if ( not renderPass.GetDesc( OUT rp_desc ))
+			return;
+
+		InstanceEntry	entry = {};
+		entry.pipelineHash	= ppln_hash;
+		entry.subpassIndex	= inst.subpassIndex;
+		entry.viewportCount	= inst.viewportCount;
+		entry.dynamicState	= uint(inst.dynamicState);
+		entry.renderState	= inst.renderState;
+
+		for (auto& vert : inst.vertexInput.Vertices())
+		{
+			auto&	dst = entry.vertices[ entry.vertexCount++ ];
+			dst.id				= uint64_t(size_t(vert.first.GetHash()));
+			dst.type			= uint(vert.second.type);
+			dst.offset			= uint(vert.second.offset);
+			dst.bufferBinding	= vert.second.bufferBinding;
+		}
+
+		for (auto& bind : inst.vertexInput.BufferBindings())
+		{
+			auto&	dst = entry.bindings[ entry.bindingCount++ ];
+			dst.id		= uint64_t(size_t(bind.first.GetHash()));
+			dst.index	= bind.second.index;
+			dst.stride	= uint(bind.second.stride);
+			dst.rate	= uint(bind.second.rate);
+		}
+
+		EXLOCK( _guard );
+
+		if ( not IsRecording() )
+			return;
+
+		auto[iter, inserted] = _renderPassMap.insert({ size_t(renderPass.GetHash()), uint(_renderPasses.size()) });
+		if ( inserted )
+			_renderPasses.push_back( rp_desc );
+
+		entry.renderPass = iter->second;
+
+		_changed |= _AddInstance( entry );
+	}
+
+/*
+=================================================
+	_AddInstance
+=================================================
+*/
+	bool  VPipelineManifest::_AddInstance (const InstanceEntry &entry)
+	{
+		if ( not _instanceSet.insert( size_t(_CalcHash( entry ))).second )
+			return false;
+
+		_instances.push_back( entry );
+		++_instanceCount[ entry.pipelineHash ];
+		return true;
+	}
+
+/*
+=================================================
+	_CalcHash
+=================================================
+*/
+	HashVal  VPipelineManifest::_CalcHash (const InstanceEntry &entry)
+	{
+		return	HashOf( entry.pipelineHash )	+ HashOf( entry.renderPass )	+
+				HashOf( entry.subpassIndex )	+ HashOf( entry.viewportCount )	+
+				HashOf( entry.dynamicState )	+ HashOf( entry.renderState )	+
+				HashOf( entry.vertices, sizeof(entry.vertices[0]) * entry.vertexCount ) +
+				HashOf( entry.bindings, sizeof(entry.bindings[0]) * entry.bindingCount );
+	}
+
+/*
+=================================================
+	GetEntries
+=================================================
+*/
+	void  VPipelineManifest::GetEntries (OUT RenderPasses_t &renderPasses, OUT Instances_t &instances)
+	{
+		EXLOCK( _guard );
+
+		renderPasses	= _renderPasses;
+		instances		= _instances;
+	}
+
+/*
+=================================================
+	GetInstanceCount
+----
+	returns number of recorded instances for pipeline,
+	used to choose the size of instance map.
+=================================================
+*/
+	uint  VPipelineManifest::GetInstanceCount (uint64_t pipelineHash)
+	{
+		if ( not IsRecording() or pipelineHash == 0 )
+			return 0;
+
+		EXLOCK( _guard );
+
+		auto	iter = _instanceCount.find( pipelineHash );
+		return iter != _instanceCount.end() ? iter->second : 0;
+	}
+
+/*
+=================================================
+	Unpack
+=================================================
+*/
+	void  VPipelineManifest::Unpack (const InstanceEntry &entry, OUT VertexInputState &vertexInput)
+	{
+		vertexInput.Clear();
+
+		for (uint i = 0; i < entry.bindingCount; ++i)
+		{
+			auto&	bind = entry.bindings[i];
+			vertexInput.Bind( VertexBufferID{HashVal{size_t(bind.id)}}, Bytes<uint>{bind.stride}, bind.index, EVertexInputRate(bind.rate) );
+		}
+
+		for (uint i = 0; i < entry.vertexCount; ++i)
+		{
+			auto&			vert = entry.vertices[i];
+			VertexBufferID	buffer_id;
+
+			for (uint j = 0; j < entry.bindingCount; ++j)
+			{
+				if ( entry.bindings[j].index == vert.bufferBinding )
+					buffer_id = VertexBufferID{HashVal{size_t(entry.bindings[j].id)}};
+			}
+
+			vertexInput.Add( VertexID{HashVal{size_t(vert.id)}}, EVertexType(vert.type), BytesU{vert.offset}, buffer_id );
+		}
+	}
+
+/*
+=================================================
+	CalcPipelineHash
+----
+	hash doesn't depend on platform and must be calculated before shader compilation,
+	returns 0 if pipeline contains shader modules which can't be identified between runs.
+=================================================
+*/
+	uint64_t  VPipelineManifest::CalcPipelineHash (const GraphicsPipelineDesc &desc)
+	{
+		uint64_t	shaders_hash = 0;
+
+		// shaders and shader formats are unordered
+		for (auto& stage : desc._shaders)
+		{
+			for (auto& sh : stage.second.data)
+			{
+				StableHash	hash;
+				hash.Add( uint64_t(stage.first) );
+				hash.Add( uint64_t(sh.first) );
+
+				if ( auto* src = UnionGetIf< PipelineDescription::ShaderSourcePtr >( &sh.second ); src and *src )
+				{
+					hash.Add( (*src)->GetEntry() );
+					hash.Add( StringView{(*src)->GetData()} );
+				}
+				else
+				if ( auto* spirv = UnionGetIf< PipelineDescription::SpirvShaderPtr >( &sh.second ); spirv and *spirv )
+				{
+					hash.Add( (*spirv)->GetEntry() );
+					hash.Add( ArrayView<uint>{(*spirv)->GetData()} );
+				}
+				else
+					return 0;
+
+				for (auto& spec : stage.second.specConstants)
+				{
+					hash.Add( uint64_t(size_t(spec.first.GetHash())) );
+					hash.Add( uint64_t(spec.second) );
+				}
+				shaders_hash += hash.value;
+			}
+		}
+
+		StableHash	hash;
+		hash.Add( shaders_hash );
+		hash.Add( uint64_t(desc._supportedTopology.to_ullong()) );
+		hash.Add( uint64_t(desc._patchControlPoints) );
+		hash.Add( uint64_t(desc._earlyFragmentTests) );
+
+		for (auto& attr : desc._vertexAttribs)
+		{
+			hash.Add( uint64_t(size_t(attr.id.GetHash())) );
+			hash.Add( uint64_t(attr.index) );
+			hash.Add( uint64_t(attr.type) );
+		}
+
+		for (auto& frag : desc._fragmentOutput)
+		{
+			hash.Add( uint64_t(frag.index) );
+			hash.Add( uint64_t(frag.type) );
+		}
+
+		return hash.value ? hash.value : 1;
+	}
+
+
+}	// FG
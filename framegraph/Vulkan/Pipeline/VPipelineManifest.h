@@ -0,0 +1,126 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Pipeline manifest records all graphics pipeline instances that have been created,
+	it is saved to file and used to create the same instances at startup.
+	Pipelines are identified by stable 64-bit hash of description (shader sources, vertex attribs, topology...),
+	name is used only for diagnostics. Pipelines that are created from shader modules can't be identified and are not recorded.
+*/
+
+#pragma once
+
+#include "VRenderPass.h"
+#include "VGraphicsPipeline.h"
+
+namespace FG
+{
+
+	//
+	// Vulkan Pipeline Manifest
+	//
+
+	class VPipelineManifest final
+	{
+	// types
+	public:
+		struct VertexEntry
+		{
+			uint64_t	id;				// 'VertexID' hash
+			uint		type;			// 'EVertexType'
+			uint		offset;
+			uint		bufferBinding;
+			uint		_padding;
+		};
+
+		struct BindingEntry
+		{
+			uint64_t	id;				// 'VertexBufferID' hash
+			uint		index;
+			uint		stride;
+			uint		rate;			// 'EVertexInputRate'
+			uint		_padding;
+		};
+
+		struct InstanceEntry
+		{
+			uint64_t		pipelineHash;	// 'CalcPipelineHash()' result
+			uint			renderPass;		// index in render pass array
+			uint			subpassIndex;
+			uint			viewportCount;
+			uint			dynamicState;	// 'EPipelineDynamicState'
+			uint			vertexCount;
+			uint			bindingCount;
+			VertexEntry		vertices [FG_MaxVertexAttribs];
+			BindingEntry	bindings [FG_MaxVertexBuffers];
+			RenderState		renderState;	// validated render state
+		};
+
+		using RenderPasses_t	= Array< VRenderPass::Desc >;
+		using Instances_t		= Array< InstanceEntry >;
+
+	private:
+		struct FileHeader
+		{
+			uint		magic;
+			uint		version;
+			uint		renderPassSize;		// size of 'VRenderPass::Desc'
+			uint		instanceSize;		// size of 'InstanceEntry'
+			uint		renderPassCount;
+			uint		instanceCount;
+		};
+
+		static constexpr uint	FileMagic	= 0x4D504746;	// 'FGPM'
+		static constexpr uint	FileVersion	= 2;
+
+		STATIC_ASSERT( std::is_trivially_copyable_v< RenderState >);
+		STATIC_ASSERT( std::is_trivially_copyable_v< VRenderPass::Desc >);
+
+		using RenderPassMap_t	= HashMap< size_t, uint >;
+		using InstanceSet_t		= HashSet< size_t >;
+		using InstanceCount_t	= HashMap< uint64_t, uint >;
+
+
+	// variables
+	private:
+		Mutex				_guard;
+		Atomic<bool>		_recording		{false};
+		bool				_changed		= false;
+		String				_filename;
+
+		RenderPasses_t		_renderPasses;
+		RenderPassMap_t		_renderPassMap;		// render pass hash to index
+		Instances_t			_instances;
+		InstanceSet_t		_instanceSet;		// instance entry hashes
+		InstanceCount_t		_instanceCount;		// pipeline hash to number of instances
+
+
+	// methods
+	public:
+		VPipelineManifest () {}
+		~VPipelineManifest ();
+
+		bool  Initialize (StringView filename);
+		void  Deinitialize ();
+
+		bool  Save ();
+
+		void  Record (const VGraphicsPipeline &gppln, const VRenderPass &renderPass, const VGraphicsPipeline::PipelineInstance &inst);
+
+		void  GetEntries (OUT RenderPasses_t &renderPasses, OUT Instances_t &instances);
+
+		ND_ uint  GetInstanceCount (uint64_t pipelineHash);
+
+		ND_ bool  IsRecording ()	const	{ return _recording.load( memory_order_relaxed ); }
+
+		static void  Unpack (const InstanceEntry &entry, OUT VertexInputState &vertexInput);
+
+		ND_ static uint64_t  CalcPipelineHash (const GraphicsPipelineDesc &desc);
+
+	private:
+		bool  _Load ();
+		bool  _AddInstance (const InstanceEntry &entry);
+
+		ND_ static HashVal  _CalcHash (const InstanceEntry &entry);
+	};
+
+
+}	// FG
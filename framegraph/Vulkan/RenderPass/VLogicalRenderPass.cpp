@@ -51,6 +51,16 @@ namespace {
 		_multisampleState	= desc.multisampleState;
 
 		_area				= desc.area;
+		
+		_fragmentOutput.depthWrite			= _depthState.write;
+		_fragmentOutput.rasterizerDiscard	= _rasterizationState.rasterizerDiscard;
+		_fragmentOutput.stencilWrite		= not _stencilState.enabled ? false :
+											  (_stencilState.front.failOp		!= EStencilOp::Keep) |
+											  (_stencilState.front.depthFailOp	!= EStencilOp::Keep) |
+											  (_stencilState.front.passOp		!= EStencilOp::Keep) |
+											  (_stencilState.back.failOp		!= EStencilOp::Keep) |
+											  (_stencilState.back.depthFailOp	!= EStencilOp::Keep) |
+											  (_stencilState.back.passOp		!= EStencilOp::Keep);
 		//_parallelExecution= desc.parallelExecution;
 		//_canBeMerged		= desc.canBeMerged;
 		//_useSecondaryCmdbuf	= desc.useSecondaryCmdbuf;
@@ -352,5 +362,27 @@ namespace {
 			draw->debugModeIndex = id;
 		}
 	}
+	
+/*
+=================================================
+	_MergePipeline
+=================================================
+*/
+	void VLogicalRenderPass::_MergePipeline (const _fg_hidden_::DynamicStates &ds, bool earlyFragmentTests)
+	{
+		if ( earlyFragmentTests )
+			_fragmentOutput.earlyFragmentTests = true;
+		else
+			_fragmentOutput.lateFragmentTests = true;
+
+		_fragmentOutput.depthWrite |= (ds.hasDepthWrite & ds.depthWrite);
+
+		_fragmentOutput.stencilWrite |= not (ds.hasStencilTest | _stencilState.enabled) ? false :
+										bool(ds.hasStencilFailOp      & (ds.stencilFailOp      != EStencilOp::Keep)) |
+										bool(ds.hasStencilDepthFailOp & (ds.stencilDepthFailOp != EStencilOp::Keep)) |
+										bool(ds.hasStencilPassOp      & (ds.stencilPassOp      != EStencilOp::Keep));
+
+		_fragmentOutput.rasterizerDiscard &= not _rasterizationState.rasterizerDiscard;
+	}
 
 }	// FG
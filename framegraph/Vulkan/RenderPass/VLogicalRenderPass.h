@@ -41,6 +41,15 @@ namespace FG
 			ND_ bool IsDefined () const		{ return imageId.IsValid(); }
 		};
 		
+		struct FragmentOutput
+		{
+			bool	earlyFragmentTests	= false;
+			bool	lateFragmentTests	= false;
+			bool	depthWrite			= false;
+			bool	stencilWrite		= false;
+			bool	rasterizerDiscard	= false;
+		};
+		
 		using VkClearValues_t			= StaticArray< VkClearValue, FG_MaxColorBuffers+1 >;
 		using ColorTargets_t			= FixedArray< ColorTarget, FG_MaxColorBuffers >;
 		using Viewports_t				= FixedArray< VkViewport, FG_MaxViewports >;
@@ -82,6 +91,7 @@ namespace FG
 		RS::MultisampleState		_multisampleState;
 
 		RectI						_area;
+		FragmentOutput				_fragmentOutput;		// merged from all draw tasks
 		//bool						_parallelExecution		= true;
 		//bool						_canBeMerged			= true;
 		//bool						_useSecondaryCmdbuf		= false;
@@ -124,6 +134,7 @@ namespace FG
 
 		void _SetRenderPass (RawRenderPassID rp, uint subpass, RawFramebufferID fb, uint depthIndex);
 		void _SetShaderDebugIndex (ShaderDbgIndex id);
+		void _MergePipeline (const _fg_hidden_::DynamicStates &, bool earlyFragmentTests);
 		
 		bool GetShadingRateImage (OUT VLocalImage const* &, OUT ImageViewDesc &) const;
 
@@ -134,6 +145,7 @@ namespace FG
 		ND_ ArrayView< VkClearValue >			GetClearValues ()			const	{ return _clearValues; }
 		
 		ND_ RectI const&						GetArea ()					const	{ return _area; }
+		ND_ FragmentOutput const&				GetFragmentOutput ()		const	{ return _fragmentOutput; }
 
 		ND_ bool								IsSubmited ()				const	{ return _isSubmited; }
 		
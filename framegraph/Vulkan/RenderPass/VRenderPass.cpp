@@ -94,8 +94,53 @@ namespace FG
 
 		_attachments.resize( max_index );
 
+		_SetupCreateInfo();
+		return true;
+	}
+	
+/*
+=================================================
+	constructor
+=================================================
+*/
+	VRenderPass::VRenderPass (const Desc &desc)
+	{
+		_Initialize( desc );
+	}
+	
+	bool VRenderPass::_Initialize (const Desc &desc)
+	{
+		EXLOCK( _drCheck );
+		CHECK_ERR( desc.attachmentCount <= maxAttachments and desc.colorCount <= maxColorAttachments );
+
+		_attachments.assign( desc.attachments, desc.attachments + desc.attachmentCount );
+		
+		_subpasses.resize( 1 );
+		VkSubpassDescription&	subpass	= _subpasses[0];
+
+		subpass.pipelineBindPoint		= VK_PIPELINE_BIND_POINT_GRAPHICS;
+		subpass.pColorAttachments		= desc.colorCount ? _attachmentRef.end() : null;
+		subpass.colorAttachmentCount	= desc.colorCount;
+
+		_attachmentRef.assign( desc.colorRefs, desc.colorRefs + desc.colorCount );
+
+		if ( desc.depthStencilRef.attachment != VK_ATTACHMENT_UNUSED )
+		{
+			subpass.pDepthStencilAttachment	= _attachmentRef.end();
+			_attachmentRef.push_back( desc.depthStencilRef );
+		}
+
+		_SetupCreateInfo();
+		return true;
+	}
 
-		// setup create info
+/*
+=================================================
+	_SetupCreateInfo
+=================================================
+*/
+	void VRenderPass::_SetupCreateInfo ()
+	{
 		_createInfo					= {};
 		_createInfo.sType			= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
 		_createInfo.flags			= 0;
@@ -104,8 +149,41 @@ namespace FG
 		_createInfo.subpassCount	= uint(_subpasses.size());
 		_createInfo.pSubpasses		= _subpasses.data();
 
-
 		_CalcHash( _createInfo, OUT _hash, OUT _attachmentHash, OUT _subpassesHash );
+	}
+
+/*
+=================================================
+	GetDesc
+----
+	returns false if render pass can't be serialized
+=================================================
+*/
+	bool VRenderPass::GetDesc (OUT Desc &desc) const
+	{
+		SHAREDLOCK( _drCheck );
+
+		std::memset( OUT &desc, 0, sizeof(desc) );
+		desc.depthStencilRef.attachment = VK_ATTACHMENT_UNUSED;
+
+		if ( _subpasses.size() != 1 or _dependencies.size() )
+			return false;
+
+		auto&	subpass = _subpasses[0];
+
+		if ( subpass.inputAttachmentCount or subpass.pResolveAttachments or subpass.preserveAttachmentCount or
+			 subpass.colorAttachmentCount > maxColorAttachments )
+			return false;
+
+		desc.attachmentCount	= uint(_attachments.size());
+		desc.colorCount			= subpass.colorAttachmentCount;
+
+		std::memcpy( OUT desc.attachments, _attachments.data(), sizeof(desc.attachments[0]) * desc.attachmentCount );
+		std::memcpy( OUT desc.colorRefs, subpass.pColorAttachments, sizeof(desc.colorRefs[0]) * desc.colorCount );
+
+		if ( subpass.pDepthStencilAttachment )
+			desc.depthStencilRef = *subpass.pDepthStencilAttachment;
+
 		return true;
 	}
 
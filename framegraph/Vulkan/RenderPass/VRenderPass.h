@@ -29,6 +29,17 @@ namespace FG
 		using Preserves_t			= FixedArray< uint, maxColorAttachments * maxSubpasses >;
 		using SubpassesHash_t		= FixedArray< HashVal, maxSubpasses >;
 
+	public:
+		// serializable description of render pass with single subpass
+		struct Desc
+		{
+			uint						attachmentCount;
+			uint						colorCount;
+			VkAttachmentDescription		attachments [maxAttachments];
+			VkAttachmentReference		colorRefs [maxColorAttachments];
+			VkAttachmentReference		depthStencilRef;	// 'attachment' is 'VK_ATTACHMENT_UNUSED' if not defined
+		};
+
 
 	// variables
 	private:
@@ -58,6 +69,7 @@ namespace FG
 		VRenderPass (VRenderPass &&) = delete;
 		VRenderPass (const VRenderPass &) = delete;
 		explicit VRenderPass (ArrayView<VLogicalRenderPass*> logicalPasses);
+		explicit VRenderPass (const Desc &desc);
 		~VRenderPass ();
 
 		bool Create (const VDevice &dev, StringView dbgName);
@@ -69,9 +81,13 @@ namespace FG
 		ND_ VkRenderPassCreateInfo const&	GetCreateInfo ()	const	{ SHAREDLOCK( _drCheck );  return _createInfo; }
 		ND_ HashVal							GetHash ()			const	{ SHAREDLOCK( _drCheck );  return _hash; }
 
+		bool GetDesc (OUT Desc &desc) const;
+
 
 	private:
 		bool _Initialize (ArrayView<VLogicalRenderPass*> logicalPasses);
+		bool _Initialize (const Desc &desc);
+		void _SetupCreateInfo ();
 
 		static void  _CalcHash (const VkRenderPassCreateInfo &ci, OUT HashVal &hash, OUT HashVal &attachmentHash,
 								OUT SubpassesHash_t &subpassesHash);
@@ -15,6 +15,7 @@ namespace FG
 		Dedicated		= uint(EMemoryType::Dedicated),
 		//AllowAliasing	= uint(EMemoryType::AllowAliasing),
 		//Sparse		= uint(EMemoryType::Sparse),
+		LazilyAllocated	= uint(EMemoryType::LazilyAllocated),
 		_Offset			= uint(EMemoryType::_Last)-1,
 
 		LocalInGPU		= _Offset << 1,
@@ -92,6 +92,7 @@ namespace FG
 	class VShaderDebugger;
 	class VPipelineResources;
 	class VCommandBuffer;
+	class VCmdBatch;
 	class VSwapchain;
 	class VSubmitted;
 	class VLocalDebugger;
@@ -115,4 +116,13 @@ namespace FG
 		mutable FixedArray< uint, FG_MaxBufferDynamicOffsets >		dynamicOffsets;
 	};
 
+
+	struct VBoundDescriptorSets
+	{
+		VkDescriptorSets_t			sets;						// starts from first descriptor set in pipeline layout
+		VPipelineResources const*	pushDescriptors	= null;		// pushed instead of binding descriptor set at 'pushIndex'
+		uint						pushIndex		= UMax;
+		uint						pushOffsetIndex	= UMax;		// dynamic offsets before this index are used for sets before 'pushIndex'
+	};
+
 }	// FG
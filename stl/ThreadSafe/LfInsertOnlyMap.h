@@ -0,0 +1,227 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Hash map with lock-free search and insertion.
+	Elements can't be removed while map is used by other threads, so nodes are never freed
+	during search and readers don't need any synchronization except acquire load of the bucket head.
+	Bucket count is chosen from expected number of elements and doesn't change while map is used by other threads,
+	use 'Reserve' to grow it when element count is known before the map is shared.
+*/
+
+#pragma once
+
+#include "stl/Common.h"
+#include "stl/Math/BitMath.h"
+#include <atomic>
+
+namespace FGC
+{
+
+	//
+	// Lock-free Insert Only Hash Map
+	//
+
+	template <typename KeyType,
+			  typename ValueType,
+			  typename Hasher = std::hash<KeyType>,
+			  typename KeyEq = std::equal_to<KeyType>
+			 >
+	struct LfInsertOnlyMap final
+	{
+	// types
+	public:
+		using Self		= LfInsertOnlyMap< KeyType, ValueType, Hasher, KeyEq >;
+		using Key_t		= KeyType;
+		using Value_t	= ValueType;
+
+		struct Node
+		{
+			Key_t			key;
+			Value_t			value;
+			size_t			hash;
+			Node *			next;
+		};
+
+		static constexpr size_t		DefaultCount	= 64;
+
+	private:
+		using Bucket_t	= Atomic<Node *>;
+		using Buckets_t	= UniquePtr< Bucket_t[] >;
+
+		STATIC_ASSERT( Bucket_t::is_always_lock_free );
+
+		static constexpr size_t		MinBucketCount	= 4;
+
+
+	// variables
+	private:
+		Buckets_t		_buckets;
+		size_t			_bucketMask		= 0;	// bucket count - 1
+		Atomic<size_t>	_count;
+
+
+	// methods
+	public:
+		explicit LfInsertOnlyMap (size_t expectedCount = DefaultCount)
+		{
+			_Allocate( expectedCount );
+			_count.store( 0, memory_order_relaxed );
+
+			// flush cache
+			std::atomic_thread_fence( memory_order_release );
+		}
+
+		LfInsertOnlyMap (const Self &) = delete;
+		LfInsertOnlyMap (Self &&) = delete;
+
+		~LfInsertOnlyMap ()
+		{
+			Clear();
+		}
+
+		Self& operator = (const Self &) = delete;
+		Self& operator = (Self &&) = delete;
+
+
+		// lock-free, returns null if not found
+		ND_ Node const*  Find (const Key_t &key) const
+		{
+			return Find( key, Hasher{}( key ));
+		}
+
+		ND_ Node const*  Find (const Key_t &key, size_t hash) const
+		{
+			for (Node* node = _buckets[ hash & _bucketMask ].load( memory_order_acquire ); node; node = node->next)
+			{
+				if ( node->hash == hash and KeyEq{}( node->key, key ))
+					return node;
+			}
+			return null;
+		}
+
+
+		// lock-free, returns existing node and 'false' if key is already inserted
+		Pair< Node const*, bool >  Insert (const Key_t &key, const Value_t &value)
+		{
+			const size_t	hash	= Hasher{}( key );
+			auto&			head	= _buckets[ hash & _bucketMask ];
+			Node*			first	= head.load( memory_order_acquire );
+			Node*			checked	= null;
+			Node*			result	= null;
+
+			for (;;)
+			{
+				// search in nodes that were added after previous attempt
+				for (Node* node = first; node != checked; node = node->next)
+				{
+					if ( node->hash == hash and KeyEq{}( node->key, key ))
+					{
+						delete result;
+						return { node, false };
+					}
+				}
+
+				if ( not result )
+					result = new Node{ key, value, hash, null };
+
+				checked		 = first;
+				result->next = first;
+
+				if ( head.compare_exchange_weak( INOUT first, result, memory_order_release, memory_order_acquire ))
+				{
+					_count.fetch_add( 1, memory_order_relaxed );
+					return { result, true };
+				}
+			}
+		}
+
+
+		// not thread safe
+		template <typename FN>
+		void  Clear (FN &&fn)
+		{
+			// invalidate cache
+			std::atomic_thread_fence( memory_order_acquire );
+
+			for (size_t i = 0; i <= _bucketMask; ++i)
+			{
+				for (Node* node = _buckets[i].exchange( null, memory_order_relaxed ); node;)
+				{
+					Node*	next = node->next;
+					fn( node->key, node->value );
+					delete node;
+					node = next;
+				}
+			}
+			_count.store( 0, memory_order_relaxed );
+		}
+
+		void  Clear ()
+		{
+			Clear( [] (Key_t &, Value_t &) {} );
+		}
+
+
+
+		// not thread safe, existing nodes are moved to the new buckets
+		void  Reserve (size_t expectedCount)
+		{
+			if ( _BucketCount( expectedCount ) <= BucketCount() )
+				return;
+
+			// invalidate cache
+			std::atomic_thread_fence( memory_order_acquire );
+
+			Buckets_t		old_buckets	= std::move(_buckets);
+			const size_t	old_count	= BucketCount();
+
+			_Allocate( expectedCount );
+
+			for (size_t i = 0; i < old_count; ++i)
+			{
+				for (Node* node = old_buckets[i].load( memory_order_relaxed ); node;)
+				{
+					Node*	next = node->next;
+					auto&	head = _buckets[ node->hash & _bucketMask ];
+
+					node->next = head.load( memory_order_relaxed );
+					head.store( node, memory_order_relaxed );
+					node = next;
+				}
+			}
+
+			// flush cache
+			std::atomic_thread_fence( memory_order_release );
+		}
+
+
+		ND_ size_t	size ()			const	{ return _count.load( memory_order_relaxed ); }
+		ND_ bool	empty ()		const	{ return size() == 0; }
+		ND_ size_t	BucketCount ()	const	{ return _bucketMask + 1; }
+
+
+	private:
+		ND_ static size_t  _BucketCount (size_t expectedCount)
+		{
+			// one element per bucket on average
+			size_t	count = MinBucketCount;
+			while ( count < expectedCount ) {
+				count <<= 1;
+			}
+			return count;
+		}
+
+		void  _Allocate (size_t expectedCount)
+		{
+			const size_t	count = _BucketCount( expectedCount );
+
+			_buckets.reset( new Bucket_t[count] );
+			_bucketMask = count - 1;
+
+			for (size_t i = 0; i < count; ++i) {
+				_buckets[i].store( null, memory_order_relaxed );
+			}
+		}
+	};
+
+
+}	// FGC
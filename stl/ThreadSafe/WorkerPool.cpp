@@ -0,0 +1,135 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/WorkerPool.h"
+#include "stl/Platforms/ThreadName.h"
+#include "stl/Algorithms/StringUtils.h"
+
+namespace FGC
+{
+
+/*
+=================================================
+	constructor
+=================================================
+*/
+	WorkerPool::WorkerPool (uint numThreads)
+	{
+		if ( numThreads == UMax )
+			numThreads = Max( 1u, std::thread::hardware_concurrency() );
+
+		// calling thread is used as worker too
+		const uint	count = numThreads > 0 ? numThreads-1 : 0;
+
+		_threads.reserve( count );
+
+		for (uint i = 0; i < count; ++i)
+		{
+			_threads.emplace_back( [this, i] () { _Loop( i+1 ); });
+		}
+	}
+
+/*
+=================================================
+	destructor
+=================================================
+*/
+	WorkerPool::~WorkerPool ()
+	{
+		{
+			std::unique_lock<Mutex>	lock{ _guard };
+			_looping = false;
+		}
+		_wakeup.notify_all();
+
+		for (auto& t : _threads) {
+			t.join();
+		}
+	}
+
+/*
+=================================================
+	_Run
+=================================================
+*/
+	void  WorkerPool::_Run (Batch &batch)
+	{
+		if ( batch.count == 0 )
+			return;
+
+		std::unique_lock<Mutex>	caller_lock{ _callerGuard, std::try_to_lock };
+
+		// pool is busy or there is nothing to parallelize
+		if ( not caller_lock.owns_lock() or _threads.empty() or batch.count == 1 )
+		{
+			_ExecuteJobs( batch, 0 );
+			return;
+		}
+
+		{
+			std::unique_lock<Mutex>	lock{ _guard };
+			_batch = &batch;
+			++_batchId;
+		}
+		_wakeup.notify_all();
+
+		_ExecuteJobs( batch, 0 );
+
+		// all jobs are acquired, wait for background threads
+		std::unique_lock<Mutex>	lock{ _guard };
+		_batch = null;
+		_finished.wait( lock, [this] () { return _active == 0; });
+	}
+
+/*
+=================================================
+	_Loop
+=================================================
+*/
+	void  WorkerPool::_Loop (uint workerIndex)
+	{
+		SetCurrentThreadName( "WorkerPool_"s << ToString( workerIndex ));
+
+		uint	last_batch = 0;
+
+		for (;;)
+		{
+			Batch*	batch = null;
+			{
+				std::unique_lock<Mutex>	lock{ _guard };
+				_wakeup.wait( lock, [this, last_batch] () { return not _looping or (_batch != null and _batchId != last_batch); });
+
+				if ( not _looping )
+					return;
+
+				batch		= _batch;
+				last_batch	= _batchId;
+				++_active;
+			}
+
+			_ExecuteJobs( *batch, workerIndex );
+
+			{
+				std::unique_lock<Mutex>	lock{ _guard };
+				if ( --_active == 0 )
+					_finished.notify_one();
+			}
+		}
+	}
+
+/*
+=================================================
+	_ExecuteJobs
+=================================================
+*/
+	void  WorkerPool::_ExecuteJobs (Batch &batch, uint workerIndex)
+	{
+		for (uint i = batch.next.fetch_add( 1, memory_order_relaxed );
+			 i < batch.count;
+			 i = batch.next.fetch_add( 1, memory_order_relaxed ))
+		{
+			batch.fn( batch.data, i, workerIndex );
+		}
+	}
+
+
+}	// FGC
@@ -0,0 +1,96 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Small fork-join thread pool.
+	The calling thread takes part in execution as worker with index 0,
+	background threads have indices 1..ThreadCount()-1.
+	If pool is already used by another thread then all jobs will be executed on the calling thread.
+*/
+
+#pragma once
+
+#include "stl/Common.h"
+#include <thread>
+#include <condition_variable>
+
+namespace FGC
+{
+
+	//
+	// Worker Pool
+	//
+
+	class WorkerPool final
+	{
+	// types
+	private:
+		using JobFn_t = void (*) (void *data, uint jobIndex, uint workerIndex);
+
+		struct Batch
+		{
+			JobFn_t			fn		= null;
+			void *			data	= null;
+			uint			count	= 0;
+			Atomic<uint>	next	{0};
+		};
+
+
+	// variables
+	private:
+		Array< std::thread >		_threads;
+
+		Mutex						_callerGuard;		// only one batch can be executed at a time
+		Mutex						_guard;
+		std::condition_variable		_wakeup;
+		std::condition_variable		_finished;
+		Batch *						_batch		= null;
+		uint						_batchId	= 0;
+		uint						_active		= 0;	// number of background threads that are executing current batch
+		bool						_looping	= true;
+
+
+	// methods
+	public:
+		explicit WorkerPool (uint numThreads = UMax);
+		~WorkerPool ();
+
+		WorkerPool (WorkerPool &&) = delete;
+		WorkerPool (const WorkerPool &) = delete;
+
+		WorkerPool& operator = (WorkerPool &&) = delete;
+		WorkerPool& operator = (const WorkerPool &) = delete;
+
+		// returns number of workers including the calling thread
+		ND_ uint  ThreadCount () const	{ return uint(_threads.size()) + 1; }
+
+		// calls 'fn(jobIndex, workerIndex)' for each job in range [0, count) and waits until all jobs are complete
+		template <typename Fn>
+		void  ParallelFor (uint count, Fn &&fn);
+
+	private:
+		void  _Run (Batch &);
+		void  _Loop (uint workerIndex);
+
+		static void  _ExecuteJobs (Batch &, uint workerIndex);
+	};
+
+
+/*
+=================================================
+	ParallelFor
+=================================================
+*/
+	template <typename Fn>
+	inline void  WorkerPool::ParallelFor (uint count, Fn &&fn)
+	{
+		using Fn_t = std::remove_reference_t< Fn >;
+
+		Batch	batch;
+		batch.fn	= [] (void *data, uint jobIndex, uint workerIndex) { (*static_cast<Fn_t *>(data))( jobIndex, workerIndex ); };
+		batch.data	= const_cast<void *>(static_cast<const void *>( &fn ));
+		batch.count	= count;
+
+		_Run( batch );
+	}
+
+
+}	// FGC
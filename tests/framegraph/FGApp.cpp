@@ -32,6 +32,7 @@ namespace {
 	FGApp::FGApp ()
 	{
 		_tests.push_back({ &FGApp::Test_CopyBuffer1,	1 });
+		_tests.push_back({ &FGApp::Test_CopyBuffer2,	1 });
 		_tests.push_back({ &FGApp::Test_CopyImage1,		1 });
 		_tests.push_back({ &FGApp::Test_CopyImage2,		1 });
 		_tests.push_back({ &FGApp::Test_CopyImage3,		1 });
@@ -62,6 +63,19 @@ namespace {
 		_tests.push_back({ &FGApp::ImplTest_Multithreading2, 1 });
 		_tests.push_back({ &FGApp::ImplTest_Multithreading3, 1 });
 		_tests.push_back({ &FGApp::ImplTest_Multithreading4, 1 });
+		_tests.push_back({ &FGApp::ImplTest_DrawPerf1,		 1 });
+		_tests.push_back({ &FGApp::ImplTest_ParallelRecording1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_TaskScheduler1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_BarrierPlanning1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_PipelineCache1,	 1 });
+		_tests.push_back({ &FGApp::ImplTest_AsyncPipeline1,	 1 });
+		_tests.push_back({ &FGApp::ImplTest_PipelineManifest1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_TransientDescriptors1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_PushDescriptors1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_ResourcePool1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_RetainedMemory1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_TransientImages1, 1 });
+		_tests.push_back({ &FGApp::ImplTest_TransientImages2, 1 });
 		
 		// RTX only
 		_tests.push_back({ &FGApp::Test_DrawMeshes1,		1 });
@@ -70,6 +84,9 @@ namespace {
 		_tests.push_back({ &FGApp::Test_TraceRays3,			1 });
 		_tests.push_back({ &FGApp::Test_ShadingRate1,		1 });
 		_tests.push_back({ &FGApp::Test_RayTracingDebugger1, 1 });
+
+		// must be last, bindless resources can't be disabled
+		_tests.push_back({ &FGApp::ImplTest_Bindless1,		 1 });
 		
 		// very slow
 		//_tests.push_back({ &FGApp::ImplTest_CacheOverflow1,	1 });
@@ -187,6 +204,7 @@ namespace {
 
 		// initialize framegraph
 		{
+			_deviceInfo = vulkan_info;
 			_frameGraph = IFrameGraph::CreateFrameGraph( vulkan_info );
 			CHECK_ERR( _frameGraph );
 
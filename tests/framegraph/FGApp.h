@@ -28,6 +28,7 @@ namespace FG
 	private:
 		#ifdef FG_ENABLE_VULKAN
 		VulkanDeviceInitializer	_vulkan;
+		VulkanDeviceInfo		_deviceInfo;		// used to create additional frame graph instances
 		#endif
 
 		WindowPtr				_window;
@@ -89,11 +90,26 @@ namespace FG
 		bool ImplTest_Multithreading2 ();
 		bool ImplTest_Multithreading3 ();
 		bool ImplTest_Multithreading4 ();
+		bool ImplTest_DrawPerf1 ();			// single pass vs two pass draw tasks processing
+		bool ImplTest_ParallelRecording1 ();
+		bool ImplTest_TaskScheduler1 ();
+		bool ImplTest_BarrierPlanning1 ();	// planned vs per-task barriers for transfer tasks
+		bool ImplTest_PipelineCache1 ();
+		bool ImplTest_AsyncPipeline1 ();
+		bool ImplTest_PipelineManifest1 ();
+		bool ImplTest_TransientDescriptors1 ();
+		bool ImplTest_PushDescriptors1 ();
+		bool ImplTest_ResourcePool1 ();
+		bool ImplTest_RetainedMemory1 ();
+		bool ImplTest_TransientImages1 ();
+		bool ImplTest_TransientImages2 ();
+		bool ImplTest_Bindless1 ();
 
 
 	// drawing tests
 	private:
 		bool Test_CopyBuffer1 ();
+		bool Test_CopyBuffer2 ();			// split barriers
 		bool Test_CopyImage1 ();
 		bool Test_CopyImage2 ();
 		bool Test_CopyImage3 ();
@@ -0,0 +1,141 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Graphics pipeline is compiled in background,
+	until compilation is complete the fallback pipeline is used for drawing.
+*/
+
+#include "../FGApp.h"
+#include <thread>
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_AsyncPipeline1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+		GraphicsPipelineDesc	fallback_ppln;
+
+		const char	vs_source[] = R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(0.0, -0.5),
+	vec2(0.5, 0.5),
+	vec2(-0.5, 0.5)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#";
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", vs_source );
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4(1.0, 0.0, 0.0, 1.0);
+}
+)#" );
+
+		fallback_ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", vs_source );
+		fallback_ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4(0.0, 0.0, 1.0, 1.0);
+}
+)#" );
+
+		const uint2		view_size	= {256, 256};
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																		.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+															    Default, "RenderTarget" );
+
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		GPipelineID		fallback	= _frameGraph->CreatePipeline( fallback_ppln );
+		CHECK_ERR( image and pipeline and fallback );
+
+		Atomic<uint>	ready_count {0};
+		CHECK_ERR( _frameGraph->SetAsyncPipelineCompilation( true, [&ready_count] (RawGPipelineID) { ready_count.fetch_add( 1 ); }));
+
+		const auto	Draw = [&] (const RGBA32f &expectedColor, OUT IFrameGraph::Statistics &stat) -> bool
+		{
+			bool	data_is_correct = false;
+
+			const auto	OnLoaded = [&data_is_correct, &expectedColor] (const ImageView &imageData)
+			{
+				RGBA32f		col;
+				imageData.Load( uint3(imageData.Dimension().x / 2, imageData.Dimension().y / 2, 0), OUT col );
+
+				data_is_correct = All(Equals( col, expectedColor, 0.1f ));
+				ASSERT( data_is_correct );
+			};
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ));
+
+			cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetFallbackPipeline( fallback ).SetTopology( EPrimitive::TriangleList ));
+
+			Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+			Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw ));
+			Unused( t_read );
+
+			// reset statistics
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( data_is_correct );
+			return true;
+		};
+
+		IFrameGraph::Statistics		stat;
+
+		// pipeline is not compiled yet, fallback pipeline is used
+		CHECK_ERR( Draw( RGBA32f{0.0f, 0.0f, 1.0f, 1.0f}, OUT stat ));
+		CHECK_ERR( stat.resources.asyncGraphicsPipelineCount == 1 );
+		CHECK_ERR( stat.renderer.fallbackDrawCalls == 1 );
+
+		// wait for compilation
+		for (uint i = 0; i < 1000 and ready_count.load() == 0; ++i) {
+			std::this_thread::sleep_for( std::chrono::milliseconds(1) );
+		}
+		CHECK_ERR( ready_count.load() == 1 );
+
+		CHECK_ERR( Draw( RGBA32f{1.0f, 0.0f, 0.0f, 1.0f}, OUT stat ));
+		CHECK_ERR( stat.resources.asyncGraphicsPipelineCount == 0 );
+		CHECK_ERR( stat.renderer.fallbackDrawCalls == 0 );
+		CHECK_ERR( stat.renderer.skippedDrawCalls == 0 );
+
+		CHECK_ERR( _frameGraph->SetAsyncPipelineCompilation( false ));
+
+		DeleteResources( image, pipeline, fallback );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
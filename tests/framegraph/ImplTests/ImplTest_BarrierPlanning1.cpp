@@ -0,0 +1,100 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Compares number of pipeline barriers for independent transfer tasks:
+	 - barriers are committed for each task,
+	 - barriers are planned for group of tasks that have no common resources.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+	static constexpr uint	buffer_count	= 16;
+	static constexpr uint	buffer_size		= 256;
+
+
+	static bool BarrierPlanning_Execute (const FrameGraph &fg, const CommandBufferDesc &desc, ArrayView<BufferID> srcBuffers,
+										 ArrayView<BufferID> dstBuffers, OUT uint &pipelineBarriers)
+	{
+		uint	cb_count		= 0;
+		bool	data_is_correct	= true;
+
+		CommandBuffer	cmd = fg->Begin( desc );
+		CHECK_ERR( cmd );
+
+		for (uint i = 0; i < buffer_count; ++i)
+		{
+			Array<uint8_t>	src_data;	src_data.resize( buffer_size );
+
+			for (size_t j = 0; j < src_data.size(); ++j) {
+				src_data[j] = uint8_t(i + j);
+			}
+
+			const auto	OnLoaded = [i, &cb_count, &data_is_correct] (BufferView data)
+			{
+				++cb_count;
+				data_is_correct &= (data.size() == buffer_size);
+
+				for (size_t j = 0; j < data.size(); ++j)
+				{
+					bool	is_equal = (uint8_t(i + j) == data[j]);
+					ASSERT( is_equal );
+
+					data_is_correct &= is_equal;
+				}
+			};
+
+			Task	t_update	= cmd->AddTask( UpdateBuffer().SetBuffer( srcBuffers[i] ).AddData( src_data ));
+			Task	t_copy		= cmd->AddTask( CopyBuffer().From( srcBuffers[i] ).To( dstBuffers[i] ).AddRegion( 0_b, 0_b, BytesU{buffer_size} ).DependsOn( t_update ));
+			Task	t_read		= cmd->AddTask( ReadBuffer().SetBuffer( dstBuffers[i], 0_b, BytesU{buffer_size} ).SetCallback( OnLoaded ).DependsOn( t_copy ));
+			Unused( t_read );
+		}
+
+		// reset statistics
+		IFrameGraph::Statistics	stat;
+		CHECK_ERR( fg->GetStatistics( OUT stat ));
+
+		CHECK_ERR( fg->Execute( cmd ));
+		CHECK_ERR( fg->WaitIdle() );
+
+		CHECK_ERR( fg->GetStatistics( OUT stat ));
+		pipelineBarriers = stat.renderer.pipelineBarriers;
+
+		CHECK_ERR( cb_count == buffer_count );
+		CHECK_ERR( data_is_correct );
+		return true;
+	}
+
+
+	bool FGApp::ImplTest_BarrierPlanning1 ()
+	{
+		Array<BufferID>		src_buffers;
+		Array<BufferID>		dst_buffers;
+
+		for (uint i = 0; i < buffer_count; ++i)
+		{
+			src_buffers.push_back( _frameGraph->CreateBuffer( BufferDesc{ BytesU{buffer_size}, EBufferUsage::Transfer }, Default, "SrcBuffer" ));
+			dst_buffers.push_back( _frameGraph->CreateBuffer( BufferDesc{ BytesU{buffer_size}, EBufferUsage::Transfer }, Default, "DstBuffer" ));
+			CHECK_ERR( src_buffers.back() and dst_buffers.back() );
+		}
+
+		uint	default_barriers	= 0;
+		uint	planned_barriers	= 0;
+
+		CHECK_ERR( BarrierPlanning_Execute( _frameGraph, CommandBufferDesc{}, src_buffers, dst_buffers, OUT default_barriers ));
+		CHECK_ERR( BarrierPlanning_Execute( _frameGraph, CommandBufferDesc{}.SetBarrierPlanning(), src_buffers, dst_buffers, OUT planned_barriers ));
+
+		FG_LOGI( "Transfer tasks: "s << ToString( buffer_count * 3 )
+				<< ", pipeline barriers: " << ToString( default_barriers )
+				<< ", with planning: " << ToString( planned_barriers ));
+
+		CHECK_ERR( planned_barriers < default_barriers );
+
+		for (auto& buf : src_buffers) { DeleteResources( buf ); }
+		for (auto& buf : dst_buffers) { DeleteResources( buf ); }
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,217 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Textures and sampler are accessed through the global bindless descriptor set,
+	indices are passed in push constants.
+	Texture that is created before bindless resources are enabled must be visible too,
+	texture that is released while command buffer is recorded must keep its index until command buffer is complete.
+	Descriptors are written with default image layout: render target is sampled in 'ShaderSample' default state,
+	storage image is used in general layout, render target without default state has no bindless index.
+	Bindless resources can't be disabled, so this test must be the last one that uses pipelines.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_Bindless1 ()
+	{
+		if ( not _pplnCompiler or not _frameGraph->GetDeviceProperties().bindlessResources )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		const uint2		tex_dim		= { 16, 16 };
+		const BytesU	buf_size	= SizeOf<float4> * 6;
+		const auto		tex_desc	= ImageDesc{}.SetDimension( tex_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+												.SetUsage( EImageUsage::Sampled | EImageUsage::TransferDst );
+		const auto		rt_desc		= ImageDesc{}.SetDimension( tex_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+												.SetUsage( EImageUsage::ColorAttachment | EImageUsage::Sampled | EImageUsage::TransferDst );
+		const auto		storage_desc= ImageDesc{}.SetDimension( tex_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+												.SetUsage( EImageUsage::Storage | EImageUsage::TransferDst );
+		ImageID			textures[4];
+
+		textures[0] = _frameGraph->CreateImage( tex_desc, Default, EResourceState::ShaderSample, "Texture-0" );
+		CHECK_ERR( textures[0] );
+
+		IFrameGraph::BindlessDesc	bindless;
+		bindless.descriptorSet	= DescriptorSetID{"Bindless"};
+		bindless.maxImages		= 64;
+		bindless.maxSamplers	= 16;
+		bindless.maxBuffers		= 64;
+		CHECK_ERR( _frameGraph->EnableBindlessResources( bindless ));
+
+		ComputePipelineDesc	ppln;
+
+		ppln.AddShader( EShaderLangFormat::VKSL_100, "main", R"#(
+#version 460 core
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (local_size_x = 4, local_size_y = 1, local_size_z = 1) in;
+
+// @set 0 Bindless
+layout(set=0, binding=0) uniform texture2D  un_Textures[];
+layout(set=0, binding=1, rgba8) readonly uniform image2D  un_Images[];
+layout(set=0, binding=2) uniform sampler    un_Samplers[];
+
+// @set 1 Output
+layout(set=1, binding=0, std430) writeonly buffer un_OutBuffer {
+	vec4	results[4];
+	vec4	renderTarget;
+	vec4	storageImage;
+};
+
+layout(push_constant, std140) uniform PushConst {
+	uvec4	textures;
+	uint	sampler;
+	uint	renderTarget;
+	uint	storageImage;
+} pc;
+
+void main ()
+{
+	const uint	i		= gl_LocalInvocationIndex;
+	const uint	tex		= pc.textures[i];
+
+	results[i] = texture( sampler2D( un_Textures[nonuniformEXT(tex)], un_Samplers[pc.sampler] ), vec2(0.5) );
+
+	if ( i == 0 )
+	{
+		renderTarget = texture( sampler2D( un_Textures[pc.renderTarget], un_Samplers[pc.sampler] ), vec2(0.5) );
+		storageImage = imageLoad( un_Images[pc.storageImage], ivec2(0) );
+	}
+}
+)#" );
+
+		struct PushConst {
+			uint4	textures;
+			uint	sampler;
+			uint	renderTarget;
+			uint	storageImage;
+		};
+
+		PushConst		pc;
+
+		for (size_t i = 0; i < CountOf(textures); ++i)
+		{
+			if ( not textures[i] )
+				textures[i] = _frameGraph->CreateImage( tex_desc, Default, EResourceState::ShaderSample, "Texture-" + ToString(i) );
+			CHECK_ERR( textures[i] );
+
+			pc.textures[i] = _frameGraph->GetBindlessIndex( textures[i] );
+			CHECK_ERR( pc.textures[i] < bindless.maxImages );
+		}
+
+		// render target is in color attachment layout by default and can't be sampled
+		{
+			ImageID		temp = _frameGraph->CreateImage( rt_desc, Default, "Temp" );
+			CHECK_ERR( temp );
+			CHECK_ERR( _frameGraph->GetBindlessIndex( temp ) == UMax );
+			DeleteResources( temp );
+		}
+
+		ImageID			render_target	= _frameGraph->CreateImage( rt_desc, Default, EResourceState::ShaderSample, "RenderTarget" );
+		ImageID			storage_image	= _frameGraph->CreateImage( storage_desc, Default, "StorageImage" );
+		CHECK_ERR( render_target and storage_image );
+
+		pc.renderTarget = _frameGraph->GetBindlessIndex( render_target );
+		pc.storageImage = _frameGraph->GetBindlessIndex( storage_image );
+		CHECK_ERR( pc.renderTarget < bindless.maxImages );
+		CHECK_ERR( pc.storageImage < bindless.maxImages );
+
+		SamplerID		sampler		= _frameGraph->CreateSampler( SamplerDesc{} );
+		BufferID		dst_buffer	= _frameGraph->CreateBuffer( BufferDesc{ buf_size, EBufferUsage::Storage | EBufferUsage::TransferSrc }, Default, "OutBuffer" );
+		CPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( sampler and dst_buffer and pipeline );
+
+		pc.sampler = _frameGraph->GetBindlessIndex( sampler );
+		CHECK_ERR( pc.sampler < bindless.maxSamplers );
+		CHECK_ERR( _frameGraph->GetBindlessIndex( dst_buffer ) < bindless.maxBuffers );
+
+		PipelineResources	resources;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID{"Output"}, OUT resources ));
+		resources.BindBuffer( UniformID{"un_OutBuffer"}, dst_buffer );
+
+		const RGBA32f	colors[] = { RGBA32f{1.0f, 0.0f, 0.0f, 1.0f}, RGBA32f{0.0f, 1.0f, 0.0f, 1.0f},
+									 RGBA32f{0.0f, 0.0f, 1.0f, 1.0f}, RGBA32f{1.0f, 1.0f, 0.0f, 1.0f} };
+		const RGBA32f	rt_color		{ 0.0f, 1.0f, 1.0f, 1.0f };
+		const RGBA32f	storage_color	{ 1.0f, 0.0f, 1.0f, 1.0f };
+		bool			data_is_correct	= false;
+
+		const auto	OnLoaded = [&colors, &rt_color, &storage_color, OUT &data_is_correct] (BufferView data)
+		{
+			const auto*	results = Cast<RGBA32f>( data.Parts().front().data() );
+
+			data_is_correct = true;
+			for (size_t i = 0; i < CountOf(colors); ++i)
+			{
+				bool	is_equal = All(Equals( results[i], colors[(i + 1) % CountOf(colors)], 0.01f ));
+				ASSERT( is_equal );
+				data_is_correct &= is_equal;
+			}
+
+			bool	rt_is_equal			= All(Equals( results[4], rt_color, 0.01f ));
+			bool	storage_is_equal	= All(Equals( results[5], storage_color, 0.01f ));
+			ASSERT( rt_is_equal and storage_is_equal );
+			data_is_correct &= rt_is_equal and storage_is_equal;
+		};
+
+		// textures will be returned to the default state at the end of the batch
+		CommandBuffer	cmd1 = _frameGraph->Begin( CommandBufferDesc{}.SetDebugFlags( EDebugFlags::Default ));
+		CHECK_ERR( cmd1 );
+
+		Task	t_update;
+		for (size_t i = 0; i < CountOf(textures); ++i)
+		{
+			t_update = cmd1->AddTask( ClearColorImage{}.SetImage( textures[i] ).AddRange( 0_mipmap, 1, 0_layer, 1 )
+														.Clear( colors[i] ).DependsOn( t_update ));
+		}
+
+		t_update = cmd1->AddTask( ClearColorImage{}.SetImage( render_target ).AddRange( 0_mipmap, 1, 0_layer, 1 )
+													.Clear( rt_color ).DependsOn( t_update ));
+		t_update = cmd1->AddTask( ClearColorImage{}.SetImage( storage_image ).AddRange( 0_mipmap, 1, 0_layer, 1 )
+													.Clear( storage_color ).DependsOn( t_update ));
+		CHECK_ERR( _frameGraph->Execute( cmd1 ));
+
+		// shift texture indices to check that indices from push constants are used
+		const uint4		tex_indices = pc.textures;
+		for (uint i = 0; i < 4; ++i) {
+			pc.textures[i] = tex_indices[ (i + 1) % 4 ];
+		}
+
+		CommandBuffer	cmd2 = _frameGraph->Begin( CommandBufferDesc{}.SetDebugFlags( EDebugFlags::Default ), {cmd1} );
+		CHECK_ERR( cmd2 );
+
+		Task	t_comp	= cmd2->AddTask( DispatchCompute().SetPipeline( pipeline ).Dispatch({ 1, 1 })
+														.AddResources( DescriptorSetID{"Output"}, resources )
+														.AddPushConstant( PushConstantID("PushConst"), pc ));
+		Task	t_read	= cmd2->AddTask( ReadBuffer{}.SetBuffer( dst_buffer, 0_b, buf_size ).SetCallback( OnLoaded ).DependsOn( t_comp ));
+		Unused( t_read );
+
+		// released texture is used in 'cmd2', so its index must not be reused
+		DeleteResources( textures[3] );
+		{
+			ImageID		temp = _frameGraph->CreateImage( tex_desc, Default, EResourceState::ShaderSample, "Temp" );
+			CHECK_ERR( temp );
+			CHECK_ERR( _frameGraph->GetBindlessIndex( temp ) != tex_indices[3] );
+			DeleteResources( temp );
+		}
+
+		CHECK_ERR( _frameGraph->Execute( cmd2 ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( data_is_correct );
+
+		DeleteResources( pipeline, sampler, dst_buffer, render_target, storage_image );
+
+		for (auto& tex : textures) {
+			DeleteResources( tex );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
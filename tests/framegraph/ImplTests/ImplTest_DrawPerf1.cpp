@@ -0,0 +1,142 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Compares CPU time of command buffer compilation for draw-heavy render pass:
+	 - draw tasks are processed twice (barriers, then draw commands),
+	 - draw tasks are processed in single pass and recorded into secondary command buffer,
+	 - draw tasks are recorded on multiple threads.
+	Redundant descriptor set and vertex buffer bindings must be skipped in all modes.
+*/
+
+#include "../FGApp.h"
+#include <chrono>
+
+namespace FG
+{
+	static constexpr uint	draw_count		= 10'000;
+	static constexpr uint	frame_count		= 10;
+
+
+	static bool DrawPerf_Execute (const FrameGraph &fg, const CommandBufferDesc &desc, RawImageID image, RawGPipelineID pipeline,
+								  RawBufferID vbuffer, RawBufferID ibuffer, const VertexInputState &vertexInput,
+								  PipelineResources &resources, INOUT Nanoseconds &cpuTime)
+	{
+		using TimePoint_t = std::chrono::high_resolution_clock::time_point;
+
+		const uint2		view_size	= fg->GetDescription( image ).dimension.xy();
+		CommandBuffer	cmd			= fg->Begin( desc );
+		CHECK_ERR( cmd );
+
+		LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ));
+		CHECK_ERR( render_pass );
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			cmd->AddTask( render_pass, DrawIndexed{}.SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList )
+											.SetVertexInput( vertexInput ).AddVertexBuffer( VertexBufferID(), vbuffer )
+											.SetIndexBuffer( ibuffer, 0_b, EIndex::UShort )
+											.AddResources( DescriptorSetID("0"), resources )
+											.Draw( 3 ));
+		}
+
+		Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+		Unused( t_draw );
+
+		// reset statistics
+		IFrameGraph::Statistics	stat;
+		CHECK_ERR( fg->GetStatistics( OUT stat ));
+
+		const auto	start_time = TimePoint_t::clock::now();
+
+		CHECK_ERR( fg->Execute( cmd ));
+
+		cpuTime += TimePoint_t::clock::now() - start_time;
+
+		CHECK_ERR( fg->WaitIdle() );
+
+		// all draw tasks use same resources, so they are bound once per chunk of draw tasks
+		CHECK_ERR( fg->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.renderer.descriptorBinds > 0 );
+		CHECK_ERR( stat.renderer.descriptorBinds == stat.renderer.vertexBufferBindings );
+		CHECK_ERR( stat.renderer.descriptorBinds <= (desc.parallelRecording ? draw_count / 128 : 1) );
+		return true;
+	}
+
+
+	bool FGApp::ImplTest_DrawPerf1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(binding=0, std140) uniform un_ConstBuf {
+	vec4	offset;
+} ub;
+
+layout(location=0) in  vec2	at_Position;
+
+void main() {
+	gl_Position	= vec4( at_Position + ub.offset.xy, 0.0, 1.0 );
+}
+)#" );
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4	out_Color;
+
+void main() {
+	out_Color = vec4(1.0);
+}
+)#" );
+
+		const uint2		view_size	= {800, 600};
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																		.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+																Default, "RenderTarget" );
+		BufferID		vbuffer		= _frameGraph->CreateBuffer( BufferDesc{ SizeOf<float2> * 3, EBufferUsage::Vertex | EBufferUsage::TransferDst }, Default, "vbuffer" );
+		BufferID		ibuffer		= _frameGraph->CreateBuffer( BufferDesc{ SizeOf<uint16_t> * 3, EBufferUsage::Index | EBufferUsage::TransferDst }, Default, "ibuffer" );
+		BufferID		ubuffer		= _frameGraph->CreateBuffer( BufferDesc{ 16_b, EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "ubuffer" );
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( image and vbuffer and ibuffer and ubuffer and pipeline );
+
+		const VertexInputState	vertex_input = VertexInputState{}.Bind( VertexBufferID(), SizeOf<float2> ).Add( VertexID("at_Position"), EVertexType::Float2, 0_b );
+
+		PipelineResources	resources;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources ));
+		resources.BindBuffer( UniformID("un_ConstBuf"), ubuffer );
+
+		Nanoseconds		two_pass_time		{0};
+		Nanoseconds		single_pass_time	{0};
+		Nanoseconds		parallel_time		{0};
+
+		for (uint i = 0; i < frame_count; ++i)
+		{
+			CHECK_ERR( DrawPerf_Execute( _frameGraph, CommandBufferDesc{}, image, pipeline, vbuffer, ibuffer, vertex_input, resources, INOUT two_pass_time ));
+			CHECK_ERR( DrawPerf_Execute( _frameGraph, CommandBufferDesc{}.SetSinglePassDrawTasks(), image, pipeline, vbuffer, ibuffer, vertex_input, resources, INOUT single_pass_time ));
+			CHECK_ERR( DrawPerf_Execute( _frameGraph, CommandBufferDesc{}.SetParallelRecording(), image, pipeline, vbuffer, ibuffer, vertex_input, resources, INOUT parallel_time ));
+		}
+
+		FG_LOGI( "Draw tasks: "s << ToString( draw_count )
+				<< ", two pass: " << ToString( two_pass_time / frame_count )
+				<< ", single pass: " << ToString( single_pass_time / frame_count )
+				<< ", parallel: " << ToString( parallel_time / frame_count ));
+
+		DeleteResources( image, vbuffer, ibuffer, ubuffer, pipeline );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
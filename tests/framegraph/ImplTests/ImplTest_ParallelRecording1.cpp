@@ -0,0 +1,141 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Independent render passes are recorded in parallel into secondary command buffers,
+	each render pass contains enough draw tasks to be splitted into multiple chunks.
+	Every draw task fills its own cell with unique color, so any lost or misplaced chunk is visible in the output images.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_ParallelRecording1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(push_constant, std140) uniform PushConst {
+	uvec4	cell;		// x - cell index, y - pass index
+} pc;
+
+layout(location=0) out vec4  v_Color;
+
+const uvec2	c_GridSize = uvec2( 32, 8 );
+
+void main() {
+	const vec2	uv		= vec2( gl_VertexIndex & 1, gl_VertexIndex >> 1 );
+	const uvec2	cell	= uvec2( pc.cell.x % c_GridSize.x, pc.cell.x / c_GridSize.x );
+	const vec2	pos		= (vec2(cell) + uv) / vec2(c_GridSize);
+
+	gl_Position	= vec4( pos * 2.0 - 1.0, 0.0, 1.0 );
+	v_Color		= vec4( vec2(cell) / vec2(c_GridSize - 1), float(pc.cell.y + 1) * 0.25, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) in  vec4  v_Color;
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = v_Color;
+}
+)#" );
+
+		constexpr uint	pass_count	= 3;
+		const uint2		grid_size	= { 32, 8 };
+		const uint2		cell_size	= { 2, 2 };
+		const uint2		view_size	= grid_size * cell_size;
+		const uint		draw_count	= grid_size.x * grid_size.y;
+
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		ImageID			images[pass_count];
+		CHECK_ERR( pipeline );
+
+		for (auto& image : images)
+		{
+			image = _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+													.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+											  Default, "RenderTarget" );
+			CHECK_ERR( image );
+		}
+
+		bool	data_is_correct[pass_count] = {};
+
+		const auto	OnLoaded = [&] (uint passIndex, const ImageView &imageData)
+		{
+			bool&	correct = data_is_correct[ passIndex ];
+			correct = true;
+
+			for (uint i = 0; i < draw_count; ++i)
+			{
+				const uint2		cell		{ i % grid_size.x, i / grid_size.x };
+				const uint2		coord		= cell * cell_size + cell_size / 2u;
+				const RGBA32f	expected	{ float(cell.x) / float(grid_size.x - 1), float(cell.y) / float(grid_size.y - 1), float(passIndex + 1) * 0.25f, 1.0f };
+
+				RGBA32f	col;
+				imageData.Load( uint3(coord, 0), OUT col );
+
+				bool	is_equal = All(Equals( col, expected, 0.02f ));
+				ASSERT( is_equal );
+				correct &= is_equal;
+			}
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{}.SetParallelRecording() );
+		CHECK_ERR( cmd );
+
+		for (uint p = 0; p < pass_count; ++p)
+		{
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, images[p], RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ));
+			CHECK_ERR( render_pass );
+
+			for (uint i = 0; i < draw_count; ++i)
+			{
+				const uint4		cell { i, p, 0, 0 };
+
+				cmd->AddTask( render_pass, DrawVertices().Draw( 4 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleStrip )
+												.AddPushConstant( PushConstantID("PushConst"), cell ));
+			}
+
+			Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+			Task	t_read	= cmd->AddTask( ReadImage().SetImage( images[p], int2(), view_size )
+												.SetCallback( [&OnLoaded, p] (const ImageView &data) { OnLoaded( p, data ); })
+												.DependsOn( t_draw ));
+			Unused( t_read );
+		}
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		for (bool correct : data_is_correct) {
+			CHECK_ERR( correct );
+		}
+
+		DeleteResources( pipeline );
+
+		for (auto& image : images) {
+			DeleteResources( image );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,192 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Creates compute and graphics pipelines with disk pipeline cache, then loads the cache file into new frame graph
+	and checks that pipelines are found in the cache. Truncated cache file must be rejected.
+*/
+
+#include "../FGApp.h"
+#include "stl/Stream/FileStream.h"
+
+#ifdef FG_ENABLE_GLSLANG
+#	include "pipeline_compiler/VPipelineCompiler.h"
+#endif
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_PipelineCache1 ()
+	{
+	#if defined(FS_HAS_FILESYSTEM) and defined(FG_ENABLE_GLSLANG)
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		const String	filename	= (FS::temp_directory_path() / "fg_pipeline_cache.bin").string();
+		const uint2		image_dim	= { 16, 16 };
+
+		// creates 4 compute and 1 graphics pipeline instances and returns statistics
+		const auto	RunPipelines = [&] (const FrameGraph &fg, OUT IFrameGraph::Statistics &stat) -> bool
+		{
+			GraphicsPipelineDesc	gppln;
+			gppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+void main() {
+	gl_Position	= vec4( vec2( gl_VertexIndex & 1, gl_VertexIndex >> 1 ) * 4.0 - 1.0, 0.0, 1.0 );
+}
+)#" );
+			gppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4(1.0);
+}
+)#" );
+
+			ComputePipelineDesc	ppln;
+			ppln.AddShader( EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(compute)
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (local_size_x_id = 0, local_size_y_id = 1, local_size_z = 1) in;
+
+layout(binding=0, rgba8) writeonly uniform image2D  un_OutImage;
+
+void main ()
+{
+	imageStore( un_OutImage, ivec2(gl_GlobalInvocationID.xy), vec4(1.0) );
+}
+)#" );
+
+			ImageID			image		= fg->CreateImage( ImageDesc{}.SetDimension( image_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																	.SetUsage( EImageUsage::Storage ),
+														   Default, "MyImage" );
+			ImageID			rt			= fg->CreateImage( ImageDesc{}.SetDimension( image_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																	.SetUsage( EImageUsage::ColorAttachment ),
+														   Default, "RenderTarget" );
+			CPipelineID		pipeline	= fg->CreatePipeline( ppln );
+			GPipelineID		gpipeline	= fg->CreatePipeline( gppln );
+			CHECK_ERR( image and rt and pipeline and gpipeline );
+
+			PipelineResources	resources;
+			CHECK_ERR( fg->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources ));
+			resources.BindImage( UniformID("un_OutImage"), image );
+
+			CommandBuffer	cmd = fg->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			// each local size creates new pipeline instance
+			Task	t_run	= null;
+			for (uint i = 1; i <= 4; ++i)
+			{
+				t_run = cmd->AddTask( DispatchCompute().SetPipeline( pipeline ).AddResources( DescriptorSetID("0"), resources )
+														.SetLocalSize( i, i ).Dispatch( image_dim / i ).DependsOn( t_run ));
+			}
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( image_dim )
+												.AddTarget( RenderTargetID::Color_0, rt, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( image_dim ));
+			CHECK_ERR( render_pass );
+
+			cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( gpipeline ).SetTopology( EPrimitive::TriangleList ));
+			t_run = cmd->AddTask( SubmitRenderPass{ render_pass }.DependsOn( t_run ));
+
+			// reset statistics
+			CHECK_ERR( fg->GetStatistics( OUT stat ));
+
+			CHECK_ERR( fg->Execute( cmd ));
+			CHECK_ERR( fg->WaitIdle() );
+			CHECK_ERR( fg->GetStatistics( OUT stat ));
+
+			fg->ReleaseResource( image );
+			fg->ReleaseResource( rt );
+			fg->ReleaseResource( pipeline );
+			fg->ReleaseResource( gpipeline );
+			return true;
+		};
+
+		// creates frame graph that uses the cache file
+		const auto	CreateFrameGraph = [&] () -> FrameGraph
+		{
+			FrameGraph	fg = IFrameGraph::CreateFrameGraph( _deviceInfo );
+			CHECK_ERR( fg );
+			CHECK_ERR( fg->AddPipelineCompiler( _pplnCompiler ));
+			CHECK_ERR( fg->SetPipelineCacheFile( filename, 0 ));
+			return fg;
+		};
+
+		IFrameGraph::Statistics		stat;
+
+		// write cache file
+		{
+			std::remove( filename.c_str() );
+
+			FrameGraph	fg = CreateFrameGraph();
+			CHECK_ERR( fg );
+			CHECK_ERR( RunPipelines( fg, OUT stat ));
+			CHECK_ERR( stat.resources.newComputePipelineCount == 4 );
+			CHECK_ERR( stat.resources.newGraphicsPipelineCount == 1 );
+			CHECK_ERR( stat.resources.pipelineCacheHits == 0 );
+
+			CHECK_ERR( fg->SavePipelineCache() );
+			fg->Deinitialize();
+		}
+
+		Array<uint8_t>	file_data;
+		{
+			FileRStream		file{ filename };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Size() > 0_b );
+			CHECK_ERR( file.Read( size_t(file.Size()), OUT file_data ));
+		}
+
+		// load cache file into new frame graph, all pipelines must be found in the cache
+		{
+			FrameGraph	fg = CreateFrameGraph();
+			CHECK_ERR( fg );
+			CHECK_ERR( RunPipelines( fg, OUT stat ));
+			CHECK_ERR( stat.resources.newComputePipelineCount == 4 );
+			CHECK_ERR( stat.resources.newGraphicsPipelineCount == 1 );
+
+			if ( _properties.pipelineCreationFeedback )
+				CHECK_ERR( stat.resources.pipelineCacheHits == 5 );
+
+			fg->Deinitialize();
+		}
+
+		// truncated file must be rejected
+		{
+			{
+				FileWStream		file{ filename };
+				CHECK_ERR( file.IsOpen() );
+				CHECK_ERR( file.Write( ArrayView<uint8_t>{ file_data.data(), file_data.size() - 1 }));
+			}
+
+			FrameGraph	fg = CreateFrameGraph();
+			CHECK_ERR( fg );
+			CHECK_ERR( RunPipelines( fg, OUT stat ));
+			CHECK_ERR( stat.resources.newComputePipelineCount == 4 );
+			CHECK_ERR( stat.resources.newGraphicsPipelineCount == 1 );
+			CHECK_ERR( stat.resources.pipelineCacheHits == 0 );
+
+			fg->Deinitialize();
+		}
+
+		std::remove( filename.c_str() );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+	#else
+		FG_LOGI( TEST_NAME << " - skipped" );
+	#endif
+		return true;
+	}
+
+}	// FG
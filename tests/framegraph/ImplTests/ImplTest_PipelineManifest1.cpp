@@ -0,0 +1,125 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Pipeline instances are recorded to the manifest, then manifest is reloaded from file,
+	pipeline is recreated without name and all recorded instances are created before drawing.
+*/
+
+#include "../FGApp.h"
+#include "stl/Stream/FileStream.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_PipelineManifest1 ()
+	{
+	#ifdef FS_HAS_FILESYSTEM
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(0.0, -0.5),
+	vec2(0.5, 0.5),
+	vec2(-0.5, 0.5)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.0, 1.0 );
+}
+)#" );
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4(1.0, 0.0, 0.0, 1.0);
+}
+)#" );
+
+		const String			filename	= (FS::temp_directory_path() / "fg_pipeline_manifest.bin").string();
+		const uint2				view_size	= {256, 256};
+		GraphicsPipelineDesc	ppln2		= ppln;
+
+		std::remove( filename.c_str() );
+		CHECK_ERR( _frameGraph->SetPipelineManifestFile( filename ));
+
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																		.SetUsage( EImageUsage::ColorAttachment ),
+																Default, "RenderTarget" );
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln, "ManifestPipeline" );
+		CHECK_ERR( image and pipeline );
+
+		// each cull mode creates new pipeline instance
+		const auto	Draw = [&] (OUT IFrameGraph::Statistics &stat) -> bool
+		{
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ));
+
+			cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ).SetCullMode( ECullMode::None ));
+			cmd->AddTask( render_pass, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ).SetCullMode( ECullMode::Back ));
+			cmd->AddTask( SubmitRenderPass{ render_pass });
+
+			// reset statistics
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			return true;
+		};
+
+		IFrameGraph::Statistics		stat;
+
+		CHECK_ERR( Draw( OUT stat ));
+		CHECK_ERR( stat.resources.newGraphicsPipelineCount == 2 );
+
+		CHECK_ERR( _frameGraph->SavePipelineManifest() );
+		{
+			FileRStream		file{ filename };
+			CHECK_ERR( file.IsOpen() );
+			CHECK_ERR( file.Size() > 0_b );
+		}
+
+		// stop recording to clear in-memory manifest, then load it from file
+		CHECK_ERR( _frameGraph->SetPipelineManifestFile( Default ));
+		CHECK_ERR( _frameGraph->SetPipelineManifestFile( filename ));
+
+		// recreate pipeline, all instances will be destroyed, pipeline is matched by description instead of name
+		_frameGraph->ReleaseResource( pipeline );
+		pipeline = _frameGraph->CreatePipeline( ppln2 );
+		CHECK_ERR( pipeline );
+
+		CHECK_ERR( _frameGraph->PrewarmPipelines({ pipeline.Get() }));
+
+		CHECK_ERR( Draw( OUT stat ));
+		CHECK_ERR( stat.resources.newGraphicsPipelineCount == 0 );
+
+		CHECK_ERR( _frameGraph->SetPipelineManifestFile( Default ));
+
+		DeleteResources( image, pipeline );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+	#else
+		FG_LOGI( TEST_NAME << " - skipped" );
+	#endif
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,210 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Pipeline layout contains descriptor sets with dynamic offsets before and after the small descriptor set,
+	so only the middle set is pushed and bound descriptor sets are split into two ranges with separate dynamic offsets.
+	Last draw uses explicitly cached resources for the pushed set, descriptor writes are created with descriptor set.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_PushDescriptors1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+// @set 1 Pushed
+layout(set=1, binding=0, std140) uniform un_Pushed {
+	vec4	rect;
+	vec4	green;
+} pushed;
+
+void main() {
+	const vec2	uv = vec2( gl_VertexIndex & 1, gl_VertexIndex >> 1 );
+	gl_Position	= vec4( mix( pushed.rect.xy, pushed.rect.zw, uv ), 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+// @set 0 Bound0
+// @dynamic-offset
+layout(set=0, binding=0, std140) uniform un_Red {
+	vec4	red;
+} ub_red;
+
+// @set 1 Pushed
+layout(set=1, binding=0, std140) uniform un_Pushed {
+	vec4	rect;
+	vec4	green;
+} pushed;
+
+// @set 2 Bound2
+// @dynamic-offset
+layout(set=2, binding=0, std140) uniform un_Blue {
+	vec4	blue;
+} ub_blue;
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = ub_red.red + pushed.green + ub_blue.blue;
+}
+)#" );
+
+		struct PushedData {
+			float4	rect;
+			float4	green;
+		};
+
+		constexpr uint	frame_count		= 2;
+		constexpr uint	draw_count		= 4;
+		const uint2		view_size		= { 64, 64 };
+		const BytesU	color_stride	= AlignToLarger( SizeOf<float4>, BytesU{_properties.minUniformBufferOffsetAlignment} );
+		const bool		push_supported	= _frameGraph->GetDeviceProperties().pushDescriptors;
+
+		// draw 'i' uses red from slot 'i' and blue from slot 'draw_count + (draw_count-1 - i)'
+		Array<uint8_t>	color_data;
+		color_data.resize( size_t(color_stride * draw_count * 2) );
+
+		PushedData		pushed_data[draw_count];
+		RGBA32f			expected[draw_count];
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			const uint		j		= draw_count-1 - i;
+			const float4	red		{ float(i) / 3.0f, 0.0f, 0.0f, 1.0f };
+			const float4	blue	{ 0.0f, 0.0f, float(j + 1) / 4.0f, 0.0f };
+
+			std::memcpy( OUT color_data.data() + size_t(color_stride * i), &red, sizeof(red) );
+			std::memcpy( OUT color_data.data() + size_t(color_stride * (draw_count + j)), &blue, sizeof(blue) );
+
+			const float2	rect_min { float(i & 1) - 1.0f, float(i >> 1) - 1.0f };
+			pushed_data[i].rect		= float4{ rect_min, rect_min + 1.0f };
+			pushed_data[i].green	= float4{ 0.0f, (i & 1 ? 1.0f : 0.5f), 0.0f, 0.0f };
+
+			expected[i] = RGBA32f{ red.x, pushed_data[i].green.y, blue.z, 1.0f };
+		}
+
+		ImageID		image		= _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+														Default, "RenderTarget" );
+		BufferID	color_buf	= _frameGraph->CreateBuffer( BufferDesc{ BytesU{color_data.size()}, EBufferUsage::Uniform | EBufferUsage::TransferDst },
+														 Default, "ColorBuffer" );
+		GPipelineID	pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( image and color_buf and pipeline );
+
+		BufferID	pushed_bufs[draw_count];
+		for (auto& buf : pushed_bufs)
+		{
+			buf = _frameGraph->CreateBuffer( BufferDesc{ SizeOf<PushedData>, EBufferUsage::Uniform | EBufferUsage::TransferDst }, Default, "PushedBuffer" );
+			CHECK_ERR( buf );
+		}
+
+		PipelineResources	red_res;
+		PipelineResources	pushed_res;
+		PipelineResources	cached_res;
+		PipelineResources	blue_res;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("Bound0"), OUT red_res ));
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("Pushed"), OUT pushed_res ));
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("Pushed"), OUT cached_res ));
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("Bound2"), OUT blue_res ));
+
+		red_res.SetBufferBase( UniformID("un_Red"), 0_b );
+		blue_res.SetBufferBase( UniformID("un_Blue"), 0_b );
+
+		cached_res.BindBuffer( UniformID("un_Pushed"), pushed_bufs[draw_count-1] );
+		CHECK_ERR( _frameGraph->CachePipelineResources( INOUT cached_res ));
+
+		for (uint frame = 0; frame < frame_count; ++frame)
+		{
+			bool	data_is_correct = false;
+
+			const auto	OnLoaded = [&expected, OUT &data_is_correct] (const ImageView &imageData)
+			{
+				data_is_correct = true;
+
+				for (uint i = 0; i < draw_count; ++i)
+				{
+					const uint2	coord	= (uint2{ i & 1, i >> 1 } * 2u + 1u) * uint2{ imageData.Dimension() } / 4u;
+
+					RGBA32f	col;
+					imageData.Load( uint3(coord, 0), OUT col );
+
+					bool	is_equal = All(Equals( col, expected[i], 0.02f ));
+					ASSERT( is_equal );
+					data_is_correct &= is_equal;
+				}
+			};
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			Task	t_update = cmd->AddTask( UpdateBuffer{}.SetBuffer( color_buf ).AddData( color_data ));
+			for (uint i = 0; i < draw_count; ++i)
+			{
+				t_update = cmd->AddTask( UpdateBuffer{}.SetBuffer( pushed_bufs[i] ).AddData( &pushed_data[i], 1 ).DependsOn( t_update ));
+			}
+
+			LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddViewport( view_size ));
+
+			for (uint i = 0; i < draw_count; ++i)
+			{
+				const uint	j = draw_count-1 - i;
+
+				red_res.BindBuffer( UniformID("un_Red"), color_buf, color_stride * i, SizeOf<float4> );
+				blue_res.BindBuffer( UniformID("un_Blue"), color_buf, color_stride * (draw_count + j), SizeOf<float4> );
+				pushed_res.BindBuffer( UniformID("un_Pushed"), pushed_bufs[i] );
+
+				cmd->AddTask( render_pass, DrawVertices().Draw( 4 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleStrip )
+												.AddResources( DescriptorSetID("Bound0"), red_res )
+												.AddResources( DescriptorSetID("Pushed"), (i == draw_count-1 ? cached_res : pushed_res) )
+												.AddResources( DescriptorSetID("Bound2"), blue_res ));
+			}
+
+			Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass }.DependsOn( t_update ));
+			Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw ));
+			Unused( t_read );
+
+			// reset statistics
+			IFrameGraph::Statistics	stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( stat.renderer.pushDescriptors == (push_supported ? draw_count : 0) );
+
+			CHECK_ERR( data_is_correct );
+		}
+
+		_frameGraph->ReleaseResource( INOUT cached_res );
+		DeleteResources( image, color_buf, pipeline );
+
+		for (auto& buf : pushed_bufs) {
+			DeleteResources( buf );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,79 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Creates more buffers than the previous pool limit,
+	resources with large indices are used in command buffer to check local remapping.
+	Then creates and releases 100k buffers to check that pool indices are reused.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_ResourcePool1 ()
+	{
+		constexpr uint	alive_count		= 40'000;		// previous limit was 32k buffers
+		constexpr uint	total_count		= 100'000;
+		constexpr uint	batch_size		= 1'000;
+		const BytesU	buf_size		= SizeOf<uint>;
+		const BufferDesc	desc		{ buf_size, EBufferUsage::TransferSrc | EBufferUsage::TransferDst };
+
+		Array<BufferID>		buffers;
+		buffers.reserve( alive_count );
+
+		for (uint i = 0; i < alive_count; ++i)
+		{
+			buffers.push_back( _frameGraph->CreateBuffer( desc ));
+			CHECK_ERR( buffers.back() );
+		}
+
+		// IDs of first buffers must be valid after pool grows
+		CHECK_ERR( _frameGraph->IsResourceAlive( buffers.front() ));
+		CHECK_ERR( _frameGraph->GetDescription( buffers.front() ).size == buf_size );
+
+		const uint	value			= 0x12345678;
+		bool		data_is_correct	= false;
+
+		const auto	OnLoaded = [value, OUT &data_is_correct] (BufferView data)
+		{
+			data_is_correct = (*Cast<uint>( data.Parts().front().data() ) == value);
+			ASSERT( data_is_correct );
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		Task	t_update	= cmd->AddTask( UpdateBuffer().SetBuffer( buffers.front() ).AddData( &value, 1 ));
+		Task	t_copy		= cmd->AddTask( CopyBuffer().From( buffers.front() ).To( buffers.back() ).AddRegion( 0_b, 0_b, buf_size ).DependsOn( t_update ));
+		Task	t_read		= cmd->AddTask( ReadBuffer().SetBuffer( buffers.back(), 0_b, buf_size ).SetCallback( OnLoaded ).DependsOn( t_copy ));
+		Unused( t_read );
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+		CHECK_ERR( data_is_correct );
+
+		for (auto& buf : buffers) {
+			DeleteResources( buf );
+		}
+		buffers.clear();
+
+		// create and release
+		for (uint i = 0; i < total_count; i += batch_size)
+		{
+			for (uint j = 0; j < batch_size; ++j)
+			{
+				buffers.push_back( _frameGraph->CreateBuffer( desc ));
+				CHECK_ERR( buffers.back() );
+			}
+
+			for (auto& buf : buffers) {
+				DeleteResources( buf );
+			}
+			buffers.clear();
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,53 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Per-frame image and buffer are created and destroyed each frame,
+	memory of destroyed resources must be reused in the next frames.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_RetainedMemory1 ()
+	{
+		constexpr uint	frame_count	= 4;
+		const uint2		img_dim		= { 256, 256 };
+		const BytesU	buf_size	= 64_Kb;
+
+		for (uint frame = 0; frame < frame_count; ++frame)
+		{
+			ImageID		image	= _frameGraph->CreateImage( ImageDesc{}.SetDimension( img_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferDst ),
+														Default, "PerFrameImage" );
+			BufferID	buffer	= _frameGraph->CreateBuffer( BufferDesc{ buf_size, EBufferUsage::TransferDst }, Default, "PerFrameBuffer" );
+			CHECK_ERR( image and buffer );
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+			CHECK_ERR( cmd );
+
+			Task	t_clear	= cmd->AddTask( ClearColorImage{}.SetImage( image ).AddRange( 0_mipmap, 1, 0_layer, 1 ).Clear( RGBA32f{1.0f, 0.0f, 0.0f, 1.0f} ));
+			Task	t_fill	= cmd->AddTask( FillBuffer{}.SetBuffer( buffer, 0_b, buf_size ).SetPattern( 0u ).DependsOn( t_clear ));
+			Unused( t_fill );
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+
+			// resources will be destroyed when command batch complete execution
+			DeleteResources( image, buffer );
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			IFrameGraph::Statistics	stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			if ( frame > 0 ) {
+				CHECK_ERR( stat.resources.retainedMemoryHits == 2 );
+				CHECK_ERR( stat.resources.retainedMemoryMisses == 0 );
+			}
+			CHECK_ERR( stat.resources.retainedMemorySize > 0 );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,218 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Frame graph is created with external task scheduler.
+	Command buffer is compiled on the scheduler's thread, render pass is recorded by 'ParallelFor' jobs,
+	continuation is called when command buffer is ready to be submitted.
+*/
+
+#include "../FGApp.h"
+#include "framegraph/Public/TaskScheduler.h"
+#include <thread>
+#include <condition_variable>
+
+#ifdef FG_ENABLE_GLSLANG
+#	include "pipeline_compiler/VPipelineCompiler.h"
+#endif
+
+namespace FG
+{
+namespace
+{
+	//
+	// Test Task Scheduler
+	//
+	class TestTaskScheduler final : public ITaskScheduler
+	{
+	public:
+		static constexpr uint	worker_count	= 4;
+
+		Mutex				_guard;
+		Array<std::thread>	_threads;
+		Atomic<uint>		enqueued		{0};
+		Atomic<uint>		parallelJobs	{0};
+
+		~TestTaskScheduler ()
+		{
+			EXLOCK( _guard );
+			for (auto& t : _threads) {
+				t.join();
+			}
+		}
+
+		uint  WorkerCount () override
+		{
+			return worker_count;
+		}
+
+		void  Enqueue (Job_t &&job) override
+		{
+			enqueued.fetch_add( 1 );
+
+			EXLOCK( _guard );
+			_threads.emplace_back( std::move(job) );
+		}
+
+		void  ParallelFor (uint count, const ParallelJob_t &job) override
+		{
+			Atomic<uint>	counter {0};
+
+			const auto	run = [&] (uint workerIndex)
+			{
+				for (uint i = counter.fetch_add( 1 ); i < count; i = counter.fetch_add( 1 ))
+				{
+					job( i, workerIndex );
+					parallelJobs.fetch_add( 1 );
+				}
+			};
+
+			// calling thread is worker 0
+			Array<std::thread>	helpers;
+			for (uint i = 1; i < worker_count; ++i) {
+				helpers.emplace_back( run, i );
+			}
+			run( 0 );
+
+			for (auto& t : helpers) {
+				t.join();
+			}
+		}
+	};
+}
+
+	bool FGApp::ImplTest_TaskScheduler1 ()
+	{
+	#ifdef FG_ENABLE_GLSLANG
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(push_constant, std140) uniform PushConst {
+	uvec4	cell;
+} pc;
+
+layout(location=0) out vec4  v_Color;
+
+void main() {
+	const vec2	uv		= vec2( gl_VertexIndex & 1, gl_VertexIndex >> 1 );
+	const uvec2	cell	= uvec2( pc.cell.x % 16, pc.cell.x / 16 );
+
+	gl_Position	= vec4( (vec2(cell) + uv) / 8.0 - 1.0, 0.0, 1.0 );
+	v_Color		= vec4( vec2(cell) / 15.0, 0.0, 1.0 );
+}
+)#" );
+
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) in  vec4  v_Color;
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = v_Color;
+}
+)#" );
+
+		auto		scheduler	= MakeShared<TestTaskScheduler>();
+		FrameGraph	fg			= IFrameGraph::CreateFrameGraph( _deviceInfo, scheduler );
+		CHECK_ERR( fg );
+		CHECK_ERR( fg->AddPipelineCompiler( _pplnCompiler ));
+
+		const uint2		view_size	= { 16, 16 };
+		const uint		draw_count	= view_size.x * view_size.y;
+		ImageID			image		= fg->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+													   Default, "RenderTarget" );
+		GPipelineID		pipeline	= fg->CreatePipeline( ppln );
+		CHECK_ERR( image and pipeline );
+
+		bool	data_is_correct = false;
+
+		const auto	OnLoaded = [&data_is_correct] (const ImageView &imageData)
+		{
+			data_is_correct = true;
+
+			for (uint y = 0; y < imageData.Dimension().y; ++y)
+			for (uint x = 0; x < imageData.Dimension().x; ++x)
+			{
+				RGBA32f	col;
+				imageData.Load( uint3{ x, y, 0 }, OUT col );
+
+				bool	is_equal = All(Equals( col, RGBA32f{ float(x) / 15.0f, float(y) / 15.0f, 0.0f, 1.0f }, 0.02f ));
+				ASSERT( is_equal );
+				data_is_correct &= is_equal;
+			}
+		};
+
+		CommandBuffer	cmd = fg->Begin( CommandBufferDesc{}.SetParallelRecording() );
+		CHECK_ERR( cmd );
+
+		LogicalPassID	render_pass	= cmd->CreateRenderPass( RenderPassDesc( view_size )
+											.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+											.AddViewport( view_size ));
+		CHECK_ERR( render_pass );
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			const uint4		cell { i, 0, 0, 0 };
+
+			cmd->AddTask( render_pass, DrawVertices().Draw( 4 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleStrip )
+											.AddPushConstant( PushConstantID("PushConst"), cell ));
+		}
+
+		Task	t_draw	= cmd->AddTask( SubmitRenderPass{ render_pass });
+		Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw ));
+		Unused( t_read );
+
+		// wait for continuation
+		Mutex						guard;
+		std::condition_variable		cv;
+		bool						executed		= false;
+		bool						exec_result		= false;
+		const std::thread::id		caller_thread	= std::this_thread::get_id();
+		bool						other_thread	= false;
+
+		CHECK_ERR( fg->Execute( cmd, [&] (bool result)
+			{
+				EXLOCK( guard );
+				executed		= true;
+				exec_result		= result;
+				other_thread	= (std::this_thread::get_id() != caller_thread);
+				cv.notify_all();
+			}));
+		{
+			std::unique_lock	lock{ guard };
+			cv.wait( lock, [&executed] () { return executed; });
+		}
+		CHECK_ERR( exec_result );
+		CHECK_ERR( other_thread );
+
+		CHECK_ERR( fg->WaitIdle() );
+		CHECK_ERR( data_is_correct );
+
+		// command buffer is compiled by single job, render pass is splitted into chunks that are recorded by scheduler
+		CHECK_ERR( scheduler->enqueued.load() == 1 );
+		CHECK_ERR( scheduler->parallelJobs.load() > 1 );
+
+		fg->ReleaseResource( image );
+		fg->ReleaseResource( pipeline );
+		fg->Deinitialize();
+
+		FG_LOGI( TEST_NAME << " - passed" );
+	#else
+		FG_LOGI( TEST_NAME << " - skipped" );
+	#endif
+		return true;
+	}
+
+}	// FG
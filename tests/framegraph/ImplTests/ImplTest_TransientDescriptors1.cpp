@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Resources are changed for each dispatch and descriptor sets are allocated from command batch pools.
+	Command batches are reused in next frames, so pools must be reset when batch complete execution.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_TransientDescriptors1 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		ComputePipelineDesc	ppln;
+
+		ppln.AddShader( EShaderLangFormat::VKSL_100, "main", R"#(
+#version 450 core
+#extension GL_ARB_shading_language_420pack : enable
+
+layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+layout(binding=0, std430) writeonly buffer un_OutBuffer {
+	uint	result;
+};
+
+layout(push_constant, std140) uniform PushConst {
+	uint	value;
+} pc;
+
+void main ()
+{
+	result = pc.value;
+}
+)#" );
+
+		constexpr uint	frame_count		= 4;
+		constexpr uint	dispatch_count	= 300;		// more than single pool can hold
+		const BytesU	buf_size		= SizeOf<uint>;
+
+		CPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( pipeline );
+
+		Array<BufferID>	buffers;
+		for (uint i = 0; i < dispatch_count; ++i)
+		{
+			buffers.push_back( _frameGraph->CreateBuffer( BufferDesc{ buf_size, EBufferUsage::Storage | EBufferUsage::TransferSrc }, Default, "Buffer" ));
+			CHECK_ERR( buffers.back() );
+		}
+
+		PipelineResources	resources;
+		CHECK_ERR( _frameGraph->InitPipelineResources( pipeline, DescriptorSetID("0"), OUT resources ));
+
+		for (uint frame = 0; frame < frame_count; ++frame)
+		{
+			uint	loaded_count	= 0;
+			bool	data_is_correct	= true;
+
+			CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{}.SetTransientDescriptorSets() );
+			CHECK_ERR( cmd );
+
+			for (uint i = 0; i < dispatch_count; ++i)
+			{
+				const uint	value	= frame * dispatch_count + i;
+				const auto	OnLoaded = [value, &loaded_count, &data_is_correct] (BufferView data)
+				{
+					bool	is_equal = (*Cast<uint>( data.Parts().front().data() ) == value);
+					ASSERT( is_equal );
+
+					data_is_correct &= is_equal;
+					++loaded_count;
+				};
+
+				resources.BindBuffer( UniformID("un_OutBuffer"), buffers[i] );
+
+				Task	t_comp	= cmd->AddTask( DispatchCompute().SetPipeline( pipeline ).Dispatch({ 1, 1 })
+															.AddResources( DescriptorSetID("0"), resources )
+															.AddPushConstant( PushConstantID("PushConst"), value ));
+				Task	t_read	= cmd->AddTask( ReadBuffer().SetBuffer( buffers[i], 0_b, buf_size ).SetCallback( OnLoaded ).DependsOn( t_comp ));
+				Unused( t_read );
+			}
+
+			// reset statistics
+			IFrameGraph::Statistics	stat;
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+			CHECK_ERR( _frameGraph->Execute( cmd ));
+			CHECK_ERR( _frameGraph->WaitIdle() );
+
+			CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+			CHECK_ERR( stat.resources.transientDescriptorSets == dispatch_count );
+
+			CHECK_ERR( loaded_count == dispatch_count );
+			CHECK_ERR( data_is_correct );
+		}
+
+		DeleteResources( pipeline );
+
+		for (auto& buf : buffers) {
+			DeleteResources( buf );
+		}
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Transient images are created in command buffer and share memory
+	if their lifetimes in task graph are not overlapped.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_TransientImages1 ()
+	{
+		const uint2		img_dim		= { 256, 256 };
+		const ImageDesc	desc		= ImageDesc{}.SetDimension( img_dim ).SetFormat( EPixelFormat::RGBA8_UNorm )
+												 .SetUsage( EImageUsage::TransferSrc | EImageUsage::TransferDst );
+		const RGBA32f	red_color	{ 1.0f, 0.0f, 0.0f, 1.0f };
+		const RGBA32f	blue_color	{ 0.0f, 0.0f, 1.0f, 1.0f };
+
+		bool	cb_was_called	= false;
+		bool	data_is_correct	= true;
+
+		const auto	OnLoaded = [&cb_was_called, &data_is_correct] (const ImageView &imageData, const RGBA32f &expected)
+		{
+			RGBA32f		col;
+			imageData.Load( uint3(imageData.Dimension().x / 2, imageData.Dimension().y / 2, 0), OUT col );
+
+			bool	is_equal = All(Equals( col, expected, 0.1f ));
+			ASSERT( is_equal );
+
+			data_is_correct &= is_equal;
+			cb_was_called	 = true;
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		RawImageID	image_a	= cmd->CreateTransientImage( desc, "TransientA" );
+		RawImageID	image_b	= cmd->CreateTransientImage( desc, "TransientB" );
+		RawImageID	image_c	= cmd->CreateTransientImage( desc, "TransientC" );
+		CHECK_ERR( image_a and image_b and image_c );
+
+		// 'image_a' is not used after 't_copy', so 'image_c' may use the same memory
+		Task	t_clear1	= cmd->AddTask( ClearColorImage{}.SetImage( image_a ).AddRange( 0_mipmap, 1, 0_layer, 1 ).Clear( red_color ));
+		Task	t_copy		= cmd->AddTask( CopyImage{}.From( image_a ).To( image_b ).AddRegion( {}, int2{}, {}, int2{}, img_dim ).DependsOn( t_clear1 ));
+		Task	t_clear2	= cmd->AddTask( ClearColorImage{}.SetImage( image_c ).AddRange( 0_mipmap, 1, 0_layer, 1 ).Clear( blue_color ).DependsOn( t_copy ));
+		Task	t_read1		= cmd->AddTask( ReadImage{}.SetImage( image_b, int2{}, img_dim )
+													  .SetCallback( [&] (const ImageView &data) { OnLoaded( data, red_color ); })
+													  .DependsOn( t_clear2 ));
+		Task	t_read2		= cmd->AddTask( ReadImage{}.SetImage( image_c, int2{}, img_dim )
+													  .SetCallback( [&] (const ImageView &data) { OnLoaded( data, blue_color ); })
+													  .DependsOn( t_read1 ));
+		Unused( t_read2 );
+
+		// reset statistics
+		IFrameGraph::Statistics	stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( cb_was_called );
+		CHECK_ERR( data_is_correct );
+
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.resources.transientImages == 3 );
+		CHECK_ERR( stat.resources.transientHeapMemory < stat.resources.transientImageMemory );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
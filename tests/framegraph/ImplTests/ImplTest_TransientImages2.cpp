@@ -0,0 +1,119 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+/*
+	Transient depth buffer that is cleared on load and never stored
+	may be placed in lazily allocated memory, depth buffer that is stored must use device memory.
+	If lazily allocated memory is not supported then device local memory is used.
+*/
+
+#include "../FGApp.h"
+
+namespace FG
+{
+
+	bool FGApp::ImplTest_TransientImages2 ()
+	{
+		if ( not _pplnCompiler )
+		{
+			FG_LOGI( TEST_NAME << " - skipped" );
+			return true;
+		}
+
+		GraphicsPipelineDesc	ppln;
+
+		ppln.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(vertex)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+const vec2	g_Positions[3] = vec2[](
+	vec2(0.0, -0.5),
+	vec2(0.5, 0.5),
+	vec2(-0.5, 0.5)
+);
+
+void main() {
+	gl_Position	= vec4( g_Positions[gl_VertexIndex], 0.5, 1.0 );
+}
+)#" );
+		ppln.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", R"#(
+#pragma shader_stage(fragment)
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location=0) out vec4  out_Color;
+
+void main() {
+	out_Color = vec4(1.0, 0.0, 0.0, 1.0);
+}
+)#" );
+
+		const uint2		view_size	= {256, 256};
+		const ImageDesc	depth_desc	= ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::Depth32F ).SetUsage( EImageUsage::DepthStencilAttachment );
+		ImageID			image		= _frameGraph->CreateImage( ImageDesc{}.SetDimension( view_size ).SetFormat( EPixelFormat::RGBA8_UNorm )
+																		.SetUsage( EImageUsage::ColorAttachment | EImageUsage::TransferSrc ),
+															    Default, "RenderTarget" );
+		GPipelineID		pipeline	= _frameGraph->CreatePipeline( ppln );
+		CHECK_ERR( image and pipeline );
+
+		bool	data_is_correct = false;
+
+		const auto	OnLoaded = [&data_is_correct] (const ImageView &imageData)
+		{
+			RGBA32f		col;
+			imageData.Load( uint3(imageData.Dimension().x / 2, imageData.Dimension().y / 2, 0), OUT col );
+
+			data_is_correct = All(Equals( col, RGBA32f{1.0f, 0.0f, 0.0f, 1.0f}, 0.1f ));
+			ASSERT( data_is_correct );
+		};
+
+		CommandBuffer	cmd = _frameGraph->Begin( CommandBufferDesc{} );
+		CHECK_ERR( cmd );
+
+		RawImageID		depth_a		= cmd->CreateTransientImage( depth_desc, "DepthA" );
+		RawImageID		depth_b		= cmd->CreateTransientImage( depth_desc, "DepthB" );
+		CHECK_ERR( depth_a and depth_b );
+
+		// content of 'depth_a' never leaves the render pass
+		LogicalPassID	pass1		= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, image, RGBA32f(0.0f), EAttachmentStoreOp::Store )
+												.AddTarget( RenderTargetID::Depth, depth_a, DepthStencil{1.0f}, EAttachmentStoreOp::Invalidate )
+												.SetDepthTestEnabled( true ).SetDepthWriteEnabled( true )
+												.AddViewport( view_size ));
+
+		// 'depth_b' is stored, so it can not be lazily allocated
+		LogicalPassID	pass2		= cmd->CreateRenderPass( RenderPassDesc( view_size )
+												.AddTarget( RenderTargetID::Color_0, image, EAttachmentLoadOp::Load, EAttachmentStoreOp::Store )
+												.AddTarget( RenderTargetID::Depth, depth_b, DepthStencil{1.0f}, EAttachmentStoreOp::Store )
+												.SetDepthTestEnabled( true ).SetDepthWriteEnabled( true )
+												.AddViewport( view_size ));
+		CHECK_ERR( pass1 and pass2 );
+
+		cmd->AddTask( pass1, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ));
+		cmd->AddTask( pass2, DrawVertices().Draw( 3 ).SetPipeline( pipeline ).SetTopology( EPrimitive::TriangleList ));
+
+		Task	t_draw1	= cmd->AddTask( SubmitRenderPass{ pass1 });
+		Task	t_draw2	= cmd->AddTask( SubmitRenderPass{ pass2 }.DependsOn( t_draw1 ));
+		Task	t_read	= cmd->AddTask( ReadImage().SetImage( image, int2(), view_size ).SetCallback( OnLoaded ).DependsOn( t_draw2 ));
+		Unused( t_read );
+
+		// reset statistics
+		IFrameGraph::Statistics	stat;
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+
+		CHECK_ERR( _frameGraph->Execute( cmd ));
+		CHECK_ERR( _frameGraph->WaitIdle() );
+
+		CHECK_ERR( data_is_correct );
+
+		CHECK_ERR( _frameGraph->GetStatistics( OUT stat ));
+		CHECK_ERR( stat.resources.transientImages == 2 );
+		CHECK_ERR( stat.resources.lazyAllocRequestedImages == 1 );
+		CHECK_ERR( stat.resources.lazilyAllocatedImages == (_frameGraph->GetDeviceProperties().lazilyAllocatedMemory ? 1 : 0) );
+
+		DeleteResources( image, pipeline );
+
+		FG_LOGI( TEST_NAME << " - passed" );
+		return true;
+	}
+
+}	// FG
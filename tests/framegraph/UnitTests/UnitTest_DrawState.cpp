@@ -0,0 +1,165 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "VDrawTask.h"
+#include "stl/Log/TimeProfiler.h"
+#include "UnitTest_Common.h"
+
+namespace
+{
+	using VertexAttrib		= VertexInputState::VertexAttrib;
+	using ColorBuffers_t	= _fg_hidden_::ColorBuffers_t;
+	using DynamicStates		= _fg_hidden_::DynamicStates;
+
+	struct Vertex1
+	{
+		float3			position;
+		Vec<short,2>	texcoord;
+		RGBA8u			color;
+	};
+
+	struct DrawState
+	{
+		VertexInputState	vertexInput;
+		ColorBuffers_t		colorBuffers;
+		DynamicStates		dynamicStates;
+		EPrimitive			topology			= EPrimitive::TriangleList;
+		bool				primitiveRestart	= false;
+		HashVal				drawStateHash;
+
+		DrawState ()
+		{
+			vertexInput.Bind( VertexBufferID(), SizeOf<Vertex1> );
+			vertexInput.Add( VertexID("position"),	&Vertex1::position );
+			vertexInput.Add( VertexID("texcoord"),	&Vertex1::texcoord, true );
+			vertexInput.Add( VertexID("color"),		&Vertex1::color );
+
+			RenderState::ColorBuffer	cb;
+			cb.blend = true;
+			colorBuffers.insert({ RenderTargetID::Color_0, cb });
+
+			dynamicStates.hasDepthTest		= true;
+			dynamicStates.depthTest			= true;
+			dynamicStates.hasCullMode		= true;
+			dynamicStates.cullMode			= ECullMode::Back;
+		}
+
+		void UpdateHash ()
+		{
+			drawStateHash = VBaseDrawVerticesTask::CalcDrawStateHash( vertexInput, colorBuffers, dynamicStates, topology, primitiveRestart );
+		}
+
+		ND_ bool  IsSame (const DrawState &rhs) const
+		{
+			return VBaseDrawVerticesTask::IsSameStates( *this, rhs );
+		}
+	};
+}
+
+
+static void DrawState_Test1 ()
+{
+	DrawState	a;	a.UpdateHash();
+	DrawState	b;	b.UpdateHash();
+
+	TEST( a.drawStateHash == b.drawStateHash );
+	TEST( a.IsSame( b ));
+
+	// stencil reference is dynamic state, value doesn't affect the pipeline
+	a.dynamicStates.hasStencilReference	= b.dynamicStates.hasStencilReference = true;
+	a.dynamicStates.stencilReference	= 1;
+	b.dynamicStates.stencilReference	= 2;
+	a.UpdateHash();
+	b.UpdateHash();
+	TEST( a.IsSame( b ));
+
+	// value is ignored if state is not overridden
+	b.dynamicStates.hasFrontFaceCCW		= false;
+	b.dynamicStates.frontFaceCCW		= true;
+	b.UpdateHash();
+	TEST( a.IsSame( b ));
+
+	b.topology = EPrimitive::LineList;
+	b.UpdateHash();
+	TEST( a.drawStateHash != b.drawStateHash );
+	TEST( not a.IsSame( b ));
+
+	b = DrawState{};
+	b.dynamicStates.hasStencilReference	= true;
+	b.dynamicStates.cullMode			= ECullMode::Front;
+	b.UpdateHash();
+	TEST( not a.IsSame( b ));
+
+	b = DrawState{};
+	b.dynamicStates.hasStencilReference	= true;
+	b.vertexInput.Add( VertexID("normal"), EVertexType::Float3, 0_b );
+	b.UpdateHash();
+	TEST( not a.IsSame( b ));
+}
+
+
+static void DrawState_Test2 ()
+{
+	// compare per-draw cost of searching for pipeline instance with the same state
+	constexpr uint	draw_count	= 100'000;
+
+	const FixedArray<VertexAttrib, 16>	attribs = {{
+		{ VertexID("position"),	0, EVertexType::Float3 },
+		{ VertexID("texcoord"),	1, EVertexType::Float2 },
+		{ VertexID("color"),	2, EVertexType::Float4 }
+	}};
+
+	RenderState		pass_state;
+	pass_state.depth.test	= true;
+	pass_state.depth.write	= true;
+
+	DrawState		draw;
+	draw.UpdateHash();
+
+	DrawState		cached;
+	cached.UpdateHash();
+
+	size_t	sum = 0;
+	{
+		TimeProfiler	profiler{ "build and hash render state" };
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			RenderState			rs		= pass_state;
+			VertexInputState	vinput	= draw.vertexInput;
+
+			rs.inputAssembly.topology			= draw.topology;
+			rs.inputAssembly.primitiveRestart	= draw.primitiveRestart;
+
+			for (auto& cb : draw.colorBuffers) {
+				rs.color.buffers[ uint(cb.first) ] = cb.second;
+			}
+			rs.depth.test				= draw.dynamicStates.hasDepthTest ? draw.dynamicStates.depthTest : rs.depth.test;
+			rs.rasterization.cullMode	= draw.dynamicStates.hasCullMode ? draw.dynamicStates.cullMode : rs.rasterization.cullMode;
+
+			TEST( vinput.ApplyAttribs( attribs ));
+			sum += size_t(HashOf( rs ) + HashOf( vinput ));
+		}
+	}
+
+	uint	hits = 0;
+	{
+		TimeProfiler	profiler{ "compare precomputed draw state" };
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			hits += uint(draw.IsSame( cached ));
+		}
+	}
+
+	TEST( hits == draw_count );
+	TEST( sum != 0 );
+}
+
+
+extern void UnitTest_DrawState ()
+{
+	DrawState_Test1();
+	DrawState_Test2();
+
+	FG_LOGI( "UnitTest_DrawState - passed" );
+}
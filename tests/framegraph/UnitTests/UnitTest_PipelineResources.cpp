@@ -0,0 +1,145 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "Shared/PipelineResourcesHelper.h"
+#include "stl/Log/TimeProfiler.h"
+#include "UnitTest_Common.h"
+
+namespace
+{
+	static constexpr uint	texture_count	= 16;
+
+	ND_ PipelineResources  CreateResources ()
+	{
+		auto	uniforms = MakeShared<PipelineDescription::UniformMap_t>();
+
+		for (uint i = 0; i < texture_count; ++i)
+		{
+			PipelineDescription::Texture	tex;
+			tex.state		= EResourceState::ShaderSample | EResourceState::_FragmentShader;
+			tex.textureType	= EImageSampler::Float2D;
+
+			PipelineDescription::Uniform	un;
+			un.data			= tex;
+			un.index		= BindingIndex{ i, i };
+			un.stageFlags	= EShaderStages::Fragment;
+
+			uniforms->insert({ UniformID{"un_Texture" + ToString(i)}, un });
+		}
+		{
+			PipelineDescription::StorageBuffer	sb;
+			sb.state		= EResourceState::ShaderRead | EResourceState::_FragmentShader;
+			sb.staticSize	= 16_b;
+
+			PipelineDescription::Uniform	un;
+			un.data			= sb;
+			un.index		= BindingIndex{ 0, texture_count };
+			un.stageFlags	= EShaderStages::Fragment;
+
+			uniforms->insert({ UniformID{"un_Buffer"}, un });
+		}
+
+		auto	data = PipelineResourcesHelper::CreateDynamicData( uniforms, uint(uniforms->size()), uint(uniforms->size()), 0 );
+
+		PipelineResources	res;
+		TEST( PipelineResourcesHelper::Initialize( OUT res, RawDescriptorSetLayoutID{ 1, 0 }, data ));
+		return res;
+	}
+
+	ND_ HashVal  GetHash (const PipelineResources &res, bool recalc = false)
+	{
+		auto	data = PipelineResourcesHelper::CloneDynamicData( res );
+		return recalc ? data->CalcHash() : data->GetHash();
+	}
+}
+
+
+static void PipelineResources_Test1 ()
+{
+	const RawPipelineResourcesID	cached_id{ 1, 0 };
+
+	PipelineResources	res = CreateResources();
+	TEST( GetHash( res ) == GetHash( res, true ));
+
+	for (uint i = 0; i < texture_count; ++i) {
+		res.BindTexture( UniformID{"un_Texture" + ToString(i)}, RawImageID{ i, 0 }, RawSamplerID{ 0, 0 });
+	}
+	res.BindBuffer( UniformID{"un_Buffer"}, RawBufferID{ 0, 0 });
+
+	const HashVal	hash1 = GetHash( res );
+	TEST( hash1 == GetHash( res, true ));
+
+	// same resources doesn't invalidate cache
+	PipelineResourcesHelper::SetCache( res, cached_id );
+	res.BindTexture( UniformID{"un_Texture3"}, RawImageID{ 3, 0 }, RawSamplerID{ 0, 0 });
+	res.BindBuffer( UniformID{"un_Buffer"}, RawBufferID{ 0, 0 });
+	TEST( PipelineResourcesHelper::GetCached( res ) == cached_id );
+	TEST( GetHash( res ) == hash1 );
+
+	// only changed uniform is rehashed
+	res.BindTexture( UniformID{"un_Texture3"}, RawImageID{ 100, 0 }, RawSamplerID{ 0, 0 });
+	TEST( not PipelineResourcesHelper::GetCached( res ));
+	TEST( GetHash( res ) != hash1 );
+	TEST( GetHash( res ) == GetHash( res, true ));
+
+	// hash is restored when previous resource is bound
+	res.BindTexture( UniformID{"un_Texture3"}, RawImageID{ 3, 0 }, RawSamplerID{ 0, 0 });
+	TEST( GetHash( res ) == hash1 );
+
+	auto	data1 = PipelineResourcesHelper::CloneDynamicData( res );
+	res.BindBuffer( UniformID{"un_Buffer"}, RawBufferID{ 1, 0 }, 16_b, 32_b );
+	auto	data2 = PipelineResourcesHelper::CloneDynamicData( res );
+	TEST( not (*data1 == *data2) );
+	TEST( data2->GetHash() == data2->CalcHash() );
+
+	res.Reset( UniformID{"un_Texture0"} );
+	TEST( GetHash( res ) == GetHash( res, true ));
+
+	res.ResetAll();
+	TEST( GetHash( res ) == GetHash( res, true ));
+}
+
+
+static void PipelineResources_Test2 ()
+{
+	// compare cost of full and incremental hash calculation when single texture is changed per draw
+	constexpr uint	draw_count	= 100'000;
+
+	PipelineResources	res		= CreateResources();
+	auto				data	= PipelineResourcesHelper::CloneDynamicData( res );
+	auto&				un		= data->Uniforms()[0];
+	auto&				tex		= *Cast<PipelineResources::Texture>( data.get() + BytesU{un.offset} );
+
+	TEST( un.resType == PipelineResources::EDescriptorType::Texture );
+
+	size_t	sum1 = 0;
+	size_t	sum2 = 0;
+	{
+		TimeProfiler	profiler{ "full hash calculation" };
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			tex.elements[0].imageId = RawImageID{ i & 0xFF, 0 };
+			sum1 += size_t(data->CalcHash());
+		}
+	}
+	{
+		TimeProfiler	profiler{ "incremental hash" };
+
+		for (uint i = 0; i < draw_count; ++i)
+		{
+			tex.elements[0].imageId = RawImageID{ i & 0xFF, 0 };
+			data->UpdateHash( INOUT un );
+			sum2 += size_t(data->GetHash());
+		}
+	}
+	TEST( sum1 == sum2 );
+}
+
+
+extern void UnitTest_PipelineResources ()
+{
+	PipelineResources_Test1();
+	PipelineResources_Test2();
+
+	FG_LOGI( "UnitTest_PipelineResources - passed" );
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VTaskGraph.h"
+#include "stl/Log/TimeProfiler.h"
+#include "UnitTest_Common.h"
+#include "DummyTask.h"
+
+
+static Array<UniquePtr<VFgDummyTask>>  CreateTasks (size_t count)
+{
+	Array<UniquePtr<VFgDummyTask>>	result;		result.reserve( count );
+
+	for (size_t i = 0; i < count; ++i) {
+		result.emplace_back( new VFgDummyTask() );
+	}
+	return result;
+}
+
+
+static void  ProcessTasks (ArrayView<UniquePtr<VFgDummyTask>> tasks, size_t edgeCount, OUT size_t &processed)
+{
+	LinearAllocator<>	allocator;
+	Array<VTask>		entries;
+	ExeOrderIndex		exe_order_index	= ExeOrderIndex::First;
+
+	for (auto& task : tasks)
+	{
+		if ( task->Inputs().empty() )
+			entries.push_back( task.get() );
+	}
+
+	processed = VisitTasksInTopologicalOrder( entries, edgeCount, 1, allocator,
+											  [&exe_order_index] (VTask node) { node->SetExecutionOrder( ++exe_order_index ); });
+}
+
+
+static bool  IsSorted (ArrayView<UniquePtr<VFgDummyTask>> tasks)
+{
+	for (auto& task : tasks)
+	{
+		if ( task->ExecutionOrder() == ExeOrderIndex::Initial )
+			return false;
+
+		for (auto in_node : task->Inputs())
+		{
+			if ( in_node->ExecutionOrder() >= task->ExecutionOrder() )
+				return false;
+		}
+	}
+	return true;
+}
+
+
+static void TaskGraph_Test1 ()
+{
+	// A, B - entries, C(A,B), D(B), E(C,D)
+	auto	tasks = CreateTasks( 5 );
+
+	tasks[2]->DependsOn( tasks[0].get() );
+	tasks[2]->DependsOn( tasks[1].get() );
+	tasks[3]->DependsOn( tasks[1].get() );
+	tasks[4]->DependsOn( tasks[2].get() );
+	tasks[4]->DependsOn( tasks[3].get() );
+
+	size_t	processed = 0;
+	ProcessTasks( tasks, 5, OUT processed );
+
+	TEST( processed == tasks.size() );
+	TEST( IsSorted( tasks ));
+	TEST( tasks[0]->ExecutionOrder() == ExeOrderIndex(2) );
+	TEST( tasks[1]->ExecutionOrder() == ExeOrderIndex(3) );
+	TEST( tasks[2]->ExecutionOrder() == ExeOrderIndex(4) );
+	TEST( tasks[3]->ExecutionOrder() == ExeOrderIndex(5) );
+	TEST( tasks[4]->ExecutionOrder() == ExeOrderIndex(6) );
+}
+
+
+static void TaskGraph_Test2 ()
+{
+	// task with unknown input must be reported as unprocessed
+	auto			tasks	= CreateTasks( 4 );
+	VFgDummyTask	unknown;
+
+	tasks[1]->DependsOn( tasks[0].get() );
+	tasks[2]->DependsOn( tasks[1].get() );
+	tasks[2]->DependsOn( &unknown );
+	tasks[3]->DependsOn( tasks[2].get() );
+
+	size_t	processed = 0;
+	ProcessTasks( tasks, 4, OUT processed );
+
+	TEST( processed == 2 );
+	TEST( tasks[2]->ExecutionOrder() == ExeOrderIndex::Initial );
+	TEST( tasks[3]->ExecutionOrder() == ExeOrderIndex::Initial );
+}
+
+
+static void TaskGraph_Test3 ()
+{
+	// long dependency chains and wide layers, time must grow linearly
+	for (size_t count : {1'000, 10'000, 100'000})
+	{
+		auto	tasks		= CreateTasks( count );
+		size_t	edge_count	= 0;
+
+		for (size_t i = 1; i < count; ++i)
+		{
+			tasks[i]->DependsOn( tasks[i-1].get() );
+			++edge_count;
+
+			if ( i % 3 == 0 and i >= 64 ) {
+				tasks[i]->DependsOn( tasks[i-64].get() );
+				++edge_count;
+			}
+		}
+
+		size_t	processed = 0;
+		{
+			TimeProfiler	profiler{ "sort "s << ToString(count) << " tasks" };
+			ProcessTasks( tasks, edge_count, OUT processed );
+		}
+
+		TEST( processed == count );
+		TEST( IsSorted( tasks ));
+	}
+}
+
+
+extern void UnitTest_TaskGraph ()
+{
+	TaskGraph_Test1();
+	TaskGraph_Test2();
+	TaskGraph_Test3();
+	FG_LOGI( "UnitTest_TaskGraph - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
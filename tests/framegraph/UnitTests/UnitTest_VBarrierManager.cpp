@@ -0,0 +1,64 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VBarrierManager.h"
+#include "UnitTest_Common.h"
+
+
+// merging of buffer barriers with adjacent and overlapped ranges
+static void VBarrierManager_Test1 ()
+{
+	VBarrierManager		barrier_mngr;
+	const VkBuffer		buffer		= BitCast<VkBuffer>( size_t(0x1000) );
+
+	VkBufferMemoryBarrier	barrier = {};
+	barrier.sType				= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	barrier.buffer				= buffer;
+	barrier.srcAccessMask		= VK_ACCESS_TRANSFER_WRITE_BIT;
+	barrier.dstAccessMask		= VK_ACCESS_SHADER_READ_BIT;
+	barrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	barrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+
+	// adjacent and overlapped ranges are merged
+	barrier.offset = 0;		barrier.size = 64;
+	barrier_mngr.AddBufferBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier );
+	
+	barrier.offset = 64;	barrier.size = 64;
+	barrier_mngr.AddBufferBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier );
+	
+	barrier.offset = 100;	barrier.size = 100;
+	barrier_mngr.AddBufferBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier );
+
+	// gap between ranges
+	barrier.offset = 256;	barrier.size = 64;
+	barrier_mngr.AddBufferBarrier( VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier );
+
+	// read -> read
+	barrier.srcAccessMask	= VK_ACCESS_SHADER_READ_BIT;
+	barrier.offset = 0;		barrier.size = 64;
+	barrier_mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier );
+
+	// 10k barriers for adjacent ranges
+	barrier.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT;
+	for (uint i = 0; i < 10'000; ++i)
+	{
+		barrier.offset = 1024 + i * 16;		barrier.size = 16;
+		barrier_mngr.AddBufferBarrier( VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier );
+	}
+
+	auto	stat = barrier_mngr.ReadStatistic();
+	TEST( stat.mergedBarriers == 2 + 9'999 );
+	TEST( stat.skippedBarriers == 1 );
+
+	barrier_mngr.ClearBarriers();
+}
+
+
+extern void UnitTest_VBarrierManager ()
+{
+	VBarrierManager_Test1();
+	FG_LOGI( "UnitTest_VBarrierManager - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
@@ -7,6 +7,7 @@
 #include "framegraph/Public/FrameGraph.h"
 #include "UnitTest_Common.h"
 #include "DummyTask.h"
+#include "stl/Log/TimeProfiler.h"
 
 
 namespace FG
@@ -22,12 +23,26 @@ namespace FG
 			return true;
 		}
 
-		static ArrayView<Barrier>  GetReadBarriers (const VLocalBuffer *buf) {
-			return buf->_accessForRead;
+		static Array<Barrier>  GetReadBarriers (const VLocalBuffer *buf) {
+			return _ToArray( *buf->_accessForRead );
 		}
 		
-		static ArrayView<Barrier>  GetWriteBarriers (const VLocalBuffer *buf) {
-			return buf->_accessForWrite;
+		static Array<Barrier>  GetWriteBarriers (const VLocalBuffer *buf) {
+			return _ToArray( *buf->_accessForWrite );
+		}
+
+		static bool  HasAccessRecords (const VLocalBuffer *buf) {
+			return buf->_accessForWrite.has_value() or buf->_accessForRead.has_value();
+		}
+
+	private:
+		static Array<Barrier>  _ToArray (const VLocalBuffer::AccessRecords_t &records)
+		{
+			Array<Barrier>	result;
+			for (auto& rec : records) {
+				result.push_back( rec.second );
+			}
+			return result;
 		}
 	};
 
@@ -42,13 +57,14 @@ static void VBuffer_Test1 ()
 	const auto			tasks		= GenDummyTasks( 30 );
 	auto				task_iter	= tasks.begin();
 
+	LinearAllocator<>	allocator;
 	VBuffer				global_buffer;
 	VLocalBuffer		local_buffer;
 	VLocalBuffer const*	buf			= &local_buffer;
 
 	TEST( VBufferUnitTest::Create( global_buffer, BufferDesc{ 1024_b, EBufferUsage::All }));
 
-	TEST( local_buffer.Create( &global_buffer ));
+	TEST( local_buffer.Create( &global_buffer, allocator ));
 
 
 	// pass 1
@@ -322,9 +338,111 @@ static void VBuffer_Test1 ()
 }
 
 
+static void VBuffer_Test2 ()
+{
+	VBarrierManager		barrier_mngr;
+	
+	const uint			count		= 10'000;
+	const auto			tasks		= GenDummyTasks( count + 1 );
+	auto				task_iter	= tasks.begin();
+	
+	LinearAllocator<>	allocator;
+	VBuffer				global_buffer;
+	VLocalBuffer		local_buffer;
+	VLocalBuffer const*	buf			= &local_buffer;
+
+	allocator.SetBlockSize( 1_Mb );
+
+	TEST( VBufferUnitTest::Create( global_buffer, BufferDesc{ 256_Mb, EBufferUsage::All }));
+	TEST( local_buffer.Create( &global_buffer, allocator ));
+
+	// disjoint writes in random order
+	{
+		TimeProfiler	profiler{ "write to "s << ToString(count) << " disjoint ranges" };
+
+		for (uint i = 0; i < count; ++i)
+		{
+			const VkDeviceSize	offset = VkDeviceSize((i * 7919) % count) * 1024;
+
+			buf->AddPendingState(BufferState{ EResourceState::ShaderWrite | EResourceState::_ComputeShader, offset, offset + 512, (task_iter++)->get() });
+			buf->CommitBarrier( barrier_mngr, null );
+		}
+	}
+
+	auto	w_barriers = VBufferUnitTest::GetWriteBarriers( buf );
+	TEST( w_barriers.size() == count );
+
+	for (uint i = 0; i < count; ++i)
+	{
+		TEST( w_barriers[i].range.begin == i * 1024 );
+		TEST( w_barriers[i].range.end == i * 1024 + 512 );
+	}
+
+	auto	stat = barrier_mngr.ReadStatistic();
+	TEST( stat.mergedBarriers == 0 );
+	TEST( stat.skippedBarriers == 0 );
+
+	// read all
+	{
+		buf->AddPendingState(BufferState{ EResourceState::UniformRead | EResourceState::_VertexShader, 0, VkDeviceSize(256_Mb), (task_iter++)->get() });
+		buf->CommitBarrier( barrier_mngr, null );
+
+		auto	r_barriers = VBufferUnitTest::GetReadBarriers( buf );
+		TEST( r_barriers.size() == 1 );
+		TEST( r_barriers[0].range.begin == 0 );
+		TEST( r_barriers[0].range.end == VkDeviceSize(256_Mb) );
+	}
+	
+	local_buffer.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+	barrier_mngr.ClearBarriers();
+
+	local_buffer.Destroy();
+}
+
+
+static void VBuffer_Test3 ()
+{
+	VBarrierManager		barrier_mngr;
+
+	const auto			tasks		= GenDummyTasks( 4 );
+	auto				task_iter	= tasks.begin();
+
+	LinearAllocator<>	allocator;
+	VBuffer				global_buffer;
+	VLocalBuffer		local_buffer;
+	VLocalBuffer const*	buf			= &local_buffer;
+
+	TEST( VBufferUnitTest::Create( global_buffer, BufferDesc{ 1024_b, EBufferUsage::All }));
+
+	// access records must be destroyed before memory is discarded by the command buffer
+	for (uint i = 0; i < 2; ++i)
+	{
+		TEST( local_buffer.Create( &global_buffer, allocator ));
+
+		buf->AddPendingState(BufferState{ EResourceState::TransferDst, 0, 512, (task_iter++)->get() });
+		buf->CommitBarrier( barrier_mngr, null );
+		TEST( VBufferUnitTest::GetWriteBarriers( buf ).size() == 1 );
+
+		buf->AddPendingState(BufferState{ EResourceState::TransferSrc, 256, 1024, (task_iter++)->get() });
+		buf->CommitBarrier( barrier_mngr, null );
+		TEST( VBufferUnitTest::GetReadBarriers( buf ).size() == 1 );
+
+		local_buffer.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+		barrier_mngr.ClearBarriers();
+
+		local_buffer.Destroy();
+		TEST( not VBufferUnitTest::HasAccessRecords( buf ));
+
+		allocator.Discard();
+	}
+}
+
+
 extern void UnitTest_VBuffer ()
 {
 	VBuffer_Test1();
+	VBuffer_Test2();
+	VBuffer_Test3();
 	FG_LOGI( "UnitTest_VBuffer - passed" );
 }
 
@@ -0,0 +1,116 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VCommandBuffer.h"
+#include "UnitTest_Common.h"
+
+
+namespace FG
+{
+	class VCommandBufferUnitTest
+	{
+	public:
+		using Index_t			= VCommandBuffer::Index_t;
+		using Allocator_t		= VCommandBuffer::Allocator_t;
+		using LocalIndexMap		= VCommandBuffer::LocalIndexMap;
+	};
+}
+
+
+// global indices are sparse, memory depends only on count of inserted indices
+static void VCommandBuffer_Test1 ()
+{
+	using Index_t = VCommandBufferUnitTest::Index_t;
+
+	VCommandBufferUnitTest::Allocator_t		alloc;
+	VCommandBufferUnitTest::LocalIndexMap	map;
+
+	constexpr uint	count		= 1000;
+	const auto		GlobalIdx	= [] (uint i) { return Index_t( (i * 7919u) % 0xFFFFu ); };
+
+	for (uint i = 0; i < count; ++i)
+	{
+		Index_t&	local = map.Insert( GlobalIdx(i), alloc );
+		TEST( local == Index_t(UMax) );
+		local = Index_t(i);
+	}
+
+	TEST( map.count == count );
+	TEST( IsPowerOfTwo( map.capacity ));
+	TEST( map.count * 4 <= map.capacity * 3 );
+	TEST( map.capacity <= count * 4 );
+
+	// existing items are not changed after rehashing
+	for (uint i = 0; i < count; ++i)
+	{
+		TEST( map.Insert( GlobalIdx(i), alloc ) == Index_t(i) );
+	}
+	TEST( map.count == count );
+
+	// memory is owned by allocator, so reset only clears the table
+	map.Reset();
+	TEST( map.count == 0 and map.capacity == 0 and not map.items );
+	TEST( map.Insert( GlobalIdx(0), alloc ) == Index_t(UMax) );
+}
+
+
+// indices that are mapped to the same slot
+static void VCommandBuffer_Test2 ()
+{
+	using Index_t = VCommandBufferUnitTest::Index_t;
+
+	VCommandBufferUnitTest::Allocator_t		alloc;
+	VCommandBufferUnitTest::LocalIndexMap	map;
+
+	map.Insert( 0, alloc ) = 100;
+	const uint	capacity = map.capacity;
+
+	// multiple of capacity is mapped to the same slot as 0
+	for (uint i = 1; i < 16; ++i)
+	{
+		map.Insert( Index_t(i * capacity), alloc ) = Index_t(100 + i);
+	}
+	TEST( map.capacity == capacity );
+	TEST( map.count == 16 );
+
+	for (uint i = 0; i < 16; ++i)
+	{
+		TEST( map.Insert( Index_t(i * capacity), alloc ) == Index_t(100 + i) );
+	}
+}
+
+
+
+// search doesn't insert new items
+static void VCommandBuffer_Test3 ()
+{
+	using Index_t = VCommandBufferUnitTest::Index_t;
+
+	VCommandBufferUnitTest::Allocator_t		alloc;
+	VCommandBufferUnitTest::LocalIndexMap	map;
+
+	TEST( map.Find( 0 ) == Index_t(UMax) );
+
+	for (uint i = 0; i < 100; ++i)
+	{
+		map.Insert( Index_t(i * 3), alloc ) = Index_t(i);
+	}
+
+	for (uint i = 0; i < 300; ++i)
+	{
+		TEST( map.Find( Index_t(i) ) == (i % 3 == 0 ? Index_t(i / 3) : Index_t(UMax)) );
+	}
+	TEST( map.count == 100 );
+}
+
+
+extern void UnitTest_VCommandBuffer ()
+{
+	VCommandBuffer_Test1();
+	VCommandBuffer_Test2();
+	VCommandBuffer_Test3();
+	FG_LOGI( "UnitTest_VCommandBuffer - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
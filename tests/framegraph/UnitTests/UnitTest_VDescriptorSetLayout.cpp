@@ -0,0 +1,109 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VDescriptorSetLayout.h"
+#include "UnitTest_Common.h"
+
+
+namespace FG
+{
+	class VDescriptorSetLayoutUnitTest
+	{
+	public:
+		using DescriptorBinding_t		= VDescriptorSetLayout::DescriptorBinding_t;
+		using TemplateEntries_t			= VDescriptorSetLayout::TemplateEntries_t;
+		using UpdateTemplateEntries_t	= VDescriptorSetLayout::UpdateTemplateEntries_t;
+
+		static bool  CalcTemplateEntries (const DescriptorBinding_t &binding, uint maxIndex, OUT TemplateEntries_t &templateEntries,
+										  OUT UpdateTemplateEntries_t &updateEntries, OUT uint &dataSize)
+		{
+			return VDescriptorSetLayout::_CalcTemplateEntries( binding, maxIndex, OUT templateEntries, OUT updateEntries, OUT dataSize );
+		}
+	};
+}
+
+
+static VkDescriptorSetLayoutBinding  Binding (uint index, VkDescriptorType type, uint count)
+{
+	VkDescriptorSetLayoutBinding	bind = {};
+	bind.binding			= index;
+	bind.descriptorType		= type;
+	bind.descriptorCount	= count;
+	bind.stageFlags			= VK_SHADER_STAGE_ALL;
+	return bind;
+}
+
+
+// descriptor infos are packed in binding order
+static void VDescriptorSetLayout_Test1 ()
+{
+	VDescriptorSetLayoutUnitTest::DescriptorBinding_t	binding;
+	binding.push_back( Binding( 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 ));
+	binding.push_back( Binding( 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 ));
+	binding.push_back( Binding( 3, VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, 2 ));
+	binding.push_back( Binding( 4, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 ));
+
+	VDescriptorSetLayoutUnitTest::TemplateEntries_t			tmpl_entries;
+	VDescriptorSetLayoutUnitTest::UpdateTemplateEntries_t	update_entries;
+	uint													data_size = 0;
+
+	TEST( VDescriptorSetLayoutUnitTest::CalcTemplateEntries( binding, 4, OUT tmpl_entries, OUT update_entries, OUT data_size ));
+	TEST( tmpl_entries.size() == 5 );
+	TEST( update_entries.size() == binding.size() );
+
+	const uint	offset1	= uint(sizeof(VkDescriptorBufferInfo));
+	const uint	offset3	= offset1 + uint(sizeof(VkDescriptorImageInfo) * 4);
+	const uint	offset4	= offset3 + uint(sizeof(VkBufferView) * 2);
+
+	TEST( tmpl_entries[0].offset == 0 );
+	TEST( tmpl_entries[0].count == 1 );
+	TEST( tmpl_entries[0].type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC );
+	TEST( tmpl_entries[1].offset == offset1 );
+	TEST( tmpl_entries[1].count == 4 );
+	TEST( tmpl_entries[2].offset == UMax );		// unused binding
+	TEST( tmpl_entries[2].count == 0 );
+	TEST( tmpl_entries[3].offset == offset3 );
+	TEST( tmpl_entries[4].offset == offset4 );
+	TEST( data_size == offset4 + uint(sizeof(VkDescriptorImageInfo)) );
+
+	// update entries must point to the same data
+	for (auto& entry : update_entries)
+	{
+		auto&	tmpl = tmpl_entries[ entry.dstBinding ];
+		TEST( entry.offset == tmpl.offset );
+		TEST( entry.descriptorCount == tmpl.count );
+		TEST( entry.descriptorType == tmpl.type );
+		TEST( entry.dstArrayElement == 0 );
+		TEST( entry.offset + entry.stride * entry.descriptorCount <= data_size );
+	}
+	TEST( update_entries[1].stride == sizeof(VkDescriptorImageInfo) );
+	TEST( update_entries[2].stride == sizeof(VkBufferView) );
+}
+
+
+// acceleration structure can't be written with template
+static void VDescriptorSetLayout_Test2 ()
+{
+#ifdef VK_NV_ray_tracing
+	VDescriptorSetLayoutUnitTest::DescriptorBinding_t	binding;
+	binding.push_back( Binding( 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1 ));
+	binding.push_back( Binding( 1, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_NV, 1 ));
+
+	VDescriptorSetLayoutUnitTest::TemplateEntries_t			tmpl_entries;
+	VDescriptorSetLayoutUnitTest::UpdateTemplateEntries_t	update_entries;
+	uint													data_size = 0;
+
+	TEST( not VDescriptorSetLayoutUnitTest::CalcTemplateEntries( binding, 1, OUT tmpl_entries, OUT update_entries, OUT data_size ));
+#endif
+}
+
+
+extern void UnitTest_VDescriptorSetLayout ()
+{
+	VDescriptorSetLayout_Test1();
+	VDescriptorSetLayout_Test2();
+	FG_LOGI( "UnitTest_VDescriptorSetLayout - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
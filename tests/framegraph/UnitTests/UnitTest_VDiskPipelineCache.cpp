@@ -0,0 +1,186 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VDiskPipelineCache.h"
+#include "UnitTest_Common.h"
+
+
+namespace FG
+{
+	class VDiskPipelineCacheUnitTest
+	{
+	public:
+		using FileHeader = VDiskPipelineCache::FileHeader;
+
+		static Array<uint8_t>  CreateFile (ArrayView<uint8_t> data, const VkPhysicalDeviceProperties &props)
+		{
+			FileHeader	header;
+			std::memset( OUT &header, 0, sizeof(header) );
+			VDiskPipelineCache::_InitHeader( OUT header, data, props );
+
+			Array<uint8_t>	file;
+			file.resize( sizeof(header) );
+			std::memcpy( OUT file.data(), &header, sizeof(header) );
+			file.insert( file.end(), data.begin(), data.end() );
+			return file;
+		}
+
+		static bool  Parse (ArrayView<uint8_t> file, const VkPhysicalDeviceProperties &props, OUT Array<uint8_t> &data)
+		{
+			return VDiskPipelineCache::_Parse( file, props, OUT data );
+		}
+	};
+}	// FG
+
+
+static VkPhysicalDeviceProperties  CreateProperties ()
+{
+	VkPhysicalDeviceProperties	props = {};
+	props.vendorID		= 0x10DE;
+	props.deviceID		= 0x1234;
+	props.driverVersion	= 42;
+
+	for (uint i = 0; i < VK_UUID_SIZE; ++i) {
+		props.pipelineCacheUUID[i] = uint8_t(i + 1);
+	}
+	return props;
+}
+
+
+// driver cache data, see 'VkPipelineCacheHeaderVersionOne'
+static Array<uint8_t>  CreateDriverData (const VkPhysicalDeviceProperties &props)
+{
+	const uint		header[] = { uint(sizeof(uint) * 4 + VK_UUID_SIZE), uint(VK_PIPELINE_CACHE_HEADER_VERSION_ONE), props.vendorID, props.deviceID };
+	Array<uint8_t>	data;
+
+	data.resize( sizeof(header) + VK_UUID_SIZE + 64 );
+	std::memcpy( OUT data.data(), header, sizeof(header) );
+	std::memcpy( OUT data.data() + sizeof(header), props.pipelineCacheUUID, VK_UUID_SIZE );
+
+	for (size_t i = sizeof(header) + VK_UUID_SIZE; i < data.size(); ++i) {
+		data[i] = uint8_t(i * 7);
+	}
+	return data;
+}
+
+
+// valid file is accepted
+static void VDiskPipelineCache_Test1 ()
+{
+	const auto		props	= CreateProperties();
+	const auto		data	= CreateDriverData( props );
+	const auto		file	= VDiskPipelineCacheUnitTest::CreateFile( data, props );
+	Array<uint8_t>	loaded;
+
+	TEST( VDiskPipelineCacheUnitTest::Parse( file, props, OUT loaded ));
+	TEST( loaded == data );
+}
+
+
+// truncated file is rejected
+static void VDiskPipelineCache_Test2 ()
+{
+	const auto		props	= CreateProperties();
+	const auto		data	= CreateDriverData( props );
+	const auto		file	= VDiskPipelineCacheUnitTest::CreateFile( data, props );
+	Array<uint8_t>	loaded;
+
+	TEST( not VDiskPipelineCacheUnitTest::Parse( ArrayView<uint8_t>{ file.data(), file.size()-1 }, props, OUT loaded ));
+	TEST( not VDiskPipelineCacheUnitTest::Parse( ArrayView<uint8_t>{ file.data(), sizeof(VDiskPipelineCacheUnitTest::FileHeader)-1 }, props, OUT loaded ));
+	TEST( not VDiskPipelineCacheUnitTest::Parse( ArrayView<uint8_t>{}, props, OUT loaded ));
+
+	// header is valid, but driver data is too small
+	const auto		small	= VDiskPipelineCacheUnitTest::CreateFile( ArrayView<uint8_t>{ data.data(), 8 }, props );
+	TEST( not VDiskPipelineCacheUnitTest::Parse( small, props, OUT loaded ));
+}
+
+
+// file that was written by another device or driver is rejected
+static void VDiskPipelineCache_Test3 ()
+{
+	const auto		props	= CreateProperties();
+	const auto		data	= CreateDriverData( props );
+	const auto		file	= VDiskPipelineCacheUnitTest::CreateFile( data, props );
+	Array<uint8_t>	loaded;
+
+	auto	other = props;
+	other.vendorID = 0x1002;
+	TEST( not VDiskPipelineCacheUnitTest::Parse( file, other, OUT loaded ));
+
+	other = props;
+	other.deviceID = 0x4321;
+	TEST( not VDiskPipelineCacheUnitTest::Parse( file, other, OUT loaded ));
+
+	other = props;
+	other.driverVersion = 43;
+	TEST( not VDiskPipelineCacheUnitTest::Parse( file, other, OUT loaded ));
+
+	other = props;
+	other.pipelineCacheUUID[VK_UUID_SIZE-1] ^= 0xFF;
+	TEST( not VDiskPipelineCacheUnitTest::Parse( file, other, OUT loaded ));
+
+	// file header matches, but driver header has different UUID
+	auto	driver_data = data;
+	driver_data[sizeof(uint) * 4] ^= 0xFF;
+	TEST( not VDiskPipelineCacheUnitTest::Parse( VDiskPipelineCacheUnitTest::CreateFile( driver_data, props ), props, OUT loaded ));
+
+	// data is modified after header was written
+	auto	modified = file;
+	modified.back() ^= 0xFF;
+	TEST( not VDiskPipelineCacheUnitTest::Parse( modified, props, OUT loaded ));
+}
+
+
+// creation feedback is chained into graphics pipeline create info
+static void VDiskPipelineCache_Test4 ()
+{
+#ifdef VK_EXT_pipeline_creation_feedback
+	VkPipelineShaderStageCreateInfo		stages[2]	= {};
+	VkBaseInStructure					ext_info	= {};	// any structure that is already in the chain
+	VkGraphicsPipelineCreateInfo		info		= {};
+
+	info.sType		= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	info.pNext		= &ext_info;
+	info.stageCount	= uint(CountOf( stages ));
+	info.pStages	= stages;
+
+	// feature is not supported
+	{
+		VPipelineCreationFeedback	feedback;
+		feedback.Attach( false, INOUT info.pNext, info.stageCount );
+		TEST( info.pNext == &ext_info );
+	}
+
+	VPipelineCreationFeedback	feedback;
+	feedback.Attach( true, INOUT info.pNext, info.stageCount );
+
+	auto*	chained = Cast<VkPipelineCreationFeedbackCreateInfoEXT>( info.pNext );
+	TEST( chained == &feedback.info );
+	TEST( chained->sType == VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT );
+	TEST( chained->pNext == &ext_info );
+	TEST( chained->pipelineStageCreationFeedbackCount == info.stageCount );
+	TEST( chained->pPipelineCreationFeedback == &feedback.pipeline );
+
+	// driver writes feedback
+	TEST( not feedback.IsCacheHit() );
+
+	feedback.pipeline.flags = VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT;
+	TEST( not feedback.IsCacheHit() );
+
+	feedback.pipeline.flags |= VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT;
+	TEST( feedback.IsCacheHit() );
+#endif
+}
+
+
+extern void UnitTest_VDiskPipelineCache ()
+{
+	VDiskPipelineCache_Test1();
+	VDiskPipelineCache_Test2();
+	VDiskPipelineCache_Test3();
+	VDiskPipelineCache_Test4();
+	FG_LOGI( "UnitTest_VDiskPipelineCache - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
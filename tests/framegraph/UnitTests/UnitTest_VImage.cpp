@@ -257,10 +257,194 @@ static void VImage_Test2 ()
 }
 
 
+static void VImage_Test3 ()
+{
+	VBarrierManager		barrier_mngr;
+	
+	const auto			tasks		= GenDummyTasks( 30 );
+	auto				task_iter	= tasks.begin();
+
+	VImage				global_image;
+	VLocalImage			local_image;
+	VLocalImage const*	img			= &local_image;
+
+	TEST( VImageUnitTest::Create( global_image,
+								  ImageDesc{}.SetDimension({ 64, 64 }).SetFormat( EPixelFormat::RGBA8_UNorm )
+											.SetUsage( EImageUsage::Transfer | EImageUsage::Sampled )));
+
+	TEST( local_image.Create( &global_image ));
+
+	// pass 1: layout transition for whole subresource
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, RectU{ 0, 0, 32, 32 }},
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.size() == 1 );
+		TEST( barriers[0].index == ExeOrderIndex(1) );
+	}
+
+	// pass 2: write to non-overlapping region, access is merged with previous
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, RectU{ 32, 0, 64, 32 }},
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.size() == 2 );
+		TEST( barriers[0].index == ExeOrderIndex(2) );
+		TEST( barriers[0].isWritable == true );
+		TEST( barriers[0].layout == VK_IMAGE_LAYOUT_GENERAL );
+	}
+
+	// pass 3: read from non-overlapping region
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferSrc, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, RectU{ 0, 32, 64, 64 }},
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.size() == 3 );
+		TEST( barriers[0].index == ExeOrderIndex(3) );
+		TEST( barriers[0].access == (VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT) );
+	}
+
+	// pass 4: write to overlapping region requires barrier, previous accesses are replaced
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, RectU{ 16, 16, 48, 48 }},
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.size() == 1 );
+		TEST( barriers[0].index == ExeOrderIndex(4) );
+		TEST( barriers[0].access == VK_ACCESS_TRANSFER_WRITE_BIT );
+	}
+
+	// pass 5: whole subresource
+	{
+		img->AddPendingState(ImageState{ EResourceState::ShaderSample | EResourceState::_FragmentShader, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1 },
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.empty() );
+		TEST( barriers[0].index == ExeOrderIndex(5) );
+	}
+
+	local_image.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+	barrier_mngr.ClearBarriers();
+
+	local_image.Destroy();
+}
+
+
+// read A -> read B -> write A, write must wait for both reads
+static void VImage_Test4 ()
+{
+	VBarrierManager		barrier_mngr;
+	
+	const auto			tasks		= GenDummyTasks( 30 );
+	auto				task_iter	= tasks.begin();
+
+	VImage				global_image;
+	VLocalImage			local_image;
+	VLocalImage const*	img			= &local_image;
+	const RectU			region_a	{ 0, 0, 32, 32 };
+	const RectU			region_b	{ 32, 32, 64, 64 };
+
+	TEST( VImageUnitTest::Create( global_image,
+								  ImageDesc{}.SetDimension({ 64, 64 }).SetFormat( EPixelFormat::RGBA8_UNorm )
+											.SetUsage( EImageUsage::Transfer | EImageUsage::Sampled )));
+
+	TEST( local_image.Create( &global_image ));
+
+	// pass 1: initial layout transition
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1 },
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		TEST( barrier_mngr.HasPendingBarriers() );
+		barrier_mngr.ClearBarriers();
+	}
+
+	// pass 2: read from region A
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferSrc, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, region_a },
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		TEST( barrier_mngr.HasPendingBarriers() );	// write -> read
+		barrier_mngr.ClearBarriers();
+	}
+
+	// pass 3: read from region B, reads are merged
+	{
+		img->AddPendingState(ImageState{ EResourceState::ShaderSample | EResourceState::_FragmentShader, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, region_b },
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		TEST( not barrier_mngr.HasPendingBarriers() );
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.size() == 2 );
+		TEST( barriers[0].index == ExeOrderIndex(3) );
+		TEST( barriers[0].isReadable and not barriers[0].isWritable );
+		TEST( barriers[0].stages == (VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) );
+		TEST( barriers[0].access == (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_SHADER_READ_BIT) );
+	}
+
+	// pass 4: write to region A requires barrier
+	{
+		img->AddPendingState(ImageState{ EResourceState::TransferDst, VK_IMAGE_LAYOUT_GENERAL,
+								ImageRange{ 0_layer, 1, 0_mipmap, 1, region_a },
+								VK_IMAGE_ASPECT_COLOR_BIT, (task_iter++)->get() });
+
+		img->CommitBarrier( barrier_mngr, null );
+		TEST( barrier_mngr.HasPendingBarriers() );
+		barrier_mngr.ClearBarriers();
+
+		auto	barriers = VImageUnitTest::GetRWBarriers( img );
+		TEST( barriers.size() == 1 );
+		TEST( barriers[0].regions.size() == 1 );
+		TEST( barriers[0].index == ExeOrderIndex(4) );
+		TEST( barriers[0].access == VK_ACCESS_TRANSFER_WRITE_BIT );
+	}
+
+	local_image.ResetState( ExeOrderIndex::Final, barrier_mngr, null );
+	barrier_mngr.ClearBarriers();
+
+	local_image.Destroy();
+}
+
+
 extern void UnitTest_VImage ()
 {
 	VImage_Test1();
 	VImage_Test2();
+	VImage_Test3();
+	VImage_Test4();
 	FG_LOGI( "UnitTest_VImage - passed" );
 }
 
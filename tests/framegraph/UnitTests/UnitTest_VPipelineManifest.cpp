@@ -0,0 +1,62 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#ifdef FG_ENABLE_VULKAN
+
+#include "VPipelineManifest.h"
+#include "UnitTest_Common.h"
+
+
+// pipeline hash depends only on description
+static void VPipelineManifest_Test1 ()
+{
+	const auto	CreateDesc = [] (StringView vertSrc, StringView fragSrc, bool vertFirst)
+	{
+		GraphicsPipelineDesc	desc;
+		if ( vertFirst ) {
+			desc.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", String{vertSrc}, "vert" );
+			desc.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", String{fragSrc}, "frag" );
+		} else {
+			desc.AddShader( EShader::Fragment, EShaderLangFormat::VKSL_100, "main", String{fragSrc}, "fragment" );
+			desc.AddShader( EShader::Vertex, EShaderLangFormat::VKSL_100, "main", String{vertSrc}, "vertex" );
+		}
+		desc.AddTopology( EPrimitive::TriangleList );
+		return desc;
+	};
+
+	const uint64_t	hash0 = VPipelineManifest::CalcPipelineHash( CreateDesc( "vert source", "frag source", true ));
+	const uint64_t	hash1 = VPipelineManifest::CalcPipelineHash( CreateDesc( "vert source", "frag source", false ));
+	const uint64_t	hash2 = VPipelineManifest::CalcPipelineHash( CreateDesc( "frag source", "vert source", true ));
+	const uint64_t	hash3 = VPipelineManifest::CalcPipelineHash( CreateDesc( "vert source", "frag source", true ).AddTopology( EPrimitive::TriangleStrip ));
+
+	TEST( hash0 != 0 );
+	TEST( hash0 == hash1 );		// shader debug names and order are ignored
+	TEST( hash0 != hash2 );		// shader stages are swapped
+	TEST( hash0 != hash3 );
+}
+
+
+// SPIR-V and shader modules
+static void VPipelineManifest_Test2 ()
+{
+	const uint64_t	hash0 = VPipelineManifest::CalcPipelineHash( GraphicsPipelineDesc{}.AddShader( EShader::Vertex, EShaderLangFormat::SPIRV_100, "main", Array<uint>{ 0x07230203, 1, 2 }));
+	const uint64_t	hash1 = VPipelineManifest::CalcPipelineHash( GraphicsPipelineDesc{}.AddShader( EShader::Vertex, EShaderLangFormat::SPIRV_100, "main", Array<uint>{ 0x07230203, 1, 3 }));
+	const uint64_t	hash2 = VPipelineManifest::CalcPipelineHash( GraphicsPipelineDesc{}.AddShader( EShader::Vertex, EShaderLangFormat::SPIRV_100, "main2", Array<uint>{ 0x07230203, 1, 2 }));
+
+	TEST( hash0 != 0 );
+	TEST( hash0 != hash1 );
+	TEST( hash0 != hash2 );
+
+	// shader module can't be identified between runs
+	const uint64_t	hash3 = VPipelineManifest::CalcPipelineHash( GraphicsPipelineDesc{}.AddShader( EShader::Vertex, EShaderLangFormat::VkShader_100, PipelineDescription::VkShaderPtr{} ));
+	TEST( hash3 == 0 );
+}
+
+
+extern void UnitTest_VPipelineManifest ()
+{
+	VPipelineManifest_Test1();
+	VPipelineManifest_Test2();
+	FG_LOGI( "UnitTest_VPipelineManifest - passed" );
+}
+
+#endif	// FG_ENABLE_VULKAN
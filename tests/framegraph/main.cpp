@@ -9,8 +9,16 @@ extern void UnitTest_ImageSwizzle ();
 extern void UnitTest_PixelFormat ();
 extern void UnitTest_ID ();
 extern void UnitTest_VBuffer ();
+extern void UnitTest_VBarrierManager ();
 extern void UnitTest_VImage ();
+extern void UnitTest_VDiskPipelineCache ();
+extern void UnitTest_VPipelineManifest ();
+extern void UnitTest_VDescriptorSetLayout ();
+extern void UnitTest_VCommandBuffer ();
 extern void UnitTest_ImageDesc ();
+extern void UnitTest_TaskGraph ();
+extern void UnitTest_DrawState ();
+extern void UnitTest_PipelineResources ();
 
 
 #ifdef PLATFORM_ANDROID
@@ -29,10 +37,18 @@ int main () {
 		UnitTest_PixelFormat();
 		UnitTest_ID();
 		UnitTest_ImageDesc();
+		UnitTest_PipelineResources();
 
 		#ifdef FG_ENABLE_VULKAN
 		UnitTest_VBuffer();
+		UnitTest_VBarrierManager();
 		UnitTest_VImage();
+		UnitTest_VDiskPipelineCache();
+		UnitTest_VPipelineManifest();
+		UnitTest_VDescriptorSetLayout();
+		UnitTest_VCommandBuffer();
+		UnitTest_TaskGraph();
+		UnitTest_DrawState();
 		#endif
 	}
 
@@ -0,0 +1,205 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/LfInsertOnlyMap.h"
+#include "stl/ThreadSafe/Barrier.h"
+#include "stl/Log/TimeProfiler.h"
+#include "UnitTest_Common.h"
+#include <thread>
+
+
+static void LfInsertOnlyMap_Test1 ()
+{
+	LfInsertOnlyMap< uint, uint >	map;
+
+	for (uint i = 0; i < 1000; ++i)
+	{
+		auto[node, inserted] = map.Insert( i, i*2 );
+		TEST( inserted );
+		TEST( node->key == i and node->value == i*2 );
+	}
+	TEST( map.size() == 1000 );
+
+	for (uint i = 0; i < 1000; ++i)
+	{
+		auto[node, inserted] = map.Insert( i, 0 );
+		TEST( not inserted );
+		TEST( node->value == i*2 );
+	}
+	TEST( map.size() == 1000 );
+
+	for (uint i = 0; i < 2000; ++i)
+	{
+		auto*	node = map.Find( i );
+
+		if ( i < 1000 ) {
+			TEST( node and node->value == i*2 );
+		}else{
+			TEST( not node );
+		}
+	}
+
+	map.Clear();
+	TEST( map.empty() );
+	TEST( not map.Find( 1 ));
+}
+
+
+static void LfInsertOnlyMap_Test2 ()
+{
+	using T = DebugInstanceCounter< int, 1 >;
+
+	T::ClearStatistic();
+	{
+		LfInsertOnlyMap< T, T >	map;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			map.Insert( T{i}, T{i} );
+			map.Insert( T{i}, T{i} );
+		}
+		TEST( map.size() == 100 );
+	}
+	TEST( T::CheckStatistic() );
+}
+
+
+static void LfInsertOnlyMap_Test3 ()
+{
+	// insert same keys from multiple threads
+	LfInsertOnlyMap< uint, uint >	map{ 16 };
+
+	constexpr uint	thread_count	= 4;
+	constexpr uint	key_count		= 2000;
+	Atomic<uint>	inserted_count	{0};
+	Barrier			sync			{ thread_count };
+
+	const auto	fn = [&] (uint threadIndex)
+	{
+		sync.wait();
+
+		for (uint i = 0; i < key_count; ++i)
+		{
+			uint	key = (i + threadIndex * 100) % key_count;
+
+			if ( map.Insert( key, key+1 ).second )
+				inserted_count.fetch_add( 1, memory_order_relaxed );
+
+			auto*	node = map.Find( key );
+			TEST( node and node->value == key+1 );
+		}
+	};
+
+	Array<std::thread>	threads;
+	for (uint i = 0; i < thread_count; ++i) {
+		threads.emplace_back( fn, i );
+	}
+	for (auto& t : threads) {
+		t.join();
+	}
+
+	TEST( inserted_count.load() == key_count );
+	TEST( map.size() == key_count );
+
+	for (uint i = 0; i < key_count; ++i) {
+		TEST( map.Find( i ));
+	}
+}
+
+
+static void LfInsertOnlyMap_Test4 ()
+{
+	// compare lookup performance with locked hash map, used for pipeline instances
+	constexpr uint	key_count		= 64;
+	constexpr uint	lookup_count	= 200'000;
+
+	LfInsertOnlyMap< uint64_t, uint64_t >	lf_map;
+	HashMap< uint64_t, uint64_t >			locked_map;
+	SharedMutex								guard;
+
+	for (uint i = 0; i < key_count; ++i)
+	{
+		const uint64_t	key = uint64_t(i) * 0x9E3779B97F4A7C15ull;
+		lf_map.Insert( key, i );
+		locked_map.insert({ key, i });
+	}
+
+	const auto	Run = [] (uint threadCount, StringView name, const auto &fn)
+	{
+		Barrier				sync	{ threadCount + 1 };
+		Array<std::thread>	threads;
+
+		for (uint i = 0; i < threadCount; ++i)
+		{
+			threads.emplace_back( [&sync, &fn] ()
+				{
+					sync.wait();
+
+					uint64_t	sum = 0;
+					for (uint j = 0; j < lookup_count; ++j) {
+						sum += fn( uint64_t(j % key_count) * 0x9E3779B97F4A7C15ull );
+					}
+					TEST( sum == uint64_t(lookup_count / key_count) * (key_count * (key_count - 1) / 2) );
+				});
+		}
+
+		TimeProfiler	profiler{ String{name} << ", threads: " << ToString(threadCount) };
+		sync.wait();
+
+		for (auto& t : threads) {
+			t.join();
+		}
+	};
+
+	for (uint threads = 1; threads <= 16; threads *= 2)
+	{
+		Run( threads, "locked map", [&] (uint64_t key)
+			{
+				SHAREDLOCK( guard );
+				return locked_map.find( key )->second;
+			});
+
+		Run( threads, "lock-free map", [&] (uint64_t key)
+			{
+				return lf_map.Find( key )->value;
+			});
+	}
+}
+
+
+static void LfInsertOnlyMap_Test5 ()
+{
+	// bucket count depends on expected number of elements
+	LfInsertOnlyMap< uint, uint >	map{ 100 };
+	TEST( map.BucketCount() == 128 );
+
+	for (uint i = 0; i < 1000; ++i) {
+		map.Insert( i, i*2 );
+	}
+
+	map.Reserve( 10 );
+	TEST( map.BucketCount() == 128 );
+
+	map.Reserve( 1000 );
+	TEST( map.BucketCount() == 1024 );
+	TEST( map.size() == 1000 );
+
+	for (uint i = 0; i < 1000; ++i)
+	{
+		auto*	node = map.Find( i );
+		TEST( node and node->value == i*2 );
+		TEST( not map.Insert( i, 0 ).second );
+	}
+	TEST( not map.Find( 1000 ));
+}
+
+
+extern void UnitTest_LfInsertOnlyMap ()
+{
+	LfInsertOnlyMap_Test1();
+	LfInsertOnlyMap_Test2();
+	LfInsertOnlyMap_Test3();
+	LfInsertOnlyMap_Test4();
+	LfInsertOnlyMap_Test5();
+
+	FG_LOGI( "UnitTest_LfInsertOnlyMap - passed" );
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2018-2020,  Zhirnov Andrey. For more information see 'LICENSE'
+
+#include "stl/ThreadSafe/WorkerPool.h"
+#include "UnitTest_Common.h"
+
+
+static void WorkerPool_Test1 ()
+{
+	WorkerPool		pool{ 4 };
+	Array<uint>		values;		values.resize( 1000 );
+
+	TEST( pool.ThreadCount() == 4 );
+
+	for (uint j = 0; j < 10; ++j)
+	{
+		pool.ParallelFor( uint(values.size()), [&values] (uint jobIndex, uint workerIndex)
+		{
+			TEST( workerIndex < 4 );
+			values[jobIndex] += jobIndex;
+		});
+	}
+
+	for (uint i = 0; i < values.size(); ++i) {
+		TEST( values[i] == i*10 );
+	}
+}
+
+
+static void WorkerPool_Test2 ()
+{
+	WorkerPool		pool{ 1 };
+	uint			count = 0;
+
+	TEST( pool.ThreadCount() == 1 );
+
+	pool.ParallelFor( 100, [&count] (uint, uint workerIndex)
+	{
+		TEST( workerIndex == 0 );
+		++count;
+	});
+
+	TEST( count == 100 );
+}
+
+
+static void WorkerPool_Test3 ()
+{
+	WorkerPool		pool{ 3 };
+	Atomic<uint>	count {0};
+
+	// if pool is used by another thread then jobs are executed on the calling thread
+	const auto		fn = [&pool, &count] ()
+	{
+		for (uint i = 0; i < 100; ++i) {
+			pool.ParallelFor( 8, [&count] (uint, uint) { ++count; });
+		}
+	};
+
+	std::thread		t0{ fn };
+	std::thread		t1{ fn };
+	t0.join();
+	t1.join();
+
+	TEST( count == 2*100*8 );
+}
+
+
+extern void UnitTest_WorkerPool ()
+{
+	WorkerPool_Test1();
+	WorkerPool_Test2();
+	WorkerPool_Test3();
+
+	FG_LOGI( "UnitTest_WorkerPool - passed" );
+}